@@ -0,0 +1,316 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AggregatePoissonTrafficGenerator.h"
+
+/**
+ * Constructor with parameters, for identical sources.
+ *
+ * @details 
+ * The N sources have the same mean interarrival time, so the aggregate has mean interarrival time sourceTau / N and picks sources uniformly.
+ * The first source is the initial source of the generator.
+ *
+ * @param simulatorGlobals Reference to SimulatorGlobals object, to get random generator info.
+ * @param scheduler Reference to Scheduler object, such that traffic generators may schedule their events.
+ * @param eventType Event type that this generator will produce.
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param sources Entities represented by this generator (to which tokens are generated). Must not be empty.
+ * @param destination Destination entity, to which the generated tokens will be sent.
+ * @param priority Token priority. Higher priority, higher number.
+ * @param sourceTau Mean interarrival time of each source.
+ */
+AggregatePoissonTrafficGenerator::AggregatePoissonTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType,
+		std::shared_ptr<Entity> tokenContents, const std::vector<std::shared_ptr<Entity>> &sources, std::shared_ptr<Entity> destination, int priority,
+		double sourceTau): TrafficGenerator(simulatorGlobals, scheduler, eventType, tokenContents, sources.empty() ? nullptr : sources.front(), destination,
+		priority), sources(sources), tau(sourceTau / sources.size()), exponentialDistribution(1/tau), isUniform(true),
+		uniformSourceDistribution(0, sources.empty() ? 0 : sources.size() - 1) {
+}
+
+/**
+ * Constructor with parameters, for sources with individual rates.
+ *
+ * @details 
+ * The aggregate rate is the sum of the rates (1/tau) of the sources, and each arrival comes from a source with probability proportional to its rate.
+ *
+ * @param simulatorGlobals Reference to SimulatorGlobals object, to get random generator info.
+ * @param scheduler Reference to Scheduler object, such that traffic generators may schedule their events.
+ * @param eventType Event type that this generator will produce.
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param sources Entities represented by this generator (to which tokens are generated). Must not be empty.
+ * @param destination Destination entity, to which the generated tokens will be sent.
+ * @param priority Token priority. Higher priority, higher number.
+ * @param sourceTaus Mean interarrival time of each source, in the same order as sources.
+ */
+AggregatePoissonTrafficGenerator::AggregatePoissonTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType,
+		std::shared_ptr<Entity> tokenContents, const std::vector<std::shared_ptr<Entity>> &sources, std::shared_ptr<Entity> destination, int priority,
+		const std::vector<double> &sourceTaus): TrafficGenerator(simulatorGlobals, scheduler, eventType, tokenContents, sources.empty() ? nullptr : sources.front(),
+		destination, priority), sources(sources), isUniform(false) {
+	std::vector<double> rates;
+	double aggregateRate = 0.0;
+	for (auto sourceTau : sourceTaus) {
+		rates.push_back(1/sourceTau);
+		aggregateRate += 1/sourceTau;
+	}
+	tau = 1/aggregateRate;
+	exponentialDistribution = std::exponential_distribution<double>(aggregateRate);
+	weightedSourceDistribution = std::discrete_distribution<std::vector<std::shared_ptr<Entity>>::size_type>(rates.begin(), rates.end());
+}
+
+/**
+ * Creates an instance of aggregate traffic event.
+ *
+ * @details 
+ * Picks the originating source, then calls parent function and complements with event generation and exponential random variate.
+ * Uses member variable tokenContents.
+ *
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> AggregatePoissonTrafficGenerator::createInstanceTrafficEvent(bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(recordRoute);
+	if (token != nullptr) {
+		scheduler.schedule(Event(generateExponentialVariate(), eventType, token));
+	}
+	return token;
+}
+
+/**
+ * Creates an instance of aggregate traffic event.
+ *
+ * @details 
+ * Picks the originating source, then calls parent function and complements with event generation and exponential random variate.
+ * Uses parameter tokenContents.
+ *
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return Token that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> AggregatePoissonTrafficGenerator::createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(tokenContents, recordRoute);
+	if (token != nullptr) {
+		scheduler.schedule(Event(generateExponentialVariate(), eventType, token));
+	}
+	return token;
+}
+
+/**
+ * Creates an instance of aggregate traffic event.
+ *
+ * @details 
+ * Picks the originating source, then calls parent function and complements with event generation and exponential random variate.
+ * Uses member variable tokenContents and parameter explicit route.
+ *
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return Token that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> AggregatePoissonTrafficGenerator::createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(explicitRoute, recordRoute);
+	if (token != nullptr) {
+		scheduler.schedule(Event(generateExponentialVariate(), eventType, token));
+	}
+	return token;
+}
+
+/**
+ * Creates an instance of aggregate traffic event.
+ *
+ * @details 
+ * Picks the originating source, then calls parent function and complements with event generation and exponential random variate.
+ * Uses parameter tokenContents and explicit route.
+ *
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return Token that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> AggregatePoissonTrafficGenerator::createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute,
+																					 bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(tokenContents, explicitRoute, recordRoute);
+	if (token != nullptr) {
+		scheduler.schedule(Event(generateExponentialVariate(), eventType, token));
+	}
+	return token;
+}
+
+/**
+ * @brief Creates an instance of aggregate traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return PDU that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> AggregatePoissonTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(recordRoute);
+	if (token == nullptr) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(token, pduSize));
+	scheduler.schedule(Event(generateExponentialVariate(), eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Creates an instance of aggregate traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate.
+ * @param pduContents Reference to Entity object that will be carried by the token.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return PDU that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> AggregatePoissonTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> pduContents,
+																								 bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(pduContents, recordRoute);
+	if (token == nullptr) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(token, pduSize));
+	scheduler.schedule(Event(generateExponentialVariate(), eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Creates an instance of aggregate traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate.
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return PDU that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> AggregatePoissonTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, std::vector<std::shared_ptr<Entity>> explicitRoute,
+																								 bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(explicitRoute, recordRoute);
+	if (token == nullptr) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(token, pduSize));
+	scheduler.schedule(Event(generateExponentialVariate(), eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Creates an instance of aggregate traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate.
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return PDU that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> AggregatePoissonTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents,
+																								 std::vector<std::shared_ptr<Entity>> explicitRoute,
+																								 bool recordRoute) {
+	pickSource();
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(tokenContents, explicitRoute, recordRoute);
+	if (token == nullptr) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(token, pduSize));
+	scheduler.schedule(Event(generateExponentialVariate(), eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Create the token of the current arrival, from a picked source, without scheduling any event (autonomous mode).
+ *
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> AggregatePoissonTrafficGenerator::materializeToken(bool recordRoute) {
+	pickSource();
+	return TrafficGenerator::materializeToken(recordRoute);
+}
+
+/**
+ * @brief Create the PDU of the current arrival, from a picked source, without scheduling any event (autonomous mode).
+ *
+ * @param pduSize Size of PDU to generate.
+ * @param recordRoute True if this generated PDU should record the route it follows. False otherwise. Default is false.
+ * @return PDU that was generated, if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> AggregatePoissonTrafficGenerator::materializePdu(unsigned int pduSize, bool recordRoute) {
+	pickSource();
+	return TrafficGenerator::materializePdu(pduSize, recordRoute);
+}
+
+/**
+ * Generate an exponential distribution variate with the aggregate rate.
+ *
+ * @return Exponential distribution variate based on member variable tau.
+ */
+double AggregatePoissonTrafficGenerator::generateExponentialVariate() {
+	return generateVariate(exponentialDistribution);
+}
+
+/**
+ * @brief Generate the interval until the next arrival, for autonomous mode.
+ *
+ * @return Next exponential variate.
+ */
+double AggregatePoissonTrafficGenerator::generateInterval() {
+	return generateExponentialVariate();
+}
+
+/**
+ * @brief Pick the originating source of the current arrival, which becomes the source of the generator.
+ *
+ * @details 
+ * Uniformly for identical sources; otherwise with probability proportional to the rate of each source.
+ */
+void AggregatePoissonTrafficGenerator::pickSource() {
+	if (sources.empty()) {
+		return;
+	}
+	source = sources[isUniform ? generateVariate(uniformSourceDistribution) : generateVariate(weightedSourceDistribution)];
+}
+
+/**
+ * @brief Return whether this generator can run in autonomous mode.
+ *
+ * @return True: intervals come from the exponential distribution with the aggregate rate.
+ */
+bool AggregatePoissonTrafficGenerator::supportsAutonomousMode() const {
+	return true;
+}
+
+/**
+ * Returns tau (mean interarrival time of the aggregate).
+ *
+ * @return Tau.
+ */
+double AggregatePoissonTrafficGenerator::getTau() const {
+	return tau;
+}
+
+/**
+ * Returns the number of sources represented by this generator.
+ *
+ * @return Number of sources.
+ */
+std::vector<std::shared_ptr<Entity>>::size_type AggregatePoissonTrafficGenerator::getNumberOfSources() const {
+	return sources.size();
+}
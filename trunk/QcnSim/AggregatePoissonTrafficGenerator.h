@@ -0,0 +1,69 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "TrafficGenerator.h"
+#include "EventType.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @brief AggregatePoissonTrafficGenerator class.
+ * 
+ * @par Description
+ * This class implements the superposition of N independent Poisson sources (e.g., the background traffic of thousands of QCN hosts) as a
+ * single generator. The superposition of Poisson processes with rates lambda_i is a Poisson process with rate sum(lambda_i), and each arrival
+ * comes from source i with probability lambda_i / sum(lambda_i), independently of the others. Thus the generator draws exponential
+ * interarrival times with the aggregate rate and picks the originating source of each arrival (uniformly, for identical sources, or by rate),
+ * with the same statistics as N ExponentialTrafficGenerator objects, but with one pending event instead of N.
+ *
+ * The originating source is the source of the generated token (and its previous and next hops), so routing proceeds as for individual generators.
+ *
+ * SimulationCheckpoint saves the distributions and the picked source of generators added with SimulationCheckpoint::addTrafficGenerator().
+ */
+class AggregatePoissonTrafficGenerator: public TrafficGenerator {
+private:
+	std::vector<std::shared_ptr<Entity>> sources; //!< Sources represented by this generator.
+	double tau;  //!< Mean interarrival time of the aggregate, i.e., inverse of the sum of the rates of the sources.
+	std::exponential_distribution<double> exponentialDistribution; //!< Exponential distribution of the aggregate interarrival times.
+	bool isUniform; //!< True if all sources have the same rate, such that sources are picked uniformly.
+	std::uniform_int_distribution<std::vector<std::shared_ptr<Entity>>::size_type> uniformSourceDistribution; //!< Source picker for identical sources.
+	std::discrete_distribution<std::vector<std::shared_ptr<Entity>>::size_type> weightedSourceDistribution; //!< Source picker, weighted by rate.
+	double generateExponentialVariate();
+	double generateInterval() override;
+	void pickSource();
+	
+public:
+	AggregatePoissonTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
+		const std::vector<std::shared_ptr<Entity>> &sources, std::shared_ptr<Entity> destination, int priority, double sourceTau);
+	AggregatePoissonTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
+		const std::vector<std::shared_ptr<Entity>> &sources, std::shared_ptr<Entity> destination, int priority, const std::vector<double> &sourceTaus);
+
+	bool supportsAutonomousMode() const override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(bool recordRoute = false) override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<Token> materializeToken(bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> materializePdu(unsigned int pduSize, bool recordRoute = false) override;
+	double getTau() const;
+	std::vector<std::shared_ptr<Entity>>::size_type getNumberOfSources() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores distributions and picked source.
+};
@@ -0,0 +1,120 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryBuffer.h"
+#include <fstream>
+
+/**
+ * @brief Constructor; the buffer starts empty.
+ */
+BinaryBuffer::BinaryBuffer(): readPosition(0) {
+}
+
+/**
+ * @brief Append raw bytes.
+ *
+ * @param bytes Bytes to append.
+ * @param size Number of bytes.
+ */
+void BinaryBuffer::writeBytes(const char *bytes, std::vector<char>::size_type size) {
+	data.insert(data.end(), bytes, bytes + size);
+}
+
+/**
+ * @brief Append a string (length, then characters).
+ *
+ * @param value String to append.
+ */
+void BinaryBuffer::writeString(const std::string &value) {
+	writeValue(static_cast<uint32_t>(value.size()));
+	data.insert(data.end(), value.begin(), value.end());
+}
+
+/**
+ * @brief Decode raw bytes.
+ *
+ * @param bytes Destination of the decoded bytes.
+ * @param size Number of bytes.
+ */
+void BinaryBuffer::readBytes(char *bytes, std::vector<char>::size_type size) {
+	if (getRemainingSize() < size) {
+		throw UnderflowException();
+	}
+	std::memcpy(bytes, data.data() + readPosition, size);
+	readPosition += size;
+}
+
+/**
+ * @brief Decode a string.
+ *
+ * @return Decoded string.
+ */
+std::string BinaryBuffer::readString() {
+	uint32_t length = readValue<uint32_t>();
+	if (getRemainingSize() < length) {
+		throw UnderflowException();
+	}
+	std::string value(data.data() + readPosition, length);
+	readPosition += length;
+	return value;
+}
+
+/**
+ * @brief Get number of bytes not yet decoded.
+ *
+ * @return Number of remaining bytes.
+ */
+std::vector<char>::size_type BinaryBuffer::getRemainingSize() const {
+	return data.size() - readPosition;
+}
+
+/**
+ * @brief Empty the buffer.
+ */
+void BinaryBuffer::clear() {
+	data.clear();
+	data.shrink_to_fit();
+	readPosition = 0;
+}
+
+/**
+ * @brief Write buffer contents to a file.
+ *
+ * @param fileName Name of the file; overwritten if it exists.
+ * @return True if the file was written; false otherwise.
+ */
+bool BinaryBuffer::writeToFile(const std::string &fileName) const {
+	std::ofstream outputFile(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	return outputFile && outputFile.write(data.data(), data.size());
+}
+
+/**
+ * @brief Replace buffer contents with the contents of a file, read with a single read; decoding restarts at the beginning.
+ *
+ * @param fileName Name of the file.
+ * @return True if the file was read; false otherwise.
+ */
+bool BinaryBuffer::readFromFile(const std::string &fileName) {
+	clear();
+	std::ifstream inputFile(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!inputFile) {
+		return false;
+	}
+	data.resize(static_cast<std::vector<char>::size_type>(inputFile.tellg()));
+	inputFile.seekg(0);
+	if (!inputFile.read(data.data(), data.size())) {
+		clear();
+		return false;
+	}
+	return true;
+}
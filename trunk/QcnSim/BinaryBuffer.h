@@ -0,0 +1,75 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Binary Buffer class.
+ * 
+ * @par Description
+ * Memory buffer for the binary files written by TopologySnapshot and SimulationCheckpoint. Plain values are appended and decoded in the
+ * in-memory representation of the host; strings are stored as a 32-bit length followed by the characters. A file is written and read with a
+ * single call, and all decoding happens in memory.
+ *
+ * Decoding past the end of the buffer throws BinaryBuffer::UnderflowException, which callers convert into their own return types.
+ */
+class BinaryBuffer {
+private:
+	std::vector<char> data; //!< Buffer contents.
+	std::vector<char>::size_type readPosition; //!< Position of next byte to decode within data.
+
+public:
+	/// Attempt to decode past the end of the buffer (i.e., truncated file).
+	class UnderflowException: public std::runtime_error {
+	public:
+		UnderflowException(): std::runtime_error("truncated file") {}
+	};
+
+	BinaryBuffer();
+
+	/**
+	 * @brief Append a plain value.
+	 *
+	 * @param value Value to append.
+	 */
+	template<typename T> void writeValue(T value) {
+		const char *bytes = reinterpret_cast<const char *>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(T));
+	}
+
+	/**
+	 * @brief Decode a plain value.
+	 *
+	 * @return Decoded value.
+	 */
+	template<typename T> T readValue() {
+		T value;
+		readBytes(reinterpret_cast<char *>(&value), sizeof(T));
+		return value;
+	}
+
+	void writeBytes(const char *bytes, std::vector<char>::size_type size);
+	void writeString(const std::string &value);
+	void readBytes(char *bytes, std::vector<char>::size_type size);
+	std::string readString();
+	std::vector<char>::size_type getRemainingSize() const;
+	void clear();
+	bool writeToFile(const std::string &fileName) const;
+	bool readFromFile(const std::string &fileName);
+};
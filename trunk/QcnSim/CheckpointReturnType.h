@@ -0,0 +1,29 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+* @brief Checkpoint Return Type enum class.
+*
+* @par Description
+* Types of return from SimulationCheckpoint functions.
+*/
+enum class CheckpointReturnType {
+	CHECKPOINT_SAVED,		//!< Checkpoint was successfully written.
+	CHECKPOINT_RESTORED,	//!< Checkpoint was successfully read and the simulation state restored.
+	FILE_NOT_FOUND,			//!< Checkpoint file could not be opened for reading or writing.
+	INVALID_CHECKPOINT,		//!< File is not a checkpoint, has an incompatible version, or is truncated or corrupted.
+	TOPOLOGY_MISMATCH,		//!< Checkpoint was saved from a topology with different nodes, links or traffic generators.
+	UNSUPPORTED_ENTITY		//!< Simulation state references an Entity that cannot be serialized.
+};
@@ -229,3 +229,21 @@ std::shared_ptr<ProtocolDataUnit> ConstantRateTrafficGenerator::createInstanceTr
 	}
 	return pdu;
 }
+
+/**
+ * @brief Generate the interval until the next arrival, for autonomous mode.
+ *
+ * @return The constant interval.
+ */
+double ConstantRateTrafficGenerator::generateInterval() {
+	return interval;
+}
+
+/**
+ * @brief Return whether this generator can run in autonomous mode.
+ *
+ * @return True: intervals come from the constant interval.
+ */
+bool ConstantRateTrafficGenerator::supportsAutonomousMode() const {
+	return true;
+}
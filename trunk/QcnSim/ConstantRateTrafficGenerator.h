@@ -35,11 +35,13 @@
 class ConstantRateTrafficGenerator: public TrafficGenerator {
 private:
 	double interval;  //!< Fixed, constant time interval for this generator.
+	double generateInterval() override;
 	
 public:
 	ConstantRateTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, double interval);
 
+	bool supportsAutonomousMode() const override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
@@ -0,0 +1,29 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DetectionData.h"
+
+/**
+ * @brief Default constructor. All fields are zeroed.
+ */
+DetectionData::DetectionData(): detectionId(0), detectionTime(0.0), firstTriggerTime(0.0), latitude(0.0), longitude(0.0), meanDeliveryLatency(0.0) {
+}
+
+/**
+ * @brief Get latency of the detection, from the first trigger at a sensor to the detection at the server.
+ *
+ * @return Detection latency.
+ */
+double DetectionData::getDetectionLatency() const {
+	return detectionTime - firstTriggerTime;
+}
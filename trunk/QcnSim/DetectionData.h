@@ -0,0 +1,41 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+#include "SeismicEventData.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Detection Data class.
+ *
+ * @par Description
+ * Describes an earthquake detection declared at a server by DetectionEngine, from the triggers (SeismicEventData) delivered to it, with the
+ * latency metrics of the detection.
+ */
+class DetectionData: public Entity {
+public:
+	unsigned int detectionId; //!< Unique detection ID, in detection order.
+	double detectionTime; //!< Absolute time of the detection, i.e., delivery time of the trigger that completed it.
+	double firstTriggerTime; //!< Earliest event time among the associated triggers.
+	double latitude; //!< Latitude of the centroid of the associated triggers.
+	double longitude; //!< Longitude of the centroid of the associated triggers.
+	double meanDeliveryLatency; //!< Mean time from event time to delivery at the server of the associated triggers.
+	std::vector<std::shared_ptr<const SeismicEventData>> triggers; //!< Associated triggers, in delivery order.
+
+	DetectionData();
+
+	double getDetectionLatency() const;
+};
@@ -0,0 +1,327 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DetectionEngine.h"
+#include "GeoUtilities.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Constructor.
+ *
+ * @param simulatorGlobals SimulatorGlobals object, for the current time.
+ * @param scheduler Scheduler object, to schedule detection events.
+ * @param minimumTriggers Number of associated triggers that declares a detection.
+ * @param radius Association radius, in Km. Radii smaller than DETECTION_MINIMUM_RADIUS (e.g., 0) are raised to it.
+ * @param timeWindow Association time window, in seconds.
+ * @param eventType Type of the detection events.
+ */
+DetectionEngine::DetectionEngine(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, unsigned int minimumTriggers, double radius, double timeWindow,
+		EventType eventType): simulatorGlobals(simulatorGlobals), scheduler(scheduler), minimumTriggers(minimumTriggers),
+		radius(std::max(radius, DETECTION_MINIMUM_RADIUS)), timeWindow(timeWindow), eventType(eventType),
+		cellDegrees(std::max(radius, DETECTION_MINIMUM_RADIUS) / (EARTH_RADIUS * GEO_DEGREES_TO_RADIANS)),
+		newestEventTime(-std::numeric_limits<double>::infinity()), triggersCount(0), staleTriggersCount(0), associatedTriggersCount(0),
+		detectionsCount(0), detectionLatencySum(0.0) {
+}
+
+/**
+ * @brief Ingest a trigger delivered at the server, at the current simulation time.
+ *
+ * @param trigger Trigger delivered.
+ * @return Detection declared by this trigger, also scheduled as an event with zero delay; nullptr if none.
+ */
+std::shared_ptr<DetectionData> DetectionEngine::ingest(std::shared_ptr<const SeismicEventData> trigger) {
+	++triggersCount;
+	if (trigger->eventTime < newestEventTime - timeWindow) {
+		++staleTriggersCount;
+		return nullptr;
+	}
+	newestEventTime = std::max(newestEventTime, trigger->eventTime);
+	expireWindow();
+	RecentDetection *recentDetection = findRecentDetection(*trigger);
+	if (recentDetection != nullptr) {
+		++associatedTriggersCount;
+		return nullptr;
+	}
+	int row = getRow(trigger->latitude);
+	TriggerRecord record = { std::move(trigger), simulatorGlobals.getCurrentAbsoluteTime(), 0, nullptr, false };
+	record.cellKey = getCellKey(row, wrapColumn(getColumn(row, record.trigger->longitude), getNumberOfColumns(row)));
+	window.push_back(std::move(record));
+	appendToCell(window.back());
+	return associate(window.back());
+}
+
+/**
+ * @brief Append a trigger of the window to the intrusive list of its grid cell.
+ *
+ * @param record Trigger just added at the back of the window.
+ */
+void DetectionEngine::appendToCell(TriggerRecord &record) {
+	Cell &cell = cells[record.cellKey];
+	if (cell.tail != nullptr) {
+		cell.tail->nextInCell = &record;
+	} else {
+		cell.head = &record;
+	}
+	cell.tail = &record;
+	++cell.count;
+}
+
+/**
+ * @brief Remove triggers older than the window from the window and their cells, and forget old detections.
+ */
+void DetectionEngine::expireWindow() {
+	while (!window.empty() && window.front().trigger->eventTime < newestEventTime - timeWindow) {
+		auto cellIterator = cells.find(window.front().cellKey);
+		// Cells list their triggers in delivery order, thus the oldest trigger of the window heads its cell.
+		cellIterator->second.head = window.front().nextInCell;
+		if (--cellIterator->second.count == 0) {
+			cells.erase(cellIterator);
+		}
+		window.pop_front();
+	}
+	while (!recentDetections.empty() && recentDetections.front().lastEventTime < newestEventTime - timeWindow) {
+		recentDetections.pop_front();
+	}
+}
+
+/**
+ * @brief Find a recent detection to which a trigger belongs, and extend the detection with it.
+ *
+ * @details 
+ * The trigger belongs to the detection if it is within timeWindow of its latest trigger, and within radius of its extent, such that the
+ * detection follows the wavefront as it expands.
+ *
+ * @param trigger Trigger delivered.
+ * @return Recent detection; nullptr if none.
+ */
+DetectionEngine::RecentDetection *DetectionEngine::findRecentDetection(const SeismicEventData &trigger) {
+	for (auto &recentDetection : recentDetections) {
+		if (trigger.eventTime <= recentDetection.lastEventTime + timeWindow) {
+			double distance = GeoUtilities::greatCircleDistance(recentDetection.detectionData->latitude, recentDetection.detectionData->longitude,
+				trigger.latitude, trigger.longitude);
+			if (distance <= recentDetection.extent + radius) {
+				recentDetection.lastEventTime = std::max(recentDetection.lastEventTime, trigger.eventTime);
+				recentDetection.extent = std::max(recentDetection.extent, distance);
+				return &recentDetection;
+			}
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Associate a trigger with its neighbors in the window, and declare a detection if there are enough.
+ *
+ * @param record Trigger just added to the window.
+ * @return Detection declared; nullptr if none.
+ */
+std::shared_ptr<DetectionData> DetectionEngine::associate(TriggerRecord &record) {
+	const SeismicEventData &trigger = *record.trigger;
+	int row = getRow(trigger.latitude);
+	double maximumLatitude = std::min(89.0, std::max(std::abs((row - 1) * cellDegrees), std::abs((row + 2) * cellDegrees)));
+	double longitudeReach = cellDegrees / std::max(std::cos(maximumLatitude * GEO_DEGREES_TO_RADIANS), 0.01);
+	unsigned int neighborsBound = 0;
+	neighborCells.clear();
+	for (int neighborRow = row - 1; neighborRow <= row + 1; ++neighborRow) {
+		// Columns past the antimeridian wrap around; if the reach spans the whole row, each column is visited once.
+		int numberOfColumns = getNumberOfColumns(neighborRow);
+		int firstColumn = getColumn(neighborRow, trigger.longitude - longitudeReach);
+		int lastColumn = getColumn(neighborRow, trigger.longitude + longitudeReach);
+		if (lastColumn - firstColumn + 1 >= numberOfColumns) {
+			firstColumn = 0;
+			lastColumn = numberOfColumns - 1;
+		}
+		for (int column = firstColumn; column <= lastColumn; ++column) {
+			auto cellIterator = cells.find(getCellKey(neighborRow, wrapColumn(column, numberOfColumns)));
+			if (cellIterator != cells.end()) {
+				neighborCells.push_back(&cellIterator->second);
+				neighborsBound += cellIterator->second.count;
+			}
+		}
+	}
+	if (neighborsBound < minimumTriggers) {
+		return nullptr;
+	}
+	neighbors.clear();
+	for (auto cell : neighborCells) {
+		for (TriggerRecord *neighbor = cell->head; neighbor != nullptr; neighbor = neighbor->nextInCell) {
+			if (!neighbor->isAssociated && std::abs(neighbor->trigger->eventTime - trigger.eventTime) <= timeWindow &&
+				GeoUtilities::greatCircleDistance(trigger.latitude, trigger.longitude, neighbor->trigger->latitude, neighbor->trigger->longitude) <= radius) {
+				neighbors.push_back(neighbor);
+			}
+		}
+	}
+	if (neighbors.size() < minimumTriggers) {
+		return nullptr;
+	}
+
+	std::stable_sort(neighbors.begin(), neighbors.end(), [](const TriggerRecord *left, const TriggerRecord *right) {
+		return left->deliveryTime < right->deliveryTime;
+	});
+	auto detectionData = std::make_shared<DetectionData>();
+	detectionData->detectionId = ++detectionsCount;
+	detectionData->detectionTime = simulatorGlobals.getCurrentAbsoluteTime();
+	detectionData->firstTriggerTime = trigger.eventTime;
+	double lastEventTime = trigger.eventTime;
+	double longitudeOffsetSum = 0.0; // Longitudes are averaged as offsets from the trigger, taken the short way around the antimeridian.
+	for (auto neighbor : neighbors) {
+		neighbor->isAssociated = true;
+		detectionData->triggers.push_back(neighbor->trigger);
+		detectionData->firstTriggerTime = std::min(detectionData->firstTriggerTime, neighbor->trigger->eventTime);
+		lastEventTime = std::max(lastEventTime, neighbor->trigger->eventTime);
+		detectionData->latitude += neighbor->trigger->latitude;
+		longitudeOffsetSum += std::remainder(neighbor->trigger->longitude - trigger.longitude, 360.0);
+		detectionData->meanDeliveryLatency += neighbor->deliveryTime - neighbor->trigger->eventTime;
+	}
+	detectionData->latitude /= neighbors.size();
+	detectionData->longitude = std::remainder(trigger.longitude + longitudeOffsetSum / neighbors.size(), 360.0);
+	detectionData->meanDeliveryLatency /= neighbors.size();
+	double extent = 0.0;
+	for (auto neighbor : neighbors) {
+		extent = std::max(extent, GeoUtilities::greatCircleDistance(detectionData->latitude, detectionData->longitude, neighbor->trigger->latitude,
+			neighbor->trigger->longitude));
+	}
+	detectionLatencySum += detectionData->getDetectionLatency();
+	RecentDetection recentDetection = { detectionData, lastEventTime, extent };
+	recentDetections.push_back(recentDetection);
+	scheduler.schedule(Event(0.0, eventType, detectionData));
+	return detectionData;
+}
+
+/**
+ * @brief Get grid row of a latitude.
+ *
+ * @param latitude Latitude.
+ * @return Row.
+ */
+int DetectionEngine::getRow(double latitude) const {
+	return static_cast<int>(std::floor(latitude / cellDegrees));
+}
+
+/**
+ * @brief Get width of the cells of a grid row, in degrees of longitude.
+ *
+ * @details 
+ * Cells are at least radius Km wide at the edge of the row farthest from the equator, thus at least as wide elsewhere within the row, and
+ * divide the 360 degrees of the row evenly (see getNumberOfColumns()).
+ *
+ * @param row Row.
+ * @return Width of the cells.
+ */
+double DetectionEngine::getColumnDegrees(int row) const {
+	return 360.0 / getNumberOfColumns(row);
+}
+
+/**
+ * @brief Get number of columns of a grid row.
+ *
+ * @param row Row.
+ * @return Number of columns, at least 1.
+ */
+int DetectionEngine::getNumberOfColumns(int row) const {
+	double farthestLatitude = std::min(89.0, std::max(std::abs(row * cellDegrees), std::abs((row + 1) * cellDegrees)));
+	double minimumColumnDegrees = cellDegrees / std::max(std::cos(farthestLatitude * GEO_DEGREES_TO_RADIANS), 0.01);
+	return std::max(1, static_cast<int>(std::floor(360.0 / minimumColumnDegrees)));
+}
+
+/**
+ * @brief Get grid column of a longitude within a row.
+ *
+ * @details 
+ * The column is not wrapped: longitudes beyond the antimeridian (e.g., 181) give columns beyond the row; see wrapColumn().
+ *
+ * @param row Row.
+ * @param longitude Longitude.
+ * @return Column.
+ */
+int DetectionEngine::getColumn(int row, double longitude) const {
+	return static_cast<int>(std::floor(longitude / getColumnDegrees(row)));
+}
+
+/**
+ * @brief Wrap a grid column around the antimeridian.
+ *
+ * @param column Column, possibly beyond the row.
+ * @param numberOfColumns Number of columns of the row (see getNumberOfColumns()).
+ * @return Column within [0, numberOfColumns).
+ */
+int DetectionEngine::wrapColumn(int column, int numberOfColumns) {
+	return ((column % numberOfColumns) + numberOfColumns) % numberOfColumns;
+}
+
+/**
+ * @brief Get key of a grid cell.
+ *
+ * @param row Row of the cell.
+ * @param column Column of the cell.
+ * @return Key.
+ */
+uint64_t DetectionEngine::getCellKey(int row, int column) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32) | static_cast<uint32_t>(column);
+}
+
+/**
+ * @brief Get number of triggers within the window.
+ *
+ * @return Number of triggers.
+ */
+std::deque<DetectionEngine::TriggerRecord>::size_type DetectionEngine::getWindowSize() const {
+	return window.size();
+}
+
+/**
+ * @brief Get number of triggers ingested.
+ *
+ * @return Number of triggers, including stale and associated ones.
+ */
+unsigned int DetectionEngine::getTriggersCount() const {
+	return triggersCount;
+}
+
+/**
+ * @brief Get number of triggers dropped because older than the window when delivered.
+ *
+ * @return Number of stale triggers.
+ */
+unsigned int DetectionEngine::getStaleTriggersCount() const {
+	return staleTriggersCount;
+}
+
+/**
+ * @brief Get number of triggers counted as part of a recent detection, after it was declared.
+ *
+ * @return Number of triggers.
+ */
+unsigned int DetectionEngine::getAssociatedTriggersCount() const {
+	return associatedTriggersCount;
+}
+
+/**
+ * @brief Get number of detections declared.
+ *
+ * @return Number of detections.
+ */
+unsigned int DetectionEngine::getDetectionsCount() const {
+	return detectionsCount;
+}
+
+/**
+ * @brief Get mean latency of all detections (see DetectionData::getDetectionLatency()).
+ *
+ * @return Mean detection latency; zero if there was no detection.
+ */
+double DetectionEngine::getMeanDetectionLatency() const {
+	return detectionsCount == 0 ? 0.0 : detectionLatencySum / detectionsCount;
+}
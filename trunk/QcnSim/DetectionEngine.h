@@ -0,0 +1,122 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "DetectionData.h"
+#include "EventType.h"
+#include "Scheduler.h"
+#include "SeismicEventData.h"
+#include "SimulatorGlobals.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#define DETECTION_MINIMUM_TRIGGERS 4 //!< Default number of associated triggers that declares a detection.
+#define DETECTION_RADIUS 100.0 //!< Default association radius, in Km.
+#define DETECTION_MINIMUM_RADIUS 0.001 //!< Smallest association radius, in Km; smaller radii (e.g., 0) are raised to it, so that grid cells have a size.
+#define DETECTION_TIME_WINDOW 10.0 //!< Default association time window, in seconds.
+
+/**
+ * @brief Detection Engine class.
+ * 
+ * @par Description
+ * Server-side earthquake detection: ingests the triggers (SeismicEventData) delivered at a destination node, in simulated time, and declares
+ * a detection when at least minimumTriggers triggers, including the one just delivered, lie within radius Km and timeWindow seconds (of event
+ * time) of it. The detection is scheduled as an event (EventType::EARTHQUAKE_DETECTION by default) carrying a DetectionData, with the
+ * latency metrics of the detection, and is returned by ingest().
+ *
+ * Triggers are kept in a sliding window, in delivery order, and in an incremental grid index of latitude/longitude cells about radius Km wide
+ * (each row is split into a whole number of columns, and column indices wrap at the antimeridian):
+ * each cell holds a count and an intrusive list of its triggers, and triggers leave the window and their cell at the front as newer event times
+ * arrive, thus insertion and expiry are O(1). On ingest, the counts of the cells around the trigger give an upper bound of its neighbors; only
+ * when the bound reaches minimumTriggers are the neighbors checked one by one, hence the cost per trigger stays O(1) amortized while no
+ * earthquake is near detection.
+ *
+ * Triggers associated with a detection are not associated again, and triggers within radius and timeWindow of a recent detection are counted
+ * as part of it (see getAssociatedTriggersCount()) rather than starting a new one. Triggers older than the window when delivered are dropped
+ * (see getStaleTriggersCount()). Triggers on both sides of the antimeridian are associated, and their centroid longitude is averaged around the
+ * trigger that declares the detection.
+ *
+ * The window, with the grid cells, and the recent detections are saved by SimulationCheckpoint if the engine is added to it (see
+ * SimulationCheckpoint::addDetectionEngine()).
+ */
+class DetectionEngine {
+private:
+	/// Trigger within the window.
+	struct TriggerRecord {
+		std::shared_ptr<const SeismicEventData> trigger; //!< Trigger delivered.
+		double deliveryTime; //!< Absolute time of delivery at the server.
+		uint64_t cellKey; //!< Key of the grid cell of the trigger.
+		TriggerRecord *nextInCell; //!< Next trigger of the same cell, in delivery order.
+		bool isAssociated; //!< True if the trigger is part of a detection already.
+	};
+	/// Grid cell: intrusive list of its triggers, in delivery order.
+	struct Cell {
+		TriggerRecord *head; //!< Oldest trigger of the cell.
+		TriggerRecord *tail; //!< Newest trigger of the cell.
+		unsigned int count; //!< Number of triggers of the cell.
+	};
+	/// Recent detection, to which later triggers nearby are associated.
+	struct RecentDetection {
+		std::shared_ptr<DetectionData> detectionData; //!< Detection.
+		double lastEventTime; //!< Latest event time among its triggers.
+		double extent; //!< Largest distance from the centroid among its triggers, in Km.
+	};
+
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object, for the current time.
+	Scheduler &scheduler; //!< Reference to Scheduler object, to schedule detection events.
+	unsigned int minimumTriggers; //!< Number of associated triggers that declares a detection.
+	double radius; //!< Association radius, in Km; at least DETECTION_MINIMUM_RADIUS.
+	double timeWindow; //!< Association time window, in seconds.
+	EventType eventType; //!< Type of the detection events.
+	double cellDegrees; //!< Height of the grid cells, in degrees of latitude.
+	std::deque<TriggerRecord> window; //!< Triggers within the window, in delivery order.
+	std::unordered_map<uint64_t, Cell> cells; //!< Grid cells with triggers, by key.
+	std::deque<RecentDetection> recentDetections; //!< Detections whose triggers may still arrive, in detection order.
+	double newestEventTime; //!< Latest event time among triggers ingested.
+	unsigned int triggersCount; //!< Number of triggers ingested.
+	unsigned int staleTriggersCount; //!< Number of triggers dropped because older than the window.
+	unsigned int associatedTriggersCount; //!< Number of triggers counted as part of a recent detection.
+	unsigned int detectionsCount; //!< Number of detections declared.
+	double detectionLatencySum; //!< Sum of the latencies of all detections.
+	std::vector<Cell *> neighborCells; //!< Scratch: cells around the trigger being associated.
+	std::vector<TriggerRecord *> neighbors; //!< Scratch: triggers associated with the trigger being associated.
+
+	void appendToCell(TriggerRecord &record);
+	void expireWindow();
+	int getRow(double latitude) const;
+	int getColumn(int row, double longitude) const;
+	int getNumberOfColumns(int row) const;
+	static int wrapColumn(int column, int numberOfColumns);
+	double getColumnDegrees(int row) const;
+	static uint64_t getCellKey(int row, int column);
+	RecentDetection *findRecentDetection(const SeismicEventData &trigger);
+	std::shared_ptr<DetectionData> associate(TriggerRecord &record);
+
+public:
+	DetectionEngine(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, unsigned int minimumTriggers = DETECTION_MINIMUM_TRIGGERS,
+		double radius = DETECTION_RADIUS, double timeWindow = DETECTION_TIME_WINDOW, EventType eventType = EventType::EARTHQUAKE_DETECTION);
+
+	std::shared_ptr<DetectionData> ingest(std::shared_ptr<const SeismicEventData> trigger);
+	std::deque<TriggerRecord>::size_type getWindowSize() const;
+	unsigned int getTriggersCount() const;
+	unsigned int getStaleTriggersCount() const;
+	unsigned int getAssociatedTriggersCount() const;
+	unsigned int getDetectionsCount() const;
+	double getMeanDetectionLatency() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores the window, the grid cells and the recent detections.
+};
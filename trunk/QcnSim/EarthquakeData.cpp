@@ -0,0 +1,36 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EarthquakeData.h"
+
+/**
+ * @brief Default constructor. All fields are zeroed.
+ */
+EarthquakeData::EarthquakeData(): earthquakeId(0), magnitude(0.0), eventTime(0.0), sWaveSpeed(0.0), depth(0.0), latitude(0.0), longitude(0.0) {
+}
+
+/**
+ * @brief Constructor with parameters.
+ *
+ * @param earthquakeId Unique earthquake ID.
+ * @param magnitude Magnitude of the earthquake at the hypocenter.
+ * @param eventTime Absolute origin time of the earthquake.
+ * @param sWaveSpeed Propagation speed of the S-wave, in Km/s.
+ * @param depth Depth of the hypocenter, in Km.
+ * @param latitude Latitude of the epicenter.
+ * @param longitude Longitude of the epicenter.
+ */
+EarthquakeData::EarthquakeData(unsigned int earthquakeId, double magnitude, double eventTime, double sWaveSpeed, double depth, double latitude,
+		double longitude): earthquakeId(earthquakeId), magnitude(magnitude), eventTime(eventTime), sWaveSpeed(sWaveSpeed), depth(depth),
+		latitude(latitude), longitude(longitude) {
+}
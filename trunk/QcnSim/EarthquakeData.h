@@ -0,0 +1,37 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+
+/**
+ * @brief Earthquake Data class.
+ *
+ * @par Description
+ * Describes an earthquake (the seismic source), as opposed to SeismicEventData, which describes the observation of an earthquake by one sensor.
+ * Fields follow the "earthquakes" section of the JSON scenario schema.
+ */
+class EarthquakeData: public Entity {
+public:
+	unsigned int earthquakeId; //!< Unique earthquake ID.
+	double magnitude; //!< Magnitude of the earthquake at the hypocenter.
+	double eventTime; //!< Absolute origin time of the earthquake.
+	double sWaveSpeed; //!< Propagation speed of the S-wave, in Km/s.
+	double depth; //!< Depth of the hypocenter, in Km.
+	double latitude; //!< Latitude of the epicenter.
+	double longitude; //!< Longitude of the epicenter.
+
+	EarthquakeData();
+	EarthquakeData(unsigned int earthquakeId, double magnitude, double eventTime, double sWaveSpeed, double depth, double latitude, double longitude);
+};
@@ -26,13 +26,30 @@
  * @param eventType Type of the event.
  * @param entity Simulator entity object associated with event.
  */
-Event::Event(double occurAfterTime, EventType eventType, std::shared_ptr<const Entity> entity): occurAfterTime(occurAfterTime), eventType(eventType), entity(entity) { /// @todo Who deletes entity?
+Event::Event(double occurAfterTime, EventType eventType, std::shared_ptr<const Entity> entity): occurAfterTime(occurAfterTime), eventType(eventType),
+		payloadType(entity == nullptr ? EventPayloadType::NO_PAYLOAD : entity.use_count() == 0 ? EventPayloadType::ENTITY_POINTER : EventPayloadType::ENTITY),
+		linkId(0), entity(entity) { /// @todo Who deletes entity?
 }
 
 /**
  * @brief Default constructor.
  */
-Event::Event() {
+Event::Event(): payloadType(EventPayloadType::NO_PAYLOAD), linkId(0) {
+}
+
+/**
+ * @brief Create an event carrying the ID of a link instead of an entity, e.g., to set that link down.
+ *
+ * @param occurAfterTime Occurrence latency, i.e., event occurs after occurAfterTime time.
+ * @param eventType Type of the event.
+ * @param linkId ID of the link (key in Topology::linkMap).
+ * @return Event tagged LINK_ID.
+ */
+Event Event::createLinkEvent(double occurAfterTime, EventType eventType, uint32_t linkId) {
+	Event event(occurAfterTime, eventType, nullptr);
+	event.payloadType = EventPayloadType::LINK_ID;
+	event.linkId = linkId;
+	return event;
 }
 
 /**
@@ -41,12 +58,13 @@ Event::Event() {
  * @details 
  * This is the overloading of the comparison == operator for use with Event.  The result should be TRUE
  * if the left Event has the same contents as the right Event.
+ * The payload tag is not compared: the same entity is tagged after the pointer class it was scheduled with.
  * 
  * @param left The Event object to the "left", to be compared with the "right".
  * @param right The Event object to the "right", to be compared with the "left".
  */
 bool operator==(const Event &left, const Event &right)  {
-	return (left.entity == right.entity && left.eventType == right.eventType && left.occurAfterTime == right.occurAfterTime); 
+	return (left.entity == right.entity && left.linkId == right.linkId && left.eventType == right.eventType && left.occurAfterTime == right.occurAfterTime); 
 }
 
 /**
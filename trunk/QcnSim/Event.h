@@ -20,8 +20,11 @@
 #pragma once
 
 #include "EventType.h"
+#include "EventPayloadType.h"
 #include "Entity.h"
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 
 /**
  * @brief Event class
@@ -31,18 +34,61 @@
  * time it will take for the event to initiate from the current time or clock
  * time; a field for the type of the event; and a generic object associated with
  * the event.
+ *
+ * The payload tag records the class of the associated entity when the Event is constructed from a typed pointer, and
+ * getEntityAs() uses it to return the entity without a dynamic cast when the requested class is exactly the tagged one.
+ * An entity pointer that does not own the entity (an aliasing pointer without control block, as components use for their own events) is
+ * tagged ENTITY_POINTER, and an event may carry the ID of a link instead of an entity (see createLinkEvent()). Within the event chain, the
+ * Scheduler keeps the payload as an EventPayload.
  */
 class Event {
 public:
 	double occurAfterTime; //!< Occurrence latency, i.e., event occurs after occurAfterTime time.
 	EventType eventType; //!< Type of the event.
+	EventPayloadType payloadType; //!< Tag of the payload: class of the entity (see EventPayloadTraits), ENTITY_POINTER or LINK_ID.
+	uint32_t linkId; //!< ID of the link (key in Topology::linkMap), if payloadType is LINK_ID.
 	std::shared_ptr<const Entity> entity; //!< Simulator entity object associated with event.
 	
 	Event(double occurAfterTime, EventType eventType, std::shared_ptr<const Entity> entity); /// @todo Who deletes entity?
 																							/// @todo Should Entity be const?
 
+	/**
+	 * Constructor with a typed entity; the payload tag records the class of the pointer, if tagged (see EventPayloadTraits), or
+	 * ENTITY_POINTER if the pointer does not own the entity.
+	 *
+	 * @param occurAfterTime Occurrence latency, i.e., event occurs after occurAfterTime time.
+	 * @param eventType Type of the event.
+	 * @param entity Simulator entity object associated with event.
+	 */
+	template<typename EntityClass>
+	Event(double occurAfterTime, EventType eventType, std::shared_ptr<EntityClass> entity): occurAfterTime(occurAfterTime), eventType(eventType),
+			payloadType(entity == nullptr ? EventPayloadType::NO_PAYLOAD : entity.use_count() == 0 ? EventPayloadType::ENTITY_POINTER :
+			EventPayloadTraits<typename std::remove_const<EntityClass>::type>::type), linkId(0), entity(std::move(entity)) {
+	}
+
 	Event();
 
+	static Event createLinkEvent(double occurAfterTime, EventType eventType, uint32_t linkId);
+
+	/**
+	 * Returns the associated entity as a (non-const) pointer to EntityClass.
+	 *
+	 * @details
+	 * If EntityClass has a tag of its own and the payload tag is exactly that tag, the entity is converted with a static cast; otherwise
+	 * (untagged entities, base or derived classes of the one recorded) the conversion falls back to a dynamic cast. Handlers own the entities they receive
+	 * through events (e.g., they update the route of a PDU), hence the removal of const-ness.
+	 *
+	 * @return Entity as EntityClass, or nullptr if there is no entity or it is not an EntityClass.
+	 */
+	template<typename EntityClass>
+	std::shared_ptr<EntityClass> getEntityAs() const {
+		typedef typename std::remove_const<EntityClass>::type MutableEntityClass;
+		if (EventPayloadTraits<MutableEntityClass>::type != EventPayloadType::ENTITY && payloadType == EventPayloadTraits<MutableEntityClass>::type) {
+			return std::static_pointer_cast<MutableEntityClass>(std::const_pointer_cast<Entity>(entity));
+		}
+		return std::dynamic_pointer_cast<MutableEntityClass>(std::const_pointer_cast<Entity>(entity));
+	}
+
 	///	Comparator ==, non-member.
 	friend bool operator==(const Event &left, const Event &right);
 
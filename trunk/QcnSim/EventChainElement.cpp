@@ -33,11 +33,26 @@
 
 /**
  * Constructor with parameters.
+ *
+ * @details 
+ * The payload takes the tag of the event, with its link ID or entity pointer; the index of an entity owned by the event is left at zero, for
+ * the Scheduler to set.
  * 
  * @param eventTime Absolute occurrence time of event (= current time + occurAfterTime of event).
  * @param event  Event object.
+ * @param recurringEventSource Source of a recurring event; nullptr (default) for ordinary events.
  */
-EventChainElement::EventChainElement(double eventTime, const Event &event): eventTime(eventTime), event(event) {
+EventChainElement::EventChainElement(double eventTime, const Event &event, RecurringEventSource *recurringEventSource): eventTime(eventTime),
+		occurAfterTime(event.occurAfterTime), sequence(0), recurringEventSource(recurringEventSource), eventType(event.eventType) {
+	payload.type = event.payloadType;
+	if (event.payloadType == EventPayloadType::ENTITY_POINTER) {
+		payload.entity = event.entity.get();
+	} else if (event.payloadType == EventPayloadType::LINK_ID) {
+		payload.linkId = event.linkId;
+	} else {
+		payload.entity = nullptr; // Clears the union.
+		payload.index = 0;
+	}
 }
 
 /**
@@ -109,7 +124,20 @@ bool operator>=(const EventChainElement &left, const EventChainElement &right)
  * @param right The EventChainElement object to the "right", to be compared with the "left".
  */
 bool operator==(const EventChainElement &left, const EventChainElement &right)  {
-	return (left.event == right.event && left.eventTime == right.eventTime); 
+	if (left.payload.type != right.payload.type || left.eventType != right.eventType || left.occurAfterTime != right.occurAfterTime ||
+			left.eventTime != right.eventTime) {
+		return false;
+	}
+	switch (left.payload.type) {
+		case EventPayloadType::NO_PAYLOAD:
+			return true;
+		case EventPayloadType::ENTITY_POINTER:
+			return left.payload.entity == right.payload.entity;
+		case EventPayloadType::LINK_ID:
+			return left.payload.linkId == right.payload.linkId;
+		default:
+			return left.payload.index == right.payload.index; // Owned entities: same slot of the Scheduler.
+	}
 }
 
 /**
@@ -20,6 +20,10 @@
 #pragma once
 
 #include "Event.h"
+#include "EventPayload.h"
+#include "RecurringEventSource.h"
+#include <cstdint>
+#include <type_traits>
 //#include "Scheduler.h"  // No! Cyclic include!
 
 /**
@@ -32,15 +36,22 @@
  * retrieves an event at the head of the list, it "causes" the event, or
  * activates the agents responsible for "executing" the actions predicted in the
  * event (such as an arrival of a token, a request for service).
+ *
+ * The element holds the fields of its Event, with the entity replaced by an EventPayload, and is trivially copyable: an entity owned by
+ * the event is kept by the Scheduler until the event is caused or removed, and the payload holds the index of its slot.
  */
 class EventChainElement {
 private:
 	double eventTime;  //!< Absolute occurrence time of event (= current time + occurAfterTime of event).
-	Event event;   //!< Event object.
+	double occurAfterTime; //!< Occurrence latency of the event.
+	int64_t sequence; //!< Scheduling order, set by the Scheduler; breaks ties between events with the same eventTime (lower first).
+	RecurringEventSource *recurringEventSource; //!< Source of a recurring event, which is moved instead of removed when caused; nullptr for ordinary events.
+	EventPayload payload; //!< Payload of the event; the index of an owned entity is set by the Scheduler.
+	EventType eventType; //!< Type of the event.
 
 public:
 	/// Constructor
-	EventChainElement(double eventTime, const Event &event);
+	EventChainElement(double eventTime, const Event &event, RecurringEventSource *recurringEventSource = nullptr);
 	
 	/// Operator <, non-member.
 	friend bool operator<(const EventChainElement &left, const EventChainElement &right);
@@ -61,4 +72,8 @@ public:
 	friend bool operator!=(const EventChainElement &left, const EventChainElement &right);
 
 	friend class Scheduler; // Only Scheduler can access these private members.
-};
\ No newline at end of file
+	friend class SimulationCheckpoint; // Saves and restores the event chain.
+};
+
+static_assert(std::is_trivially_copyable<EventChainElement>::value, "EventChainElement must be trivially copyable");
+static_assert(sizeof(EventChainElement) <= 56, "EventChainElement must fit in 56 bytes");
\ No newline at end of file
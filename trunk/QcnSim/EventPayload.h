@@ -0,0 +1,44 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "EventPayloadType.h"
+#include "Entity.h"
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Event Payload struct.
+ *
+ * @par Description
+ * Payload of an event within the event chain, as a closed tagged union: type tells which member of the union is in use.
+ * - NO_PAYLOAD: none;
+ * - ENTITY, TOKEN, PROTOCOL_DATA_UNIT, DETECTION_DATA and SEISMIC_EVENT_DATA: index, the slot where the Scheduler keeps the entity owned by
+ *   the event until it is caused or removed;
+ * - ENTITY_POINTER: entity, which outlives the event and is not owned by it;
+ * - LINK_ID: linkId.
+ *
+ * Being trivially copyable, the payload lets the Scheduler move event chain elements around as plain bytes.
+ */
+struct EventPayload {
+	EventPayloadType type; //!< Tag of the payload; selects the member of the union in use.
+	union {
+		uint32_t index; //!< Slot of the entity owned by the event, in the Scheduler.
+		uint32_t linkId; //!< ID of the link (key in Topology::linkMap).
+		const Entity *entity; //!< Entity not owned by the event.
+	};
+};
+
+static_assert(sizeof(EventPayload) <= 16, "EventPayload must fit in 16 bytes");
+static_assert(std::is_trivially_copyable<EventPayload>::value, "EventPayload must be trivially copyable");
@@ -0,0 +1,64 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class Token;
+class ProtocolDataUnit;
+class DetectionData;
+class SeismicEventData;
+
+/**
+ * @brief EventPayloadType enum class.
+ *
+ * @par Description
+ * Tag of the payload carried by an Event, and of the member of EventPayload in use within the event chain. For an entity owned by the event,
+ * the tag is the class of the pointer the Event was constructed from, if that class has a tag of its own (see EventPayloadTraits), so that
+ * handlers recover the typed entity with a static cast instead of a dynamic cast.
+ */
+enum class EventPayloadType: uint8_t {
+	NO_PAYLOAD,				//!< No entity.
+	ENTITY,					//!< Entity of a class without a tag of its own; recovered with a dynamic cast.
+	TOKEN,					//!< Token.
+	PROTOCOL_DATA_UNIT,		//!< Protocol data unit.
+	DETECTION_DATA,			//!< Detection data.
+	SEISMIC_EVENT_DATA,		//!< Seismic event data.
+	ENTITY_POINTER,			//!< Entity not owned by the event (e.g., a component scheduling its own recurring event); recovered with a dynamic cast.
+	LINK_ID					//!< ID of a link (its key in Topology::linkMap), without entity.
+};
+
+/**
+ * @brief Payload tag of an entity class.
+ *
+ * @details
+ * Only the classes specialized below have a tag of their own; any other class, including subclasses of tagged classes, is ENTITY. The tag is
+ * thus exact: an entity tagged PROTOCOL_DATA_UNIT was scheduled through a ProtocolDataUnit pointer, and only getEntityAs<ProtocolDataUnit>()
+ * may convert it with a static cast.
+ */
+template<typename EntityClass> struct EventPayloadTraits {
+	static const EventPayloadType type = EventPayloadType::ENTITY; //!< Tag of the class.
+};
+template<> struct EventPayloadTraits<Token> {
+	static const EventPayloadType type = EventPayloadType::TOKEN; //!< Tag of the class.
+};
+template<> struct EventPayloadTraits<ProtocolDataUnit> {
+	static const EventPayloadType type = EventPayloadType::PROTOCOL_DATA_UNIT; //!< Tag of the class.
+};
+template<> struct EventPayloadTraits<DetectionData> {
+	static const EventPayloadType type = EventPayloadType::DETECTION_DATA; //!< Tag of the class.
+};
+template<> struct EventPayloadTraits<SeismicEventData> {
+	static const EventPayloadType type = EventPayloadType::SEISMIC_EVENT_DATA; //!< Tag of the class.
+};
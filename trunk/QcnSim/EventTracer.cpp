@@ -0,0 +1,243 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventTracer.h"
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+#define EVENT_TRACE_MAGIC "QCNEVTRC" //!< Magic at the beginning of event traces.
+#define EVENT_TRACE_MAGIC_SIZE 8 //!< Size of EVENT_TRACE_MAGIC, without terminator.
+#define EVENT_TRACE_DRAIN_PERIOD_US 200 //!< Sleep of the writer thread when the ring buffer is empty, in microseconds.
+
+static_assert(sizeof(EventTraceRecord) == 24, "EventTraceRecord must be 24 bytes");
+static_assert(EVENT_TYPES_COUNT <= 64, "eventTypeMask holds one bit per EventType");
+
+/**
+ * @brief Constructor. The tracer keeps all event types and entities, and does not record until start().
+ */
+EventTracer::EventTracer(): ringMask(0), writePosition(0), readPosition(0), isStopping(false), isRecordingOn(false), eventTypeMask(~0ULL),
+		recordsCount(0), fullWaitsCount(0) {
+}
+
+/**
+ * @brief Destructor. Stops recording, writing the remaining records.
+ */
+EventTracer::~EventTracer() {
+	stop();
+}
+
+/**
+ * @brief Open the trace file and start recording; a trace already being recorded is stopped first.
+ *
+ * @param fileName Name of the trace file.
+ * @param capacity Number of records of the ring buffer; rounded up to a power of 2.
+ * @return TRACE_OPENED if recording; FILE_NOT_FOUND if the file could not be opened for writing.
+ */
+TraceReturnType EventTracer::start(const std::string &fileName, unsigned int capacity) {
+	stop();
+	traceFile.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!traceFile) {
+		return TraceReturnType::FILE_NOT_FOUND;
+	}
+	uint32_t version = EVENT_TRACE_VERSION;
+	uint32_t recordSize = sizeof(EventTraceRecord);
+	traceFile.write(EVENT_TRACE_MAGIC, EVENT_TRACE_MAGIC_SIZE);
+	traceFile.write(reinterpret_cast<const char *>(&version), sizeof(version));
+	traceFile.write(reinterpret_cast<const char *>(&recordSize), sizeof(recordSize));
+	uint64_t ringSize = 1;
+	while (ringSize < capacity) {
+		ringSize <<= 1;
+	}
+	ringBuffer.assign(ringSize, EventTraceRecord());
+	ringMask = ringSize - 1;
+	writePosition.store(0, std::memory_order_relaxed);
+	readPosition.store(0, std::memory_order_relaxed);
+	isStopping.store(false, std::memory_order_relaxed);
+	recordsCount = 0;
+	fullWaitsCount = 0;
+	isRecordingOn = true;
+	writerThread = std::thread(&EventTracer::drain, this);
+	return TraceReturnType::TRACE_OPENED;
+}
+
+/**
+ * @brief Stop recording: the writer thread drains the remaining records, and the trace file is closed. Does nothing if not recording.
+ */
+void EventTracer::stop() {
+	if (!isRecordingOn) {
+		return;
+	}
+	isRecordingOn = false;
+	isStopping.store(true, std::memory_order_release);
+	writerThread.join();
+	traceFile.close();
+}
+
+/**
+ * @brief Body of the writer thread: write the records stored so far to the trace file, in contiguous blocks, until stopped.
+ */
+void EventTracer::drain() {
+	while (true) {
+		// Read isStopping before writePosition, such that the last records stored before stop() are drained.
+		bool isLastPass = isStopping.load(std::memory_order_acquire);
+		uint64_t position = readPosition.load(std::memory_order_relaxed);
+		uint64_t endPosition = writePosition.load(std::memory_order_acquire);
+		while (position < endPosition) {
+			uint64_t blockEndPosition = std::min(endPosition, (position | ringMask) + 1); // Up to the end of the ring buffer.
+			traceFile.write(reinterpret_cast<const char *>(&ringBuffer[position & ringMask]),
+				static_cast<std::streamsize>((blockEndPosition - position) * sizeof(EventTraceRecord)));
+			position = blockEndPosition;
+			readPosition.store(position, std::memory_order_release);
+		}
+		if (isLastPass) {
+			break;
+		}
+		if (position == writePosition.load(std::memory_order_acquire)) {
+			std::this_thread::sleep_for(std::chrono::microseconds(EVENT_TRACE_DRAIN_PERIOD_US));
+		}
+	}
+	traceFile.flush();
+}
+
+/**
+ * @brief Whether the tracer is recording, i.e., between start() and stop().
+ *
+ * @return True if recording.
+ */
+bool EventTracer::isRecording() const {
+	return isRecordingOn;
+}
+
+/**
+ * @brief Keep or filter out the records of an event type.
+ *
+ * @param eventType Event type.
+ * @param isKept True to keep its records; false to filter them out.
+ */
+void EventTracer::setEventTypeFilter(EventType eventType, bool isKept) {
+	uint64_t eventTypeBit = 1ULL << static_cast<unsigned int>(eventType);
+	eventTypeMask = isKept ? eventTypeMask | eventTypeBit : eventTypeMask & ~eventTypeBit;
+}
+
+/**
+ * @brief Keep or filter out the records of all event types; e.g., filter all out, then keep a few with setEventTypeFilter().
+ *
+ * @param isKept True to keep all records; false to filter all out.
+ */
+void EventTracer::setAllEventTypesFilter(bool isKept) {
+	eventTypeMask = isKept ? ~0ULL : 0ULL;
+}
+
+/**
+ * @brief Keep the records of an entity. Once an entity is added, only the records of the entities added are kept.
+ *
+ * @param entityKind Kind of the entity; entities of other kinds with the same ID are not kept.
+ * @param entityId ID of the entity.
+ */
+void EventTracer::addEntityFilter(TraceEntityKind entityKind, uint32_t entityId) {
+	uint64_t entityKey = getEntityKey(entityKind, entityId);
+	std::vector<uint64_t>::iterator entityIterator = std::lower_bound(entityFilter.begin(), entityFilter.end(), entityKey);
+	if (entityIterator == entityFilter.end() || *entityIterator != entityKey) {
+		entityFilter.insert(entityIterator, entityKey);
+	}
+}
+
+/**
+ * @brief Remove the entity filter, keeping the records of all entities.
+ */
+void EventTracer::clearEntityFilter() {
+	entityFilter.clear();
+}
+
+/**
+ * @brief Number of records stored since start(), i.e., not filtered out.
+ *
+ * @return Number of records.
+ */
+uint64_t EventTracer::getRecordsCount() const {
+	return recordsCount;
+}
+
+/**
+ * @brief Number of records that had to wait for room in the ring buffer, i.e., for the writer thread; ideally zero.
+ *
+ * @return Number of records.
+ */
+uint64_t EventTracer::getFullWaitsCount() const {
+	return fullWaitsCount;
+}
+
+/**
+ * @brief Read an event trace written by an EventTracer.
+ *
+ * @param fileName Name of the trace file.
+ * @param traceRecords Vector to which the records are appended.
+ * @return TRACE_OPENED if read; FILE_NOT_FOUND if the file could not be opened; INVALID_TRACE if not an event trace of this version and
+ * record size (records of a truncated last record are ignored).
+ */
+TraceReturnType EventTracer::readTrace(const std::string &fileName, std::vector<EventTraceRecord> &traceRecords) {
+	std::ifstream inputFile(fileName, std::ios::in | std::ios::binary);
+	if (!inputFile) {
+		return TraceReturnType::FILE_NOT_FOUND;
+	}
+	char magic[EVENT_TRACE_MAGIC_SIZE];
+	uint32_t version = 0;
+	uint32_t recordSize = 0;
+	inputFile.read(magic, EVENT_TRACE_MAGIC_SIZE);
+	inputFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+	inputFile.read(reinterpret_cast<char *>(&recordSize), sizeof(recordSize));
+	if (!inputFile || std::memcmp(magic, EVENT_TRACE_MAGIC, EVENT_TRACE_MAGIC_SIZE) != 0 || version != EVENT_TRACE_VERSION
+			|| recordSize != sizeof(EventTraceRecord)) {
+		return TraceReturnType::INVALID_TRACE;
+	}
+	EventTraceRecord traceRecord;
+	while (inputFile.read(reinterpret_cast<char *>(&traceRecord), sizeof(traceRecord))) {
+		traceRecords.push_back(traceRecord);
+	}
+	return TraceReturnType::TRACE_OPENED;
+}
+
+/**
+ * @brief Format a record as a line of text: time, event type, entity kind and ID, token ID and outcome.
+ *
+ * @param traceRecord Record.
+ * @return Text, without line terminator.
+ */
+std::string EventTracer::formatRecord(const EventTraceRecord &traceRecord) {
+	static const char *const outcomeNames[] = { "HANDLED", "FORWARDED", "DELIVERED", "DROPPED", "STORED", "FUSED" };
+	static const char *const entityKindNames[] = { "none", "node", "sensor" };
+	std::ostringstream line;
+	line << std::fixed << std::setprecision(9) << traceRecord.time << " ";
+	if (traceRecord.eventType < EVENT_TYPES_COUNT) {
+		line << getEventTypeName(static_cast<EventType>(traceRecord.eventType));
+	} else {
+		line << "EVENT_TYPE_" << traceRecord.eventType;
+	}
+	line << " entity=";
+	if (traceRecord.entityKind == static_cast<uint8_t>(TraceEntityKind::NO_ENTITY) || traceRecord.entityId == EVENT_TRACE_NO_ENTITY) {
+		line << "-";
+	} else if (traceRecord.entityKind < sizeof(entityKindNames) / sizeof(entityKindNames[0])) {
+		line << entityKindNames[traceRecord.entityKind] << ":" << traceRecord.entityId;
+	} else {
+		line << "KIND_" << static_cast<unsigned int>(traceRecord.entityKind) << ":" << traceRecord.entityId;
+	}
+	line << " token=" << traceRecord.tokenId << " ";
+	if (traceRecord.outcome < sizeof(outcomeNames) / sizeof(outcomeNames[0])) {
+		line << outcomeNames[traceRecord.outcome];
+	} else {
+		line << "OUTCOME_" << traceRecord.outcome;
+	}
+	return line.str();
+}
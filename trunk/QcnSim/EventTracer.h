@@ -0,0 +1,150 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "EventType.h"
+#include "TraceEntityKind.h"
+#include "TraceOutcome.h"
+#include "TraceReturnType.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define EVENT_TRACE_CAPACITY 65536 //!< Default number of records of the ring buffer of an event tracer; a power of 2.
+#define EVENT_TRACE_VERSION 2 //!< Version of the event trace format; traces of other versions are rejected.
+#define EVENT_TRACE_NO_ENTITY UINT32_MAX //!< Entity ID of records of events not handled by a particular entity.
+
+/// Fixed-size record of an event trace.
+struct EventTraceRecord {
+	double time; //!< Simulated (absolute) time of the event.
+	uint32_t entityId; //!< ID of the entity that handled the event (e.g., node ID, sensor ID); EVENT_TRACE_NO_ENTITY if none.
+	uint32_t tokenId; //!< ID of the token or PDU of the event; zero if none.
+	uint16_t eventType; //!< EventType of the event.
+	uint16_t outcome; //!< TraceOutcome of the handling.
+	uint8_t entityKind; //!< TraceEntityKind of the entity, which tells node IDs from sensor IDs.
+	uint8_t reserved[3]; //!< Padding to 24 bytes; zero.
+};
+
+/**
+ * @brief Event Tracer class.
+ * 
+ * @par Description
+ * Binary trace of the events of a simulation, replacing text traces printed to std::cout: each call to record() stores a fixed-size
+ * EventTraceRecord (time, event type, entity kind and ID, token ID and outcome) in a lock-free single-producer, single-consumer ring buffer, and a
+ * writer thread drains the buffer to the trace file, such that the simulation thread never waits on the file. The simulation thread only
+ * waits when the ring buffer is full, i.e., when the file cannot keep up (see getFullWaitsCount()).
+ *
+ * Records may be filtered at run time by event type (setEventTypeFilter()) and by entity (addEntityFilter()); filtered out records
+ * cost a test. The simulator runs in a single thread; a parallel simulation would use one tracer (and file) per thread.
+ *
+ * The file holds the magic "QCNEVTRC", a 32-bit version and a 32-bit record size, followed by the records in the representation of the
+ * host. readTrace() reads a trace back and formatRecord() prints a record as text (see the QcnTraceDecoder tool).
+ */
+class EventTracer {
+private:
+	std::vector<EventTraceRecord> ringBuffer; //!< Ring buffer of records; its size is a power of 2.
+	uint64_t ringMask; //!< Size of ringBuffer - 1, to map positions into indexes.
+	std::atomic<uint64_t> writePosition; //!< Position of the next record to store; written by the simulation thread only.
+	std::atomic<uint64_t> readPosition; //!< Position of the next record to drain; written by the writer thread only.
+	std::atomic<bool> isStopping; //!< True when the writer thread must drain the remaining records and finish.
+	std::thread writerThread; //!< Thread that drains the ring buffer to traceFile.
+	std::ofstream traceFile; //!< Trace file; used by the writer thread while recording.
+	bool isRecordingOn; //!< True between start() and stop().
+	uint64_t eventTypeMask; //!< Bit i set if records of EventType i are kept.
+	std::vector<uint64_t> entityFilter; //!< Keys of the entities whose records are kept (see getEntityKey()), sorted; empty keeps all entities.
+	uint64_t recordsCount; //!< Number of records stored since start().
+	uint64_t fullWaitsCount; //!< Number of records that had to wait for room in the ring buffer.
+
+	void drain();
+
+	/**
+	 * @brief Key of an entity in the entity filter: its kind in the high half, its ID in the low half.
+	 *
+	 * @param entityKind Kind of the entity.
+	 * @param entityId ID of the entity.
+	 * @return Key.
+	 */
+	static uint64_t getEntityKey(TraceEntityKind entityKind, uint32_t entityId) {
+		return static_cast<uint64_t>(entityKind) << 32 | entityId;
+	}
+
+	/**
+	 * @brief Whether records of an event type and entity pass the filters.
+	 *
+	 * @param eventType Type of the event.
+	 * @param entityKind Kind of the entity.
+	 * @param entityId ID of the entity.
+	 * @return True if kept.
+	 */
+	bool isKept(EventType eventType, TraceEntityKind entityKind, uint32_t entityId) const {
+		return (eventTypeMask >> static_cast<unsigned int>(eventType) & 1) != 0
+			&& (entityFilter.empty() || std::binary_search(entityFilter.begin(), entityFilter.end(), getEntityKey(entityKind, entityId)));
+	}
+
+public:
+	EventTracer();
+	~EventTracer();
+
+	TraceReturnType start(const std::string &fileName, unsigned int capacity = EVENT_TRACE_CAPACITY);
+	void stop();
+
+	/**
+	 * @brief Record an event, if recording and not filtered out.
+	 *
+	 * @param time Simulated time of the event.
+	 * @param eventType Type of the event.
+	 * @param entityKind Kind of the entity that handled the event; NO_ENTITY if none.
+	 * @param entityId ID of the entity that handled the event; EVENT_TRACE_NO_ENTITY if none.
+	 * @param tokenId ID of the token or PDU of the event; zero if none.
+	 * @param outcome Outcome of the handling.
+	 */
+	void record(double time, EventType eventType, TraceEntityKind entityKind, uint32_t entityId, uint32_t tokenId,
+			TraceOutcome outcome = TraceOutcome::HANDLED) {
+		if (!isRecordingOn || !isKept(eventType, entityKind, entityId)) {
+			return;
+		}
+		uint64_t position = writePosition.load(std::memory_order_relaxed);
+		if (position - readPosition.load(std::memory_order_acquire) > ringMask) {
+			++fullWaitsCount;
+			while (position - readPosition.load(std::memory_order_acquire) > ringMask) {
+				std::this_thread::yield();
+			}
+		}
+		EventTraceRecord &traceRecord = ringBuffer[position & ringMask];
+		traceRecord.time = time;
+		traceRecord.entityId = entityId;
+		traceRecord.tokenId = tokenId;
+		traceRecord.eventType = static_cast<uint16_t>(eventType);
+		traceRecord.outcome = static_cast<uint16_t>(outcome);
+		traceRecord.entityKind = static_cast<uint8_t>(entityKind);
+		traceRecord.reserved[0] = traceRecord.reserved[1] = traceRecord.reserved[2] = 0;
+		writePosition.store(position + 1, std::memory_order_release);
+		++recordsCount;
+	}
+
+	bool isRecording() const;
+	void setEventTypeFilter(EventType eventType, bool isKept);
+	void setAllEventTypesFilter(bool isKept);
+	void addEntityFilter(TraceEntityKind entityKind, uint32_t entityId);
+	void clearEntityFilter();
+	uint64_t getRecordsCount() const;
+	uint64_t getFullWaitsCount() const;
+
+	static TraceReturnType readTrace(const std::string &fileName, std::vector<EventTraceRecord> &traceRecords);
+	static std::string formatRecord(const EventTraceRecord &traceRecord);
+};
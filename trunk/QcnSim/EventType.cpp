@@ -0,0 +1,49 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventType.h"
+
+/**
+ * @brief Name of an event type, for reports and traces.
+ *
+ * @param eventType Event type.
+ * @return Name, as in the EventType enum class.
+ */
+const char *getEventTypeName(EventType eventType) {
+	static const char *const eventTypeNames[EVENT_TYPES_COUNT] = {
+		"BEGIN_SIMULATION",
+		"TURN_ON_GENERATORS",
+		"TURN_OFF_GENERATORS",
+		"REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY",
+		"REQUEST_SERVICE_FOR_TOKEN_AT_CENTRAL_FACILITY",
+		"REQUEST_SERVICE_FOR_TOKEN_AT_BACKUP_FACILITY",
+		"REQUEST_SERVICE_FOR_TOKEN_AT_BOINC_FACILITY",
+		"REQUEST_SERVICE_FOR_TOKEN_AT_NODE",
+		"REQUEST_PDU_TRANSMISSION_AT_LINK",
+		"END_TRANSMISSION_PROPAGATE_PDU_AT_LINK",
+		"PDUTOKEN_ARRIVAL_AT_NODE",
+		"SEISMIC_EVENT_DETECTION",
+		"ACTIVATE_BACKUP_FACILITY",
+		"RELEASE_TOKEN_FROM_SERVICE_AT_FACILITY",
+		"TRAFFIC_GENERATOR_ARRIVAL",
+		"SET_LINK_DOWN",
+		"REROUTE_QCN_TRAFFIC",
+		"END_PROPAGATION_AT_LINK",
+		"EARTHQUAKE_DETECTION",
+		"HOST_AVAILABILITY_TRANSITION",
+		"TRICKLE_RETRY",
+		"QUAKE_WAVEFRONT_ADVANCE",
+		"END_SIMULATION"
+	};
+	return eventTypeNames[static_cast<std::size_t>(eventType)];
+}
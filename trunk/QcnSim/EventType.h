@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 /**
  * @brief EventType enum class.
  *
@@ -45,5 +47,13 @@ enum class EventType {
 	SET_LINK_DOWN,								//!< Sets link down.
 	REROUTE_QCN_TRAFFIC,						//!< Reroutes traffic from QCN sensors.
 	END_PROPAGATION_AT_LINK,					//!< Ends propagation of a PDU in a link. Schedule next event (typically ARRIVAL_AT_NODE).
+	EARTHQUAKE_DETECTION,						//!< An earthquake is detected at a server from the triggers delivered to it (see DetectionEngine).
+	HOST_AVAILABILITY_TRANSITION,				//!< Candidate on/connected/active transition of a volunteer host (see HostAvailabilityModel).
+	TRICKLE_RETRY,								//!< Retries of the outboxes of disconnected hosts due (see TrickleOutbox).
+	QUAKE_WAVEFRONT_ADVANCE,					//!< The wavefront of an earthquake reaches the next batch of sensors (see QuakeWaveModel).
 	END_SIMULATION								//!< End of simulation event.  Should be the last event to occur in the simulation, and the Event Chain should have at least this event for soundness.
-};
\ No newline at end of file
+};
+
+#define EVENT_TYPES_COUNT (static_cast<std::size_t>(EventType::END_SIMULATION) + 1) //!< Number of event types; END_SIMULATION must remain the last one.
+
+const char *getEventTypeName(EventType eventType);
\ No newline at end of file
@@ -52,7 +52,7 @@ ExponentialTrafficGenerator::ExponentialTrafficGenerator(SimulatorGlobals &simul
  * @param destination Destination entity, to which the generated tokens will be sent.
  * @param priority Token priority. Higher priority, higher number.
  * @param tau Mean interarrival time (or inverse rate or arrival, lambda) for exponential probability distribution.
- * @param seed Seed to the default random number generator, to be passed to SimulatorGlobals object.
+ * @param seed Seed for the own random stream of this generator (see TrafficGenerator).
  */
 ExponentialTrafficGenerator::ExponentialTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, double tau, unsigned int seed): TrafficGenerator(simulatorGlobals, scheduler, eventType, tokenContents,
@@ -150,7 +150,7 @@ std::shared_ptr<Token> ExponentialTrafficGenerator::createInstanceTrafficEvent(s
  *
  * @details 
  * The exponential variate is generated using C++11 Random library and uses the random number generator obtained from SimulatorGlobals,
- * such that its global seed can be utilized.
+ * such that its global seed can be utilized, or the own random stream of this generator, if set (see TrafficGenerator::setRandomStream()).
  *
  * @return Exponential distribution variate based on member variable tau.
  */
@@ -159,7 +159,7 @@ double ExponentialTrafficGenerator::generateExponentialVariate() {
 	// The pseudorandom sequence seems to be unique per simulation, not per generator; the former is the expected behavior.
 	//static std::exponential_distribution<double> exponentialGenerator(tau);
 	std::exponential_distribution<double> exponentialGenerator(1/tau); // !!! Notice that the exponential generator takes lambda (from Poisson), not tau!!!
-	return exponentialGenerator(simulatorGlobals.getRandomNumberGeneratorEngineInstance());
+	return generateVariate(exponentialGenerator);
 }
 
 /**
@@ -267,4 +267,22 @@ std::shared_ptr<ProtocolDataUnit> ExponentialTrafficGenerator::createInstanceTra
 		scheduler.schedule(Event(generateExponentialVariate(), eventType, pdu));
 	}
 	return pdu;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Generate the interval until the next arrival, for autonomous mode.
+ *
+ * @return Next exponential variate.
+ */
+double ExponentialTrafficGenerator::generateInterval() {
+	return generateExponentialVariate();
+}
+
+/**
+ * @brief Return whether this generator can run in autonomous mode.
+ *
+ * @return True: intervals come from the exponential distribution.
+ */
+bool ExponentialTrafficGenerator::supportsAutonomousMode() const {
+	return true;
+}
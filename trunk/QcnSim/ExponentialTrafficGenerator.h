@@ -41,6 +41,7 @@ private:
 	double tau;  //!< Mean interarrival time for exponential probability distribution.
 	//std::exponential_distribution<double> exponentialDistribution; //!< Exponential probability distribution variate generator.
 	double generateExponentialVariate();
+	double generateInterval() override;
 	
 public:
 	ExponentialTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
@@ -48,6 +49,7 @@ public:
 	ExponentialTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, double tau, unsigned int seed);
 
+	bool supportsAutonomousMode() const override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
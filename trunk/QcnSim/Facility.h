@@ -108,4 +108,6 @@ public:
 	unsigned int getRequestsPreemptsCount() const;
 	void setQueueSizeLimit(unsigned int limit);
 	unsigned int getQueueSizeLimit() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores counters, servers and queue.
 };
\ No newline at end of file
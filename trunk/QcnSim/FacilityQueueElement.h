@@ -50,4 +50,5 @@ class FacilityQueueElement {
 	friend bool operator<(const FacilityQueueElement &left, const FacilityQueueElement &right);
 
 	friend class Facility; //!< Only Facility can access these private members.
+	friend class SimulationCheckpoint; //!< Saves and restores queued tokens.
 };					
\ No newline at end of file
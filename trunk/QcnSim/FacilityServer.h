@@ -41,4 +41,5 @@ class FacilityServer {
 	FacilityServer();
 
 	friend class Facility;
+	friend class SimulationCheckpoint;
 };			
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ForwardingTable.h"
+#include "Link.h"
+
+/**
+ * @brief Default constructor.
+ *
+ * @details 
+ * Creates an empty table. The table grows as entries are set.
+ */
+ForwardingTable::ForwardingTable(): entries() {
+}
+
+/**
+ * @brief Constructor with number of destinations.
+ *
+ * @details 
+ * Reserves one (empty) entry per destination, such that the table does not need to grow when entries are set.
+ *
+ * @param numberOfDestinations Number of destination IDs (the highest dense node ID plus one).
+ */
+ForwardingTable::ForwardingTable(unsigned int numberOfDestinations): entries(numberOfDestinations) {
+}
+
+/**
+ * @brief Set (or overwrite) the entry for a destination.
+ *
+ * @details 
+ * If the destination ID is beyond the current table size, the table is extended with empty entries.
+ *
+ * @param destinationId Dense ID of the destination node.
+ * @param nextHop Next hop towards the destination.
+ * @param nextLink Link that connects the current node to the next hop. Default is nullptr.
+ */
+void ForwardingTable::setEntry(unsigned int destinationId, std::shared_ptr<Entity> nextHop, std::shared_ptr<Entity> nextLink) {
+	if (destinationId >= entries.size()) {
+		entries.resize(destinationId + 1);
+	}
+	entries[destinationId].nextHop = nextHop;
+	entries[destinationId].nextLink = nextLink;
+	entries[destinationId].nextLinkDown = false;
+}
+
+/**
+ * @brief Remove the entry for a destination, i.e., the destination becomes unreachable through this table.
+ *
+ * @param destinationId Dense ID of the destination node.
+ */
+void ForwardingTable::removeEntry(unsigned int destinationId) {
+	if (destinationId < entries.size()) {
+		entries[destinationId] = ForwardingTableEntry();
+	}
+}
+
+/**
+ * @brief Find the entry for a destination.
+ *
+ * @details 
+ * This is the O(1) lookup used in the forwarding path; it does not copy the smart pointers.
+ *
+ * @param destinationId Dense ID of the destination node.
+ * @return Pointer to the entry, or nullptr if there is no route to the destination. The pointer is invalidated if the table grows.
+ */
+const ForwardingTableEntry *ForwardingTable::findEntry(unsigned int destinationId) const {
+	if (destinationId >= entries.size() || entries[destinationId].nextHop == nullptr || entries[destinationId].nextLinkDown) {
+		return nullptr;
+	}
+	return &entries[destinationId];
+}
+
+/**
+ * @brief Get the next hop towards a destination.
+ *
+ * @param destinationId Dense ID of the destination node.
+ * @return Next hop, or nullptr if there is no route to the destination.
+ */
+std::shared_ptr<Entity> ForwardingTable::getNextHop(unsigned int destinationId) const {
+	const ForwardingTableEntry *entry = findEntry(destinationId);
+	return (entry != nullptr) ? entry->nextHop : nullptr;
+}
+
+/**
+ * @brief Get the link towards the next hop for a destination.
+ *
+ * @param destinationId Dense ID of the destination node.
+ * @return Link towards the next hop, or nullptr if there is no route or no link was informed.
+ */
+std::shared_ptr<Entity> ForwardingTable::getNextLink(unsigned int destinationId) const {
+	const ForwardingTableEntry *entry = findEntry(destinationId);
+	return (entry != nullptr) ? entry->nextLink : nullptr;
+}
+
+/**
+ * @brief Get the table size, i.e., the number of destination IDs the table currently spans (including empty entries).
+ *
+ * @return Table size.
+ */
+std::vector<ForwardingTableEntry>::size_type ForwardingTable::getSize() const {
+	return entries.size();
+}
+
+/**
+ * @brief Suspend or restore the entries that use a link, upon change of state of that link.
+ *
+ * @details 
+ * Only entries whose next link is the given link are modified.
+ *
+ * @param link Link that changed state.
+ * @param isUp True if the link has just come up; false if it has just gone down.
+ */
+void ForwardingTable::linkStateChanged(const Link &link, bool isUp) {
+	for (auto &entry : entries) {
+		if (entry.nextLink.get() == &link) {
+			entry.nextLinkDown = !isUp;
+		}
+	}
+}
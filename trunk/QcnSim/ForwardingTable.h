@@ -0,0 +1,66 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+#include "LinkStateObserver.h"
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Forwarding Table Entry.
+ *
+ * @par Description
+ * One entry of a ForwardingTable: the next hop (typically a Node) and, optionally, the Link through which the next hop is reached.
+ * The Link is kept as an Entity here to avoid the cyclic include between Node and Link; the caller casts it back when needed.
+ * Nodes record that link in the tokens they forward (see Token::nextLink), and drivers transmit hop-by-hop PDUs over it, which matters when
+ * parallel links join the same nodes.
+ */
+struct ForwardingTableEntry {
+	std::shared_ptr<Entity> nextHop; //!< Next hop (typically a Node) towards the destination. nullptr if there is no route.
+	std::shared_ptr<Entity> nextLink; //!< Link that connects the current node to the next hop. nullptr if not informed.
+	bool nextLinkDown; //!< True if nextLink is currently down; the entry is then ignored by lookups until the link comes back up.
+};
+
+/**
+ * @brief Forwarding Table class.
+ * 
+ * @par Description
+ * A ForwardingTable implements hop-by-hop routing as an alternative to explicit (source) routes carried by each token/PDU.
+ * The table is indexed by the dense destination node ID (see Node::getNodeId()), such that a lookup is a direct vector access, i.e., O(1).
+ * Each entry holds the next hop and, optionally, the link towards that next hop.
+ *
+ * Nodes hold the table through a smart pointer, therefore one table object can be shared by all nodes that have identical tables (e.g.,
+ * all access nodes of a region that forward everything to the same aggregation node). Updating a shared table updates the routing of all
+ * nodes that share it.
+ *
+ * The table is also a LinkStateObserver: if registered with the links it references, entries whose next link goes down are suspended
+ * (lookups miss, and the PDU is dropped at the node) and are restored when the link comes back up. No other entry is touched.
+ */
+class ForwardingTable: public LinkStateObserver {
+private:
+	std::vector<ForwardingTableEntry> entries; //!< Entries indexed by dense destination node ID.
+
+public:
+	ForwardingTable();
+	explicit ForwardingTable(unsigned int numberOfDestinations);
+
+	void setEntry(unsigned int destinationId, std::shared_ptr<Entity> nextHop, std::shared_ptr<Entity> nextLink = nullptr);
+	void removeEntry(unsigned int destinationId);
+	const ForwardingTableEntry *findEntry(unsigned int destinationId) const;
+	std::shared_ptr<Entity> getNextHop(unsigned int destinationId) const;
+	std::shared_ptr<Entity> getNextLink(unsigned int destinationId) const;
+	std::vector<ForwardingTableEntry>::size_type getSize() const;
+	void linkStateChanged(const Link &link, bool isUp) override;
+};
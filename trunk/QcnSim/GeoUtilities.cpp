@@ -0,0 +1,49 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "GeoUtilities.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Unit vector (Earth-centered) to a location.
+ *
+ * @param latitude Latitude of the location.
+ * @param longitude Longitude of the location.
+ * @param coordinates Array of three coordinates to fill.
+ */
+void GeoUtilities::toUnitVector(double latitude, double longitude, double *coordinates) {
+	double latitudeRadians = latitude * GEO_DEGREES_TO_RADIANS;
+	double longitudeRadians = longitude * GEO_DEGREES_TO_RADIANS;
+	coordinates[0] = std::cos(latitudeRadians) * std::cos(longitudeRadians);
+	coordinates[1] = std::cos(latitudeRadians) * std::sin(longitudeRadians);
+	coordinates[2] = std::sin(latitudeRadians);
+}
+
+/**
+ * @brief Great-circle distance between two locations (haversine formula).
+ *
+ * @param latitudeA Latitude of the first location.
+ * @param longitudeA Longitude of the first location.
+ * @param latitudeB Latitude of the second location.
+ * @param longitudeB Longitude of the second location.
+ * @return Distance in Km.
+ */
+double GeoUtilities::greatCircleDistance(double latitudeA, double longitudeA, double latitudeB, double longitudeB) {
+	double deltaLatitude = (latitudeB - latitudeA) * GEO_DEGREES_TO_RADIANS;
+	double deltaLongitude = (longitudeB - longitudeA) * GEO_DEGREES_TO_RADIANS;
+	double haversine = std::sin(deltaLatitude / 2) * std::sin(deltaLatitude / 2) + std::cos(latitudeA * GEO_DEGREES_TO_RADIANS) *
+		std::cos(latitudeB * GEO_DEGREES_TO_RADIANS) * std::sin(deltaLongitude / 2) * std::sin(deltaLongitude / 2);
+	return 2.0 * EARTH_RADIUS * std::asin(std::sqrt(std::min(1.0, haversine)));
+}
@@ -0,0 +1,32 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#define EARTH_RADIUS 6371.0 //!< Mean Earth radius, Km.
+#define GEO_PI 3.14159265358979323846 //!< Pi.
+#define GEO_DEGREES_TO_RADIANS (GEO_PI / 180.0) //!< Radians per degree.
+
+/**
+ * @brief Geo Utilities class.
+ * 
+ * @par Description
+ * Geographic computations shared by the components that locate sensors, servers and earthquakes on the Earth surface (JsonScenarioLoader,
+ * DetectionEngine, QuakeWaveModel, SensorSpatialIndex). The Earth is a sphere of radius EARTH_RADIUS; latitudes and longitudes are in degrees.
+ */
+class GeoUtilities {
+public:
+	static void toUnitVector(double latitude, double longitude, double *coordinates);
+	static double greatCircleDistance(double latitudeA, double longitudeA, double latitudeB, double longitudeB);
+};
@@ -0,0 +1,168 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GoodnessOfFit.h"
+#include <algorithm>
+#include <cmath>
+
+#define KOLMOGOROV_SMIRNOV_CRITICAL_COEFFICIENT 1.628 //!< Asymptotic Kolmogorov-Smirnov critical coefficient at 1% significance.
+#define ANDERSON_DARLING_CRITICAL_VALUE 3.857 //!< Anderson-Darling critical value at 1% significance, for a fully specified distribution.
+#define CHI_SQUARE_CRITICAL_Z 2.326 //!< Standard normal quantile at 1% significance (one-sided), for the chi-square critical value.
+#define CDF_EPSILON 1e-300 //!< Smallest CDF value taken into logarithms, such that samples at the tails do not yield infinities.
+
+/**
+ * @brief Kolmogorov-Smirnov statistic of samples against a CDF.
+ *
+ * @details 
+ * D = max |F_n(x) - F(x)|, where F_n is the empirical distribution of the samples.
+ *
+ * @param samples Samples (a copy is sorted here).
+ * @param cdf Analytical cumulative distribution function.
+ * @return Statistic D; zero if there are no samples.
+ */
+double GoodnessOfFit::kolmogorovSmirnovStatistic(std::vector<double> samples, const Cdf &cdf) {
+	std::sort(samples.begin(), samples.end());
+	double numberOfSamples = static_cast<double>(samples.size());
+	double statistic = 0.0;
+	for (std::vector<double>::size_type i = 0; i < samples.size(); ++i) {
+		double cdfValue = cdf(samples[i]);
+		statistic = std::max(statistic, std::max((i + 1) / numberOfSamples - cdfValue, cdfValue - i / numberOfSamples));
+	}
+	return statistic;
+}
+
+/**
+ * @brief Critical value of the Kolmogorov-Smirnov statistic at 1% significance.
+ *
+ * @param numberOfSamples Number of samples.
+ * @return Critical value.
+ */
+double GoodnessOfFit::kolmogorovSmirnovCriticalValue(std::vector<double>::size_type numberOfSamples) {
+	double root = std::sqrt(static_cast<double>(numberOfSamples));
+	return KOLMOGOROV_SMIRNOV_CRITICAL_COEFFICIENT / (root + 0.12 + 0.11 / root);
+}
+
+/**
+ * @brief Anderson-Darling statistic of samples against a CDF.
+ *
+ * @details 
+ * A^2 = -n - (1/n) sum_{i=1..n} (2i - 1) [ln F(x_i) + ln(1 - F(x_{n+1-i}))], with the samples sorted. Weighs the tails more than
+ * Kolmogorov-Smirnov.
+ *
+ * @param samples Samples (a copy is sorted here).
+ * @param cdf Analytical cumulative distribution function.
+ * @return Statistic A^2; zero if there are no samples.
+ */
+double GoodnessOfFit::andersonDarlingStatistic(std::vector<double> samples, const Cdf &cdf) {
+	if (samples.empty()) {
+		return 0.0;
+	}
+	std::sort(samples.begin(), samples.end());
+	std::vector<double>::size_type numberOfSamples = samples.size();
+	double sum = 0.0;
+	for (std::vector<double>::size_type i = 0; i < numberOfSamples; ++i) {
+		double lowerCdf = std::max(cdf(samples[i]), CDF_EPSILON);
+		double upperCdf = std::max(1.0 - cdf(samples[numberOfSamples - 1 - i]), CDF_EPSILON);
+		sum += (2.0 * i + 1.0) * (std::log(lowerCdf) + std::log(upperCdf));
+	}
+	return -static_cast<double>(numberOfSamples) - sum / numberOfSamples;
+}
+
+/**
+ * @brief Critical value of the Anderson-Darling statistic at 1% significance.
+ *
+ * @return Critical value.
+ */
+double GoodnessOfFit::andersonDarlingCriticalValue() {
+	return ANDERSON_DARLING_CRITICAL_VALUE;
+}
+
+/**
+ * @brief Chi-square statistic of samples against a CDF.
+ *
+ * @details 
+ * The samples are counted in numberOfBins bins of equal probability, using the CDF value of each sample (probability integral transform),
+ * such that no inverse CDF is needed. Each bin expects samples.size() / numberOfBins samples.
+ *
+ * @param samples Samples.
+ * @param cdf Analytical cumulative distribution function.
+ * @param numberOfBins Number of bins; at least 2.
+ * @return Chi-square statistic, with numberOfBins - 1 degrees of freedom; zero if there are no samples.
+ */
+double GoodnessOfFit::chiSquareStatistic(const std::vector<double> &samples, const Cdf &cdf, unsigned int numberOfBins) {
+	if (samples.empty() || numberOfBins == 0) {
+		return 0.0;
+	}
+	std::vector<unsigned int> observed(numberOfBins, 0);
+	for (auto sample : samples) {
+		double cdfValue = cdf(sample);
+		unsigned int bin = cdfValue <= 0.0 ? 0 : static_cast<unsigned int>(std::min(cdfValue * numberOfBins, numberOfBins - 1.0));
+		++observed[bin];
+	}
+	double expected = static_cast<double>(samples.size()) / numberOfBins;
+	double statistic = 0.0;
+	for (auto count : observed) {
+		statistic += (count - expected) * (count - expected) / expected;
+	}
+	return statistic;
+}
+
+/**
+ * @brief Critical value of the chi-square statistic at 1% significance.
+ *
+ * @details 
+ * Uses the Wilson-Hilferty approximation, accurate for the number of bins used in validations (tens or more).
+ *
+ * @param numberOfBins Number of bins (degrees of freedom plus one); at least 2.
+ * @return Critical value.
+ */
+double GoodnessOfFit::chiSquareCriticalValue(unsigned int numberOfBins) {
+	double degreesOfFreedom = numberOfBins - 1.0;
+	double term = 2.0 / (9.0 * degreesOfFreedom);
+	return degreesOfFreedom * std::pow(1.0 - term + CHI_SQUARE_CRITICAL_Z * std::sqrt(term), 3);
+}
+
+/**
+ * @brief CDF of the exponential distribution, as in ExponentialTrafficGenerator.
+ *
+ * @param x Value.
+ * @param tau Mean interarrival time (inverse of lambda).
+ * @return Probability of a variate not greater than x.
+ */
+double GoodnessOfFit::exponentialCdf(double x, double tau) {
+	return x <= 0.0 ? 0.0 : 1.0 - std::exp(-x / tau);
+}
+
+/**
+ * @brief CDF of the Normal distribution, as in NormalTrafficGenerator.
+ *
+ * @param x Value.
+ * @param mean Mean, or mu.
+ * @param standardDeviation Standard deviation, or sigma.
+ * @return Probability of a variate not greater than x.
+ */
+double GoodnessOfFit::normalCdf(double x, double mean, double standardDeviation) {
+	return 0.5 * std::erfc(-(x - mean) / (standardDeviation * std::sqrt(2.0)));
+}
+
+/**
+ * @brief CDF of the Weibull distribution, as in WeibullTrafficGenerator.
+ *
+ * @param x Value.
+ * @param scale Scale parameter.
+ * @param shape Shape parameter.
+ * @return Probability of a variate not greater than x.
+ */
+double GoodnessOfFit::weibullCdf(double x, double scale, double shape) {
+	return x <= 0.0 ? 0.0 : 1.0 - std::exp(-std::pow(x / scale, shape));
+}
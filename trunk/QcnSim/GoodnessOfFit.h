@@ -0,0 +1,43 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Goodness of Fit class.
+ * 
+ * @par Description
+ * Statistical tests of a set of samples against an analytical cumulative distribution function (CDF), to validate the variate generators
+ * in-process: Kolmogorov-Smirnov, Anderson-Darling and chi-square. Each test has a function for the statistic and one for its critical value
+ * at the 1% significance level; the samples fit the distribution if the statistic does not exceed the critical value.
+ *
+ * The CDFs of the distributions used by the traffic generators are provided, with the same parameters as the generators.
+ */
+class GoodnessOfFit {
+public:
+	typedef std::function<double(double)> Cdf; //!< Cumulative distribution function.
+
+	static double kolmogorovSmirnovStatistic(std::vector<double> samples, const Cdf &cdf);
+	static double kolmogorovSmirnovCriticalValue(std::vector<double>::size_type numberOfSamples);
+	static double andersonDarlingStatistic(std::vector<double> samples, const Cdf &cdf);
+	static double andersonDarlingCriticalValue();
+	static double chiSquareStatistic(const std::vector<double> &samples, const Cdf &cdf, unsigned int numberOfBins);
+	static double chiSquareCriticalValue(unsigned int numberOfBins);
+
+	static double exponentialCdf(double x, double tau);
+	static double normalCdf(double x, double mean, double standardDeviation);
+	static double weibullCdf(double x, double scale, double shape);
+};
@@ -0,0 +1,313 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HostAvailabilityModel.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+
+/**
+ * @brief Constructor.
+ *
+ * @param simulatorGlobals SimulatorGlobals object.
+ * @param scheduler Scheduler object, for the recurring event and the buffered triggers.
+ * @param transitionEventType Type of the recurring event of candidate transitions.
+ * @param releaseEventType Type of the events of buffered triggers released.
+ * @param streamId ID of the own random stream (see SimulatorGlobals::createRandomStream()).
+ */
+HostAvailabilityModel::HostAvailabilityModel(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType transitionEventType,
+		EventType releaseEventType, unsigned int streamId): simulatorGlobals(simulatorGlobals), scheduler(scheduler),
+		transitionEventType(transitionEventType), releaseEventType(releaseEventType), randomStream(simulatorGlobals.createRandomStream(streamId)),
+		candidateRate(0.0), isStarted(false), candidateTransitionsCount(0), transitionsCount(0), bufferedTriggersCount(0), droppedTriggersCount(0) {
+	meanCycles[static_cast<int>(HostState::ON)] = HOST_ON_MEAN_CYCLE;
+	meanCycles[static_cast<int>(HostState::CONNECTED)] = HOST_CONNECTED_MEAN_CYCLE;
+	meanCycles[static_cast<int>(HostState::ACTIVE)] = HOST_ACTIVE_MEAN_CYCLE;
+	for (int state = 0; state < 3; ++state) {
+		maximumRates[state] = 0.0;
+		upCounts[state] = 0;
+	}
+}
+
+/**
+ * @brief Destructor. Removes the recurring event from the event chain, if any.
+ */
+HostAvailabilityModel::~HostAvailabilityModel() {
+	stop();
+}
+
+/**
+ * @brief Add the host of a sensor, with the fractions of its QcnSensorParameters.
+ *
+ * @param sensor Sensor to add.
+ */
+void HostAvailabilityModel::addSensor(std::shared_ptr<QcnSensorTrafficGenerator> sensor) {
+	hostIndexMap[sensor->getQcnExplorerSensorId()] = static_cast<uint32_t>(sensors.size());
+	fractions[static_cast<int>(HostState::ON)].push_back(sensor->getSensorParameters().onFraction);
+	fractions[static_cast<int>(HostState::CONNECTED)].push_back(sensor->getSensorParameters().connectedFraction);
+	fractions[static_cast<int>(HostState::ACTIVE)].push_back(sensor->getSensorParameters().activeFraction);
+	sensors.push_back(std::move(sensor));
+}
+
+/**
+ * @brief Add the hosts of all QCN sensors of a topology.
+ *
+ * @param topology Topology whose qcnSensorTrafficGeneratorMap is added.
+ */
+void HostAvailabilityModel::addSensors(const Topology &topology) {
+	for (auto &sensorPair : topology.qcnSensorTrafficGeneratorMap) {
+		addSensor(sensorPair.second);
+	}
+}
+
+/**
+ * @brief Set the mean cycle of a state, i.e., the mean time up plus the mean time down. Must be called before start().
+ *
+ * @param hostState State.
+ * @param meanCycle Mean cycle, in seconds.
+ */
+void HostAvailabilityModel::setMeanCycle(HostState hostState, double meanCycle) {
+	meanCycles[static_cast<int>(hostState)] = meanCycle;
+}
+
+/**
+ * @brief Draw the initial states of the hosts and schedule the recurring event of candidate transitions.
+ *
+ * @details 
+ * Does nothing if already started.
+ */
+void HostAvailabilityModel::start() {
+	if (isStarted) {
+		return;
+	}
+	std::uniform_real_distribution<double> uniformDistribution(0.0, 1.0);
+	candidateRate = 0.0;
+	for (int state = 0; state < 3; ++state) {
+		stateBits[state].assign((sensors.size() + 63) / 64, 0);
+		upCounts[state] = 0;
+		maximumRates[state] = 0.0;
+		for (uint32_t hostIndex = 0; hostIndex < sensors.size(); ++hostIndex) {
+			double fraction = fractions[state][hostIndex];
+			if (uniformDistribution(randomStream) < fraction) {
+				stateBits[state][hostIndex / 64] |= uint64_t(1) << (hostIndex % 64);
+				++upCounts[state];
+			}
+			if (fraction > 0.0 && fraction < 1.0) {
+				maximumRates[state] = std::max(maximumRates[state], 1.0 / (std::min(fraction, 1.0 - fraction) * meanCycles[state]));
+			}
+		}
+		candidateRate += sensors.size() * maximumRates[state];
+	}
+	isStarted = true;
+	// Aliasing constructor with an empty owner: the event points to this model without owning it.
+	scheduler.scheduleRecurring(Event(nextOccurAfterTime(), transitionEventType, std::shared_ptr<const Entity>(std::shared_ptr<const Entity>(), this)), *this);
+}
+
+/**
+ * @brief Remove the recurring event from the event chain. Hosts keep their states; triggers are no longer filtered.
+ */
+void HostAvailabilityModel::stop() {
+	if (isStarted) {
+		scheduler.cancelRecurring(*this);
+		isStarted = false;
+	}
+}
+
+/**
+ * @brief Process a candidate transition; to be called by the driver upon each recurring event.
+ *
+ * @details 
+ * Picks a state, with probability proportional to its largest rate, and a host uniformly, and flips the state of the host with probability
+ * of its rate over the largest rate. Buffered triggers of the host are released if it becomes on and connected.
+ *
+ * @return True if a state flipped; false if the candidate was rejected.
+ */
+bool HostAvailabilityModel::processTransition() {
+	++candidateTransitionsCount;
+	if (sensors.empty() || candidateRate <= 0.0) {
+		return false;
+	}
+	std::uniform_real_distribution<double> uniformDistribution(0.0, 1.0);
+	double draw = uniformDistribution(randomStream) * (maximumRates[0] + maximumRates[1] + maximumRates[2]);
+	int state = 0;
+	while (state < 2 && (draw >= maximumRates[state] || maximumRates[state] == 0.0)) {
+		draw -= maximumRates[state];
+		++state;
+	}
+	std::uniform_int_distribution<uint32_t> hostDistribution(0, static_cast<uint32_t>(sensors.size() - 1));
+	uint32_t hostIndex = hostDistribution(randomStream);
+	if (uniformDistribution(randomStream) * maximumRates[state] >= getTransitionRate(static_cast<HostState>(state), hostIndex)) {
+		return false;
+	}
+	uint64_t &word = stateBits[state][hostIndex / 64];
+	word ^= uint64_t(1) << (hostIndex % 64);
+	if (word & (uint64_t(1) << (hostIndex % 64))) {
+		++upCounts[state];
+		if (state != static_cast<int>(HostState::ACTIVE) && isUp(HostState::ON, hostIndex) && isUp(HostState::CONNECTED, hostIndex)) {
+			releaseTriggers(hostIndex);
+		}
+	} else {
+		--upCounts[state];
+	}
+	++transitionsCount;
+	return true;
+}
+
+/**
+ * @brief Decide what happens to a trigger, given the states of its host.
+ *
+ * @details 
+ * Triggers of sensors not in the model, or received while the model is not started, are delivered.
+ *
+ * @param trigger Trigger of a sensor.
+ * @return DELIVER, BUFFER (the trigger is kept and scheduled again when the host connects) or DROP.
+ */
+TriggerDisposition HostAvailabilityModel::filterTrigger(std::shared_ptr<const SeismicEventData> trigger) {
+	auto hostIndexIterator = hostIndexMap.find(trigger->qcnExplorerSensorId);
+	if (!isStarted || hostIndexIterator == hostIndexMap.end()) {
+		return TriggerDisposition::DELIVER;
+	}
+	uint32_t hostIndex = hostIndexIterator->second;
+	if (!isUp(HostState::ON, hostIndex) || !isUp(HostState::ACTIVE, hostIndex)) {
+		++droppedTriggersCount;
+		return TriggerDisposition::DROP;
+	}
+	if (!isUp(HostState::CONNECTED, hostIndex)) {
+		++bufferedTriggersCount;
+		bufferedTriggers[hostIndex].push_back(std::move(trigger));
+		return TriggerDisposition::BUFFER;
+	}
+	return TriggerDisposition::DELIVER;
+}
+
+/**
+ * @brief Interval until the next candidate transition, from the aggregated stream.
+ *
+ * @return Exponential interval; infinity if no host can change state.
+ */
+double HostAvailabilityModel::nextOccurAfterTime() {
+	if (candidateRate <= 0.0) {
+		return std::numeric_limits<double>::infinity();
+	}
+	std::exponential_distribution<double> exponentialDistribution(candidateRate);
+	return exponentialDistribution(randomStream);
+}
+
+/**
+ * @brief Whether the host of a sensor is up in a state.
+ *
+ * @param hostState State.
+ * @param qcnExplorerSensorId Sensor ID.
+ * @return True if up; false if down or if the sensor is not in the model.
+ */
+bool HostAvailabilityModel::isHostUp(HostState hostState, unsigned int qcnExplorerSensorId) const {
+	auto hostIndexIterator = hostIndexMap.find(qcnExplorerSensorId);
+	return hostIndexIterator != hostIndexMap.end() && isUp(hostState, hostIndexIterator->second);
+}
+
+/**
+ * @brief Whether a host is up in a state.
+ *
+ * @param hostState State.
+ * @param hostIndex Host index.
+ * @return True if up.
+ */
+bool HostAvailabilityModel::isUp(HostState hostState, uint32_t hostIndex) const {
+	const std::vector<uint64_t> &bits = stateBits[static_cast<int>(hostState)];
+	return hostIndex / 64 < bits.size() && (bits[hostIndex / 64] >> (hostIndex % 64) & 1) != 0;
+}
+
+/**
+ * @brief Rate at which a host leaves its current state.
+ *
+ * @param hostState State.
+ * @param hostIndex Host index.
+ * @return 1 / (fraction * mean cycle) if up, 1 / ((1 - fraction) * mean cycle) if down; zero if the host cannot leave it.
+ */
+double HostAvailabilityModel::getTransitionRate(HostState hostState, uint32_t hostIndex) const {
+	double fraction = fractions[static_cast<int>(hostState)][hostIndex];
+	if (fraction <= 0.0 || fraction >= 1.0) {
+		return 0.0;
+	}
+	return 1.0 / ((isUp(hostState, hostIndex) ? fraction : 1.0 - fraction) * meanCycles[static_cast<int>(hostState)]);
+}
+
+/**
+ * @brief Schedule the buffered triggers of a host, now on and connected.
+ *
+ * @param hostIndex Host index.
+ */
+void HostAvailabilityModel::releaseTriggers(uint32_t hostIndex) {
+	auto bufferedTriggersIterator = bufferedTriggers.find(hostIndex);
+	if (bufferedTriggersIterator == bufferedTriggers.end()) {
+		return;
+	}
+	for (auto &trigger : bufferedTriggersIterator->second) {
+		scheduler.schedule(Event(0.0, releaseEventType, trigger));
+	}
+	bufferedTriggers.erase(bufferedTriggersIterator);
+}
+
+/**
+ * @brief Get number of hosts.
+ *
+ * @return Number of hosts.
+ */
+std::vector<std::shared_ptr<QcnSensorTrafficGenerator>>::size_type HostAvailabilityModel::getNumberOfHosts() const {
+	return sensors.size();
+}
+
+/**
+ * @brief Get number of hosts up in a state.
+ *
+ * @param hostState State.
+ * @return Number of hosts up.
+ */
+unsigned int HostAvailabilityModel::getHostsUpCount(HostState hostState) const {
+	return upCounts[static_cast<int>(hostState)];
+}
+
+/**
+ * @brief Get number of candidate transitions processed.
+ *
+ * @return Number of candidates, accepted or rejected.
+ */
+unsigned int HostAvailabilityModel::getCandidateTransitionsCount() const {
+	return candidateTransitionsCount;
+}
+
+/**
+ * @brief Get number of transitions, i.e., state flips.
+ *
+ * @return Number of transitions.
+ */
+unsigned int HostAvailabilityModel::getTransitionsCount() const {
+	return transitionsCount;
+}
+
+/**
+ * @brief Get number of triggers buffered while their host was disconnected.
+ *
+ * @return Number of triggers.
+ */
+unsigned int HostAvailabilityModel::getBufferedTriggersCount() const {
+	return bufferedTriggersCount;
+}
+
+/**
+ * @brief Get number of triggers dropped because their host was off or inactive.
+ *
+ * @return Number of triggers.
+ */
+unsigned int HostAvailabilityModel::getDroppedTriggersCount() const {
+	return droppedTriggersCount;
+}
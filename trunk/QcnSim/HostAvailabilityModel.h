@@ -0,0 +1,114 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+#include "EventType.h"
+#include "QcnSensorTrafficGenerator.h"
+#include "RandomStream.h"
+#include "RecurringEventSource.h"
+#include "Scheduler.h"
+#include "SeismicEventData.h"
+#include "SimulatorGlobals.h"
+#include "Topology.h"
+#include "TriggerDisposition.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#define HOST_AVAILABILITY_RANDOM_STREAM_ID 0xE0000001 //!< Default ID of the random stream of the host availability model.
+#define HOST_ON_MEAN_CYCLE 86400.0 //!< Default mean duration of an on/off cycle of a host, in seconds.
+#define HOST_CONNECTED_MEAN_CYCLE 3600.0 //!< Default mean duration of a connected/disconnected cycle of a host, in seconds.
+#define HOST_ACTIVE_MEAN_CYCLE 3600.0 //!< Default mean duration of an active/inactive cycle of the QCN client, in seconds.
+
+/**
+ * @brief Host Availability Model class.
+ * 
+ * @par Description
+ * Churn of the volunteer hosts of QCN sensors: each host is on or off, connected or disconnected, and its QCN client active or inactive, following
+ * the onFrac, connFrac and actFrac of its QcnSensorParameters. Each of the three states is an alternating-renewal process with exponential
+ * durations: over a mean cycle C (see setMeanCycle()), the mean time up is fraction * C and the mean time down (1 - fraction) * C, thus the
+ * state is up a fraction of the time. The three processes are independent, such that connFrac and actFrac are also the fractions of time
+ * connected and active while on. Initial states are drawn from the same fractions.
+ *
+ * The model scales to millions of hosts: states are stored as bitsets, and transitions come from a single aggregated stream instead of one
+ * pending event per host. The model keeps one recurring event in the event chain (type HOST_AVAILABILITY_TRANSITION by default) at the times of
+ * a Poisson stream of candidate transitions, whose rate is the number of hosts times the largest transition rate of any host, for each state.
+ * On each event, the driver calls processTransition(), which picks a state and a host at random and flips it with probability of its actual rate
+ * over the largest rate (thinning). The stream is thus exact, and efficient as long as the rates of hosts are of similar magnitude; fractions
+ * very close to 0 or 1 raise the largest rate and the share of rejected candidates.
+ *
+ * Triggers of sensors are then filtered with filterTrigger(): triggers of hosts off or inactive are dropped; triggers of hosts on and active,
+ * but disconnected, are buffered, and scheduled again (type SEISMIC_EVENT_DETECTION by default, with zero delay) once the host is on and
+ * connected. Hosts are added before start(). SimulationCheckpoint saves the states, the random stream and the buffered triggers of a model added
+ * with SimulationCheckpoint::addHostAvailabilityModel().
+ */
+class HostAvailabilityModel: public Entity, public RecurringEventSource {
+public:
+	/// State of a host, as index of its bitset.
+	enum class HostState {
+		ON,			//!< Host computer is on.
+		CONNECTED,	//!< Host is connected to the network.
+		ACTIVE		//!< QCN client is active.
+	};
+
+private:
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object.
+	Scheduler &scheduler; //!< Reference to Scheduler object, for the recurring event and the buffered triggers.
+	EventType transitionEventType; //!< Type of the recurring event of candidate transitions.
+	EventType releaseEventType; //!< Type of the events of buffered triggers released.
+	RandomStream randomStream; //!< Own random stream.
+	std::vector<std::shared_ptr<QcnSensorTrafficGenerator>> sensors; //!< Sensors, by host index.
+	std::unordered_map<unsigned int, uint32_t> hostIndexMap; //!< Host index of each sensor, by QCNExplorer sensor ID.
+	std::vector<double> fractions[3]; //!< Fraction of time up of each host, for each state.
+	std::vector<uint64_t> stateBits[3]; //!< Bitset of the hosts up, for each state.
+	double meanCycles[3]; //!< Mean cycle of each state.
+	double maximumRates[3]; //!< Largest transition rate of any host, for each state.
+	unsigned int upCounts[3]; //!< Number of hosts up, for each state.
+	double candidateRate; //!< Rate of the stream of candidate transitions.
+	bool isStarted; //!< True if the recurring event is in the event chain.
+	std::unordered_map<uint32_t, std::vector<std::shared_ptr<const SeismicEventData>>> bufferedTriggers; //!< Triggers waiting for their host to connect, by host index.
+	unsigned int candidateTransitionsCount; //!< Number of candidate transitions processed.
+	unsigned int transitionsCount; //!< Number of transitions (state flips).
+	unsigned int bufferedTriggersCount; //!< Number of triggers buffered.
+	unsigned int droppedTriggersCount; //!< Number of triggers dropped.
+
+	bool isUp(HostState hostState, uint32_t hostIndex) const;
+	double getTransitionRate(HostState hostState, uint32_t hostIndex) const;
+	void releaseTriggers(uint32_t hostIndex);
+
+public:
+	HostAvailabilityModel(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType transitionEventType = EventType::HOST_AVAILABILITY_TRANSITION,
+		EventType releaseEventType = EventType::SEISMIC_EVENT_DETECTION, unsigned int streamId = HOST_AVAILABILITY_RANDOM_STREAM_ID);
+	virtual ~HostAvailabilityModel();
+
+	void addSensor(std::shared_ptr<QcnSensorTrafficGenerator> sensor);
+	void addSensors(const Topology &topology);
+	void setMeanCycle(HostState hostState, double meanCycle);
+	void start();
+	void stop();
+	bool processTransition();
+	TriggerDisposition filterTrigger(std::shared_ptr<const SeismicEventData> trigger);
+	double nextOccurAfterTime() override;
+	bool isHostUp(HostState hostState, unsigned int qcnExplorerSensorId) const;
+	std::vector<std::shared_ptr<QcnSensorTrafficGenerator>>::size_type getNumberOfHosts() const;
+	unsigned int getHostsUpCount(HostState hostState) const;
+	unsigned int getCandidateTransitionsCount() const;
+	unsigned int getTransitionsCount() const;
+	unsigned int getBufferedTriggersCount() const;
+	unsigned int getDroppedTriggersCount() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores the states, the random stream and the buffered triggers.
+};
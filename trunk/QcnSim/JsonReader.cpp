@@ -0,0 +1,407 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "JsonReader.h"
+
+/**
+ * @brief Constructor.
+ *
+ * @param message Description of the error.
+ * @param line Line of the offending character.
+ * @param column Column of the offending character.
+ */
+JsonReaderException::JsonReaderException(const std::string &message, unsigned long line, unsigned long column): std::runtime_error(message),
+		line(line), column(column) {
+}
+
+/**
+ * @brief Get line of the offending character.
+ *
+ * @return Line, starting at 1.
+ */
+unsigned long JsonReaderException::getLine() const {
+	return line;
+}
+
+/**
+ * @brief Get column of the offending character.
+ *
+ * @return Column, starting at 1.
+ */
+unsigned long JsonReaderException::getColumn() const {
+	return column;
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param inputStream Stream from which JSON text is read. Must outlive this reader.
+ * @param bufferSize Size of the input block, in bytes.
+ */
+JsonReader::JsonReader(std::istream &inputStream, std::vector<char>::size_type bufferSize): inputStream(inputStream), buffer(bufferSize),
+		bufferPosition(0), bufferEnd(0), line(1), column(1) {
+}
+
+/**
+ * @brief Read the next block from the stream.
+ *
+ * @return True if at least one character was read; false at end of stream.
+ */
+bool JsonReader::fillBuffer() {
+	inputStream.read(buffer.data(), buffer.size());
+	bufferEnd = static_cast<std::vector<char>::size_type>(inputStream.gcount());
+	bufferPosition = 0;
+	return bufferEnd > 0;
+}
+
+/**
+ * @brief Peek the next character without consuming it.
+ *
+ * @return Next character, or -1 at end of input.
+ */
+int JsonReader::peekChar() {
+	if (bufferPosition == bufferEnd && !fillBuffer()) {
+		return -1;
+	}
+	return static_cast<unsigned char>(buffer[bufferPosition]);
+}
+
+/**
+ * @brief Consume the next character.
+ *
+ * @return Consumed character, or -1 at end of input.
+ */
+int JsonReader::getChar() {
+	int character = peekChar();
+	if (character >= 0) {
+		++bufferPosition;
+		if (character == '\n') {
+			++line;
+			column = 1;
+		} else {
+			++column;
+		}
+	}
+	return character;
+}
+
+/**
+ * @brief Skip blanks, tabs and line breaks.
+ */
+void JsonReader::skipWhitespace() {
+	int character = peekChar();
+	while (character == ' ' || character == '\t' || character == '\n' || character == '\r') {
+		getChar();
+		character = peekChar();
+	}
+}
+
+/**
+ * @brief Consume the expected character (after whitespace), or fail.
+ *
+ * @param expected Expected character.
+ */
+void JsonReader::expectChar(char expected) {
+	skipWhitespace();
+	int character = peekChar();
+	if (character != static_cast<unsigned char>(expected)) {
+		fail(std::string("expected '") + expected + "', found " + (character < 0 ? std::string("end of input") : "'" + std::string(1, static_cast<char>(character)) + "'"));
+	}
+	getChar();
+}
+
+/**
+ * @brief Throw a JsonReaderException at the current position.
+ *
+ * @param message Description of the error.
+ */
+void JsonReader::fail(const std::string &message) const {
+	throw JsonReaderException(message, line, column);
+}
+
+/**
+ * @brief Enter an object. Members are then read with nextMember().
+ */
+void JsonReader::beginObject() {
+	expectChar('{');
+	isFirstInContainer.push_back(true);
+}
+
+/**
+ * @brief Advance to the next member of the current object.
+ *
+ * @details 
+ * If there is a member, its name is read, as well as the name separator; the caller must then consume the member value
+ * (readScalar(), skipValue(), beginObject(), beginArray()). If the object ends, the closing brace is consumed.
+ *
+ * @param name Receives the member name.
+ * @return True if a member was found; false if the object has ended.
+ */
+bool JsonReader::nextMember(std::string &name) {
+	skipWhitespace();
+	if (peekChar() == '}') {
+		getChar();
+		isFirstInContainer.pop_back();
+		return false;
+	}
+	if (!isFirstInContainer.back()) {
+		expectChar(',');
+		skipWhitespace();
+	}
+	isFirstInContainer.back() = false;
+	readString(name);
+	expectChar(':');
+	return true;
+}
+
+/**
+ * @brief Enter an array. Elements are then visited with nextElement().
+ */
+void JsonReader::beginArray() {
+	expectChar('[');
+	isFirstInContainer.push_back(true);
+}
+
+/**
+ * @brief Advance to the next element of the current array.
+ *
+ * @details 
+ * If there is an element, the caller must then consume it. If the array ends, the closing bracket is consumed.
+ *
+ * @return True if an element was found; false if the array has ended.
+ */
+bool JsonReader::nextElement() {
+	skipWhitespace();
+	if (peekChar() == ']') {
+		getChar();
+		isFirstInContainer.pop_back();
+		return false;
+	}
+	if (!isFirstInContainer.back()) {
+		expectChar(',');
+	}
+	isFirstInContainer.back() = false;
+	return true;
+}
+
+/**
+ * @brief Check whether the next value is an object.
+ *
+ * @return True if the next value is an object.
+ */
+bool JsonReader::isNextObject() {
+	skipWhitespace();
+	return peekChar() == '{';
+}
+
+/**
+ * @brief Check whether the next value is an array.
+ *
+ * @return True if the next value is an array.
+ */
+bool JsonReader::isNextArray() {
+	skipWhitespace();
+	return peekChar() == '[';
+}
+
+/**
+ * @brief Read four hexadecimal digits of a \\u escape sequence.
+ *
+ * @return Code unit.
+ */
+unsigned long JsonReader::readHexQuad() {
+	unsigned long codeUnit = 0;
+	for (int i = 0; i < 4; ++i) {
+		int character = getChar();
+		codeUnit <<= 4;
+		if (character >= '0' && character <= '9') {
+			codeUnit |= character - '0';
+		} else if (character >= 'a' && character <= 'f') {
+			codeUnit |= character - 'a' + 10;
+		} else if (character >= 'A' && character <= 'F') {
+			codeUnit |= character - 'A' + 10;
+		} else {
+			fail("invalid \\u escape sequence");
+		}
+	}
+	return codeUnit;
+}
+
+/**
+ * @brief Append a Unicode code point to a string, encoded as UTF-8.
+ *
+ * @param value String to append to.
+ * @param codePoint Unicode code point.
+ */
+void JsonReader::appendUtf8(std::string &value, unsigned long codePoint) {
+	if (codePoint < 0x80) {
+		value += static_cast<char>(codePoint);
+	} else if (codePoint < 0x800) {
+		value += static_cast<char>(0xC0 | (codePoint >> 6));
+		value += static_cast<char>(0x80 | (codePoint & 0x3F));
+	} else if (codePoint < 0x10000) {
+		value += static_cast<char>(0xE0 | (codePoint >> 12));
+		value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		value += static_cast<char>(0x80 | (codePoint & 0x3F));
+	} else {
+		value += static_cast<char>(0xF0 | (codePoint >> 18));
+		value += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		value += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+/**
+ * @brief Read a string value, resolving escape sequences.
+ *
+ * @param value Receives the string contents (without quotes).
+ */
+void JsonReader::readString(std::string &value) {
+	expectChar('"');
+	value.clear();
+	while (true) {
+		// Copy runs of plain characters straight from the buffer.
+		std::vector<char>::size_type runStart = bufferPosition;
+		while (bufferPosition < bufferEnd && buffer[bufferPosition] != '"' && buffer[bufferPosition] != '\\' && buffer[bufferPosition] != '\n') {
+			++bufferPosition;
+		}
+		value.append(buffer.data() + runStart, bufferPosition - runStart);
+		column += static_cast<unsigned long>(bufferPosition - runStart);
+		if (bufferPosition == bufferEnd) {
+			// Buffer exhausted within the string; refill and keep copying.
+			if (!fillBuffer()) {
+				fail("unterminated string");
+			}
+			continue;
+		}
+		int character = getChar();
+		if (character == '"') {
+			return;
+		} else if (character == '\\') {
+			character = getChar();
+			switch (character) {
+				case '"': value += '"'; break;
+				case '\\': value += '\\'; break;
+				case '/': value += '/'; break;
+				case 'b': value += '\b'; break;
+				case 'f': value += '\f'; break;
+				case 'n': value += '\n'; break;
+				case 'r': value += '\r'; break;
+				case 't': value += '\t'; break;
+				case 'u': {
+					unsigned long codePoint = readHexQuad();
+					if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+						// High surrogate; must be followed by a low surrogate.
+						if (getChar() != '\\' || getChar() != 'u') {
+							fail("unpaired surrogate in \\u escape sequence");
+						}
+						unsigned long lowSurrogate = readHexQuad();
+						if (lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF) {
+							fail("unpaired surrogate in \\u escape sequence");
+						}
+						codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+					}
+					appendUtf8(value, codePoint);
+					break;
+				}
+				default:
+					fail("invalid escape sequence in string");
+			}
+		} else {
+			fail("line break within string");
+		}
+	}
+}
+
+/**
+ * @brief Read a scalar value (string, number, true, false or null) as text.
+ *
+ * @details 
+ * Strings are returned without quotes and with escape sequences resolved; other scalars are returned exactly as written.
+ *
+ * @param value Receives the scalar text.
+ */
+void JsonReader::readScalar(std::string &value) {
+	skipWhitespace();
+	int character = peekChar();
+	if (character == '"') {
+		readString(value);
+		return;
+	}
+	if (character == '{' || character == '[') {
+		fail("expected a scalar value, found " + std::string(character == '{' ? "an object" : "an array"));
+	}
+	if (!(character == '-' || (character >= '0' && character <= '9') || character == 't' || character == 'f' || character == 'n')) {
+		fail(character < 0 ? "unexpected end of input" : "unexpected character '" + std::string(1, static_cast<char>(character)) + "'");
+	}
+	value.clear();
+	while (character >= 0 && character != ',' && character != '}' && character != ']' && character != ' ' && character != '\t' &&
+		   character != '\n' && character != '\r') {
+		value += static_cast<char>(getChar());
+		character = peekChar();
+	}
+	if (character < 0 || (!(value[0] == '-' || (value[0] >= '0' && value[0] <= '9')) && value != "true" && value != "false" && value != "null")) {
+		if (character < 0) {
+			fail("unexpected end of input");
+		}
+		fail("invalid literal '" + value + "'");
+	}
+}
+
+/**
+ * @brief Skip the next value, whatever its type (used for unknown members).
+ */
+void JsonReader::skipValue() {
+	std::string scratch;
+	if (isNextObject()) {
+		beginObject();
+		while (nextMember(scratch)) {
+			skipValue();
+		}
+	} else if (isNextArray()) {
+		beginArray();
+		while (nextElement()) {
+			skipValue();
+		}
+	} else {
+		readScalar(scratch);
+	}
+}
+
+/**
+ * @brief Check whether only whitespace remains in the input.
+ *
+ * @return True if the end of input was reached.
+ */
+bool JsonReader::isAtEnd() {
+	skipWhitespace();
+	return peekChar() < 0;
+}
+
+/**
+ * @brief Get current line.
+ *
+ * @return Line, starting at 1.
+ */
+unsigned long JsonReader::getLine() const {
+	return line;
+}
+
+/**
+ * @brief Get current column.
+ *
+ * @return Column, starting at 1.
+ */
+unsigned long JsonReader::getColumn() const {
+	return column;
+}
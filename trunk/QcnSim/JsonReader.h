@@ -0,0 +1,95 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief JSON Reader Exception class.
+ *
+ * @par Description
+ * Thrown by JsonReader upon malformed input. Carries the line and column (both starting at 1) of the offending character.
+ */
+class JsonReaderException: public std::runtime_error {
+private:
+	unsigned long line; //!< Line of the offending character.
+	unsigned long column; //!< Column of the offending character.
+
+public:
+	JsonReaderException(const std::string &message, unsigned long line, unsigned long column);
+	unsigned long getLine() const;
+	unsigned long getColumn() const;
+};
+
+/**
+ * @brief JSON Reader class.
+ * 
+ * @par Description
+ * Streaming (pull) JSON reader. No document tree is built: the caller walks the input in order, asking for the next object member or array
+ * element and reading scalar values as they come, such that arbitrarily large arrays can be consumed with constant memory.
+ * Input is read in blocks from the stream, and line and column are tracked for error reporting.
+ *
+ * Typical use:
+ * @code
+ * reader.beginObject();
+ * while (reader.nextMember(name)) {
+ *     if (name == "ID") {
+ *         reader.readScalar(value);
+ *     } else {
+ *         reader.skipValue();
+ *     }
+ * }
+ * @endcode
+ *
+ * Scalars (strings, numbers, true, false, null) are all returned as text; conversion is left to the caller, which knows the schema.
+ * Malformed input causes a JsonReaderException.
+ */
+class JsonReader {
+private:
+	std::istream &inputStream; //!< Stream from which JSON text is read.
+	std::vector<char> buffer; //!< Input block.
+	std::vector<char>::size_type bufferPosition; //!< Position of next character within buffer.
+	std::vector<char>::size_type bufferEnd; //!< Number of valid characters within buffer.
+	unsigned long line; //!< Current line, starting at 1.
+	unsigned long column; //!< Current column, starting at 1.
+	std::vector<bool> isFirstInContainer; //!< For each open object/array, whether no member/element has been read yet.
+
+	bool fillBuffer();
+	int peekChar();
+	int getChar();
+	void skipWhitespace();
+	void expectChar(char expected);
+	void appendUtf8(std::string &value, unsigned long codePoint);
+	unsigned long readHexQuad();
+	void fail(const std::string &message) const;
+
+public:
+	explicit JsonReader(std::istream &inputStream, std::vector<char>::size_type bufferSize = 65536);
+
+	void beginObject();
+	bool nextMember(std::string &name);
+	void beginArray();
+	bool nextElement();
+	bool isNextObject();
+	bool isNextArray();
+	void readString(std::string &value);
+	void readScalar(std::string &value);
+	void skipValue();
+	bool isAtEnd();
+	unsigned long getLine() const;
+	unsigned long getColumn() const;
+};
@@ -0,0 +1,583 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "JsonScenarioLoader.h"
+#include "GeoUtilities.h"
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+/**
+ * @brief Constructor.
+ *
+ * @param simulatorGlobals Reference to SimulatorGlobals object, passed on to the created objects.
+ * @param scheduler Reference to Scheduler object, passed on to the created objects.
+ * @param topology Topology that receives the created objects.
+ */
+JsonScenarioLoader::JsonScenarioLoader(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, Topology &topology): simulatorGlobals(simulatorGlobals),
+		scheduler(scheduler), topology(topology), nextNodeId(0), currentElementIndex(0) {
+}
+
+/**
+ * @brief Load a scenario from a file.
+ *
+ * @param fileName Name of the JSON scenario file.
+ * @return ScenarioLoaderReturnType indicating whether the scenario was loaded, or the kind of error.
+ */
+ScenarioLoaderReturnType JsonScenarioLoader::load(const std::string &fileName) {
+	std::ifstream inputFile(fileName, std::ios::in | std::ios::binary);
+	if (!inputFile) {
+		errorMessage = "cannot open scenario file " + fileName;
+		return ScenarioLoaderReturnType::FILE_NOT_FOUND;
+	}
+	return load(inputFile);
+}
+
+/**
+ * @brief Load a scenario from a stream.
+ *
+ * @details 
+ * Reads the whole input, creating nodes and sensors as they are read, and then resolves routes and creates links.
+ * Unknown sections and members are ignored.
+ *
+ * @param inputStream Stream containing the JSON scenario.
+ * @return ScenarioLoaderReturnType indicating whether the scenario was loaded, or the kind of error.
+ */
+ScenarioLoaderReturnType JsonScenarioLoader::load(std::istream &inputStream) {
+	JsonReader jsonReader(inputStream);
+	bool inputRead = false;
+	errorMessage.clear();
+	try {
+		std::string sectionName;
+		jsonReader.beginObject();
+		while (jsonReader.nextMember(sectionName)) {
+			currentSection = sectionName;
+			currentElementIndex = ULONG_MAX; // Not within an array element.
+			currentField.clear();
+			if (sectionName == "parameters") {
+				readParameters(jsonReader);
+			} else if (sectionName == "earthquakes") {
+				readEarthquakes(jsonReader);
+			} else if (sectionName == "sensors") {
+				readSensors(jsonReader);
+			} else if (sectionName == "nodes") {
+				readNodes(jsonReader);
+			} else if (sectionName == "links") {
+				readLinks(jsonReader);
+			} else {
+				jsonReader.skipValue();
+			}
+		}
+		if (!jsonReader.isAtEnd()) {
+			throw JsonReaderException("unexpected data after end of scenario", jsonReader.getLine(), jsonReader.getColumn());
+		}
+		inputRead = true;
+		resolveRoutes();
+		createLinks();
+	} catch (const JsonReaderException &exception) {
+		std::ostringstream message;
+		message << "line " << exception.getLine() << ", column " << exception.getColumn() << ": " << exception.what();
+		errorMessage = message.str();
+		return ScenarioLoaderReturnType::SYNTAX_ERROR;
+	} catch (const SchemaException &exception) {
+		std::ostringstream message;
+		message << exception.what();
+		if (!inputRead) {
+			message << " (line " << jsonReader.getLine() << ")";
+		}
+		errorMessage = message.str();
+		return ScenarioLoaderReturnType::SCHEMA_ERROR;
+	}
+	pendingLinks.clear();
+	pendingRoutes.clear();
+	return ScenarioLoaderReturnType::SCENARIO_LOADED;
+}
+
+/**
+ * @brief Get general parameters read from the scenario.
+ *
+ * @return Scenario parameters.
+ */
+const ScenarioParameters &JsonScenarioLoader::getScenarioParameters() const {
+	return scenarioParameters;
+}
+
+/**
+ * @brief Get earthquakes read from the scenario, in input order.
+ *
+ * @return Earthquakes.
+ */
+const std::vector<std::shared_ptr<EarthquakeData>> &JsonScenarioLoader::getEarthquakes() const {
+	return earthquakes;
+}
+
+/**
+ * @brief Get description of the last error.
+ *
+ * @return Error message; empty if the last load succeeded.
+ */
+std::string JsonScenarioLoader::getErrorMessage() const {
+	return errorMessage;
+}
+
+/**
+ * @brief Read the "parameters" object.
+ *
+ * @param jsonReader Reader positioned at the section value.
+ */
+void JsonScenarioLoader::readParameters(JsonReader &jsonReader) {
+	jsonReader.beginObject();
+	while (jsonReader.nextMember(currentField)) {
+		if (currentField == "simName") {
+			jsonReader.readScalar(scenarioParameters.simulationName);
+		} else if (currentField == "simDesc") {
+			jsonReader.readScalar(scenarioParameters.simulationDescription);
+		} else if (currentField == "initalClock" || currentField == "initialClock") { // The documented schema spells it "initalClock".
+			scenarioParameters.initialClock = readDouble(jsonReader);
+		} else if (currentField == "endClock") {
+			scenarioParameters.endClock = readDouble(jsonReader);
+		} else if (currentField == "printTraces") {
+			scenarioParameters.printTraces = readBool(jsonReader);
+		} else if (currentField == "startRecTime") {
+			scenarioParameters.startRecordingTime = readDouble(jsonReader);
+		} else {
+			jsonReader.skipValue();
+		}
+	}
+	currentField.clear();
+	if (scenarioParameters.endClock < scenarioParameters.initialClock) {
+		schemaError("endClock is before initalClock");
+	}
+}
+
+/**
+ * @brief Read the "earthquakes" array.
+ *
+ * @param jsonReader Reader positioned at the section value.
+ */
+void JsonScenarioLoader::readEarthquakes(JsonReader &jsonReader) {
+	jsonReader.beginArray();
+	for (currentElementIndex = 0; jsonReader.nextElement(); ++currentElementIndex) {
+		auto earthquake = std::make_shared<EarthquakeData>();
+		bool hasId = false;
+		bool hasLocation = false;
+		jsonReader.beginObject();
+		while (jsonReader.nextMember(currentField)) {
+			if (currentField == "ID") {
+				earthquake->earthquakeId = readUnsignedInt(jsonReader);
+				hasId = true;
+			} else if (currentField == "magnitude") {
+				earthquake->magnitude = readDouble(jsonReader);
+			} else if (currentField == "time") {
+				earthquake->eventTime = readDouble(jsonReader);
+			} else if (currentField == "swaveSpeed") {
+				earthquake->sWaveSpeed = readDouble(jsonReader);
+			} else if (currentField == "depth") {
+				earthquake->depth = readDouble(jsonReader);
+			} else if (currentField == "location") {
+				Location location = readLocation(jsonReader);
+				earthquake->latitude = location.latitude;
+				earthquake->longitude = location.longitude;
+				hasLocation = true;
+			} else {
+				jsonReader.skipValue();
+			}
+		}
+		currentField.clear();
+		if (!hasId) {
+			schemaError("missing required member \"ID\"");
+		}
+		if (!hasLocation) {
+			schemaError("missing required member \"location\"");
+		}
+		earthquakes.push_back(earthquake);
+	}
+}
+
+/**
+ * @brief Read the "sensors" array, creating one Node and one QcnSensorTrafficGenerator per sensor.
+ *
+ * @param jsonReader Reader positioned at the section value.
+ */
+void JsonScenarioLoader::readSensors(JsonReader &jsonReader) {
+	jsonReader.beginArray();
+	for (currentElementIndex = 0; jsonReader.nextElement(); ++currentElementIndex) {
+		unsigned int sensorId = 0;
+		bool hasId = false;
+		bool hasLocation = false;
+		Location location = { 0.0, 0.0 };
+		QcnSensorParameters sensorParameters;
+		PendingRoutes sensorRoutes;
+		jsonReader.beginObject();
+		while (jsonReader.nextMember(currentField)) {
+			if (currentField == "ID") {
+				sensorId = readUnsignedInt(jsonReader);
+				hasId = true;
+			} else if (currentField == "onFrac") {
+				sensorParameters.onFraction = readDouble(jsonReader);
+			} else if (currentField == "connFrac") {
+				sensorParameters.connectedFraction = readDouble(jsonReader);
+			} else if (currentField == "actFrac") {
+				sensorParameters.activeFraction = readDouble(jsonReader);
+			} else if (currentField == "flaseTrigRate" || currentField == "falseTrigRate") { // The documented schema spells it "flaseTrigRate".
+				sensorParameters.falseTriggerRate = readDouble(jsonReader);
+			} else if (currentField == "trigLowerBound") {
+				sensorParameters.triggerLowerBound = readDouble(jsonReader);
+			} else if (currentField == "trigUpperBound") {
+				sensorParameters.triggerUpperBound = readDouble(jsonReader);
+			} else if (currentField == "trigProb") {
+				sensorParameters.triggerProbability = readDouble(jsonReader);
+			} else if (currentField == "pduSize") {
+				sensorParameters.pduSize = readUnsignedInt(jsonReader);
+			} else if (currentField == "location") {
+				location = readLocation(jsonReader);
+				hasLocation = true;
+			} else if (currentField == "routes") {
+				jsonReader.beginArray();
+				while (jsonReader.nextElement()) {
+					sensorRoutes.routes.push_back(std::vector<unsigned int>());
+					jsonReader.beginArray();
+					while (jsonReader.nextElement()) {
+						sensorRoutes.routes.back().push_back(readUnsignedInt(jsonReader));
+					}
+				}
+			} else {
+				jsonReader.skipValue();
+			}
+		}
+		currentField.clear();
+		if (!hasId) {
+			schemaError("missing required member \"ID\"");
+		}
+		if (!hasLocation) {
+			schemaError("missing required member \"location\"");
+		}
+		if (sensorParameters.onFraction < 0.0 || sensorParameters.onFraction > 1.0 || sensorParameters.connectedFraction < 0.0 ||
+			sensorParameters.connectedFraction > 1.0 || sensorParameters.activeFraction < 0.0 || sensorParameters.activeFraction > 1.0 ||
+			sensorParameters.triggerProbability < 0.0 || sensorParameters.triggerProbability > 1.0) {
+			schemaError("onFrac, connFrac, actFrac and trigProb must be within [0, 1]");
+		}
+		if (sensorParameters.triggerUpperBound < sensorParameters.triggerLowerBound) {
+			schemaError("trigUpperBound is below trigLowerBound");
+		}
+		std::shared_ptr<Node> sensorNode = createNode(sensorId);
+		locationMap.emplace_hint(locationMap.end(), sensorId, location);
+		auto qcnSensorTrafficGenerator = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL,
+			nullptr, sensorNode, nullptr, 1, location.latitude, location.longitude, sensorId);
+		qcnSensorTrafficGenerator->setSensorParameters(sensorParameters);
+		qcnSensorTrafficGenerator->turnOn();
+		topology.qcnSensorTrafficGeneratorMap.emplace_hint(topology.qcnSensorTrafficGeneratorMap.end(), sensorId, qcnSensorTrafficGenerator);
+		if (!sensorRoutes.routes.empty()) {
+			sensorRoutes.sensorId = sensorId;
+			sensorRoutes.elementIndex = currentElementIndex;
+			pendingRoutes.push_back(std::move(sensorRoutes));
+		}
+	}
+}
+
+/**
+ * @brief Read the "nodes" array, creating one Node per entry.
+ *
+ * @param jsonReader Reader positioned at the section value.
+ */
+void JsonScenarioLoader::readNodes(JsonReader &jsonReader) {
+	jsonReader.beginArray();
+	for (currentElementIndex = 0; jsonReader.nextElement(); ++currentElementIndex) {
+		unsigned int nodeId = 0;
+		bool hasId = false;
+		bool hasLocation = false;
+		Location location = { 0.0, 0.0 };
+		jsonReader.beginObject();
+		while (jsonReader.nextMember(currentField)) {
+			if (currentField == "ID") {
+				nodeId = readUnsignedInt(jsonReader);
+				hasId = true;
+			} else if (currentField == "location") {
+				location = readLocation(jsonReader);
+				hasLocation = true;
+			} else {
+				jsonReader.skipValue();
+			}
+		}
+		currentField.clear();
+		if (!hasId) {
+			schemaError("missing required member \"ID\"");
+		}
+		if (!hasLocation) {
+			schemaError("missing required member \"location\"");
+		}
+		createNode(nodeId);
+		locationMap.emplace_hint(locationMap.end(), nodeId, location);
+	}
+}
+
+/**
+ * @brief Read the "links" array. Links are only created after all nodes are known (see createLinks()).
+ *
+ * @param jsonReader Reader positioned at the section value.
+ */
+void JsonScenarioLoader::readLinks(JsonReader &jsonReader) {
+	jsonReader.beginArray();
+	for (currentElementIndex = 0; jsonReader.nextElement(); ++currentElementIndex) {
+		PendingLink pendingLink = { 0, 0, 0, 0.0, SCENARIO_PROPAGATION_SPEED_WIRE, currentElementIndex };
+		bool hasId = false;
+		bool hasSource = false;
+		bool hasDestination = false;
+		bool hasBandwidth = false;
+		jsonReader.beginObject();
+		while (jsonReader.nextMember(currentField)) {
+			if (currentField == "ID") {
+				pendingLink.linkId = readUnsignedInt(jsonReader);
+				hasId = true;
+			} else if (currentField == "src") {
+				pendingLink.sourceId = readUnsignedInt(jsonReader);
+				hasSource = true;
+			} else if (currentField == "dest") {
+				pendingLink.destinationId = readUnsignedInt(jsonReader);
+				hasDestination = true;
+			} else if (currentField == "bandwidth") {
+				pendingLink.bandwidth = readDouble(jsonReader) * SCENARIO_LINK_BANDWIDTH_UNIT;
+				hasBandwidth = true;
+				if (pendingLink.bandwidth <= 0.0) {
+					schemaError("bandwidth must be positive");
+				}
+			} else if (currentField == "medium") {
+				jsonReader.readScalar(scratch);
+				if (scratch == "fiber") {
+					pendingLink.propagationSpeed = SCENARIO_PROPAGATION_SPEED_FIBER;
+				} else if (scratch == "wire") {
+					pendingLink.propagationSpeed = SCENARIO_PROPAGATION_SPEED_WIRE;
+				} else if (scratch == "wireless") {
+					pendingLink.propagationSpeed = SCENARIO_PROPAGATION_SPEED_WIRELESS;
+				} else {
+					schemaError("unknown medium \"" + scratch + "\" (expected \"fiber\", \"wire\" or \"wireless\")");
+				}
+			} else {
+				jsonReader.skipValue();
+			}
+		}
+		currentField.clear();
+		if (!hasId) {
+			schemaError("missing required member \"ID\"");
+		}
+		if (!hasSource) {
+			schemaError("missing required member \"src\"");
+		}
+		if (!hasDestination) {
+			schemaError("missing required member \"dest\"");
+		}
+		if (!hasBandwidth) {
+			schemaError("missing required member \"bandwidth\"");
+		}
+		pendingLinks.push_back(pendingLink);
+	}
+}
+
+/**
+ * @brief Read a "location" object (members "lat" and "lng").
+ *
+ * @param jsonReader Reader positioned at the location value.
+ * @return Location read.
+ */
+JsonScenarioLoader::Location JsonScenarioLoader::readLocation(JsonReader &jsonReader) {
+	Location location = { 0.0, 0.0 };
+	bool hasLatitude = false;
+	bool hasLongitude = false;
+	std::string name;
+	jsonReader.beginObject();
+	while (jsonReader.nextMember(name)) {
+		currentField = "location." + name;
+		if (name == "lat") {
+			location.latitude = readDouble(jsonReader);
+			hasLatitude = true;
+		} else if (name == "lng") {
+			location.longitude = readDouble(jsonReader);
+			hasLongitude = true;
+		} else {
+			jsonReader.skipValue();
+		}
+	}
+	currentField = "location";
+	if (!hasLatitude || !hasLongitude) {
+		schemaError("location requires members \"lat\" and \"lng\"");
+	}
+	if (location.latitude < -90.0 || location.latitude > 90.0 || location.longitude < -180.0 || location.longitude > 180.0) {
+		schemaError("latitude or longitude out of range");
+	}
+	return location;
+}
+
+/**
+ * @brief Resolve sensor routes (lists of node IDs) into explicit routes, and set the destination of each sensor traffic generator.
+ */
+void JsonScenarioLoader::resolveRoutes() {
+	currentSection = "sensors";
+	for (auto &sensorRoutes : pendingRoutes) {
+		currentElementIndex = sensorRoutes.elementIndex;
+		std::shared_ptr<Node> sensorNode = topology.nodeMap.at(sensorRoutes.sensorId);
+		for (std::vector<std::vector<unsigned int>>::size_type routeIndex = 0; routeIndex < sensorRoutes.routes.size(); ++routeIndex) {
+			const std::vector<unsigned int> &route = sensorRoutes.routes[routeIndex];
+			currentField = "routes[" + std::to_string(routeIndex) + "]";
+			if (route.empty()) {
+				schemaError("empty route");
+			}
+			std::vector<std::shared_ptr<Entity>> explicitRoute;
+			explicitRoute.reserve(route.size() + 1);
+			explicitRoute.push_back(sensorNode);
+			for (auto nodeId : route) {
+				auto nodeIterator = topology.nodeMap.find(nodeId);
+				if (nodeIterator == topology.nodeMap.end()) {
+					schemaError("unknown node ID " + std::to_string(nodeId));
+				}
+				explicitRoute.push_back(nodeIterator->second);
+			}
+			if (routeIndex == 0) {
+				topology.qcnSensorTrafficGeneratorMap.at(sensorRoutes.sensorId)->setDestination(explicitRoute.back());
+				topology.explicitRouteMap[sensorRoutes.sensorId] = std::move(explicitRoute);
+			} else {
+				topology.alternateRouteMap[sensorRoutes.sensorId].push_back(std::move(explicitRoute));
+			}
+		}
+	}
+	currentField.clear();
+}
+
+/**
+ * @brief Create the links read from input.
+ */
+void JsonScenarioLoader::createLinks() {
+	currentSection = "links";
+	currentField.clear();
+	for (auto &pendingLink : pendingLinks) {
+		currentElementIndex = pendingLink.elementIndex;
+		auto sourceIterator = topology.nodeMap.find(pendingLink.sourceId);
+		if (sourceIterator == topology.nodeMap.end()) {
+			currentField = "src";
+			schemaError("unknown node or sensor ID " + std::to_string(pendingLink.sourceId));
+		}
+		auto destinationIterator = topology.nodeMap.find(pendingLink.destinationId);
+		if (destinationIterator == topology.nodeMap.end()) {
+			currentField = "dest";
+			schemaError("unknown node or sensor ID " + std::to_string(pendingLink.destinationId));
+		}
+		auto linkHint = topology.linkMap.lower_bound(pendingLink.linkId);
+		if (linkHint != topology.linkMap.end() && linkHint->first == pendingLink.linkId) {
+			currentField = "ID";
+			schemaError("duplicate link ID " + std::to_string(pendingLink.linkId));
+		}
+		const Location &sourceLocation = locationMap.at(pendingLink.sourceId);
+		const Location &destinationLocation = locationMap.at(pendingLink.destinationId);
+		double propagationDelay = GeoUtilities::greatCircleDistance(sourceLocation.latitude, sourceLocation.longitude, destinationLocation.latitude,
+			destinationLocation.longitude) / pendingLink.propagationSpeed;
+		topology.linkMap.emplace_hint(linkHint, pendingLink.linkId, std::make_shared<Link>(sourceIterator->second, destinationIterator->second,
+			pendingLink.bandwidth, propagationDelay, simulatorGlobals, scheduler, std::to_string(pendingLink.linkId)));
+	}
+}
+
+/**
+ * @brief Create a node with the next dense node ID and insert it into the topology.
+ *
+ * @param id JSON ID of the node (or sensor); key within Topology::nodeMap.
+ * @return Created node.
+ */
+std::shared_ptr<Node> JsonScenarioLoader::createNode(unsigned int id) {
+	// Inputs are typically sorted by ID; the hint then makes insertion constant time.
+	auto nodeHint = topology.nodeMap.lower_bound(id);
+	if (nodeHint != topology.nodeMap.end() && nodeHint->first == id) {
+		currentField = "ID";
+		schemaError("duplicate node or sensor ID " + std::to_string(id));
+	}
+	auto node = std::make_shared<Node>(simulatorGlobals, nextNodeId++);
+	topology.nodeMap.emplace_hint(nodeHint, id, node);
+	return node;
+}
+
+/**
+ * @brief Read a number (given as a JSON number or string).
+ *
+ * @param jsonReader Reader positioned at the value.
+ * @return Number read.
+ */
+double JsonScenarioLoader::readDouble(JsonReader &jsonReader) {
+	jsonReader.readScalar(scratch);
+	char *end = nullptr;
+	double value = std::strtod(scratch.c_str(), &end);
+	if (scratch.empty() || *end != '\0' || !std::isfinite(value)) {
+		schemaError("expected a number, found \"" + scratch + "\"");
+	}
+	return value;
+}
+
+/**
+ * @brief Read a non-negative integer (given as a JSON number or string).
+ *
+ * @param jsonReader Reader positioned at the value.
+ * @return Integer read.
+ */
+unsigned int JsonScenarioLoader::readUnsignedInt(JsonReader &jsonReader) {
+	jsonReader.readScalar(scratch);
+	return parseUnsignedInt(scratch);
+}
+
+/**
+ * @brief Read a boolean (given as a JSON literal or string).
+ *
+ * @param jsonReader Reader positioned at the value.
+ * @return Boolean read.
+ */
+bool JsonScenarioLoader::readBool(JsonReader &jsonReader) {
+	jsonReader.readScalar(scratch);
+	if (scratch == "true") {
+		return true;
+	} else if (scratch != "false") {
+		schemaError("expected true or false, found \"" + scratch + "\"");
+	}
+	return false;
+}
+
+/**
+ * @brief Convert text to a non-negative integer.
+ *
+ * @param text Text to convert.
+ * @return Integer.
+ */
+unsigned int JsonScenarioLoader::parseUnsignedInt(const std::string &text) {
+	char *end = nullptr;
+	unsigned long value = std::strtoul(text.c_str(), &end, 10);
+	if (text.empty() || text[0] < '0' || text[0] > '9' || *end != '\0' || value > UINT_MAX) {
+		schemaError("expected a non-negative integer, found \"" + text + "\"");
+	}
+	return static_cast<unsigned int>(value);
+}
+
+/**
+ * @brief Throw a schema error for the element being processed.
+ *
+ * @details 
+ * The message is prefixed with the path to the element, e.g., "sensors[1042].location.lat".
+ *
+ * @param message Description of the error.
+ */
+void JsonScenarioLoader::schemaError(const std::string &message) const {
+	std::string path = currentSection;
+	if (currentElementIndex != ULONG_MAX) {
+		path += "[" + std::to_string(currentElementIndex) + "]";
+	}
+	if (!currentField.empty()) {
+		path += "." + currentField;
+	}
+	throw SchemaException(path + ": " + message);
+}
@@ -0,0 +1,144 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "JsonReader.h"
+#include "Topology.h"
+#include "EarthquakeData.h"
+#include "QcnSensorParameters.h"
+#include "ScenarioLoaderReturnType.h"
+#include "SimulatorGlobals.h"
+#include "Scheduler.h"
+#include <istream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define SCENARIO_LINK_BANDWIDTH_UNIT 1000000.0 //!< Link bandwidths in the scenario file are in Mbps.
+#define SCENARIO_PROPAGATION_SPEED_FIBER 200000.0 //!< Propagation speed in fiber, Km/s.
+#define SCENARIO_PROPAGATION_SPEED_WIRE 200000.0 //!< Propagation speed in copper wire, Km/s.
+#define SCENARIO_PROPAGATION_SPEED_WIRELESS 300000.0 //!< Propagation speed in air, Km/s.
+
+/**
+ * @brief Scenario Parameters.
+ *
+ * @par Description
+ * General simulation parameters, from the "parameters" section of the JSON scenario schema.
+ */
+struct ScenarioParameters {
+	std::string simulationName; //!< Simulation name.
+	std::string simulationDescription; //!< Simulation description.
+	double initialClock; //!< Initial simulation clock.
+	double endClock; //!< Simulation clock at which the simulation ends.
+	bool printTraces; //!< Whether traces should be printed.
+	double startRecordingTime; //!< Clock from which statistics should be recorded.
+
+	/// Default values.
+	ScenarioParameters(): initialClock(0.0), endClock(0.0), printTraces(false), startRecordingTime(0.0) {}
+};
+
+/**
+ * @brief JSON Scenario Loader class.
+ * 
+ * @par Description
+ * Reads a scenario in the JSON schema documented in doc/JSON parser/example.json and builds the simulation objects directly into a Topology:
+ * one Node per "nodes" entry and one per "sensors" entry (sensors are link endpoints), one QcnSensorTrafficGenerator per sensor, one simplex Link
+ * per "links" entry, and the explicit routes of each sensor. Earthquakes and general parameters are kept in the loader.
+ *
+ * The input is read with a streaming JsonReader: each sensor is turned into objects as soon as its JSON object ends, and no document tree is kept,
+ * such that scenarios with millions of sensors load in time and memory proportional to the objects created. Because sections may come in any order
+ * (e.g., sensors before the nodes their routes traverse), routes and links are resolved after the whole input has been read.
+ *
+ * Conventions:
+ * - Node keys in Topology::nodeMap, sensor keys in Topology::qcnSensorTrafficGeneratorMap, and link keys in Topology::linkMap are the JSON IDs.
+ * - Nodes are given dense node IDs (see Node::getNodeId()) in the order they are created.
+ * - Bandwidths are in Mbps. Propagation delays are computed from the great-circle distance between the link endpoints and the propagation speed in
+ *   the link medium ("fiber", "wire" or "wireless").
+ * - Each route is a list of node IDs, starting after the sensor; the sensor node is prepended to build the explicit route. The first route of a
+ *   sensor goes to Topology::explicitRouteMap (key is the sensor ID) and the others, in order, to Topology::alternateRouteMap. The destination of
+ *   the sensor traffic generator is the last node of its first route.
+ * - Values may be given as JSON strings (as in the documented example) or as JSON numbers. Unknown members are ignored.
+ *
+ * Errors are reported through ScenarioLoaderReturnType; getErrorMessage() then gives line and column for syntax errors, and the offending element
+ * (e.g., "sensors[1042].location.lat") for schema errors. On error, the topology may be partially filled.
+ */
+class JsonScenarioLoader {
+private:
+	/// Link read from input, to be created once all nodes are known.
+	struct PendingLink {
+		unsigned int linkId;
+		unsigned int sourceId;
+		unsigned int destinationId;
+		double bandwidth;
+		double propagationSpeed;
+		unsigned long elementIndex; //!< Index within the input section, for error messages.
+	};
+	/// Routes of a sensor read from input, to be resolved once all nodes are known.
+	struct PendingRoutes {
+		unsigned int sensorId;
+		std::vector<std::vector<unsigned int>> routes;
+		unsigned long elementIndex; //!< Index within the input section, for error messages.
+	};
+	/// Schema violation; converted into ScenarioLoaderReturnType::SCHEMA_ERROR by load().
+	class SchemaException: public std::runtime_error {
+	public:
+		explicit SchemaException(const std::string &message): std::runtime_error(message) {}
+	};
+	/// Location of a node or sensor, used to compute propagation delays.
+	struct Location {
+		double latitude;
+		double longitude;
+	};
+
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object, passed on to the created objects.
+	Scheduler &scheduler; //!< Reference to Scheduler object, passed on to the created objects.
+	Topology &topology; //!< Topology that receives the created objects.
+	ScenarioParameters scenarioParameters; //!< General parameters read from input.
+	std::vector<std::shared_ptr<EarthquakeData>> earthquakes; //!< Earthquakes read from input.
+	std::string errorMessage; //!< Description of the last error.
+	std::map<unsigned int, Location> locationMap; //!< Location of each node and sensor, by JSON ID.
+	std::vector<PendingLink> pendingLinks; //!< Links to be created.
+	std::vector<PendingRoutes> pendingRoutes; //!< Routes to be resolved.
+	unsigned int nextNodeId; //!< Next dense node ID to be assigned.
+	std::string currentSection; //!< Section being read (for error messages).
+	unsigned long currentElementIndex; //!< Index of the element being read within the section.
+	std::string currentField; //!< Member being read within the element (for error messages).
+	std::string scratch; //!< Scratch string for scalar values, reused to avoid allocations.
+
+	void readParameters(JsonReader &jsonReader);
+	void readEarthquakes(JsonReader &jsonReader);
+	void readSensors(JsonReader &jsonReader);
+	void readNodes(JsonReader &jsonReader);
+	void readLinks(JsonReader &jsonReader);
+	Location readLocation(JsonReader &jsonReader);
+	void resolveRoutes();
+	void createLinks();
+	std::shared_ptr<Node> createNode(unsigned int id);
+	double readDouble(JsonReader &jsonReader);
+	unsigned int readUnsignedInt(JsonReader &jsonReader);
+	bool readBool(JsonReader &jsonReader);
+	unsigned int parseUnsignedInt(const std::string &text);
+	void schemaError(const std::string &message) const;
+
+public:
+	JsonScenarioLoader(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, Topology &topology);
+
+	ScenarioLoaderReturnType load(const std::string &fileName);
+	ScenarioLoaderReturnType load(std::istream &inputStream);
+	const ScenarioParameters &getScenarioParameters() const;
+	const std::vector<std::shared_ptr<EarthquakeData>> &getEarthquakes() const;
+	std::string getErrorMessage() const;
+};
@@ -107,9 +107,14 @@ bool Link::isUp() const {
  *
  * @details  
  * Sets the underlying Facility up. Link's transmission server statistics and status are controlled by this facility.
+ * If the link was down, the registered LinkStateObserver objects are notified.
  */
 void Link::setUp() {
+	bool wasUp = isUp();
 	transmissionServer.setUp();
+	if (!wasUp) {
+		notifyLinkStateObservers(true);
+	}
 	if (linkType == LinkType::DUPLEX_LINK) {
 		getReverseLink()->setUp();
 	}
@@ -121,9 +126,44 @@ void Link::setUp() {
  * @details  
  * Sets the underlying Facility down. Link's transmission server statistics and status are controlled by this facility.
  * Drops both PDUs in transmission and PDUs in transit through link medium.
+ * If the link was up, the registered LinkStateObserver objects are notified.
  */
 unsigned int Link::setDown() {
-	return transmissionServer.setDown() + purgeInTransitQueue() + ((linkType == LinkType::DUPLEX_LINK) ? getReverseLink()->setDown() : 0);
+	bool wasUp = isUp();
+	unsigned int droppedPdus = transmissionServer.setDown() + purgeInTransitQueue();
+	if (wasUp) {
+		notifyLinkStateObservers(false);
+	}
+	return droppedPdus + ((linkType == LinkType::DUPLEX_LINK) ? getReverseLink()->setDown() : 0);
+}
+
+/**
+ * @brief Register an observer of topology changes (in both directions in case of duplex links).
+ *
+ * @details 
+ * The observer will be notified every time this link goes down or comes back up. Only a weak pointer is kept; observers that no longer
+ * exist are silently skipped.
+ *
+ * @param observer Observer to be notified, typically a routing table.
+ */
+void Link::addLinkStateObserver(std::shared_ptr<LinkStateObserver> observer) {
+	linkStateObservers.push_back(observer);
+	if (linkType == LinkType::DUPLEX_LINK) {
+		getReverseLink()->addLinkStateObserver(observer);
+	}
+}
+
+/**
+ * @brief Notify all registered observers that this link (this direction only) changed state.
+ *
+ * @param isUp True if the link has just come up; false if it has just gone down.
+ */
+void Link::notifyLinkStateObservers(bool isUp) const {
+	for (auto &observer : linkStateObservers) {
+		if (auto lockedObserver = observer.lock()) {
+			lockedObserver->linkStateChanged(*this, isUp);
+		}
+	}
 }
 
 /**
@@ -131,7 +171,7 @@ unsigned int Link::setDown() {
  *
  * @return inTransitQueue size.
  */
-unsigned int Link::getInTransitQueueSize() const {
+std::list<std::shared_ptr<const ProtocolDataUnit>>::size_type Link::getInTransitQueueSize() const {
 	return inTransitQueue.size();
 }
 
@@ -27,8 +27,11 @@
 #include "Facility.h"
 #include "LinkReturnType.h"
 #include "LinkType.h"
+#include "LinkStateObserver.h"
 #include <string>
 #include <list>
+#include <vector>
+#include <memory>
 
 /**
  * @brief Link class.
@@ -65,6 +68,9 @@
  * The functions that return statistics, such as dropped PDUs at medium or at transmission server, are constrained to one link direction only. Thus, to obtain the total
  * statistics for both directions of a link, call the statistics functions for each direction and then add the results. The statistics will never overlap (i.e., one PDU
  * dropped in one direction will never be added to statistics to the other direction).
+ *
+ * Topology changes are published to registered LinkStateObserver objects (e.g., routing tables): every time setDown() or setUp() effectively
+ * changes the state of the link, the observers are notified. Observers are held through weak pointers, thus the link does not keep them alive.
  */
 class Link: public Entity {
 private:
@@ -80,8 +86,10 @@ private:
 	unsigned int droppedPdusCountMedium; //!< Count of dropped PDUs by this link's medium.
 	LinkType linkType; //!< Type of link (typically Simplex or Duplex).
 	std::shared_ptr<Link> reverseLink; //!< Contains the pointer for the link in the reverse direction in case of Duplex links.
+	std::vector<std::weak_ptr<LinkStateObserver>> linkStateObservers; //!< Observers to be notified of topology changes (link down/up).
 
 	unsigned int purgeInTransitQueue();
+	void notifyLinkStateObservers(bool isUp) const;
 
 public:
 	Link(std::shared_ptr<Node> nodeA, std::shared_ptr<Node> nodeB, double bandwidth, double propagationDelay,
@@ -115,5 +123,7 @@ public:
 	virtual void setUp(); // Works for duplex links.
 	virtual unsigned int setDown(); // Works for duplex links.
 	virtual void setTransmissionQueueSizeLimit(unsigned int limit); // Works for duplex links.
+	virtual void addLinkStateObserver(std::shared_ptr<LinkStateObserver> observer); // Works for duplex links.
 
+	friend class SimulationCheckpoint; //!< Saves and restores in-transit queue and transmission server.
 };
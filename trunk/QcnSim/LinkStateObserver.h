@@ -0,0 +1,38 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+class Link;
+
+/**
+ * @brief Link State Observer class.
+ * 
+ * @par Description
+ * Abstract interface for objects that must react to topology changes, i.e., to a Link going down or coming back up.
+ * Observers are registered with Link::addLinkStateObserver(); the link calls linkStateChanged() whenever Link::setDown() or
+ * Link::setUp() effectively changes its state. Routing structures (forwarding tables, region route tables) implement this
+ * interface to update themselves incrementally, instead of having every traffic source rebuilt by the simulation driver.
+ */
+class LinkStateObserver {
+public:
+	virtual ~LinkStateObserver() {}
+
+	/**
+	 * @brief Notification of change of state of a link.
+	 *
+	 * @param link Link that changed state. For duplex links, each direction notifies separately.
+	 * @param isUp True if the link has just come up; false if it has just gone down.
+	 */
+	virtual void linkStateChanged(const Link &link, bool isUp) = 0;
+};
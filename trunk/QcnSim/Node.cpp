@@ -28,7 +28,22 @@
  * @param simulatorGlobals SimulatorGlobals object.
  */
 Node::Node(SimulatorGlobals &simulatorGlobals): receivedBytesCount(0), receivedPdusOrTokensCount(0), forwardedPdusOrTokensCount(0), forwardedBytesCount(0), droppedPdusOrTokensCount(0),
-		lastDelay(0.0), sumDelay(0.0), meanDelay(0.0), lastJitter(0.0), sumJitter(0.0), meanJitter(0.0), previousDelay(0.0), simulatorGlobals(simulatorGlobals) {
+		lastDelay(0.0), sumDelay(0.0), meanDelay(0.0), lastJitter(0.0), sumJitter(0.0), meanJitter(0.0), previousDelay(0.0), simulatorGlobals(simulatorGlobals),
+		nodeId(0), forwardingTable(nullptr) {
+}
+
+/**
+ * @brief Constructor with node ID.
+ *
+ * @details 
+ * Sets all member variables (statistics) to zero. The node ID must be dense and unique if this node is to be used with forwarding tables,
+ * since it is the index into the tables.
+ *
+ * @param simulatorGlobals SimulatorGlobals object.
+ * @param nodeId Dense, unique ID of this node.
+ */
+Node::Node(SimulatorGlobals &simulatorGlobals, unsigned int nodeId): Node(simulatorGlobals) {
+	this->nodeId = nodeId;
 }
 
 /**
@@ -133,6 +148,38 @@ double Node::getMeanPduOrTokenJitter() const {
 	return meanJitter;
 }
 
+/**
+ * @brief Get the node ID.
+ *
+ * @return Dense node ID.
+ */
+unsigned int Node::getNodeId() const {
+	return nodeId;
+}
+
+/**
+ * @brief Get the forwarding table attached to this node.
+ *
+ * @return Forwarding table, or nullptr if this node has none.
+ */
+std::shared_ptr<ForwardingTable> Node::getForwardingTable() const {
+	return forwardingTable;
+}
+
+/**
+ * @brief Attach a forwarding table to this node, for hop-by-hop routing.
+ *
+ * @details 
+ * The same table object may be attached to several nodes that have identical tables.
+ * Tokens/PDUs with an explicit route keep following it; the table is only consulted for tokens/PDUs without one.
+ * Attach nullptr to remove the table.
+ *
+ * @param forwardingTable Forwarding table.
+ */
+void Node::setForwardingTable(std::shared_ptr<ForwardingTable> forwardingTable) {
+	this->forwardingTable = forwardingTable;
+}
+
 /**
  * @brief Process the token by updating statistics and other procedures. Then, "forward" the token by changing its previous/next hops according to the attached route.
  *
@@ -165,8 +212,15 @@ NodeReturnType Node::processAndForward(std::shared_ptr<Token> token) {
 		// This is not the destination node. Forward the token to the next hop by modifying the appropriate token fields.
 		// Do not deal with TTL here; leave it for PDU types.
 		token->addHopToRecordedRoute(shared_from_this()); // need smart pointer of self reference here!
+		// An explicit route attached to the token takes precedence; otherwise, use the forwarding table, if any (hop-by-hop routing).
+		NodeReturnType routeUpdate = (!token->hasExplicitRoute() && forwardingTable != nullptr) ? updateForwardHopsFromForwardingTable(token) : updateForwardHops(token);
+		if (routeUpdate == NodeReturnType::ROUTE_NOT_FOUND) {
+			// No route (no forwarding table entry for this destination, or a malformed explicit route); the token cannot be forwarded and is dropped.
+			++droppedPdusOrTokensCount;
+			return NodeReturnType::ROUTE_NOT_FOUND;
+		}
 		// Sanity check; if the return type is not PDU_ROUTE_UPDATED, there is some inconsistency in the route table or unpredicted bug.
-		if (updateForwardHops(token) != NodeReturnType::PDU_ROUTE_UPDATED) {
+		if (routeUpdate != NodeReturnType::PDU_ROUTE_UPDATED) {
 			std::cout << "Node::processAndForward(token): Inconsistency in routing path. Aborting..." << std::endl;
 			exit(1);
 		}
@@ -215,8 +269,15 @@ NodeReturnType Node::processAndForward(std::shared_ptr<ProtocolDataUnit> pdu) {
 		// This is not the destination node. Forward the pdu to the next hop by modifying the appropriate pdu fields.
 		// Do not deal with TTL here; leave it for PDU types.
 		pdu->addHopToRecordedRoute(shared_from_this()); // need smart pointer of self reference here!
+		// An explicit route attached to the PDU takes precedence; otherwise, use the forwarding table, if any (hop-by-hop routing).
+		NodeReturnType routeUpdate = (!pdu->hasExplicitRoute() && forwardingTable != nullptr) ? updateForwardHopsFromForwardingTable(pdu) : updateForwardHops(pdu);
+		if (routeUpdate == NodeReturnType::ROUTE_NOT_FOUND) {
+			// No route (no forwarding table entry for this destination, or a malformed explicit route); the PDU cannot be forwarded and is dropped.
+			++droppedPdusOrTokensCount;
+			return NodeReturnType::ROUTE_NOT_FOUND;
+		}
 		// Sanity check; if the return type is not PDU_ROUTE_UPDATED, there is some inconsistency in the route table or unpredicted bug.
-		if (updateForwardHops(pdu) != NodeReturnType::PDU_ROUTE_UPDATED) {
+		if (routeUpdate != NodeReturnType::PDU_ROUTE_UPDATED) {
 			std::cout << "Node::processAndForward(PDU): Inconsistency in routing path. Aborting..." << std::endl;
 			exit(1);
 		}
@@ -306,17 +367,53 @@ void Node::updateForwardingStatistics(std::shared_ptr<ProtocolDataUnit> pdu) {
  *
  * This function should work for Token and ProtocolDataUnit class objects.
  *
- * @return NodeReturnType indicating whether the operation was successful, or not.
+ * @return NodeReturnType indicating whether the operation was successful, or not; ROUTE_NOT_FOUND if the explicit route does not lead
+ * away from this node.
  */
 NodeReturnType Node::updateForwardHops(std::shared_ptr<Token> token) {
 	// Sanity check: if next == destination, there is no forwarding to be done! The token has reached its destination.
 	if (token->next.get() == token->destination.get()) {
 		return NodeReturnType::FINAL_DESTINATION;
 	}
-	// Need to check whether next hop is the current hop.
-	token->updateHopsFromExplicitRoute(shared_from_this());
-	if (this == token->next.get()) { // Indicates that the route table begins with the source node, or there is some inconsistency...
-		updateForwardHops(token);  // Recursion. Really? Disaster?
+	// Need to check whether next hop is the current hop. If so, the route table begins with the source node (or there is some inconsistency);
+	// skip it and fetch the hop after. A malformed route may keep returning this node (e.g., it ends here, short of the destination): after
+	// as many skips as the route has hops, give up.
+	auto explicitRouteSize = token->getExplicitRouteSize();
+	decltype(explicitRouteSize) skippedHopsCount = 0;
+	do {
+		token->updateHopsFromExplicitRoute(shared_from_this());
+	} while (this == token->next.get() && skippedHopsCount++ < explicitRouteSize);
+	token->nextLink = nullptr; // Explicit routes name hops, not links.
+	if (this == token->next.get()) {
+		return NodeReturnType::ROUTE_NOT_FOUND;
+	}
+	return NodeReturnType::PDU_ROUTE_UPDATED;
+}
+
+/**
+ * @brief Update token's or PDU's hop fields to prepare it for forwarding, according to the forwarding table attached to this node.
+ *
+ * @details 
+ * The destination of the token must be a Node; its node ID is used as index into the forwarding table.
+ * Previous hop is set to this node, next hop to the one found in the table, and next link to the link of the entry (nullptr if not informed),
+ * such that the token keeps the link it leaves through even if the entry changes (e.g., is suspended) while the token is on its way. If there
+ * is no entry for the destination, the token fields are left untouched and ROUTE_NOT_FOUND is returned; the caller should then drop the token.
+ *
+ * This function should work for Token and ProtocolDataUnit class objects.
+ *
+ * @return NodeReturnType indicating whether the operation was successful, or not.
+ */
+NodeReturnType Node::updateForwardHopsFromForwardingTable(std::shared_ptr<Token> token) {
+	auto destinationNode = std::dynamic_pointer_cast<Node>(token->destination);
+	if (destinationNode == nullptr) {
+		return NodeReturnType::ROUTE_NOT_FOUND;
+	}
+	auto entry = forwardingTable->findEntry(destinationNode->getNodeId());
+	if (entry == nullptr) {
+		return NodeReturnType::ROUTE_NOT_FOUND;
 	}
+	token->previous = shared_from_this();
+	token->next = entry->nextHop;
+	token->nextLink = entry->nextLink;
 	return NodeReturnType::PDU_ROUTE_UPDATED;
 }
@@ -23,6 +23,7 @@
 #include "Token.h"
 #include "ProtocolDataUnit.h"
 #include "NodeReturnType.h"
+#include "ForwardingTable.h"
 #include <memory>
 #include <iostream>
 
@@ -47,6 +48,10 @@
  * current node) through which the PDU/token will be forwarded. Note that this "next link" is similar to the "next hop" information on typical
  * routing tables.
  * "Next link," "attached application server," "traffic generators" are all Entity objects.
+ *
+ * Routing is done either by an explicit route attached to the token/PDU (source routing), or hop-by-hop, through a ForwardingTable attached
+ * to the node. The explicit route, if present, always takes precedence. The forwarding table is indexed by the destination node ID, thus
+ * nodes that participate in hop-by-hop routing must be constructed with a dense, unique ID.
  */
 class Node: public Entity, public std::enable_shared_from_this<Node> {
 private:
@@ -63,15 +68,19 @@ private:
 	double meanJitter; //!< Mean jitter as measured for all PDUs received by this node.
 	double previousDelay; //!< Delay measured for previous PDU (the PDU before the current received one) received by this node. Necessary for jitter calculation.
 	SimulatorGlobals &simulatorGlobals;  //!< Reference to SimulatorGlobals object, to get clock time.
+	unsigned int nodeId; //!< Dense, unique ID of this node; used as index into forwarding tables.
+	std::shared_ptr<ForwardingTable> forwardingTable; //!< Forwarding table for hop-by-hop routing (possibly shared with other nodes). nullptr if none.
 
 	void updateArrivalStatistics(std::shared_ptr<Token> token);
 	void updateForwardingStatistics(std::shared_ptr<Token> token);
 	void updateArrivalStatistics(std::shared_ptr<ProtocolDataUnit> pdu);
 	void updateForwardingStatistics(std::shared_ptr<ProtocolDataUnit> pdu);
 	NodeReturnType updateForwardHops(std::shared_ptr<Token> token);
+	NodeReturnType updateForwardHopsFromForwardingTable(std::shared_ptr<Token> token);
 
 public:
 	explicit Node(SimulatorGlobals &simulatorGlobals);
+	Node(SimulatorGlobals &simulatorGlobals, unsigned int nodeId);
 
 	unsigned int getReceivedBytesCount() const;
 	unsigned int getReceivedPdusOrTokensCount() const;
@@ -84,8 +93,12 @@ public:
 	double getLastPduOrTokenJitter() const;
 	double getSumPduOrTokenJitter() const;
 	double getMeanPduOrTokenJitter() const;
+	unsigned int getNodeId() const;
+	std::shared_ptr<ForwardingTable> getForwardingTable() const;
+	void setForwardingTable(std::shared_ptr<ForwardingTable> forwardingTable);
 
 	NodeReturnType processAndForward(std::shared_ptr<Token> token);
 	NodeReturnType processAndForward(std::shared_ptr<ProtocolDataUnit> pdu);
 
+	friend class SimulationCheckpoint; //!< Saves and restores statistics.
 };
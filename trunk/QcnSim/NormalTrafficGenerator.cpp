@@ -52,7 +52,7 @@ NormalTrafficGenerator::NormalTrafficGenerator(SimulatorGlobals &simulatorGlobal
  * @param priority Token priority. Higher priority, higher number.
  * @param mean Mean of the normal distribution, or mu.
  * @param standardDeviation Standard deviation of the normal distribution, or sigma.
- * @param seed Seed to the default random number generator, to be passed to SimulatorGlobals object.
+ * @param seed Seed for the own random stream of this generator (see TrafficGenerator).
  */
 NormalTrafficGenerator::NormalTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, double mean, double standardDeviation, unsigned int seed): TrafficGenerator(simulatorGlobals, scheduler, eventType, tokenContents,
@@ -149,13 +149,13 @@ std::shared_ptr<Token> NormalTrafficGenerator::createInstanceTrafficEvent(std::s
  *
  * @details 
  * The Normal variate is generated using C++11 Random library and uses the random number generator obtained from SimulatorGlobals,
- * such that its global seed can be utilized.
+ * such that its global seed can be utilized, or the own random stream of this generator, if set (see TrafficGenerator::setRandomStream()).
  *
  * @return Normal distribution variate based on member variables mean and standardDeviation.
  */
 double NormalTrafficGenerator::generateNormalVariate() {
 	std::normal_distribution<double> normalGenerator(mean, standardDeviation);
-	return normalGenerator(simulatorGlobals.getRandomNumberGeneratorEngineInstance());
+	return generateVariate(normalGenerator);
 }
 
 /**
@@ -272,4 +272,22 @@ std::shared_ptr<ProtocolDataUnit> NormalTrafficGenerator::createInstanceTrafficE
 		scheduler.schedule(Event(generateNormalVariate(), eventType, pdu));
 	}
 	return pdu;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Generate the interval until the next arrival, for autonomous mode.
+ *
+ * @return Next Normal variate.
+ */
+double NormalTrafficGenerator::generateInterval() {
+	return generateNormalVariate();
+}
+
+/**
+ * @brief Return whether this generator can run in autonomous mode.
+ *
+ * @return True: intervals come from the Normal distribution.
+ */
+bool NormalTrafficGenerator::supportsAutonomousMode() const {
+	return true;
+}
@@ -36,6 +36,7 @@ private:
 	double mean;  //!< Mean of the normal distribution, or mu.
 	double standardDeviation;  //!< Standard deviation of the normal distribution, or sigma.
 	double generateNormalVariate();
+	double generateInterval() override;
 	
 public:
 	NormalTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
@@ -43,6 +44,7 @@ public:
 	NormalTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, double mean, double standardDeviation, unsigned int seed);
 
+	bool supportsAutonomousMode() const override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
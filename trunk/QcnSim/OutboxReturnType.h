@@ -0,0 +1,26 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+* @brief Outbox Return Type enum class.
+*
+* @par Description
+* Types of return from TrickleOutbox::submit().
+*/
+enum class OutboxReturnType {
+	PDU_SENT,					//!< Uplink is up and nothing is waiting in the outbox: the PDU was scheduled for transmission now.
+	PDU_STORED,					//!< Uplink is down, or older PDUs are waiting: the PDU was stored in the outbox, to be sent on a retry.
+	PDU_STORED_OLDEST_DROPPED	//!< The outbox was full: its oldest PDU was dropped to store this one.
+};
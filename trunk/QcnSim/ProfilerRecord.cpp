@@ -0,0 +1,223 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProfilerRecord.h"
+#include <fstream>
+#include <iomanip>
+
+/**
+ * @brief Constructor.
+ *
+ * @param sampleInterval Number of event chain sizes recorded between progress samples; the first one is always sampled.
+ */
+ProfilerRecord::ProfilerRecord(unsigned int sampleInterval): eventCounts(EVENT_TYPES_COUNT, 0), handlerNanoseconds(EVENT_TYPES_COUNT, 0),
+		popCount(0), popNanoseconds(0), insertCount(0), insertNanoseconds(0), maximumEventChainSize(0), eventChainSizeSum(0.0), eventChainSizeCount(0),
+		sampleInterval(sampleInterval > 0 ? sampleInterval : 1) {
+}
+
+/**
+ * @brief Count an event handled, with the time of its handler.
+ *
+ * @param eventType Type of the event.
+ * @param nanoseconds Time of the handler.
+ */
+void ProfilerRecord::addHandlerTime(EventType eventType, int64_t nanoseconds) {
+	++eventCounts[static_cast<std::size_t>(eventType)];
+	handlerNanoseconds[static_cast<std::size_t>(eventType)] += nanoseconds;
+}
+
+/**
+ * @brief Count an event popped from the scheduler, with the time of the pop.
+ *
+ * @param nanoseconds Time of the pop.
+ */
+void ProfilerRecord::addPopTime(int64_t nanoseconds) {
+	++popCount;
+	popNanoseconds += nanoseconds;
+}
+
+/**
+ * @brief Count an event inserted into the scheduler, with the time of the insert.
+ *
+ * @param nanoseconds Time of the insert.
+ */
+void ProfilerRecord::addInsertTime(int64_t nanoseconds) {
+	++insertCount;
+	insertNanoseconds += nanoseconds;
+}
+
+/**
+ * @brief Record the event chain size; every sampleInterval calls, a progress sample is taken as well.
+ *
+ * @param wallclockNanoseconds Wallclock time since the start of the run.
+ * @param simulatedTime Simulated (absolute) time.
+ * @param eventChainSize Number of events pending in the scheduler.
+ */
+void ProfilerRecord::recordEventChainSize(int64_t wallclockNanoseconds, double simulatedTime, std::size_t eventChainSize) {
+	if (eventChainSize > maximumEventChainSize) {
+		maximumEventChainSize = eventChainSize;
+	}
+	eventChainSizeSum += static_cast<double>(eventChainSize);
+	if (eventChainSizeCount++ % sampleInterval == 0) {
+		ProgressSample progressSample = { wallclockNanoseconds, simulatedTime, eventChainSize };
+		progressSamples.push_back(progressSample);
+	}
+}
+
+/**
+ * @brief Write a text report: events and handler times per EventType, scheduler operations and event chain size.
+ *
+ * @param outputStream Stream to write to.
+ */
+void ProfilerRecord::writeReport(std::ostream &outputStream) const {
+	int64_t totalNanoseconds = popNanoseconds + insertNanoseconds;
+	for (auto nanoseconds : handlerNanoseconds) {
+		totalNanoseconds += nanoseconds;
+	}
+	std::ios::fmtflags flags = outputStream.flags();
+	std::streamsize precision = outputStream.precision();
+	outputStream << std::fixed;
+	outputStream << "Profile" << std::endl;
+	outputStream << "-------" << std::endl << std::endl;
+	outputStream << std::left << std::setw(48) << "Event type" << std::right << std::setw(12) << "Events" << std::setw(14) << "Total (ms)"
+		<< std::setw(12) << "Mean (ns)" << std::setw(8) << "%" << std::endl;
+	for (std::size_t typeIndex = 0; typeIndex < EVENT_TYPES_COUNT; ++typeIndex) {
+		if (eventCounts[typeIndex] == 0) {
+			continue;
+		}
+		outputStream << std::left << std::setw(48) << getEventTypeName(static_cast<EventType>(typeIndex)) << std::right << std::setw(12) << eventCounts[typeIndex]
+			<< std::setw(14) << std::setprecision(3) << handlerNanoseconds[typeIndex] / 1e6
+			<< std::setw(12) << std::setprecision(1) << static_cast<double>(handlerNanoseconds[typeIndex]) / eventCounts[typeIndex]
+			<< std::setw(8) << (totalNanoseconds > 0 ? 100.0 * handlerNanoseconds[typeIndex] / totalNanoseconds : 0.0) << std::endl;
+	}
+	outputStream << std::left << std::setw(48) << "Scheduler pop" << std::right << std::setw(12) << popCount
+		<< std::setw(14) << std::setprecision(3) << popNanoseconds / 1e6
+		<< std::setw(12) << std::setprecision(1) << (popCount > 0 ? static_cast<double>(popNanoseconds) / popCount : 0.0)
+		<< std::setw(8) << (totalNanoseconds > 0 ? 100.0 * popNanoseconds / totalNanoseconds : 0.0) << std::endl;
+	outputStream << std::left << std::setw(48) << "Scheduler insert (by driver)" << std::right << std::setw(12) << insertCount
+		<< std::setw(14) << std::setprecision(3) << insertNanoseconds / 1e6
+		<< std::setw(12) << std::setprecision(1) << (insertCount > 0 ? static_cast<double>(insertNanoseconds) / insertCount : 0.0)
+		<< std::setw(8) << (totalNanoseconds > 0 ? 100.0 * insertNanoseconds / totalNanoseconds : 0.0) << std::endl << std::endl;
+	outputStream << "Maximum event chain size: " << maximumEventChainSize << std::endl;
+	outputStream << "Mean event chain size:    " << std::setprecision(1) << getMeanEventChainSize() << std::endl;
+	outputStream.flags(flags);
+	outputStream.precision(precision);
+}
+
+/**
+ * @brief Write the progress samples as a Chrome trace-event JSON file, with counters of simulated time and event chain size.
+ *
+ * @param fileName Name of the file.
+ * @return True if written; false if the file could not be written.
+ */
+bool ProfilerRecord::writeChromeTrace(const std::string &fileName) const {
+	std::ofstream traceFile(fileName);
+	if (!traceFile) {
+		return false;
+	}
+	traceFile << "{\"traceEvents\":[" << std::endl;
+	bool isFirst = true;
+	for (auto &progressSample : progressSamples) {
+		// Timestamps of trace events are in microseconds.
+		double timestamp = progressSample.wallclockNanoseconds / 1e3;
+		traceFile << (isFirst ? "" : ",\n") << std::setprecision(15)
+			<< "{\"name\":\"Simulated time\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":" << timestamp << ",\"args\":{\"seconds\":" << progressSample.simulatedTime << "}},\n"
+			<< "{\"name\":\"Event chain size\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":" << timestamp << ",\"args\":{\"events\":" << progressSample.eventChainSize << "}}";
+		isFirst = false;
+	}
+	traceFile << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+	return static_cast<bool>(traceFile);
+}
+
+/**
+ * @brief Number of events handled of a type.
+ *
+ * @param eventType Type of the events.
+ * @return Number of events.
+ */
+uint64_t ProfilerRecord::getEventCount(EventType eventType) const {
+	return eventCounts[static_cast<std::size_t>(eventType)];
+}
+
+/**
+ * @brief Total time of the handlers of a type.
+ *
+ * @param eventType Type of the events.
+ * @return Time, in nanoseconds.
+ */
+int64_t ProfilerRecord::getHandlerNanoseconds(EventType eventType) const {
+	return handlerNanoseconds[static_cast<std::size_t>(eventType)];
+}
+
+/**
+ * @brief Number of events popped from the scheduler.
+ *
+ * @return Number of pops.
+ */
+uint64_t ProfilerRecord::getPopCount() const {
+	return popCount;
+}
+
+/**
+ * @brief Total time of the pops.
+ *
+ * @return Time, in nanoseconds.
+ */
+int64_t ProfilerRecord::getPopNanoseconds() const {
+	return popNanoseconds;
+}
+
+/**
+ * @brief Number of events inserted into the scheduler by the driver.
+ *
+ * @return Number of inserts.
+ */
+uint64_t ProfilerRecord::getInsertCount() const {
+	return insertCount;
+}
+
+/**
+ * @brief Total time of the inserts.
+ *
+ * @return Time, in nanoseconds.
+ */
+int64_t ProfilerRecord::getInsertNanoseconds() const {
+	return insertNanoseconds;
+}
+
+/**
+ * @brief Largest event chain size recorded.
+ *
+ * @return Number of events.
+ */
+std::size_t ProfilerRecord::getMaximumEventChainSize() const {
+	return maximumEventChainSize;
+}
+
+/**
+ * @brief Mean of the event chain sizes recorded.
+ *
+ * @return Mean number of events; zero if none recorded.
+ */
+double ProfilerRecord::getMeanEventChainSize() const {
+	return eventChainSizeCount > 0 ? eventChainSizeSum / eventChainSizeCount : 0.0;
+}
+
+/**
+ * @brief Progress samples, in wallclock order.
+ *
+ * @return Reference to the samples.
+ */
+const std::vector<ProfilerRecord::ProgressSample> &ProfilerRecord::getProgressSamples() const {
+	return progressSamples;
+}
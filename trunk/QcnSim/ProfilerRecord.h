@@ -0,0 +1,75 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "EventType.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define PROFILER_SAMPLE_INTERVAL 1000 //!< Default number of events between progress samples (simulated time, wallclock and event chain size).
+
+/**
+ * @brief Profiler Record class.
+ * 
+ * @par Description
+ * Measurements of a profiled simulation run (see SimulationProfiler): number of events and handler time per EventType, number and time of
+ * the scheduler operations timed by the driver (pops and inserts), event chain size, and samples of the simulation progress, i.e., simulated
+ * time against wallclock time. Times are in nanoseconds of std::chrono::steady_clock.
+ *
+ * The record is written as a text report (writeReport()) and as a Chrome trace-event JSON file (writeChromeTrace()), which chrome://tracing
+ * or Perfetto show as counters of simulated time and event chain size along the wallclock time of the run.
+ */
+class ProfilerRecord {
+public:
+	/// Progress of the simulation at some point of the run.
+	struct ProgressSample {
+		int64_t wallclockNanoseconds; //!< Wallclock time since the start of the run.
+		double simulatedTime; //!< Simulated (absolute) time.
+		std::size_t eventChainSize; //!< Number of events pending in the scheduler.
+	};
+
+private:
+	std::vector<uint64_t> eventCounts; //!< Number of events handled, by EventType.
+	std::vector<int64_t> handlerNanoseconds; //!< Total time of the handlers, by EventType.
+	uint64_t popCount; //!< Number of events popped from the scheduler.
+	int64_t popNanoseconds; //!< Total time of the pops.
+	uint64_t insertCount; //!< Number of events inserted into the scheduler by the driver.
+	int64_t insertNanoseconds; //!< Total time of the inserts.
+	std::size_t maximumEventChainSize; //!< Largest event chain size recorded.
+	double eventChainSizeSum; //!< Sum of the event chain sizes recorded, for the mean.
+	uint64_t eventChainSizeCount; //!< Number of event chain sizes recorded.
+	unsigned int sampleInterval; //!< Number of event chain sizes recorded between progress samples.
+	std::vector<ProgressSample> progressSamples; //!< Progress samples, in wallclock order.
+
+public:
+	ProfilerRecord(unsigned int sampleInterval = PROFILER_SAMPLE_INTERVAL);
+
+	void addHandlerTime(EventType eventType, int64_t nanoseconds);
+	void addPopTime(int64_t nanoseconds);
+	void addInsertTime(int64_t nanoseconds);
+	void recordEventChainSize(int64_t wallclockNanoseconds, double simulatedTime, std::size_t eventChainSize);
+	void writeReport(std::ostream &outputStream) const;
+	bool writeChromeTrace(const std::string &fileName) const;
+	uint64_t getEventCount(EventType eventType) const;
+	int64_t getHandlerNanoseconds(EventType eventType) const;
+	uint64_t getPopCount() const;
+	int64_t getPopNanoseconds() const;
+	uint64_t getInsertCount() const;
+	int64_t getInsertNanoseconds() const;
+	std::size_t getMaximumEventChainSize() const;
+	double getMeanEventChainSize() const;
+	const std::vector<ProgressSample> &getProgressSamples() const;
+};
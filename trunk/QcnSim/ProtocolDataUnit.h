@@ -60,4 +60,5 @@ public:
 	///	Comparator
 	//friend bool ProtocolDataUnit::operator==(const ProtocolDataUnit &left, const ProtocolDataUnit &right);
 
+	friend class SimulationCheckpoint; //!< Saves and restores PDUs in flight.
 };					
\ No newline at end of file
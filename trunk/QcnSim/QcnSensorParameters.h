@@ -0,0 +1,36 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+ * @brief QCN Sensor Parameters.
+ *
+ * @par Description
+ * Behavioral parameters of a QCN sensor (host availability, triggering), as defined in the "sensors" section of the JSON scenario schema.
+ * They are carried by QcnSensorTrafficGenerator objects for use by availability and detection models.
+ */
+struct QcnSensorParameters {
+	double onFraction; //!< Fraction of time the host computer is on.
+	double connectedFraction; //!< Fraction of time the host is connected to the network, when on.
+	double activeFraction; //!< Fraction of time the QCN client is active, when the host is on.
+	double falseTriggerRate; //!< Rate of false triggers (noise), in triggers per unit of time.
+	double triggerLowerBound; //!< Lower bound of the ground acceleration range in which the sensor may trigger.
+	double triggerUpperBound; //!< Upper bound of the ground acceleration range in which the sensor may trigger.
+	double triggerProbability; //!< Probability of triggering within the bounds above.
+	unsigned int pduSize; //!< Size of the PDU sent upon trigger; 0 means the simulation default.
+
+	/// Default values: always available, never false-triggers, always triggers, default PDU size.
+	QcnSensorParameters(): onFraction(1.0), connectedFraction(1.0), activeFraction(1.0), falseTriggerRate(0.0), triggerLowerBound(0.0),
+		triggerUpperBound(0.0), triggerProbability(1.0), pduSize(0) {}
+};
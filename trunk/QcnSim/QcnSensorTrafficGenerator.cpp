@@ -169,6 +169,15 @@ unsigned int QcnSensorTrafficGenerator::getRegionId() const {
 	return regionId;
 }
 
+/**
+ * @brief Get sensor parameters (availability, triggering).
+ *
+ * @return Sensor parameters.
+ */
+const QcnSensorParameters &QcnSensorTrafficGenerator::getSensorParameters() const {
+	return sensorParameters;
+}
+
 /**
  * @brief Set Latitude.
  *
@@ -205,6 +214,15 @@ void QcnSensorTrafficGenerator::setRegionId(unsigned int regionId) {
 	this->regionId = regionId;
 }
 
+/**
+ * @brief Set sensor parameters (availability, triggering).
+ *
+ * @param sensorParameters Sensor parameters.
+ */
+void QcnSensorTrafficGenerator::setSensorParameters(const QcnSensorParameters &sensorParameters) {
+	this->sensorParameters = sensorParameters;
+}
+
 /**
  * @brief Creates an instance of QCN sensor traffic event with PDU.
  *
@@ -314,3 +332,36 @@ std::shared_ptr<ProtocolDataUnit> QcnSensorTrafficGenerator::createInstanceTraff
 	}
 	return pdu;
 }
+
+/**
+ * @brief Creates an instance of QCN sensor traffic event, routed through the active route of this sensor's region.
+ *
+ * @details  
+ * The instance is scheduled to occur immediately, i.e., at 0.0 delay.
+ * Source, destination and explicit route of the PDU are taken from the route of this sensor in the region route table, i.e., the active route
+ * of regionId, or its split route if the sensor is in the split share (by qcnExplorerSensorId), and not from this generator's source and destination.
+ * Throws std::out_of_range if the region has no routes in the table.
+ *
+ * @param pduSize Size of PDU to generate.
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param regionRouteTable Region route table from which the route is obtained.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ *
+ * @return PDU that was generated, per the class constructor parameters and if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> QcnSensorTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents,
+																						   const RegionRouteTable &regionRouteTable, bool recordRoute) {
+	const RegionRoute &regionRoute = regionRouteTable.getActiveRoute(regionId, qcnExplorerSensorId);
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(tokenContents, regionRoute.explicitRoute, recordRoute);
+	if (token == nullptr) {
+		return nullptr;
+	}
+	// Tokens are generated with previous = next = source to facilitate Node forwarding; here, the source is the region's ingress node.
+	token->source = regionRoute.source;
+	token->destination = regionRoute.destination;
+	token->previous = regionRoute.source;
+	token->next = regionRoute.source;
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(token, pduSize));
+	scheduler.schedule(Event(0.0, eventType, pdu));
+	return pdu;
+}
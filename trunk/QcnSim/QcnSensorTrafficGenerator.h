@@ -22,6 +22,8 @@
 #include "TrafficGenerator.h"
 #include "EventType.h"
 #include "ProtocolDataUnit.h"
+#include "RegionRouteTable.h"
+#include "QcnSensorParameters.h"
 #include <memory>
 
 /**
@@ -31,6 +33,9 @@
 * This class implements a Quake-Catcher Network Sensor Traffic Generator.
 * Basically, a simulated sensor will be triggered by a seismic event, and then the sensor will produce a PDU to be sent to a
 * BOINC server. This PDU may contain information such as time of observed event, magnitude, and other sensor-related information.*
+*
+* The sensor may be routed through its region only (see RegionRouteTable): the PDU then takes source, destination and explicit route from
+* the region's active route (or split route) at generation time, such that rerouting a region does not require modifying its sensors.
 */
 class QcnSensorTrafficGenerator: public TrafficGenerator {
 private:
@@ -38,6 +43,7 @@ private:
 	double longitude; //!< Longitude of this sensor.
 	unsigned int qcnExplorerSensorId; //!< Sensor ID as assigned by QCNExplorer.
 	unsigned int regionId; //!< Region ID as assigned by QCNExplorer.
+	QcnSensorParameters sensorParameters; //!< Availability and triggering parameters of this sensor.
 
 public:
 	QcnSensorTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
@@ -52,13 +58,16 @@ public:
 	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
 	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
 	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, const RegionRouteTable &regionRouteTable, bool recordRoute = false);
 	
 	double getLatitude() const;
 	double getLongitude() const;
 	unsigned int getQcnExplorerSensorId() const;
 	unsigned int getRegionId() const;
+	const QcnSensorParameters &getSensorParameters() const;
 	void setLatitude(double latitude);
 	void setLongitude(double longitude);
 	void setQcnExplorerSensorId(unsigned int qcnExplorerSensorId);
 	void setRegionId(unsigned int regionId);
+	void setSensorParameters(const QcnSensorParameters &sensorParameters);
 };
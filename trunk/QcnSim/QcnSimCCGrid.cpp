@@ -27,8 +27,7 @@
 #include "QcnSimCCGrid.h"
 
 // A few constants...
-#define INPUT_FILENAME "..\\Release\\map C high (4 regions) no failure 1.csv"
-#define OUTPUT_FILENAME std::string(INPUT_FILENAME) + "-output.csv"
+#define INPUT_FILENAME "map C high (4 regions) no failure 1.csv" // Scenario file used if none is given in the command line (relative to the working directory).
 #define PDU_SIZE 512 // PDU size for PDUs.
 #define BANDWIDTH_REGION_A 8700000 // 7 Mbps.
 #define PROPAGATION_REGION_A 0.03 // 30 ms.
@@ -61,7 +60,17 @@
 #define LINK_FAILURE false // If true, link will be set down at time LINK_DOWN_TIME after first QCN traffic arrival.
 #define REROUTE_TRAFFIC_TIME 1.0 // Route will be rerouted after this time after first traffic arrival.
 #define REROUTE_TRAFFIC false // If true, then traffic will be rerouted accordingn to LINK_DOWN
-#define PRINT_TRACE false
+#define REROUTE_ON_LINK_FAILURE false // If true, regions fail over to their backup route as soon as a link of their active route goes down.
+#define DETECTION_TRIGGERS 4 // Triggers within DETECTION_RADIUS and DETECTION_WINDOW that declare an earthquake detection at the BOINC servers.
+#define DETECTION_RADIUS_KM 100.0 // Association radius, in Km.
+#define DETECTION_WINDOW 10.0 // Association time window, in seconds.
+#define HOST_AVAILABILITY false // If true, sensor triggers are dropped or buffered according to the availability of their hosts.
+#define FUSE_ZERO_DELAY_EVENTS true // If true, zero-delay continuations of PDU events (propagation end, arrival, transmission request) are handled directly when they would be the next event anyway.
+#define VERIFY_FUSION false // If true, fused continuations are still scheduled, and the scheduler verifies that each one is the next event (debug).
+#define STORE_AND_FORWARD false // If true, triggers leaving their region while its uplink is down wait in the outbox of their sensor, instead of being dropped.
+#define PROFILE_SIMULATION false // If true, events and handler times are profiled, and the report written at the end (compiled out if false).
+#define TRACE_EVENTS false // If true, a binary trace of the events is written to <input>-trace.bin (see EventTracer; decode with QcnTraceDecoder).
+#define PRINT_TRACE false // If true, the setup steps are printed.
 
 /**
  * @brief Finds and returns a link pointer form a map of links, given the nodeB.
@@ -82,6 +91,10 @@ std::shared_ptr<Link> findLinkByNodeB(std::map<unsigned int, std::shared_ptr<Lin
 
 /**
  * @brief Main simulation function.
+ *
+ * @details 
+ * Usage: qcnsim [<scenario file>]. The scenario file lists the sensor triggers (CSV, as exported by qcnexplorer); if omitted, INPUT_FILENAME
+ * is used. Output files are written next to the scenario file, with the suffixes -output.csv, -detections.csv and -statistics.csv.
  */
 int main(int argc, char *argv[]) {
 	std::ofstream outputFile; // Output file handle
@@ -92,10 +105,19 @@ int main(int argc, char *argv[]) {
 	std::map<unsigned int, std::shared_ptr<Node>> nodeMap;
 	std::map<unsigned int, std::shared_ptr<Link>> linkMap;
 	std::map<unsigned int, std::vector<std::shared_ptr<Entity>>> explicitRouteMap;
+	std::shared_ptr<RegionRouteTable> regionRouteTable = std::make_shared<RegionRouteTable>(); // Region-level indirection between sensors and routes.
+	const unsigned int regionIds[] = { REGION_A_ID, REGION_B_ID, REGION_C_ID, REGION_D_ID }; // Regions with real sensors (not the fake one).
 	std::shared_ptr<Link> link(nullptr);
-	std::uniform_int_distribution<int> uniformVariate(0,1); // 50% probability generator.
 	
+	const std::string inputFileName = argc > 1 ? argv[1] : INPUT_FILENAME; // Scenario file, from the command line if given.
 	bool simulationEnded = false; // Indicates whether the simulation has ended.
+	bool isFused = false; // Indicates whether currentEvent is a fused continuation, to handle without fetching the next event.
+	EventType tracedEventType = EventType::BEGIN_SIMULATION; // Type of the event being handled, for the trace (currentEvent may be fused meanwhile).
+	TraceEntityKind tracedEntityKind = TraceEntityKind::NO_ENTITY; // Kind of the entity handling the event (node or sensor), for the trace.
+	uint32_t tracedEntityId = EVENT_TRACE_NO_ENTITY; // ID of the node (or sensor) handling the event, for the trace.
+	TraceOutcome traceOutcome = TraceOutcome::HANDLED; // Outcome of the event being handled, for the trace.
+	const Node *tracedNode = nullptr; // Node handling the event, for the trace.
+	TriggerDisposition triggerDisposition = TriggerDisposition::DELIVER; // Disposition of a sensor trigger by the availability of its host.
 	Event currentEvent;
 	bool rerouteTrafficEventFulfilled = false; // Indicates whether this event was already fulfilled.
 	bool setLinkDownEventFulfilled = false; // Indicates whether this event was already fulfilled.
@@ -106,6 +128,19 @@ int main(int argc, char *argv[]) {
 	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "CCGrid 2014 - Map C, no failure.");
 	// Scheduler.
 	Scheduler scheduler(simulatorGlobals);
+	scheduler.setFusion(FUSE_ZERO_DELAY_EVENTS, VERIFY_FUSION);
+	// Profiler of the main loop; without PROFILE_SIMULATION, it is just the scheduler.
+	SimulationProfiler<std::conditional<PROFILE_SIMULATION, ProfilingEnabled, ProfilingDisabled>::type> profiler(simulatorGlobals, scheduler);
+	// Detection at the BOINC servers, from the triggers delivered.
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, DETECTION_TRIGGERS, DETECTION_RADIUS_KM, DETECTION_WINDOW);
+	std::ofstream detectionsFile; // Detections output file.
+	std::shared_ptr<const DetectionData> detectionData(nullptr);
+	// Churn of the volunteer hosts of the sensors, if HOST_AVAILABILITY is set.
+	std::unique_ptr<HostAvailabilityModel> hostAvailabilityModel(HOST_AVAILABILITY ? new HostAvailabilityModel(simulatorGlobals, scheduler) : nullptr);
+	// Outboxes of the sensors, for triggers sent while disconnected, if STORE_AND_FORWARD is set.
+	std::unique_ptr<TrickleOutbox> trickleOutbox(STORE_AND_FORWARD ? new TrickleOutbox(simulatorGlobals, scheduler) : nullptr);
+	// Binary trace of the events, if TRACE_EVENTS is set.
+	EventTracer eventTracer;
 
 	// Create 4 nodes, one for each region ID. Insert into node Map. Key is Region ID or Region Source Node.
 	if (PRINT_TRACE) {
@@ -193,11 +228,30 @@ int main(int argc, char *argv[]) {
 	if (PRINT_TRACE) {
 		std::cout << linkMap.size() << " links created." << std::endl;
 	}
+
+	// Create region routes. Each region has its own route as primary and the fake region route as backup. Sensors only know their region ID;
+	// rerouting a region is done here, in the region route table, and not in each sensor traffic generator.
+	for (auto regionId : regionIds) {
+		regionRouteTable->addRoute(regionId, nodeMap.at(regionId), nodeMap.at(regionId * 10), explicitRouteMap.at(regionId),
+			std::vector<std::shared_ptr<Link>>({ linkMap.at(regionId * 10) }));
+		regionRouteTable->addRoute(regionId, nodeMap.at(REGION_FAKE_SOURCE), nodeMap.at(REGION_FAKE_DESTINATION), explicitRouteMap.at(REGION_FAKE_ID),
+			std::vector<std::shared_ptr<Link>>({ linkMap.at(REGION_FAKE_DESTINATION) }));
+	}
+	regionRouteTable->addRoute(REGION_FAKE_ID, nodeMap.at(REGION_FAKE_SOURCE), nodeMap.at(REGION_FAKE_DESTINATION), explicitRouteMap.at(REGION_FAKE_ID),
+		std::vector<std::shared_ptr<Link>>({ linkMap.at(REGION_FAKE_DESTINATION) }));
+	// Let the region route table follow link failures. Register once per link object (several map keys share the same link).
+	if (REROUTE_ON_LINK_FAILURE) {
+		linkMap.at(REGION_A_DESTINATION)->addLinkStateObserver(regionRouteTable);
+		linkMap.at(REGION_FAKE_DESTINATION)->addLinkStateObserver(regionRouteTable);
+	}
 			
 	// Create seismic events, put them into event chain, and create QCN sensor traffic generators from the unique qcnExplorerSensorIds.
 	// Open file for input.
-	//inputFile.open(INPUT_FILENAME, std::ios::in);
-	inputFile.open(argv[1], std::ios::in);  // Using command line argument.
+	inputFile.open(inputFileName, std::ios::in);
+	if (!inputFile.is_open()) {
+		std::cout << "Could not open scenario file " << inputFileName << ".\nUsage: " << argv[0] << " [<scenario file>]" << std::endl;
+		return 1;
+	}
 
 	// Now read all file. Discard line if it begins with string "ID", meaning this is the header
 	if (PRINT_TRACE) {
@@ -222,11 +276,22 @@ int main(int argc, char *argv[]) {
 		std::cout << scheduler.getChainSize() << " seismic events entered into event chain.\n" << qcnSensorTrafficGeneratorMap.size() <<
 			" QCN sensor traffic generators created." << std::endl;
 	}
+	if (hostAvailabilityModel != nullptr) {
+		for (auto &sensorPair : qcnSensorTrafficGeneratorMap) {
+			hostAvailabilityModel->addSensor(sensorPair.second);
+		}
+		hostAvailabilityModel->start();
+	}
 	inputFile.close();
 
 	// Prepare output file for collecting general statistics.
-	outputFile.open(std::string(argv[1]) + "-output.csv");
+	outputFile.open(inputFileName + "-output.csv");
 	outputFile << "link,ID,lat,lng,mag,obsvTime,hypoCentDist,regionID,deliverTime" << std::endl; // Write the header.
+	detectionsFile.open(inputFileName + "-detections.csv");
+	detectionsFile << "detectionID,lat,lng,firstTrigTime,detectTime,detectLatency,meanDeliverLatency,numTrigs" << std::endl;
+	if (TRACE_EVENTS && eventTracer.start(inputFileName + "-trace.bin") != TraceReturnType::TRACE_OPENED) {
+		std::cout << "Could not open trace file." << std::endl;
+	}
 
 	// Schedule end of simulation.
 	scheduler.schedule(Event(MAX_SIMULATION_TIME, EventType::END_SIMULATION, nullptr));
@@ -236,45 +301,67 @@ int main(int argc, char *argv[]) {
 		std::cout << "Beginning simulation..." << std::endl;
 	}
 	while (!simulationEnded) {
-		currentEvent = scheduler.cause(); // Fetch next event from scheduler.
-		//pduFromEventEntity = std::dynamic_pointer_cast<const ProtocolDataUnit>(currentEvent.entity); // Entity from event converted to PDU.
-		pduFromEventEntityNonConst = std::dynamic_pointer_cast<ProtocolDataUnit>(std::const_pointer_cast<Entity>(currentEvent.entity)); // Same PDU as above, but non-const.
+		// A fused continuation is handled right away; it has the same entity (PDU) as the event just handled.
+		if (!isFused) {
+			currentEvent = profiler.cause(); // Fetch next event from scheduler.
+			//pduFromEventEntity = std::dynamic_pointer_cast<const ProtocolDataUnit>(currentEvent.entity); // Entity from event converted to PDU.
+			pduFromEventEntityNonConst = currentEvent.getEntityAs<ProtocolDataUnit>(); // Same PDU as above, but non-const.
+		}
+		isFused = false;
+		profiler.beginHandler(currentEvent.eventType);
+		tracedEventType = currentEvent.eventType;
+		traceOutcome = TraceOutcome::HANDLED;
+		tracedEntityKind = TraceEntityKind::NO_ENTITY;
+		tracedEntityId = EVENT_TRACE_NO_ENTITY;
+		if (eventTracer.isRecording() && pduFromEventEntityNonConst != nullptr) {
+			tracedNode = dynamic_cast<const Node *>(pduFromEventEntityNonConst->next.get());
+			if (tracedNode != nullptr) {
+				tracedEntityKind = TraceEntityKind::NODE;
+				tracedEntityId = tracedNode->getNodeId();
+			}
+		}
 		
 		// Now decide what to do.
 		switch (currentEvent.eventType) {
 			case EventType::REROUTE_QCN_TRAFFIC:
 				// This event is only scheduled if macro REROUTE_TRAFFIC is true.
-				// Flag is set, and then traffic arrivals will be directly modified.
-				// Test here if traffic is to be forcibly rerouted. Use 50% probability. If true, modify seismic data region ID and source/destination nodes.
-				for (auto qcnSensorTrafficGeneratorIterator : qcnSensorTrafficGeneratorMap) {
-					if (uniformVariate(simulatorGlobals.getRandomNumberGeneratorEngineInstance()) == 1) {
-						// Change qcn sensor generator with 50% probability.
-						qcnSensorTrafficGeneratorIterator.second->setSource(nodeMap.at(REGION_FAKE_SOURCE));
-						qcnSensorTrafficGeneratorIterator.second->setDestination(nodeMap.at(REGION_FAKE_DESTINATION));
-						qcnSensorTrafficGeneratorIterator.second->setRegionId(REGION_FAKE_ID);
-					}
+				// Forcibly reroute traffic: split each real region, such that each sensor follows the fake route (index 1) with 50% probability.
+				// Only the region entries change; the sensors take their route from the region route table at the next detection.
+				for (auto regionId : regionIds) {
+					regionRouteTable->setSplitRoute(regionId, 1, 0.5, simulatorGlobals.getRandomNumberGeneratorEngineInstance()());
 				}
 				break;
 
+			case EventType::EARTHQUAKE_DETECTION:
+				detectionData = currentEvent.getEntityAs<const DetectionData>();
+				detectionsFile << detectionData->detectionId << ",";
+				detectionsFile << std::setprecision(10) << detectionData->latitude << ",";
+				detectionsFile << std::setprecision(10) << detectionData->longitude << ",";
+				detectionsFile << std::setprecision(10) << detectionData->firstTriggerTime << ",";
+				detectionsFile << std::setprecision(10) << detectionData->detectionTime << ",";
+				detectionsFile << std::setprecision(10) << detectionData->getDetectionLatency() << ",";
+				detectionsFile << std::setprecision(10) << detectionData->meanDeliveryLatency << ",";
+				detectionsFile << detectionData->triggers.size() << std::endl;
+				break;
+
+			case EventType::HOST_AVAILABILITY_TRANSITION:
+				hostAvailabilityModel->processTransition();
+				break;
+
+			case EventType::TRICKLE_RETRY:
+				trickleOutbox->processRetries();
+				break;
+
 			case EventType::END_SIMULATION:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::END_SIMULATION" << std::endl;
-				}
 				simulationEnded = true;
 				break;
 
 			case EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK" << std::endl;
-				}
 				// End link transmission here and schedule end of propagation.
 				findLinkByNodeB(linkMap, std::dynamic_pointer_cast<Node>(pduFromEventEntityNonConst->next))->propagatePdu(EventType::END_PROPAGATION_AT_LINK, pduFromEventEntityNonConst);
 				break;
 
 			case EventType::PDUTOKEN_ARRIVAL_AT_NODE:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::PDUTOKEN_ARRIVAL_AT_NODE" << std::endl;
-				}
 				// Ends propagation. If this node is just the source node, return will be nullptr, do nothing.
 				link = findLinkByNodeB(linkMap, std::dynamic_pointer_cast<Node>(pduFromEventEntityNonConst->next));
 				if (link != nullptr) {
@@ -285,16 +372,21 @@ int main(int argc, char *argv[]) {
 				// Now forward the PDU to the next hop. Test, however, if this is the destination node, in which case output data to a file.
 				if (std::dynamic_pointer_cast<Node>(pduFromEventEntityNonConst->next)->processAndForward(pduFromEventEntityNonConst) != NodeReturnType::FINAL_DESTINATION) {
 					// Not final destination. Schedule transmission event.
-					if (PRINT_TRACE) {
-						std::cout << "EventType::PDUTOKEN_ARRIVAL_AT_NODE: not final destination." << std::endl;
+					traceOutcome = TraceOutcome::FORWARDED;
+					if (trickleOutbox != nullptr && pduFromEventEntityNonConst->previous == pduFromEventEntityNonConst->source) {
+						// Leaving the region meta-node: the sensor sends now, or keeps the trigger in its outbox until the uplink is up.
+						seismicEventData = std::dynamic_pointer_cast<SeismicEventData>(pduFromEventEntityNonConst->associatedEntity);
+						if (trickleOutbox->submit(seismicEventData->qcnExplorerSensorId, pduFromEventEntityNonConst,
+								findLinkByNodeB(linkMap, std::dynamic_pointer_cast<Node>(pduFromEventEntityNonConst->next))) != OutboxReturnType::PDU_SENT) {
+							traceOutcome = TraceOutcome::STORED;
+						}
+					} else {
+						isFused = scheduler.scheduleOrFuse(currentEvent, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK);
 					}
-					scheduler.schedule(Event(0.0, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, pduFromEventEntityNonConst));
 				} else {
 					// It is the final destination. Output received data to file.
 					// Or deliver it to some Facility modeling a BOINC server.
-					if (PRINT_TRACE) {
-						std::cout << "EventType::PDUTOKEN_ARRIVAL_AT_NODE: final destination." << std::endl;
-					}
+					traceOutcome = TraceOutcome::DELIVERED;
 					seismicEventData = std::dynamic_pointer_cast<SeismicEventData>(pduFromEventEntityNonConst->associatedEntity);
 					// Comment out the next line after debugging.
 					outputFile << findLinkByNodeB(linkMap, std::dynamic_pointer_cast<Node>(pduFromEventEntityNonConst->next))->getName() << ","; // For debug purposes only.
@@ -306,41 +398,38 @@ int main(int argc, char *argv[]) {
 					outputFile << std::setprecision(10) << seismicEventData->distance << ",";
 					outputFile << seismicEventData->regionId << ",";
 					outputFile << std::setprecision(10) << simulatorGlobals.getCurrentAbsoluteTime() << std::endl; // Timestamp of delivery at destination.
+					detectionEngine.ingest(seismicEventData); // Detection, if declared, comes as an EARTHQUAKE_DETECTION event.
 				}
 				break;
 
 			case EventType::REQUEST_PDU_TRANSMISSION_AT_LINK:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::REQUEST_PDU_TRANSMISSION_AT_LINK" << std::endl;
-				}
 				// Decide which link to use based on next field of PDU.
 				findLinkByNodeB(linkMap, std::dynamic_pointer_cast<Node>(pduFromEventEntityNonConst->next))->transmitPdu(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK,
 																												 EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK, pduFromEventEntityNonConst);
 				break;
 
 			case EventType::SEISMIC_EVENT_DETECTION:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::SEISMIC_EVENT_DETECTION" << std::endl;
-				}
 				// When creating traffic instance, attach tokenContents (seismicEventData) and explicitRoute.
 				// QCN sensor ID will the the key for the map. Upon seismic event, trigger message to send to BOINC server at destination.
-				seismicEventData = std::dynamic_pointer_cast<SeismicEventData>(std::const_pointer_cast<Entity>(currentEvent.entity)); // Get seismic event data.
-				qcnSensorTrafficGeneratorMap.at(seismicEventData->qcnExplorerSensorId)->createInstanceTrafficEventPdu(PDU_SIZE, seismicEventData,
-					  explicitRouteMap.at(qcnSensorTrafficGeneratorMap.at(seismicEventData->qcnExplorerSensorId)->getRegionId()));				
+				seismicEventData = currentEvent.getEntityAs<SeismicEventData>(); // Get seismic event data.
+				tracedEntityKind = TraceEntityKind::SENSOR;
+				tracedEntityId = seismicEventData->qcnExplorerSensorId;
+				// Hosts off or inactive miss the event; disconnected hosts send it when they connect again (as a new SEISMIC_EVENT_DETECTION).
+				triggerDisposition = hostAvailabilityModel != nullptr ? hostAvailabilityModel->filterTrigger(seismicEventData) : TriggerDisposition::DELIVER;
+				if (triggerDisposition != TriggerDisposition::DELIVER) {
+					traceOutcome = triggerDisposition == TriggerDisposition::BUFFER ? TraceOutcome::STORED : TraceOutcome::DROPPED;
+					break;
+				}
+				// Source, destination and route come from the active route of the sensor's region.
+				qcnSensorTrafficGeneratorMap.at(seismicEventData->qcnExplorerSensorId)->createInstanceTrafficEventPdu(PDU_SIZE, seismicEventData, *regionRouteTable);
 				break;
 
 			case EventType::SET_LINK_DOWN:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::SET_LINK_DOWN" << std::endl;
-				}
-				// Set some link down here at specific time.
-				linkMap.at(REGION_A_DESTINATION)->setDown();
+				// Set the link carried by the event down.
+				linkMap.at(currentEvent.linkId)->setDown();
 				break;
 
 			case EventType::TRAFFIC_GENERATOR_ARRIVAL:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::TRAFFIC_GENERATOR_ARRIVAL" << std::endl;
-				}
 				// Arrival from traffic generator.
 				// Actually, all operations here can be handled by PDUTOKEN_ARRIVAL_AT_NODE. Just schedule this as next event and pass PDU.
 				// If desired, insert additional random propagation latency here, by scheduling PDUTOKEN_ARRIVAL_AT_NODE with the additional delay.
@@ -354,17 +443,14 @@ int main(int argc, char *argv[]) {
 				}
 				// Schedule link down event if macro is set. Only once!
 				if (LINK_FAILURE && !setLinkDownEventFulfilled) {
-					scheduler.schedule(Event(LINK_DOWN_TIME, EventType::SET_LINK_DOWN, nullptr));
+					scheduler.schedule(Event::createLinkEvent(LINK_DOWN_TIME, EventType::SET_LINK_DOWN, REGION_A_DESTINATION));
 					setLinkDownEventFulfilled = true; // Avoid doing this scheduling again.
 				}
 				break;
 
 			case EventType::END_PROPAGATION_AT_LINK:
-				if (PRINT_TRACE) {
-					std::cout << "EventType::END_PROPAGATION_AT_LINK" << std::endl;
-				}
-				// Ends propagation. Just deliver the PDU to the node by scheduling the next event.
-				scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pduFromEventEntityNonConst));
+				// Ends propagation. Just deliver the PDU to the node by scheduling the next event (or handling it now, if fused).
+				isFused = scheduler.scheduleOrFuse(currentEvent, EventType::PDUTOKEN_ARRIVAL_AT_NODE);
 				break;
 
 			default:
@@ -372,13 +458,22 @@ int main(int argc, char *argv[]) {
 				std::cout << "Error in Main switch-case!" << std::endl;
 				return 1;
 		} // End switch-case.
+		profiler.endHandler();
+		eventTracer.record(simulatorGlobals.getCurrentAbsoluteTime(), tracedEventType, tracedEntityKind, tracedEntityId,
+			pduFromEventEntityNonConst != nullptr ? pduFromEventEntityNonConst->id : 0, isFused && traceOutcome == TraceOutcome::HANDLED ? TraceOutcome::FUSED : traceOutcome);
 	} // End while.
+	eventTracer.stop();
+
+	// Profile of the run, if PROFILE_SIMULATION is set.
+	profiler.writeReport(std::cout);
+	profiler.writeChromeTrace(inputFileName + "-profile.json");
 
-	// Close output file for BOINC servers.
+	// Close output files for BOINC servers.
 	outputFile.close();
+	detectionsFile.close();
 
 	// Now print or record additional statistics here if desired.
-	outputFile.open(std::string(argv[1]) + "-statistics.csv");
+	outputFile.open(inputFileName + "-statistics.csv");
 
 	outputFile << "Statistics" << std::endl;
 	outputFile << "----------" << std::endl << std::endl;
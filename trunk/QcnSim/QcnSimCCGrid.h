@@ -34,10 +34,17 @@
 #include "SeismicEventData.h"
 #include "Link.h"
 #include "Node.h"
+#include "RegionRouteTable.h"
+#include "DetectionEngine.h"
+#include "HostAvailabilityModel.h"
+#include "TrickleOutbox.h"
+#include "SimulationProfiler.h"
+#include "EventTracer.h"
 #include <sstream>
 #include <fstream>
 #include <memory>
 #include <iostream>
 #include <map>
 #include <iomanip>
+#include <type_traits>
 //#include <vector>
\ No newline at end of file
@@ -0,0 +1,362 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "QuakeWaveModel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+/**
+ * @brief Constructor.
+ *
+ * @param simulatorGlobals SimulatorGlobals object, for the current time and the random stream.
+ * @param streamId ID of the random stream from which triggers are drawn (see SimulatorGlobals::createRandomStream()).
+ */
+QuakeWaveModel::QuakeWaveModel(SimulatorGlobals &simulatorGlobals, unsigned int streamId): simulatorGlobals(simulatorGlobals),
+		randomStream(simulatorGlobals.createRandomStream(streamId)), attenuationConstant(QUAKE_ATTENUATION_CONSTANT),
+		attenuationMagnitude(QUAKE_ATTENUATION_MAGNITUDE), attenuationDistance(QUAKE_ATTENUATION_DISTANCE),
+		attenuationNearField(QUAKE_ATTENUATION_NEAR_FIELD), wavefrontStep(QUAKE_WAVEFRONT_STEP),
+		minimumTriggerLowerBound(std::numeric_limits<double>::infinity()) {
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param earthquake Copy of the earthquake.
+ * @param sweep Sweep of the sensors from the hypocenter.
+ * @param eventType Type of the trigger events.
+ */
+QuakeWaveModel::Wavefront::Wavefront(std::shared_ptr<EarthquakeData> earthquake, SensorSpatialIndex::Sweep sweep, EventType eventType):
+		earthquake(std::move(earthquake)), sweep(std::move(sweep)), sWaveSlowness(0.0), logAccelerationAtSource(0.0), cutoffDistance(0.0),
+		eventType(eventType) {
+}
+
+/**
+ * @brief Add a sensor to the model.
+ *
+ * @details 
+ * Location and QcnSensorParameters of the sensor are copied into the arrays of the model.
+ *
+ * @param sensor Sensor to add.
+ */
+void QuakeWaveModel::addSensor(std::shared_ptr<QcnSensorTrafficGenerator> sensor) {
+	double coordinates[3];
+	GeoUtilities::toUnitVector(sensor->getLatitude(), sensor->getLongitude(), coordinates);
+	unitX.push_back(coordinates[0]);
+	unitY.push_back(coordinates[1]);
+	unitZ.push_back(coordinates[2]);
+	triggerLowerBounds.push_back(sensor->getSensorParameters().triggerLowerBound);
+	triggerUpperBounds.push_back(sensor->getSensorParameters().triggerUpperBound);
+	sensorTriggerProbabilities.push_back(sensor->getSensorParameters().triggerProbability);
+	minimumTriggerLowerBound = std::min(minimumTriggerLowerBound, sensor->getSensorParameters().triggerLowerBound);
+	sensorSpatialIndex.add(sensor->getLatitude(), sensor->getLongitude(), sensor);
+	sensors.push_back(std::move(sensor));
+}
+
+/**
+ * @brief Add all QCN sensors of a topology to the model, in map order.
+ *
+ * @param topology Topology whose qcnSensorTrafficGeneratorMap is added.
+ */
+void QuakeWaveModel::addSensors(const Topology &topology) {
+	sensors.reserve(sensors.size() + topology.qcnSensorTrafficGeneratorMap.size());
+	for (auto &sensorPair : topology.qcnSensorTrafficGeneratorMap) {
+		addSensor(sensorPair.second);
+	}
+}
+
+/**
+ * @brief Get number of sensors in the model.
+ *
+ * @return Number of sensors.
+ */
+std::vector<std::shared_ptr<QcnSensorTrafficGenerator>>::size_type QuakeWaveModel::getNumberOfSensors() const {
+	return sensors.size();
+}
+
+/**
+ * @brief Set the coefficients of the attenuation relation log10(PGA) = c0 + c1 * M - c2 * log10(d + c3).
+ *
+ * @param constant c0.
+ * @param magnitude c1, scaling of the magnitude M.
+ * @param distance c2, geometric spreading over the hypocentral distance d.
+ * @param nearField c3, in Km; saturates the acceleration near the hypocenter.
+ */
+void QuakeWaveModel::setAttenuation(double constant, double magnitude, double distance, double nearField) {
+	attenuationConstant = constant;
+	attenuationMagnitude = magnitude;
+	attenuationDistance = distance;
+	attenuationNearField = nearField;
+}
+
+/**
+ * @brief Set the span of S-wave arrival times whose triggers scheduleTriggers() and advanceWavefront() schedule per batch.
+ *
+ * @param step Span, in seconds, positive; shorter steps keep fewer pending events, at the cost of more QUAKE_WAVEFRONT_ADVANCE events.
+ */
+void QuakeWaveModel::setWavefrontStep(double step) {
+	wavefrontStep = step;
+}
+
+/**
+ * @brief Compute distances, arrival times, peak accelerations and trigger probabilities of all sensors for an earthquake.
+ *
+ * @details 
+ * With the epicenter e and the sensor s as unit vectors, the straight-line distance between the sensor, at the surface, and the hypocenter,
+ * at depth h, is sqrt(h^2 + R * (R - h) * |s - e|^2), where R is EARTH_RADIUS. The squared chord |s - e|^2 is a sum of squared differences,
+ * accurate at short distances, and the loops below have no branches, so that the compiler vectorizes them.
+ * Results are read with getHypocentralDistances(), getPWaveArrivalTimes(), getSWaveArrivalTimes(), getPeakAccelerations() and
+ * getTriggerProbabilities(), by sensor index.
+ *
+ * @param earthquake Earthquake to evaluate.
+ */
+void QuakeWaveModel::evaluate(const EarthquakeData &earthquake) {
+	double epicenter[3];
+	GeoUtilities::toUnitVector(earthquake.latitude, earthquake.longitude, epicenter);
+	const double epicenterX = epicenter[0];
+	const double epicenterY = epicenter[1];
+	const double epicenterZ = epicenter[2];
+	const double depthSquared = earthquake.depth * earthquake.depth;
+	const double radiusProduct = EARTH_RADIUS * (EARTH_RADIUS - earthquake.depth);
+	const double sWaveSpeed = earthquake.sWaveSpeed > 0.0 ? earthquake.sWaveSpeed : QUAKE_DEFAULT_S_WAVE_SPEED;
+	const double sWaveSlowness = 1.0 / sWaveSpeed;
+	const double pWaveSlowness = 1.0 / (sWaveSpeed * QUAKE_P_TO_S_WAVE_SPEED_RATIO);
+	const double eventTime = earthquake.eventTime;
+	const double logAccelerationAtSource = (attenuationConstant + attenuationMagnitude * earthquake.magnitude) * std::log(10.0);
+	const double spreading = attenuationDistance;
+	const double nearField = attenuationNearField;
+	const std::vector<double>::size_type numberOfSensors = sensors.size();
+
+	hypocentralDistances.resize(numberOfSensors);
+	pWaveArrivalTimes.resize(numberOfSensors);
+	sWaveArrivalTimes.resize(numberOfSensors);
+	peakAccelerations.resize(numberOfSensors);
+	triggerProbabilities.resize(numberOfSensors);
+	const double *x = unitX.data();
+	const double *y = unitY.data();
+	const double *z = unitZ.data();
+	const double *lowerBound = triggerLowerBounds.data();
+	const double *upperBound = triggerUpperBounds.data();
+	const double *sensorProbability = sensorTriggerProbabilities.data();
+	double *distance = hypocentralDistances.data();
+	double *pWaveArrival = pWaveArrivalTimes.data();
+	double *sWaveArrival = sWaveArrivalTimes.data();
+	double *acceleration = peakAccelerations.data();
+	double *probability = triggerProbabilities.data();
+
+	for (std::vector<double>::size_type i = 0; i < numberOfSensors; ++i) {
+		double deltaX = x[i] - epicenterX;
+		double deltaY = y[i] - epicenterY;
+		double deltaZ = z[i] - epicenterZ;
+		distance[i] = std::sqrt(depthSquared + radiusProduct * (deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ));
+		pWaveArrival[i] = eventTime + distance[i] * pWaveSlowness;
+		sWaveArrival[i] = eventTime + distance[i] * sWaveSlowness;
+	}
+	for (std::vector<double>::size_type i = 0; i < numberOfSensors; ++i) {
+		acceleration[i] = std::exp(logAccelerationAtSource - spreading * std::log(distance[i] + nearField));
+	}
+	for (std::vector<double>::size_type i = 0; i < numberOfSensors; ++i) {
+		double saturated = (acceleration[i] >= upperBound[i] && upperBound[i] > lowerBound[i]) ? 1.0 : sensorProbability[i];
+		probability[i] = acceleration[i] < lowerBound[i] ? 0.0 : saturated;
+	}
+}
+
+/**
+ * @brief Start the wavefront of an earthquake: a sweep of the sensors from its hypocenter, and the constants of its attenuation.
+ *
+ * @details 
+ * The acceleration decreases with the distance (for a positive c2), thus no sensor beyond the distance at which it falls below the lowest
+ * trigger lower bound of all sensors can trigger; the cutoff is widened by a relative tolerance, such that rounding never drops a sensor.
+ *
+ * @param earthquake Earthquake whose wavefront starts.
+ * @param eventType Type of the trigger events.
+ * @return Wavefront, before the nearest sensor.
+ */
+QuakeWaveModel::Wavefront QuakeWaveModel::startWavefront(const EarthquakeData &earthquake, EventType eventType) {
+	Wavefront wavefront(std::make_shared<EarthquakeData>(earthquake), sensorSpatialIndex.sweep(earthquake.latitude, earthquake.longitude,
+		earthquake.depth), eventType);
+	wavefront.sWaveSlowness = 1.0 / (earthquake.sWaveSpeed > 0.0 ? earthquake.sWaveSpeed : QUAKE_DEFAULT_S_WAVE_SPEED);
+	wavefront.logAccelerationAtSource = (attenuationConstant + attenuationMagnitude * earthquake.magnitude) * std::log(10.0);
+	wavefront.cutoffDistance = std::numeric_limits<double>::infinity();
+	if (attenuationDistance > 0.0 && minimumTriggerLowerBound > 0.0) {
+		wavefront.cutoffDistance = (std::exp((wavefront.logAccelerationAtSource - std::log(minimumTriggerLowerBound)) / attenuationDistance) -
+			attenuationNearField) * (1.0 + 1e-9) + 1e-9;
+	}
+	return wavefront;
+}
+
+/**
+ * @brief Advance a wavefront up to a time, and draw which of the sensors reached trigger.
+ *
+ * @details 
+ * Sensors come from the sweep in increasing distance; each one within the cutoff distance draws one uniform variate from the own random
+ * stream, whatever its probability, such that the triggers of a sensor do not depend on the probabilities of the others. The distance is
+ * the one of the sweep, thus event times never decrease; acceleration and probability are computed as in evaluate().
+ *
+ * @param wavefront Wavefront to advance.
+ * @param horizon Absolute time; sensors whose S-wave arrives later are left for the next advance.
+ * @param triggers Vector to which the seismic event data of the triggered sensors are appended, in S-wave arrival order.
+ */
+void QuakeWaveModel::sweepTriggers(Wavefront &wavefront, double horizon, std::vector<std::shared_ptr<SeismicEventData>> &triggers) {
+	const EarthquakeData &earthquake = *wavefront.earthquake;
+	const double maximumDistance = std::min(wavefront.cutoffDistance, (horizon - earthquake.eventTime) / wavefront.sWaveSlowness);
+	std::uniform_real_distribution<double> uniformDistribution(0.0, 1.0);
+	while (wavefront.sweep.hasNext() && wavefront.sweep.getNextDistance() <= maximumDistance) {
+		double distance = wavefront.sweep.getNextDistance();
+		std::vector<std::shared_ptr<QcnSensorTrafficGenerator>>::size_type i = wavefront.sweep.getNextAddedIndex();
+		wavefront.sweep.next();
+		double acceleration = std::exp(wavefront.logAccelerationAtSource - attenuationDistance * std::log(distance + attenuationNearField));
+		double saturated = (acceleration >= triggerUpperBounds[i] && triggerUpperBounds[i] > triggerLowerBounds[i]) ? 1.0 : sensorTriggerProbabilities[i];
+		double probability = acceleration < triggerLowerBounds[i] ? 0.0 : saturated;
+		if (uniformDistribution(randomStream) < probability) {
+			triggers.push_back(std::make_shared<SeismicEventData>(sensors[i]->getQcnExplorerSensorId(), sensors[i]->getLatitude(),
+				sensors[i]->getLongitude(), earthquake.magnitude, earthquake.eventTime + distance * wavefront.sWaveSlowness, distance,
+				sensors[i]->getRegionId()));
+		}
+	}
+}
+
+/**
+ * @brief Sweep the whole wavefront of an earthquake and draw which sensors trigger.
+ *
+ * @details 
+ * Uniform variates are drawn in sweep order (see sweepTriggers()); sensors beyond the cutoff distance draw none. The arrays read by the getters
+ * are not updated; call evaluate() for them.
+ *
+ * @param earthquake Earthquake to evaluate.
+ * @return Seismic event data of the triggered sensors, ordered by event time (S-wave arrival).
+ */
+std::vector<std::shared_ptr<SeismicEventData>> QuakeWaveModel::generateTriggers(const EarthquakeData &earthquake) {
+	Wavefront wavefront = startWavefront(earthquake, EventType::SEISMIC_EVENT_DETECTION);
+	std::vector<std::shared_ptr<SeismicEventData>> triggers;
+	sweepTriggers(wavefront, std::numeric_limits<double>::infinity(), triggers);
+	return triggers;
+}
+
+/**
+ * @brief Start the wavefront of an earthquake and schedule its first batch of triggers, one event per trigger, at its event time.
+ *
+ * @details 
+ * The entity of each event is the SeismicEventData of the trigger, as for triggers read from QCNExplorer files. Triggers before the current
+ * simulation time are scheduled at the current time. Later batches are scheduled by advanceWavefront(), on the QUAKE_WAVEFRONT_ADVANCE events.
+ *
+ * @param earthquake Earthquake to evaluate; it is copied.
+ * @param scheduler Scheduler in which to schedule the events.
+ * @param eventType Type of the trigger events.
+ * @return Number of trigger events scheduled in the first batch.
+ */
+unsigned int QuakeWaveModel::scheduleTriggers(const EarthquakeData &earthquake, Scheduler &scheduler, EventType eventType) {
+	Wavefront wavefront = startWavefront(earthquake, eventType);
+	const EarthquakeData *earthquakeCopy = wavefront.earthquake.get();
+	wavefronts.emplace(earthquakeCopy, std::move(wavefront));
+	return advanceWavefront(*earthquakeCopy, scheduler);
+}
+
+/**
+ * @brief Schedule the next batch of triggers of a wavefront: those whose S-wave arrives within one wavefront step of the current time.
+ *
+ * @details 
+ * A QUAKE_WAVEFRONT_ADVANCE event is scheduled for the following batch, when the wavefront step has elapsed, or later if no sensor is reached
+ * meanwhile; once the wavefront passes the cutoff distance, or the last sensor, it is discarded.
+ *
+ * @param earthquake Entity of the QUAKE_WAVEFRONT_ADVANCE event, i.e., the copy of the earthquake made by scheduleTriggers().
+ * @param scheduler Scheduler in which to schedule the events.
+ * @return Number of trigger events scheduled; 0 if the wavefront is unknown.
+ */
+unsigned int QuakeWaveModel::advanceWavefront(const EarthquakeData &earthquake, Scheduler &scheduler) {
+	auto wavefrontIterator = wavefronts.find(&earthquake);
+	if (wavefrontIterator == wavefronts.end()) {
+		return 0;
+	}
+	Wavefront &wavefront = wavefrontIterator->second;
+	const double currentTime = simulatorGlobals.getCurrentAbsoluteTime();
+	std::vector<std::shared_ptr<SeismicEventData>> triggers;
+	sweepTriggers(wavefront, currentTime + wavefrontStep, triggers);
+	for (auto &trigger : triggers) {
+		scheduler.schedule(Event(std::max(0.0, trigger->eventTime - currentTime), wavefront.eventType, trigger));
+	}
+	double nextDistance = wavefront.sweep.getNextDistance();
+	if (wavefront.sweep.hasNext() && nextDistance <= wavefront.cutoffDistance) {
+		double nextArrivalTime = earthquake.eventTime + nextDistance * wavefront.sWaveSlowness;
+		scheduler.schedule(Event(std::max(wavefrontStep, nextArrivalTime - wavefrontStep - currentTime), EventType::QUAKE_WAVEFRONT_ADVANCE,
+			wavefront.earthquake));
+	}
+	else {
+		wavefronts.erase(wavefrontIterator);
+	}
+	return static_cast<unsigned int>(triggers.size());
+}
+
+/**
+ * @brief Get number of wavefronts still advancing.
+ *
+ * @return Number of wavefronts whose QUAKE_WAVEFRONT_ADVANCE event is pending.
+ */
+std::unordered_map<const EarthquakeData *, QuakeWaveModel::Wavefront>::size_type QuakeWaveModel::getNumberOfWavefronts() const {
+	return wavefronts.size();
+}
+
+/**
+ * @brief Get sensors of the model; results are indexed in this order.
+ *
+ * @return Sensors, in the order they were added.
+ */
+const std::vector<std::shared_ptr<QcnSensorTrafficGenerator>> &QuakeWaveModel::getSensors() const {
+	return sensors;
+}
+
+/**
+ * @brief Get hypocentral distances of the last earthquake evaluated.
+ *
+ * @return Distance of each sensor, in Km.
+ */
+const std::vector<double> &QuakeWaveModel::getHypocentralDistances() const {
+	return hypocentralDistances;
+}
+
+/**
+ * @brief Get P-wave arrival times of the last earthquake evaluated.
+ *
+ * @return Absolute arrival time at each sensor.
+ */
+const std::vector<double> &QuakeWaveModel::getPWaveArrivalTimes() const {
+	return pWaveArrivalTimes;
+}
+
+/**
+ * @brief Get S-wave arrival times of the last earthquake evaluated.
+ *
+ * @return Absolute arrival time at each sensor.
+ */
+const std::vector<double> &QuakeWaveModel::getSWaveArrivalTimes() const {
+	return sWaveArrivalTimes;
+}
+
+/**
+ * @brief Get peak ground accelerations of the last earthquake evaluated.
+ *
+ * @return Acceleration at each sensor, in m/s^2.
+ */
+const std::vector<double> &QuakeWaveModel::getPeakAccelerations() const {
+	return peakAccelerations;
+}
+
+/**
+ * @brief Get trigger probabilities of the last earthquake evaluated.
+ *
+ * @return Probability that each sensor triggers.
+ */
+const std::vector<double> &QuakeWaveModel::getTriggerProbabilities() const {
+	return triggerProbabilities;
+}
@@ -0,0 +1,129 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "EarthquakeData.h"
+#include "EventType.h"
+#include "GeoUtilities.h"
+#include "QcnSensorTrafficGenerator.h"
+#include "RandomStream.h"
+#include "Scheduler.h"
+#include "SeismicEventData.h"
+#include "SensorSpatialIndex.h"
+#include "SimulatorGlobals.h"
+#include "Topology.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#define QUAKE_RANDOM_STREAM_ID 0xE0000000 //!< Default ID of the random stream from which the quake model draws triggers.
+#define QUAKE_DEFAULT_S_WAVE_SPEED 3.5 //!< S-wave speed, in Km/s, used when the earthquake gives none.
+#define QUAKE_P_TO_S_WAVE_SPEED_RATIO 1.7320508075688772 //!< Ratio of P-wave to S-wave speed (sqrt(3), Poisson solid).
+#define QUAKE_ATTENUATION_CONSTANT -2.2 //!< Default c0 of the attenuation relation (see QuakeWaveModel).
+#define QUAKE_ATTENUATION_MAGNITUDE 0.6 //!< Default c1 of the attenuation relation.
+#define QUAKE_ATTENUATION_DISTANCE 1.0 //!< Default c2 of the attenuation relation.
+#define QUAKE_ATTENUATION_NEAR_FIELD 10.0 //!< Default c3 of the attenuation relation, in Km.
+#define QUAKE_WAVEFRONT_STEP 1.0 //!< Default span of S-wave arrival times, in seconds, whose triggers are scheduled per wavefront batch.
+
+/**
+ * @brief Quake Wave Model class.
+ * 
+ * @par Description
+ * Physics-based earthquake model that generates sensor triggers within the simulator, instead of reading them precomputed from QCNExplorer files.
+ * For an earthquake (EarthquakeData) and every sensor registered, the model computes:
+ * - the hypocentral distance, from the epicenter, the depth of the hypocenter and the sensor location;
+ * - the arrival times of the P-wave and the S-wave, from the origin time and the wave speeds (the P-wave speed is the S-wave speed times
+ *   QUAKE_P_TO_S_WAVE_SPEED_RATIO);
+ * - the peak ground acceleration, in m/s^2, by the attenuation relation log10(PGA) = c0 + c1 * M - c2 * log10(d + c3), where M is the magnitude
+ *   and d the hypocentral distance (see setAttenuation());
+ * - the trigger probability, from the QcnSensorParameters of the sensor: zero below trigLowerBound; one at or above trigUpperBound, if it is
+ *   above trigLowerBound; trigProb otherwise.
+ *
+ * Triggers are drawn from the probabilities above and carried by SeismicEventData objects, with the S-wave arrival time as event time (the
+ * strong shaking that sensors pick), such that they replace the QCNExplorer input unchanged.
+ *
+ * Triggers are generated by sweeping the sensors from the hypocenter with a SensorSpatialIndex: sensors come in increasing distance, thus in
+ * S-wave arrival order, and the sweep stops at the distance beyond which the acceleration is below the lowest trigger lower bound of all
+ * sensors. Sensors that cannot trigger are never visited, and triggers need no sorting. scheduleTriggers() schedules the triggers in batches
+ * as the wavefront advances: each batch covers the arrivals of the next wavefront step (see setWavefrontStep()), and a QUAKE_WAVEFRONT_ADVANCE
+ * event, whose entity is a copy of the earthquake, is scheduled for the next batch; the application passes that entity to advanceWavefront().
+ * The event queue thus only holds the triggers of the near future, whatever the number of sensors shaken.
+ *
+ * evaluate() computes the values above for all sensors at once, e.g., for shake maps. Sensor data and results are kept as structures of arrays,
+ * and distances come from dot products of unit vectors rather than per-sensor trigonometry: the chord between sensor and epicenter gives the
+ * straight-line distance to the hypocenter exactly. The loops over sensors have no branches and no calls other than sqrt and log10, so that the
+ * compiler vectorizes them; a quake over one million sensors is evaluated in milliseconds.
+ *
+ * Sensor locations and parameters are copied when the sensors are added; add them again after changing them, and not while wavefronts advance.
+ */
+class QuakeWaveModel {
+private:
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object, for the current time.
+	RandomStream randomStream; //!< Own random stream, from which triggers are drawn.
+	double attenuationConstant; //!< c0 of the attenuation relation.
+	double attenuationMagnitude; //!< c1 of the attenuation relation.
+	double attenuationDistance; //!< c2 of the attenuation relation.
+	double attenuationNearField; //!< c3 of the attenuation relation, in Km.
+	double wavefrontStep; //!< Span of S-wave arrival times scheduled per wavefront batch, in seconds.
+	double minimumTriggerLowerBound; //!< Lowest trigger lower bound of all sensors.
+	std::vector<std::shared_ptr<QcnSensorTrafficGenerator>> sensors; //!< Sensors, in the order they were added.
+	std::vector<double> unitX; //!< X coordinate of the unit vector to each sensor (Earth-centered).
+	std::vector<double> unitY; //!< Y coordinate of the unit vector to each sensor.
+	std::vector<double> unitZ; //!< Z coordinate of the unit vector to each sensor.
+	std::vector<double> triggerLowerBounds; //!< Trigger lower bound of each sensor.
+	std::vector<double> triggerUpperBounds; //!< Trigger upper bound of each sensor.
+	std::vector<double> sensorTriggerProbabilities; //!< Trigger probability of each sensor within its bounds.
+	std::vector<double> hypocentralDistances; //!< Hypocentral distance of each sensor to the last earthquake evaluated, in Km.
+	std::vector<double> pWaveArrivalTimes; //!< Absolute arrival time of the P-wave at each sensor.
+	std::vector<double> sWaveArrivalTimes; //!< Absolute arrival time of the S-wave at each sensor.
+	std::vector<double> peakAccelerations; //!< Peak ground acceleration at each sensor, in m/s^2.
+	std::vector<double> triggerProbabilities; //!< Probability that each sensor triggers.
+	SensorSpatialIndex sensorSpatialIndex; //!< Sensor locations, swept from the hypocenter to generate triggers.
+
+	/// Wavefront of an earthquake, sweeping the sensors.
+	struct Wavefront {
+		std::shared_ptr<EarthquakeData> earthquake; //!< Copy of the earthquake; entity of the QUAKE_WAVEFRONT_ADVANCE events.
+		SensorSpatialIndex::Sweep sweep; //!< Sweep of the sensors from the hypocenter.
+		double sWaveSlowness; //!< Inverse of the S-wave speed, in s/Km.
+		double logAccelerationAtSource; //!< Natural logarithm of 10^(c0 + c1 * M).
+		double cutoffDistance; //!< Distance beyond which no sensor triggers, in Km.
+		EventType eventType; //!< Type of the trigger events.
+		Wavefront(std::shared_ptr<EarthquakeData> earthquake, SensorSpatialIndex::Sweep sweep, EventType eventType);
+	};
+
+	std::unordered_map<const EarthquakeData *, Wavefront> wavefronts; //!< Wavefronts still advancing, by their copy of the earthquake.
+
+	Wavefront startWavefront(const EarthquakeData &earthquake, EventType eventType);
+	void sweepTriggers(Wavefront &wavefront, double horizon, std::vector<std::shared_ptr<SeismicEventData>> &triggers);
+
+public:
+	QuakeWaveModel(SimulatorGlobals &simulatorGlobals, unsigned int streamId = QUAKE_RANDOM_STREAM_ID);
+
+	void addSensor(std::shared_ptr<QcnSensorTrafficGenerator> sensor);
+	void addSensors(const Topology &topology);
+	std::vector<std::shared_ptr<QcnSensorTrafficGenerator>>::size_type getNumberOfSensors() const;
+	void setAttenuation(double constant, double magnitude, double distance, double nearField);
+	void setWavefrontStep(double step);
+	void evaluate(const EarthquakeData &earthquake);
+	std::vector<std::shared_ptr<SeismicEventData>> generateTriggers(const EarthquakeData &earthquake);
+	unsigned int scheduleTriggers(const EarthquakeData &earthquake, Scheduler &scheduler, EventType eventType = EventType::SEISMIC_EVENT_DETECTION);
+	unsigned int advanceWavefront(const EarthquakeData &earthquake, Scheduler &scheduler);
+	std::unordered_map<const EarthquakeData *, Wavefront>::size_type getNumberOfWavefronts() const;
+	const std::vector<std::shared_ptr<QcnSensorTrafficGenerator>> &getSensors() const;
+	const std::vector<double> &getHypocentralDistances() const;
+	const std::vector<double> &getPWaveArrivalTimes() const;
+	const std::vector<double> &getSWaveArrivalTimes() const;
+	const std::vector<double> &getPeakAccelerations() const;
+	const std::vector<double> &getTriggerProbabilities() const;
+};
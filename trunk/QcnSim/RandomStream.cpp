@@ -0,0 +1,170 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RandomStream.h"
+
+#define PHILOX_M0 0xD2511F53 //!< Philox4x32 multiplier, first word pair.
+#define PHILOX_M1 0xCD9E8D57 //!< Philox4x32 multiplier, second word pair.
+#define PHILOX_W0 0x9E3779B9 //!< Philox key schedule increment (golden ratio), first key word.
+#define PHILOX_W1 0xBB67AE85 //!< Philox key schedule increment (sqrt(3) - 1), second key word.
+#define PHILOX_ROUNDS 10 //!< Number of Philox rounds.
+
+/**
+ * @brief Default constructor: master seed, stream ID and replication zero.
+ */
+RandomStream::RandomStream(): RandomStream(0, 0, 0) {
+}
+
+/**
+ * @brief Constructor.
+ *
+ * @param masterSeed Master seed of the simulation.
+ * @param streamId ID of this stream, unique among the components that draw random numbers.
+ * @param replication Replication number; each replication of a simulation gets independent streams. Default is zero.
+ */
+RandomStream::RandomStream(uint32_t masterSeed, uint32_t streamId, uint32_t replication): outputIndex(4) {
+	key[0] = masterSeed;
+	key[1] = streamId;
+	counter[0] = 0;
+	counter[1] = 0;
+	counter[2] = replication;
+	counter[3] = 0;
+	output[0] = output[1] = output[2] = output[3] = 0;
+}
+
+/**
+ * @brief Compute the Philox4x32-10 block for a counter and a key.
+ *
+ * @param counter Counter (four words).
+ * @param key Key (two words).
+ * @param result Resulting block (four words).
+ */
+void RandomStream::philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t result[4]) {
+	uint32_t x0 = counter[0], x1 = counter[1], x2 = counter[2], x3 = counter[3];
+	uint32_t k0 = key[0], k1 = key[1];
+	for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+		uint64_t product0 = static_cast<uint64_t>(PHILOX_M0) * x0;
+		uint64_t product1 = static_cast<uint64_t>(PHILOX_M1) * x2;
+		x0 = static_cast<uint32_t>(product1 >> 32) ^ x1 ^ k0;
+		x1 = static_cast<uint32_t>(product1);
+		x2 = static_cast<uint32_t>(product0 >> 32) ^ x3 ^ k1;
+		x3 = static_cast<uint32_t>(product0);
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+	result[0] = x0;
+	result[1] = x1;
+	result[2] = x2;
+	result[3] = x3;
+}
+
+/**
+ * @brief Generate the block at the current counter and advance the counter.
+ */
+void RandomStream::generateBlock() {
+	philox4x32(counter, key, output);
+	if (++counter[0] == 0) {
+		++counter[1];
+	}
+	outputIndex = 0;
+}
+
+/**
+ * @brief Return next number of the stream.
+ *
+ * @return Uniformly distributed number in [min(), max()].
+ */
+RandomStream::result_type RandomStream::operator()() {
+	if (outputIndex == 4) {
+		generateBlock();
+	}
+	return output[outputIndex++];
+}
+
+/**
+ * @brief Skip numbers of the stream, in constant time.
+ *
+ * @param z Number of numbers to skip.
+ */
+void RandomStream::discard(unsigned long long z) {
+	unsigned long long available = 4 - outputIndex;
+	if (z <= available) {
+		outputIndex += static_cast<unsigned int>(z);
+		return;
+	}
+	z -= available;
+	// Skip whole blocks by advancing the counter, then generate the block holding the next number, if needed.
+	uint64_t blockIndex = (static_cast<uint64_t>(counter[1]) << 32 | counter[0]) + z / 4;
+	counter[0] = static_cast<uint32_t>(blockIndex);
+	counter[1] = static_cast<uint32_t>(blockIndex >> 32);
+	if (z % 4 == 0) {
+		outputIndex = 4;
+	} else {
+		generateBlock();
+		outputIndex = static_cast<unsigned int>(z % 4);
+	}
+}
+
+/**
+ * @brief Comparator ==, non-member function.
+ */
+bool operator==(const RandomStream &left, const RandomStream &right) {
+	for (int i = 0; i < 4; ++i) {
+		if (left.counter[i] != right.counter[i] || left.output[i] != right.output[i]) {
+			return false;
+		}
+	}
+	return left.key[0] == right.key[0] && left.key[1] == right.key[1] && left.outputIndex == right.outputIndex;
+}
+
+/**
+ * @brief Comparator !=, non-member function.
+ */
+bool operator!=(const RandomStream &left, const RandomStream &right) {
+	return !(left == right);
+}
+
+/**
+ * @brief Write state as text (space-separated words), non-member function.
+ */
+std::ostream &operator<<(std::ostream &outputStream, const RandomStream &randomStream) {
+	outputStream << randomStream.key[0] << " " << randomStream.key[1];
+	for (int i = 0; i < 4; ++i) {
+		outputStream << " " << randomStream.counter[i];
+	}
+	for (int i = 0; i < 4; ++i) {
+		outputStream << " " << randomStream.output[i];
+	}
+	return outputStream << " " << randomStream.outputIndex;
+}
+
+/**
+ * @brief Read state written by operator<<, non-member function. On failure, the stream is left unchanged and failbit is set.
+ */
+std::istream &operator>>(std::istream &inputStream, RandomStream &randomStream) {
+	RandomStream readStream;
+	inputStream >> readStream.key[0] >> readStream.key[1];
+	for (int i = 0; i < 4; ++i) {
+		inputStream >> readStream.counter[i];
+	}
+	for (int i = 0; i < 4; ++i) {
+		inputStream >> readStream.output[i];
+	}
+	inputStream >> readStream.outputIndex;
+	if (inputStream && readStream.outputIndex <= 4) {
+		randomStream = readStream;
+	} else {
+		inputStream.setstate(std::ios::failbit);
+	}
+	return inputStream;
+}
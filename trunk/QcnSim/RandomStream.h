@@ -0,0 +1,66 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+
+/**
+ * @brief Random Stream class.
+ * 
+ * @par Description
+ * Counter-based pseudorandom number generator (Philox4x32-10, Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC 2011).
+ * Each output block is a bijection of a 128-bit counter under a 64-bit key; the key is (master seed, stream ID) and the counter carries the
+ * replication number and the block index. Thus streams are independent of each other and of the order in which they are created or used,
+ * and constructing one costs nothing: there is no state to warm up.
+ *
+ * This class satisfies the C++11 UniformRandomBitGenerator requirements and can be passed to the standard distributions, like
+ * std::default_random_engine. Its state can be written to and read from streams with operator<< and operator>>, like the standard engines.
+ */
+class RandomStream {
+private:
+	uint32_t key[2]; //!< Key: master seed and stream ID.
+	uint32_t counter[4]; //!< Counter: index of next block to generate (two words), replication number, zero.
+	uint32_t output[4]; //!< Current output block.
+	unsigned int outputIndex; //!< Index of next output to return within the current block; 4 if the block is used up.
+
+	void generateBlock();
+
+public:
+	typedef uint32_t result_type; //!< Type of generated numbers.
+
+	RandomStream();
+	RandomStream(uint32_t masterSeed, uint32_t streamId, uint32_t replication = 0);
+
+	/// Smallest value returned by operator().
+	static constexpr result_type min() { return 0; }
+	/// Largest value returned by operator().
+	static constexpr result_type max() { return 0xFFFFFFFF; }
+
+	result_type operator()();
+	void discard(unsigned long long z);
+	static void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t result[4]);
+
+	///	Comparator ==, non-member. Streams are equal if they will generate the same sequence.
+	friend bool operator==(const RandomStream &left, const RandomStream &right);
+
+	///	Comparator !=, non-member.
+	friend bool operator!=(const RandomStream &left, const RandomStream &right);
+
+	/// Write state as text, non-member.
+	friend std::ostream &operator<<(std::ostream &outputStream, const RandomStream &randomStream);
+
+	/// Read state written by operator<<, non-member.
+	friend std::istream &operator>>(std::istream &inputStream, RandomStream &randomStream);
+};
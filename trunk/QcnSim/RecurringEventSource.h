@@ -0,0 +1,37 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+ * @brief Recurring Event Source class.
+ * 
+ * @par Description
+ * Abstract interface for objects that own a recurring event in the Event Chain (see Scheduler::scheduleRecurring()), such as autonomous
+ * traffic generators. Instead of removing the event when it is caused and having a new one scheduled, the Scheduler asks its source for the
+ * next interval and moves the same event chain element to its new position.
+ */
+class RecurringEventSource {
+public:
+	virtual ~RecurringEventSource() {}
+
+	/**
+	 * @brief Interval until the next occurrence of the recurring event.
+	 *
+	 * @details 
+	 * Called by the Scheduler right after the recurring event is caused, with the clock at the time of that occurrence.
+	 *
+	 * @return Time from now to the next occurrence.
+	 */
+	virtual double nextOccurAfterTime() = 0;
+};
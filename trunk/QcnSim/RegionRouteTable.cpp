@@ -0,0 +1,298 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RegionRouteTable.h"
+
+/**
+ * @brief Default constructor.
+ */
+RegionRouteTable::RegionRouteTable(): rerouteCount(0) {
+}
+
+/**
+ * @brief Add a route to a region.
+ *
+ * @details 
+ * Routes are kept in the order they are added, which is the order of preference: the first route added to a region is its primary route.
+ * The first route added to a region becomes its active route.
+ *
+ * @param regionId Region ID.
+ * @param source Ingress node of the region for this route.
+ * @param destination Destination node for this route.
+ * @param explicitRoute Explicit route from source to destination.
+ * @param links Links traversed by the route. If empty, the route is considered always usable.
+ *
+ * @return Index of the added route within the region.
+ */
+std::vector<RegionRoute>::size_type RegionRouteTable::addRoute(unsigned int regionId, std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination,
+		std::vector<std::shared_ptr<Entity>> explicitRoute, std::vector<std::shared_ptr<Link>> links) {
+	std::vector<RegionRoute> &routes = regionRoutes[regionId];
+	for (auto &link : links) {
+		// Index the region under each link only once, even if several of its routes share the link.
+		bool alreadyIndexed = false;
+		auto range = regionsByLink.equal_range(link.get());
+		for (auto iterator = range.first; iterator != range.second; ++iterator) {
+			if (iterator->second == regionId) {
+				alreadyIndexed = true;
+				break;
+			}
+		}
+		if (!alreadyIndexed) {
+			regionsByLink.insert(std::make_pair(link.get(), regionId));
+		}
+	}
+	RegionRoute regionRoute = { source, destination, explicitRoute, links };
+	routes.push_back(regionRoute);
+	if (routes.size() == 1) {
+		activeRouteIndex[regionId] = 0;
+	}
+	return routes.size() - 1;
+}
+
+/**
+ * @brief Get the active route of a region.
+ *
+ * @details 
+ * Throws std::out_of_range if the region has no routes.
+ *
+ * @param regionId Region ID.
+ * @return Active route for the region.
+ */
+const RegionRoute &RegionRouteTable::getActiveRoute(unsigned int regionId) const {
+	return regionRoutes.at(regionId).at(activeRouteIndex.at(regionId));
+}
+
+/**
+ * @brief Get the route followed by a source of a region, which may be in the split share of the region.
+ *
+ * @details 
+ * If the region is split and the source is in the share of the split route, that route is returned, provided it is usable; otherwise, the
+ * active route of the region. The lookup is O(1) in the number of sources.
+ * Throws std::out_of_range if the region has no routes.
+ *
+ * @param regionId Region ID.
+ * @param sourceKey Key of the source within the region, e.g., the QCNExplorer sensor ID.
+ * @return Route for the source.
+ */
+const RegionRoute &RegionRouteTable::getActiveRoute(unsigned int regionId, unsigned int sourceKey) const {
+	auto regionSplitIterator = regionSplits.find(regionId);
+	if (regionSplitIterator != regionSplits.end() && getSourceShare(regionSplitIterator->second.seed, sourceKey) < regionSplitIterator->second.fraction) {
+		const RegionRoute &splitRoute = regionRoutes.at(regionId).at(regionSplitIterator->second.routeIndex);
+		if (isRouteUsable(splitRoute)) {
+			return splitRoute;
+		}
+	}
+	return getActiveRoute(regionId);
+}
+
+/**
+ * @brief Get the index of the active route of a region.
+ *
+ * @param regionId Region ID.
+ * @return Index of the active route (0 is the primary route).
+ */
+std::vector<RegionRoute>::size_type RegionRouteTable::getActiveRouteIndex(unsigned int regionId) const {
+	return activeRouteIndex.at(regionId);
+}
+
+/**
+ * @brief Force the active route of a region, e.g., to reroute traffic administratively.
+ *
+ * @details 
+ * The choice holds until a link of the route goes down; the region then fails over, and back to this route when its links are up again.
+ * A pending failback of the region is cancelled. Throws std::out_of_range if the region or the route index does not exist.
+ *
+ * @param regionId Region ID.
+ * @param routeIndex Index of the route to activate.
+ */
+void RegionRouteTable::setActiveRoute(unsigned int regionId, std::vector<RegionRoute>::size_type routeIndex) {
+	regionRoutes.at(regionId).at(routeIndex); // Bounds check.
+	failedOverRouteIndex.erase(regionId);
+	activateRoute(regionId, routeIndex);
+}
+
+/**
+ * @brief Split the sources of a region between its active route and another route, e.g., to reroute part of its traffic.
+ *
+ * @details 
+ * Each source follows the split route with probability fraction, independently of the others: the source key is hashed with the seed, such
+ * that a source keeps its route while the split holds, and another seed picks another share. Only the region entry is written.
+ * Throws std::out_of_range if the region or the route index does not exist.
+ *
+ * @param regionId Region ID.
+ * @param routeIndex Index of the route of the share.
+ * @param fraction Fraction of the sources that follow the route, in [0, 1].
+ * @param seed Seed of the hash that picks the sources (e.g., drawn from the random engine).
+ */
+void RegionRouteTable::setSplitRoute(unsigned int regionId, std::vector<RegionRoute>::size_type routeIndex, double fraction, uint64_t seed) {
+	regionRoutes.at(regionId).at(routeIndex); // Bounds check.
+	RegionSplit regionSplit = { routeIndex, fraction, seed };
+	regionSplits[regionId] = regionSplit;
+	++rerouteCount;
+}
+
+/**
+ * @brief Remove the split of a region; all its sources follow the active route again.
+ *
+ * @param regionId Region ID.
+ */
+void RegionRouteTable::clearSplitRoute(unsigned int regionId) {
+	regionSplits.erase(regionId);
+}
+
+/**
+ * @brief Check whether the sources of a region are split between two routes.
+ *
+ * @param regionId Region ID.
+ * @return True if the region has a split; false otherwise.
+ */
+bool RegionRouteTable::isRegionSplit(unsigned int regionId) const {
+	return regionSplits.find(regionId) != regionSplits.end();
+}
+
+/**
+ * @brief Get the number of regions in the table.
+ *
+ * @return Number of regions.
+ */
+std::map<unsigned int, std::vector<RegionRoute>>::size_type RegionRouteTable::getNumberOfRegions() const {
+	return regionRoutes.size();
+}
+
+/**
+ * @brief Get the number of times a region had its active route changed.
+ *
+ * @return Reroute count.
+ */
+unsigned int RegionRouteTable::getRerouteCount() const {
+	return rerouteCount;
+}
+
+/**
+ * @brief Reselect the active routes of the regions that use a link, upon change of state of that link.
+ *
+ * @details 
+ * A link going down only affects the regions whose active route goes through it: they fail over to their most preferred usable route, and the
+ * route they were switched from is kept (the first one, if they fail over again). A link coming up only affects regions that failed over: when
+ * the route they were switched from is usable again, it is restored; otherwise, the most preferred usable route is selected. Other regions
+ * keep their active route, even if it was set administratively to a less preferred one.
+ *
+ * @param link Link that changed state.
+ * @param isUp True if the link has just come up; false if it has just gone down.
+ */
+void RegionRouteTable::linkStateChanged(const Link &link, bool isUp) {
+	auto range = regionsByLink.equal_range(&link);
+	for (auto iterator = range.first; iterator != range.second; ++iterator) {
+		unsigned int regionId = iterator->second;
+		if (!isUp) {
+			if (isLinkInRoute(link, getActiveRoute(regionId))) {
+				std::vector<RegionRoute>::size_type previousRouteIndex = activeRouteIndex.at(regionId);
+				selectActiveRoute(regionId);
+				if (activeRouteIndex.at(regionId) != previousRouteIndex) {
+					failedOverRouteIndex.insert(std::make_pair(regionId, previousRouteIndex)); // Keeps the first route switched from.
+				}
+			}
+			continue;
+		}
+		auto failedOverIterator = failedOverRouteIndex.find(regionId);
+		if (failedOverIterator == failedOverRouteIndex.end()) {
+			continue;
+		}
+		if (isRouteUsable(regionRoutes.at(regionId).at(failedOverIterator->second))) {
+			activateRoute(regionId, failedOverIterator->second);
+			failedOverRouteIndex.erase(failedOverIterator);
+		} else {
+			selectActiveRoute(regionId);
+		}
+	}
+}
+
+/**
+ * @brief Check whether a route goes through a link.
+ *
+ * @param link Link to look for.
+ * @param regionRoute Route to check.
+ * @return True if the link is one of the route links; false otherwise.
+ */
+bool RegionRouteTable::isLinkInRoute(const Link &link, const RegionRoute &regionRoute) const {
+	for (auto &routeLink : regionRoute.links) {
+		if (routeLink.get() == &link) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Check whether all links of a route are up.
+ *
+ * @param regionRoute Route to check.
+ * @return True if the route is usable; false otherwise.
+ */
+bool RegionRouteTable::isRouteUsable(const RegionRoute &regionRoute) const {
+	for (auto &link : regionRoute.links) {
+		if (!link->isUp()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Make a route the active route of a region, counting the change.
+ *
+ * @param regionId Region ID.
+ * @param routeIndex Index of the route to activate, within bounds.
+ */
+void RegionRouteTable::activateRoute(unsigned int regionId, std::vector<RegionRoute>::size_type routeIndex) {
+	if (activeRouteIndex.at(regionId) != routeIndex) {
+		activeRouteIndex[regionId] = routeIndex;
+		++rerouteCount;
+	}
+}
+
+/**
+ * @brief Activate the most preferred usable route of a region.
+ *
+ * @details 
+ * If no route is usable, the active route is left unchanged; traffic will then be dropped at the failed link, as it would be without this table.
+ *
+ * @param regionId Region ID.
+ */
+void RegionRouteTable::selectActiveRoute(unsigned int regionId) {
+	const std::vector<RegionRoute> &routes = regionRoutes.at(regionId);
+	for (std::vector<RegionRoute>::size_type routeIndex = 0; routeIndex < routes.size(); ++routeIndex) {
+		if (isRouteUsable(routes[routeIndex])) {
+			activateRoute(regionId, routeIndex);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Map a source key to a uniform share in [0, 1), with a seed.
+ *
+ * @details 
+ * The key and the seed are mixed with the SplitMix64 finalizer, whose output bits are all well distributed even for consecutive keys.
+ *
+ * @param seed Seed of the split.
+ * @param sourceKey Key of the source.
+ * @return Share of the source, in [0, 1).
+ */
+double RegionRouteTable::getSourceShare(uint64_t seed, unsigned int sourceKey) {
+	uint64_t hash = seed + (static_cast<uint64_t>(sourceKey) + 1) * 0x9E3779B97F4A7C15ULL;
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+	hash ^= hash >> 31;
+	return static_cast<double>(hash >> 11) / 9007199254740992.0; // 53 bits, divided by 2^53.
+}
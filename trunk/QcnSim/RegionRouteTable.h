@@ -0,0 +1,94 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+#include "Link.h"
+#include "LinkStateObserver.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Region Route.
+ *
+ * @par Description
+ * One route available to a region: ingress (source) node, egress (destination) node, the explicit route between them, and the links
+ * the route traverses. The route is only usable if all its links are up.
+ */
+struct RegionRoute {
+	std::shared_ptr<Entity> source; //!< Ingress node of the region for this route.
+	std::shared_ptr<Entity> destination; //!< Destination node (e.g., BOINC server) for this route.
+	std::vector<std::shared_ptr<Entity>> explicitRoute; //!< Explicit route from source to destination.
+	std::vector<std::shared_ptr<Link>> links; //!< Links traversed by this route; used to decide whether the route is usable.
+};
+
+/**
+ * @brief Region Route Table class.
+ * 
+ * @par Description
+ * Level of indirection between traffic sources (typically QcnSensorTrafficGenerator objects) and the routes their traffic follows.
+ * Sensors only know their region ID; the table maps each region to a list of routes, in order of preference, and to the currently
+ * active one. Rerouting traffic is then a matter of changing the active route of a region, which is O(regions), instead of modifying
+ * every traffic generator, which is O(sensors).
+ *
+ * A region may also be split (setSplitRoute()): a fraction of its sources, picked by hashing the source key (e.g., the QCNExplorer sensor ID)
+ * with a seed given to the split, follow another route, and the rest the active route. Each source thus keeps its share until the split
+ * changes, as if every sensor had flipped a coin, but the reroute only writes the region entry.
+ *
+ * The table is a LinkStateObserver. When registered with the links (Link::addLinkStateObserver()), a link going down makes every region
+ * whose active route traverses that link fail over to its most preferred usable route; when the links of the route the region was switched
+ * from are all up again, the region fails back to it. Regions whose route was chosen with setActiveRoute() and not switched automatically
+ * keep it. The share of a split region whose split route is not usable follows the active route meanwhile. Only regions that have a route
+ * through the link are visited.
+ */
+class RegionRouteTable: public LinkStateObserver {
+private:
+	/// Share of the sources of a region that follow another route than the active one.
+	struct RegionSplit {
+		std::vector<RegionRoute>::size_type routeIndex; //!< Index of the route of the share.
+		double fraction; //!< Fraction of the sources in the share, in [0, 1].
+		uint64_t seed; //!< Seed of the hash that picks the sources of the share.
+	};
+
+	std::map<unsigned int, std::vector<RegionRoute>> regionRoutes; //!< Routes per region ID, in order of preference (primary first).
+	std::map<unsigned int, std::vector<RegionRoute>::size_type> activeRouteIndex; //!< Index of the active route per region ID.
+	std::map<unsigned int, std::vector<RegionRoute>::size_type> failedOverRouteIndex; //!< Per region switched away by a link failure, the route to restore.
+	std::map<unsigned int, RegionSplit> regionSplits; //!< Split of the sources per region ID, for split regions only.
+	std::multimap<const Link *, unsigned int> regionsByLink; //!< Region IDs that have at least one route through a given link.
+	unsigned int rerouteCount; //!< Number of times a region had its active route changed.
+
+	bool isRouteUsable(const RegionRoute &regionRoute) const;
+	bool isLinkInRoute(const Link &link, const RegionRoute &regionRoute) const;
+	void activateRoute(unsigned int regionId, std::vector<RegionRoute>::size_type routeIndex);
+	void selectActiveRoute(unsigned int regionId);
+	static double getSourceShare(uint64_t seed, unsigned int sourceKey);
+
+public:
+	RegionRouteTable();
+
+	std::vector<RegionRoute>::size_type addRoute(unsigned int regionId, std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination,
+		std::vector<std::shared_ptr<Entity>> explicitRoute, std::vector<std::shared_ptr<Link>> links = std::vector<std::shared_ptr<Link>>());
+	const RegionRoute &getActiveRoute(unsigned int regionId) const;
+	const RegionRoute &getActiveRoute(unsigned int regionId, unsigned int sourceKey) const;
+	std::vector<RegionRoute>::size_type getActiveRouteIndex(unsigned int regionId) const;
+	void setActiveRoute(unsigned int regionId, std::vector<RegionRoute>::size_type routeIndex);
+	void setSplitRoute(unsigned int regionId, std::vector<RegionRoute>::size_type routeIndex, double fraction, uint64_t seed);
+	void clearSplitRoute(unsigned int regionId);
+	bool isRegionSplit(unsigned int regionId) const;
+	std::map<unsigned int, std::vector<RegionRoute>>::size_type getNumberOfRegions() const;
+	unsigned int getRerouteCount() const;
+	void linkStateChanged(const Link &link, bool isUp) override;
+};
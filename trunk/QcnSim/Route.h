@@ -56,5 +56,6 @@ private:
 	std::shared_ptr<Entity> getNextHopFromExplicitRoute();
 
 	friend class Token;
+	friend class SimulationCheckpoint;
 
 };			
\ No newline at end of file
@@ -0,0 +1,27 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+* @brief Scenario Loader Return Type enum class.
+*
+* @par Description
+* Types of return from JsonScenarioLoader::load.
+*/
+enum class ScenarioLoaderReturnType {
+	SCENARIO_LOADED,	//!< Scenario was successfully loaded and all objects were created.
+	FILE_NOT_FOUND,		//!< Scenario file could not be opened.
+	SYNTAX_ERROR,		//!< Input is not valid JSON. See error message for line and column.
+	SCHEMA_ERROR		//!< Input is valid JSON, but does not conform to the scenario schema. See error message for the offending element.
+};
@@ -18,6 +18,9 @@
  */
 
 #include "Scheduler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
 
 /**
  * @brief Constructor with initial event.
@@ -28,7 +31,10 @@
  * @param simulatorGlobals SimulatorGlobals object.
  * @param event New event to insert.
  */
-Scheduler::Scheduler(SimulatorGlobals &simulatorGlobals, const Event &event): simulatorGlobals(simulatorGlobals) {
+Scheduler::Scheduler(SimulatorGlobals &simulatorGlobals, const Event &event): simulatorGlobals(simulatorGlobals), wheelTick(SCHEDULER_WHEEL_TICK),
+		wheelLevels(SCHEDULER_WHEEL_LEVELS), wheelCursor(0), wheelSlots(SCHEDULER_WHEEL_LEVELS * SCHEDULER_WHEEL_SLOTS),
+		wheelLevelSizes(SCHEDULER_WHEEL_LEVELS, 0), wheelSize(0), nextSequence(0), nextFrontSequence(-1), isFusionOn(false),
+		isFusionVerified(false), fusedEventsCount(0) {
 	// This is the first event, so just add it to the heap.
 	schedule(event);
 }
@@ -41,33 +47,315 @@ Scheduler::Scheduler(SimulatorGlobals &simulatorGlobals, const Event &event): si
  * 
  * @param simulatorGlobals SimulatorGlobals object.
  */
-Scheduler::Scheduler(SimulatorGlobals &simulatorGlobals): simulatorGlobals(simulatorGlobals) {
+Scheduler::Scheduler(SimulatorGlobals &simulatorGlobals): simulatorGlobals(simulatorGlobals), wheelTick(SCHEDULER_WHEEL_TICK),
+		wheelLevels(SCHEDULER_WHEEL_LEVELS), wheelCursor(0), wheelSlots(SCHEDULER_WHEEL_LEVELS * SCHEDULER_WHEEL_SLOTS),
+		wheelLevelSizes(SCHEDULER_WHEEL_LEVELS, 0), wheelSize(0), nextSequence(0), nextFrontSequence(-1), isFusionOn(false),
+		isFusionVerified(false), fusedEventsCount(0) {
 }
 
+/**
+ * @brief Whether an element is to be caused before another: earlier eventTime, or same eventTime and lower sequence.
+ *
+ * @param left Element to compare.
+ * @param right Element to compare.
+ * @return True if left comes before right.
+ */
+bool Scheduler::isEarlier(const EventChainElement &left, const EventChainElement &right) {
+	return left.eventTime < right.eventTime || (left.eventTime == right.eventTime && left.sequence < right.sequence);
+}
+
+/**
+ * @brief Whether a payload tag is of an entity owned by the event, which the Scheduler keeps in a slot.
+ *
+ * @param payloadType Payload tag.
+ * @return True for ENTITY, TOKEN, PROTOCOL_DATA_UNIT, DETECTION_DATA and SEISMIC_EVENT_DATA.
+ */
+bool Scheduler::isOwnedPayload(EventPayloadType payloadType) {
+	return payloadType != EventPayloadType::NO_PAYLOAD && payloadType != EventPayloadType::ENTITY_POINTER && payloadType != EventPayloadType::LINK_ID;
+}
+
+/**
+ * @brief Create the element of an event, keeping the entity owned by the event, if any, in a free slot.
+ *
+ * @param eventTime Absolute occurrence time of the event.
+ * @param event Event.
+ * @param recurringEventSource Source of a recurring event; nullptr for ordinary events.
+ * @return Element, with its payload set; its sequence is to be set by the caller.
+ */
+EventChainElement Scheduler::createElement(double eventTime, const Event &event, RecurringEventSource *recurringEventSource) {
+	EventChainElement element(eventTime, event, recurringEventSource);
+	if (isOwnedPayload(event.payloadType)) {
+		if (freePayloadSlots.empty()) {
+			element.payload.index = static_cast<uint32_t>(payloadEntities.size());
+			payloadEntities.push_back(event.entity);
+		} else {
+			element.payload.index = freePayloadSlots.back();
+			freePayloadSlots.pop_back();
+			payloadEntities[element.payload.index] = event.entity;
+		}
+	}
+	return element;
+}
+
+/**
+ * @brief Rebuild the Event of an element.
+ *
+ * @param element Element.
+ * @param isPayloadReleased True to move the entity owned by the event out of its slot, and free the slot (the element is being removed);
+ * false to share it (the element stays, e.g., a recurring event).
+ * @return Event, with the entity, link ID and payload tag of the element.
+ */
+Event Scheduler::createEvent(const EventChainElement &element, bool isPayloadReleased) {
+	Event event;
+	event.occurAfterTime = element.occurAfterTime;
+	event.eventType = element.eventType;
+	event.payloadType = element.payload.type;
+	switch (element.payload.type) {
+		case EventPayloadType::NO_PAYLOAD:
+			break;
+		case EventPayloadType::ENTITY_POINTER:
+			event.entity = std::shared_ptr<const Entity>(std::shared_ptr<const Entity>(), element.payload.entity);
+			break;
+		case EventPayloadType::LINK_ID:
+			event.linkId = element.payload.linkId;
+			break;
+		default:
+			if (isPayloadReleased) {
+				event.entity = std::move(payloadEntities[element.payload.index]);
+				freePayloadSlots.push_back(element.payload.index);
+			} else {
+				event.entity = payloadEntities[element.payload.index];
+			}
+	}
+	return event;
+}
+
+/**
+ * @brief Release the entity owned by the event of an element being removed, if any, and free its slot.
+ *
+ * @param payload Payload of the element.
+ */
+void Scheduler::releasePayload(const EventPayload &payload) {
+	if (isOwnedPayload(payload.type)) {
+		payloadEntities[payload.index] = nullptr;
+		freePayloadSlots.push_back(payload.index);
+	}
+}
+
+/**
+ * @brief Entity of the payload of an element.
+ *
+ * @param payload Payload of the element.
+ * @return Entity, owned by the event or not; nullptr if there is none (including link IDs).
+ */
+const Entity *Scheduler::getPayloadEntity(const EventPayload &payload) const {
+	switch (payload.type) {
+		case EventPayloadType::NO_PAYLOAD:
+		case EventPayloadType::LINK_ID:
+			return nullptr;
+		case EventPayloadType::ENTITY_POINTER:
+			return payload.entity;
+		default:
+			return payloadEntities[payload.index].get();
+	}
+}
+
+/**
+ * @brief Tick of the timing wheel of a time.
+ *
+ * @details 
+ * Non-decreasing with the time, thus events of earlier ticks are always earlier. Negative times map to tick 0, and times too far away for
+ * 64-bit ticks to a tick beyond any horizon.
+ *
+ * @param eventTime Absolute time.
+ * @return Tick.
+ */
+uint64_t Scheduler::getTick(double eventTime) const {
+	double tick = eventTime / wheelTick;
+	if (!(tick > 0.0)) {
+		return 0;
+	}
+	return tick < 1e18 ? static_cast<uint64_t>(tick) : static_cast<uint64_t>(1e18);
+}
+
+/**
+ * @brief Select where an element goes: the slot of the timing wheel of its tick, or eventChain. Counts the element in the wheel, if there.
+ *
+ * @details 
+ * An element goes to level l if its tick and the cursor are within the same block of SCHEDULER_WHEEL_SLOTS^(l+1) ticks, but not of
+ * SCHEDULER_WHEEL_SLOTS^l ticks; elements before the cursor, or beyond the blocks of the highest level, go to eventChain.
+ *
+ * @param element Element to place; its eventTime is set.
+ * @return List to insert the element into.
+ */
+std::list<EventChainElement> &Scheduler::selectList(const EventChainElement &element) {
+	uint64_t tick = getTick(element.eventTime);
+	if (tick < wheelCursor) {
+		return eventChain;
+	}
+	for (unsigned int level = 0; level < wheelLevels; ++level) {
+		unsigned int blockShift = SCHEDULER_WHEEL_SLOT_BITS * (level + 1);
+		if ((tick >> blockShift) == (wheelCursor >> blockShift)) {
+			++wheelLevelSizes[level];
+			++wheelSize;
+			return wheelSlots[level * SCHEDULER_WHEEL_SLOTS + ((tick >> (SCHEDULER_WHEEL_SLOT_BITS * level)) & (SCHEDULER_WHEEL_SLOTS - 1))];
+		}
+	}
+	return eventChain;
+}
+
+
 /**
  * Schedules an event in time, ordered by time.
  * 
  * @details 
  * The event occurrence time is calculated by adding currentAbsoluteTime and event's occurAfterTime.
  * Adds element to the list ordered in time, after events with same absolute occurrence time.
+ * Events with zero occurAfterTime are appended to the zero-delay queue, in constant time.
  * 
  * @param event New event to insert.
  */
 void Scheduler::schedule(const Event &event) {
-	// Search for insertion point within the event chain, i.e., look for event (in event chain) just after new event to be inserted.
 	double eventTime = simulatorGlobals.getCurrentAbsoluteTime() + event.occurAfterTime; // Absolute occurrence time
-	std::list<EventChainElement>::iterator eventChainIterator = eventChain.begin();
-	while (eventChainIterator != eventChain.end()) {
-		if (eventChainIterator->eventTime <= eventTime) { // Looking for event with eventTime *after* the new event to insert
-			++eventChainIterator;
-		} else {
-			// Found next event after new event to be inserted. Insert new event before.
-			eventChain.insert(eventChainIterator, EventChainElement(eventTime, event)); // Insert element (new EventChainElement with copy of event).
-			return; // Done.
+	EventChainElement element = createElement(eventTime, event);
+	element.sequence = nextSequence++;
+	if (event.occurAfterTime == 0.0) {
+		zeroDelayQueue.push_back(element);
+	} else {
+		insert(element);
+	}
+}
+
+/**
+ * @brief Find where to insert an element within an ordered list of elements (a slot of level 0 of the timing wheel, or eventChain).
+ *
+ * @details 
+ * Searches from the end, since new events are most often the latest of their list. Slots of higher levels of the timing wheel are not
+ * ordered (their elements are ordered when cascaded down to level 0): elements are appended.
+ *
+ * @param elementList List to search.
+ * @param element Element to insert.
+ * @return Position of the first element after the given one; end of the list if there is none.
+ */
+std::list<EventChainElement>::iterator Scheduler::findInsertionPoint(std::list<EventChainElement> &elementList, const EventChainElement &element) {
+	std::list<EventChainElement>::iterator eventChainIterator = elementList.end();
+	if (wheelLevels > 1 && &elementList >= wheelSlots.data() + SCHEDULER_WHEEL_SLOTS && &elementList < wheelSlots.data() + wheelSlots.size()) {
+		return eventChainIterator;
+	}
+	while (eventChainIterator != elementList.begin() && isEarlier(element, *std::prev(eventChainIterator))) {
+		--eventChainIterator;
+	}
+	return eventChainIterator;
+}
+
+/**
+ * @brief Insert a copy of an element, with its eventTime and sequence set, into the timing wheel or eventChain.
+ *
+ * @param element Element to insert.
+ */
+void Scheduler::insert(const EventChainElement &element) {
+	if (wheelSize == 0) {
+		// Empty wheel: restart it at the current time.
+		wheelCursor = getTick(simulatorGlobals.getCurrentAbsoluteTime());
+	}
+	std::list<EventChainElement> &elementList = selectList(element);
+	elementList.insert(findInsertionPoint(elementList, element), element);
+}
+
+/**
+ * @brief Move the elements of a slot of the timing wheel down to lower levels, once the cursor has entered the block of the slot.
+ *
+ * @param level Level of the slot; at least 1.
+ * @param slot Slot within the level.
+ */
+void Scheduler::cascade(unsigned int level, unsigned int slot) {
+	std::list<EventChainElement> cascadedElements;
+	cascadedElements.swap(wheelSlots[level * SCHEDULER_WHEEL_SLOTS + slot]);
+	wheelLevelSizes[level] -= cascadedElements.size();
+	wheelSize -= cascadedElements.size();
+	while (!cascadedElements.empty()) {
+		std::list<EventChainElement> &elementList = selectList(cascadedElements.front());
+		elementList.splice(findInsertionPoint(elementList, cascadedElements.front()), cascadedElements, cascadedElements.begin());
+	}
+}
+
+/**
+ * @brief Find the list whose first element is the next event to cause, moving the cursor of the timing wheel up to it.
+ *
+ * @details 
+ * The cursor moves over empty slots of level 0 within the current block; over empty blocks, it jumps to the next non-empty slot of the
+ * lowest non-empty level, cascading it. It never moves past the first element of eventChain, such that the cursor is at the tick of the
+ * event caused, and new events (which are not earlier) can still be placed in the wheel.
+ *
+ * @param tickLimit Tick past which the cursor must not move; if the first event is beyond it, the list returned is eventChain (or nullptr).
+ * @return List whose first element is the next event; nullptr if there is no event.
+ */
+std::list<EventChainElement> *Scheduler::findFirst(uint64_t tickLimit) {
+	uint64_t eventChainTick = std::min(eventChain.empty() ? UINT64_MAX : getTick(eventChain.front().eventTime), tickLimit);
+	while (wheelSize > 0 && wheelCursor < eventChainTick) {
+		if (wheelLevelSizes[0] > 0) {
+			unsigned int slot = static_cast<unsigned int>(wheelCursor & (SCHEDULER_WHEEL_SLOTS - 1));
+			while (wheelSlots[slot].empty()) {
+				++slot;
+			}
+			wheelCursor = std::min((wheelCursor & ~static_cast<uint64_t>(SCHEDULER_WHEEL_SLOTS - 1)) | slot, eventChainTick);
+			break;
+		}
+		unsigned int level = 1;
+		while (wheelLevelSizes[level] == 0) {
+			++level;
 		}
+		unsigned int slotShift = SCHEDULER_WHEEL_SLOT_BITS * level;
+		unsigned int slot = static_cast<unsigned int>((wheelCursor >> slotShift) & (SCHEDULER_WHEEL_SLOTS - 1)) + 1;
+		while (wheelSlots[level * SCHEDULER_WHEEL_SLOTS + slot].empty()) {
+			++slot;
+		}
+		uint64_t slotTick = ((wheelCursor >> (slotShift + SCHEDULER_WHEEL_SLOT_BITS)) << (slotShift + SCHEDULER_WHEEL_SLOT_BITS)) | (static_cast<uint64_t>(slot) << slotShift);
+		if (eventChainTick < slotTick) {
+			wheelCursor = eventChainTick;
+			break;
+		}
+		wheelCursor = slotTick;
+		cascade(level, slot);
 	}
-	// Can only reach this point if end of event chain was reached, i.e., the new event must be inserted at the end of event chain.
-	eventChain.push_back(EventChainElement(eventTime, event));
+	std::list<EventChainElement> *wheelList = nullptr;
+	if (wheelSize > 0 && wheelLevelSizes[0] > 0) {
+		std::list<EventChainElement> &slotList = wheelSlots[wheelCursor & (SCHEDULER_WHEEL_SLOTS - 1)];
+		if (!slotList.empty()) {
+			wheelList = &slotList;
+		}
+	}
+	if (wheelList != nullptr && (eventChain.empty() || isEarlier(wheelList->front(), eventChain.front()))) {
+		return wheelList;
+	}
+	return eventChain.empty() ? nullptr : &eventChain;
+}
+
+/**
+ * @brief Schedules a recurring event.
+ * 
+ * @details 
+ * The event is scheduled as in schedule(), but it is never removed when caused: cause() returns a copy, asks recurringEventSource for the
+ * next interval and moves the same element to its new position, with no allocation. Thus a source such as an autonomous traffic generator
+ * keeps a single slot in the event chain. Use cancelRecurring() to remove it.
+ * 
+ * @param event Event to insert; its occurAfterTime is the interval until the first occurrence.
+ * @param recurringEventSource Source of the next intervals. Must remain valid until the event is cancelled.
+ */
+void Scheduler::scheduleRecurring(const Event &event, RecurringEventSource &recurringEventSource) {
+	EventChainElement element = createElement(simulatorGlobals.getCurrentAbsoluteTime() + event.occurAfterTime, event, &recurringEventSource);
+	element.sequence = nextSequence++;
+	insert(element);
+}
+
+/**
+ * @brief Removes the recurring events of a source from the event chain.
+ * 
+ * @param recurringEventSource Source of recurring events to remove.
+ * @return Number of events removed; zero if the source had no recurring event.
+ */
+unsigned int Scheduler::cancelRecurring(const RecurringEventSource &recurringEventSource) {
+	return removeElements([&recurringEventSource](const EventChainElement &element) { return element.recurringEventSource == &recurringEventSource; });
 }
 
 /**
@@ -77,11 +365,14 @@ void Scheduler::schedule(const Event &event) {
  * The event occurrence time is equal to currentAbsoluteTime, since this event must occur before any other event.
  * This is a function tailored for dequeued tokens from facilities, which have to have service request scheduled for them before anything else happens in the simulation.
  * Misuse of this function may cause unsound simulations.
+ * The event is pushed to the front of the zero-delay queue, in constant time.
  * 
  * @param event New event to insert.
  */
 void Scheduler::scheduleFront(const Event &event) {
-	eventChain.push_front(EventChainElement(simulatorGlobals.getCurrentAbsoluteTime(), event));
+	EventChainElement element = createElement(simulatorGlobals.getCurrentAbsoluteTime(), event);
+	element.sequence = nextFrontSequence--;
+	zeroDelayQueue.push_front(element);
 }
 
 /**
@@ -89,23 +380,48 @@ void Scheduler::scheduleFront(const Event &event) {
  *
  * @details 
  * Advances the SimulatorGlobals.currentAbsoluteTime to the eventTime (event absolute occurrence time).
+ * A recurring event (see scheduleRecurring()) is not removed, but moved to its next occurrence.
+ * Events of the zero-delay queue are caused first, unless an event of the timing wheel or event chain at the current time was
+ * scheduled before them; the search for such an event stops at the current tick.
  * 
  * @return Next event to cause.
  */
 Event Scheduler::cause() {
-	try {
-		simulatorGlobals.setCurrentAbsoluteTime((eventChain.begin())->eventTime); // Sets currentAbsoluteTime to first event's eventTime (advances or jumps the clock).
-		// Removes and returns the first event.
-		Event nextEvent = eventChain.front().event;
-		eventChain.pop_front();
-		return nextEvent; 
-	}
-	catch (int e) {
+	std::list<EventChainElement> *firstList = findFirst(zeroDelayQueue.empty() ? UINT64_MAX : getTick(simulatorGlobals.getCurrentAbsoluteTime()));
+	if (!zeroDelayQueue.empty() && (firstList == nullptr || isEarlier(zeroDelayQueue.front(), firstList->front()))) {
+		simulatorGlobals.setCurrentAbsoluteTime(zeroDelayQueue.front().eventTime);
+		Event nextEvent = createEvent(zeroDelayQueue.front(), true);
+		zeroDelayQueue.pop_front();
+		return nextEvent;
+	}
+	if (firstList == nullptr) {
 		// Empty Event Chain.  Should not happen... should always have at least an END_SIMULATION event.
 		std::cout << "Event Chain is empty.  No more events to process, ending simulation..." << std::endl;
-		exit(e);
-		//return nullptr;
+		exit(1);
 	}
+	simulatorGlobals.setCurrentAbsoluteTime(firstList->front().eventTime); // Sets currentAbsoluteTime to first event's eventTime (advances or jumps the clock).
+	// Removes and returns the first event.
+	RecurringEventSource *recurringEventSource = firstList->front().recurringEventSource;
+	Event nextEvent = createEvent(firstList->front(), recurringEventSource == nullptr);
+	if (firstList != &eventChain) {
+		--wheelLevelSizes[0];
+		--wheelSize;
+	}
+	if (recurringEventSource == nullptr) {
+		firstList->pop_front();
+	} else {
+		// Re-key the element with the next occurrence and move it there.
+		EventChainElement &recurringElement = firstList->front();
+		recurringElement.occurAfterTime = recurringEventSource->nextOccurAfterTime();
+		recurringElement.eventTime = simulatorGlobals.getCurrentAbsoluteTime() + recurringElement.occurAfterTime;
+		recurringElement.sequence = nextSequence++;
+		if (wheelSize == 0) {
+			wheelCursor = getTick(simulatorGlobals.getCurrentAbsoluteTime());
+		}
+		std::list<EventChainElement> &elementList = selectList(recurringElement);
+		elementList.splice(findInsertionPoint(elementList, recurringElement), *firstList, firstList->begin());
+	}
+	return nextEvent; 
 }
 
 /**
@@ -115,33 +431,8 @@ Event Scheduler::cause() {
  * @return Returns number of events removed; zero if no matching event was found.
  */
 unsigned int Scheduler::removeEvents(std::shared_ptr<const Entity> entity) {
-	// Find all eventChainElements in which Events contain Entity object, and remove them all.
-	unsigned int removedEventsCounter = 0; // How many events were removed?
-	// Using the regular iterator loop instead of C++11 foreach, since we need the iterator to remove elements anyway (or be forced to search
-	// the list one more time to remove by value.
-	// This will actually not work, since, when removing an element, the loop iterator pointing to it will be invalidated. Therefore,
-	// cannot be incremented. See http://stackoverflow.com/questions/596162/can-you-remove-elements-from-a-stdlist-while-iterating-through-it.
-	//for (std::list<EventChainElement>::iterator eventIterator = eventChain.begin(); eventIterator != eventChain.end(); ++eventIterator) {
-	//	if (eventIterator->event.entity == entity) {
-	//		// Found event with matching Entity: remove.
-	//		eventChain.erase(eventIterator);
-	//		++removedEventsCounter; // Increment removed events counter.
-	//	}
-	//}
-	std::list<EventChainElement>::iterator eventIterator = eventChain.begin();
-	while (eventIterator != eventChain.end()) {
-		// If this event has the specified Entity object, then remove it.
-		if (eventIterator->event.entity == entity) {
-			eventIterator = eventChain.erase(eventIterator); /* Looks weird? Check http://stackoverflow.com/questions/596162/can-you-remove-elements-from-a-stdlist-while-iterating-through-it.
-															  * Notice that erase deletes the element at eventIterator, and returns the iterator to the *next* element. eventIterator has to
-															  * has to point to this next element, otherwise it will point to a no-longer existing element.
-															  */
-			++removedEventsCounter; // Increment removed events counter.
-		} else {
-			++eventIterator;
-		}
-	}
-	return removedEventsCounter;
+	// Find all eventChainElements in which Events contain Entity object, in the timing wheel and in the event chain, and remove them all.
+	return removeElements([this, &entity](const EventChainElement &element) { return getPayloadEntity(element.payload) == entity.get(); });
 }
 
 /**
@@ -150,7 +441,161 @@ unsigned int Scheduler::removeEvents(std::shared_ptr<const Entity> entity) {
  * @return Size of event chain, in size_type.
  */
 std::list<EventChainElement>::size_type Scheduler::getChainSize() const {
-	return eventChain.size();
+	return zeroDelayQueue.size() + eventChain.size() + wheelSize;
+}
+
+/**
+ * @brief Whether no event is pending at the current time, i.e., an event scheduled now with zero delay would be the next event caused.
+ *
+ * @return True if the zero-delay queue is empty and the next event of the timing wheel or event chain, if any, is later than the current time.
+ */
+bool Scheduler::isCurrentTimeDrained() {
+	if (!zeroDelayQueue.empty()) {
+		return false;
+	}
+	double currentTime = simulatorGlobals.getCurrentAbsoluteTime();
+	std::list<EventChainElement> *firstList = findFirst(getTick(currentTime));
+	return firstList == nullptr || firstList->front().eventTime > currentTime;
+}
+
+/**
+ * @brief Schedule the zero-delay continuation of the event being handled, or fuse it, i.e., let the driver handle it directly.
+ *
+ * @details 
+ * For chains of events at the same instant on the same entity (e.g., END_PROPAGATION_AT_LINK, PDUTOKEN_ARRIVAL_AT_NODE and
+ * REQUEST_PDU_TRANSMISSION_AT_LINK for a PDU). Must be the last action of the handler of currentEvent: the continuation is fused only if
+ * fusion is on and no other event is pending at the current time (see isCurrentTimeDrained()), in which case scheduling it would make it the
+ * next event caused, at the same time. currentEvent then becomes the continuation, and the driver handles it as if just caused.
+ * In verification mode, the continuation is scheduled and caused instead; if the event caused is not the continuation, or the clock moved,
+ * the simulation is aborted.
+ *
+ * @param currentEvent Event being handled; becomes the continuation if fused.
+ * @param nextEventType Type of the continuation, with the same entity as currentEvent.
+ * @return True if fused (the driver must handle currentEvent now); false if the continuation was scheduled.
+ */
+bool Scheduler::scheduleOrFuse(Event &currentEvent, EventType nextEventType) {
+	// The continuation keeps the payload of currentEvent, with its tag.
+	if (!isFusionOn || !isCurrentTimeDrained()) {
+		Event nextEvent = currentEvent;
+		nextEvent.occurAfterTime = 0.0;
+		nextEvent.eventType = nextEventType;
+		schedule(nextEvent);
+		return false;
+	}
+	++fusedEventsCount;
+	currentEvent.occurAfterTime = 0.0;
+	currentEvent.eventType = nextEventType;
+	if (isFusionVerified) {
+		double currentTime = simulatorGlobals.getCurrentAbsoluteTime();
+		Event nextEvent = currentEvent;
+		schedule(nextEvent);
+		currentEvent = cause();
+		if (currentEvent != nextEvent || simulatorGlobals.getCurrentAbsoluteTime() != currentTime) {
+			std::cout << "Scheduler::scheduleOrFuse: fused event is not the next event scheduled. Aborting..." << std::endl;
+			exit(1);
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Turn fusion of zero-delay continuations on or off (see scheduleOrFuse()).
+ *
+ * @param isFusionOn True to fuse continuations; false to always schedule them.
+ * @param isFusionVerified True to schedule and cause fused continuations anyway, verifying that they are the next events (debug mode).
+ */
+void Scheduler::setFusion(bool isFusionOn, bool isFusionVerified) {
+	this->isFusionOn = isFusionOn;
+	this->isFusionVerified = isFusionVerified;
+}
+
+/**
+ * @brief Number of continuations fused by scheduleOrFuse(), including those verified.
+ *
+ * @return Number of events fused.
+ */
+unsigned int Scheduler::getFusedEventsCount() const {
+	return fusedEventsCount;
+}
+
+/**
+ * @brief Configure the timing wheel; events already scheduled are moved accordingly.
+ *
+ * @details 
+ * Events within wheelTick * SCHEDULER_WHEEL_SLOTS^wheelLevels of the cursor are kept in the wheel, and the others in the ordered event
+ * chain. The tick should be in the order of the short delays of the simulation (e.g., transmission times); the order of events does not
+ * depend on it.
+ *
+ * @param wheelTick Duration of a tick, in seconds; positive.
+ * @param wheelLevels Number of levels, up to SCHEDULER_WHEEL_MAXIMUM_LEVELS; zero turns the wheel off (all events in the event chain).
+ */
+void Scheduler::setTimingWheel(double wheelTick, unsigned int wheelLevels) {
+	std::list<EventChainElement> elements;
+	for (auto &slotList : wheelSlots) {
+		elements.splice(elements.end(), slotList);
+	}
+	elements.splice(elements.end(), eventChain);
+	this->wheelTick = wheelTick;
+	this->wheelLevels = std::min(wheelLevels, static_cast<unsigned int>(SCHEDULER_WHEEL_MAXIMUM_LEVELS));
+	wheelSlots = std::vector<std::list<EventChainElement>>(this->wheelLevels * SCHEDULER_WHEEL_SLOTS);
+	wheelLevelSizes.assign(this->wheelLevels, 0);
+	wheelSize = 0;
+	wheelCursor = getTick(simulatorGlobals.getCurrentAbsoluteTime());
+	while (!elements.empty()) {
+		std::list<EventChainElement> &elementList = selectList(elements.front());
+		elementList.splice(findInsertionPoint(elementList, elements.front()), elements, elements.begin());
+	}
+}
+
+/**
+ * @brief Horizon of the timing wheel, i.e., how far its blocks reach, at most, from the current tick.
+ *
+ * @return Horizon, in seconds; zero if the wheel is off.
+ */
+double Scheduler::getTimingWheelHorizon() const {
+	double horizon = wheelLevels > 0 ? wheelTick : 0.0;
+	for (unsigned int level = 0; level < wheelLevels; ++level) {
+		horizon *= SCHEDULER_WHEEL_SLOTS;
+	}
+	return horizon;
+}
+
+/**
+ * @brief Remove all events, from the timing wheel and from the event chain.
+ */
+void Scheduler::clearEventChain() {
+	for (auto &slotList : wheelSlots) {
+		slotList.clear();
+	}
+	wheelLevelSizes.assign(wheelLevels, 0);
+	wheelSize = 0;
+	eventChain.clear();
+	zeroDelayQueue.clear();
+	payloadEntities.clear();
+	freePayloadSlots.clear();
+}
+
+/**
+ * @brief All events, in the order they will be caused.
+ *
+ * @return Elements of the timing wheel and of the event chain, in order.
+ */
+std::vector<const EventChainElement *> Scheduler::getOrderedElements() const {
+	std::vector<const EventChainElement *> elements;
+	elements.reserve(getChainSize());
+	for (auto &element : zeroDelayQueue) {
+		elements.push_back(&element);
+	}
+	for (auto &slotList : wheelSlots) {
+		for (auto &element : slotList) {
+			elements.push_back(&element);
+		}
+	}
+	for (auto &element : eventChain) {
+		elements.push_back(&element);
+	}
+	std::sort(elements.begin(), elements.end(), [](const EventChainElement *left, const EventChainElement *right) { return isEarlier(*left, *right); });
+	return elements;
 }
 
 
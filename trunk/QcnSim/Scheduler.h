@@ -22,8 +22,19 @@
 #include "EventChainElement.h"
 #include "SimulatorGlobals.h"
 #include "Entity.h"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <list>
 #include <iostream>
+#include <memory>
+#include <vector>
+
+#define SCHEDULER_WHEEL_TICK 0.001 //!< Default tick of the timing wheel of the Scheduler, in seconds.
+#define SCHEDULER_WHEEL_LEVELS 3 //!< Default number of levels of the timing wheel; the horizon is SCHEDULER_WHEEL_TICK * SCHEDULER_WHEEL_SLOTS^levels.
+#define SCHEDULER_WHEEL_SLOT_BITS 6 //!< Log2 of the number of slots per level of the timing wheel.
+#define SCHEDULER_WHEEL_SLOTS (1u << SCHEDULER_WHEEL_SLOT_BITS) //!< Number of slots per level of the timing wheel.
+#define SCHEDULER_WHEEL_MAXIMUM_LEVELS 9 //!< Maximum number of levels of the timing wheel (ticks are 64-bit).
 
 /**
  * @brief Scheduler class.
@@ -53,7 +64,26 @@
  * simulation will proceed by causing events in the Event Chain. If there is no more events 
  * in the Event Chain, then the simulation must halt. The simulation can also be stopped according
  * to other criteria, such as by reaching a target simulation time.
-
+ *
+ * Events within a horizon (see setTimingWheel()) are kept in a hierarchical timing wheel, since most events are scheduled with zero or
+ * very short delays (arrivals at nodes, transmission requests, transmission times); events further away are kept in the ordered list
+ * eventChain. The wheel has levels of SCHEDULER_WHEEL_SLOTS slots: a slot of level 0 holds the events of one tick, ordered, and a slot of
+ * level l the events of SCHEDULER_WHEEL_SLOTS^l ticks, unordered, which are cascaded down as the clock approaches them. Ticks only select
+ * slots: event times are never rounded, and events are caused in exact order of time, with ties broken by scheduling order (events scheduled
+ * with scheduleFront() first). The order of events is thus the same as with a single ordered list, with or without the wheel.
+ *
+ * Events scheduled with zero delay, and with scheduleFront(), bypass both: they happen at the current time, after (or, for scheduleFront(),
+ * before) all events already scheduled for it, thus they are kept in a FIFO queue, appended (or pushed to its front) in constant time.
+ * cause() drains this queue before moving the clock, taking first only the events at the current time scheduled earlier.
+ *
+ * With fusion on (see setFusion()), a driver may hand a zero-delay event that continues the event being handled, as its last action, to
+ * scheduleOrFuse(): if no other event is pending at the current time, the continuation would be the very next event caused, thus the
+ * driver handles it directly, with no event scheduled. In verification mode, the event is scheduled and caused instead, and the Scheduler
+ * checks that it was indeed the next event, such that fused and scheduled runs are known to give the same trace.
+ *
+ * Event chain elements are trivially copyable (see EventChainElement): the entities owned by scheduled events are kept in a table of slots,
+ * reused as events are caused or removed, and the payload of each element holds the index of its slot. cause() rebuilds the Event, moving
+ * the entity out of its slot.
  */
 class Scheduler {
 private:
@@ -62,8 +92,74 @@ private:
 	* Will have to use a list and make_heap, push_heap, pop_heap, etc. to maintain heap property.
 	*/
 	//std::priority_queue<EventChainElement> eventChain; //!<The Event Chain as a min-heap ordered by eventTime.
-	std::list<EventChainElement> eventChain; //!<The Event Chain as a min-heap ordered by eventTime. Underlying container is a list, and this class should maintain heap order.
+	std::list<EventChainElement> eventChain; //!<The Event Chain as a min-heap ordered by eventTime. Underlying container is a list, and this class should maintain heap order. Holds the events beyond the horizon of the timing wheel.
 	SimulatorGlobals &simulatorGlobals;  //!< Reference to SimulatorGlobals object, to control simulation clock time and etc.
+	double wheelTick; //!< Duration of a tick of the timing wheel, in seconds.
+	unsigned int wheelLevels; //!< Number of levels of the timing wheel; zero if the wheel is off.
+	uint64_t wheelCursor; //!< Current tick of the timing wheel; no event of the wheel is earlier.
+	std::vector<std::list<EventChainElement>> wheelSlots; //!< Slots of the timing wheel, level by level (slot s of level l at l * SCHEDULER_WHEEL_SLOTS + s).
+	std::vector<std::list<EventChainElement>::size_type> wheelLevelSizes; //!< Number of events of each level of the timing wheel.
+	std::list<EventChainElement>::size_type wheelSize; //!< Number of events in the timing wheel.
+	std::deque<EventChainElement> zeroDelayQueue; //!< Events at the current time scheduled with zero delay or scheduleFront(), in order.
+	int64_t nextSequence; //!< Sequence of the next event scheduled.
+	int64_t nextFrontSequence; //!< Sequence of the next event scheduled with scheduleFront(); decreasing and negative.
+	bool isFusionOn; //!< True if scheduleOrFuse() may fuse events.
+	bool isFusionVerified; //!< True if fused events are scheduled and caused anyway, to verify that they are the next events.
+	unsigned int fusedEventsCount; //!< Number of events fused by scheduleOrFuse().
+	std::vector<std::shared_ptr<const Entity>> payloadEntities; //!< Entities owned by scheduled events, by slot (see EventPayload::index); empty slots hold nullptr.
+	std::vector<uint32_t> freePayloadSlots; //!< Slots of payloadEntities free for reuse.
+
+	static bool isEarlier(const EventChainElement &left, const EventChainElement &right);
+	static bool isOwnedPayload(EventPayloadType payloadType);
+	EventChainElement createElement(double eventTime, const Event &event, RecurringEventSource *recurringEventSource = nullptr);
+	Event createEvent(const EventChainElement &element, bool isPayloadReleased);
+	void releasePayload(const EventPayload &payload);
+	const Entity *getPayloadEntity(const EventPayload &payload) const;
+	uint64_t getTick(double eventTime) const;
+	std::list<EventChainElement> &selectList(const EventChainElement &element);
+	std::list<EventChainElement>::iterator findInsertionPoint(std::list<EventChainElement> &elementList, const EventChainElement &element);
+	void insert(const EventChainElement &element);
+	void cascade(unsigned int level, unsigned int slot);
+	std::list<EventChainElement> *findFirst(uint64_t tickLimit = UINT64_MAX);
+	void clearEventChain();
+	std::vector<const EventChainElement *> getOrderedElements() const;
+
+	/**
+	 * @brief Remove the events that satisfy a predicate, from the zero-delay queue, the timing wheel and eventChain, releasing their payloads.
+	 *
+	 * @param predicate Predicate on EventChainElement.
+	 * @return Number of events removed.
+	 */
+	template<typename Predicate> unsigned int removeElements(Predicate predicate) {
+		// std::remove_if applies the predicate exactly once per element, thus each payload is released once.
+		auto isRemoved = [this, &predicate](const EventChainElement &element) {
+			if (!predicate(element)) {
+				return false;
+			}
+			releasePayload(element.payload);
+			return true;
+		};
+		std::deque<EventChainElement>::size_type zeroDelayQueueSize = zeroDelayQueue.size();
+		zeroDelayQueue.erase(std::remove_if(zeroDelayQueue.begin(), zeroDelayQueue.end(), isRemoved), zeroDelayQueue.end());
+		unsigned int removedEventsCounter = static_cast<unsigned int>(zeroDelayQueueSize - zeroDelayQueue.size());
+		for (std::vector<std::list<EventChainElement>>::size_type slotIndex = 0; slotIndex <= wheelSlots.size(); ++slotIndex) {
+			std::list<EventChainElement> &elementList = slotIndex < wheelSlots.size() ? wheelSlots[slotIndex] : eventChain;
+			std::list<EventChainElement>::iterator eventIterator = elementList.begin();
+			while (eventIterator != elementList.end()) {
+				if (isRemoved(*eventIterator)) {
+					eventIterator = elementList.erase(eventIterator);
+					++removedEventsCounter;
+					if (slotIndex < wheelSlots.size()) {
+						--wheelLevelSizes[slotIndex / SCHEDULER_WHEEL_SLOTS];
+						--wheelSize;
+					}
+				} else {
+					++eventIterator;
+				}
+			}
+		}
+		return removedEventsCounter;
+	}
 
 public:
 	Scheduler(SimulatorGlobals &simulatorGlobals, const Event &event);
@@ -71,8 +167,18 @@ public:
 
 	void schedule(const Event &event);
 	void scheduleFront(const Event &event);
+	void scheduleRecurring(const Event &event, RecurringEventSource &recurringEventSource);
+	unsigned int cancelRecurring(const RecurringEventSource &recurringEventSource);
 	Event cause();
 	unsigned int removeEvents(std::shared_ptr<const Entity> entity);
 	std::list<EventChainElement>::size_type getChainSize() const;
+	bool scheduleOrFuse(Event &currentEvent, EventType nextEventType);
+	bool isCurrentTimeDrained();
+	void setFusion(bool isFusionOn, bool isFusionVerified = false);
+	unsigned int getFusedEventsCount() const;
+	void setTimingWheel(double wheelTick, unsigned int wheelLevels = SCHEDULER_WHEEL_LEVELS);
+	double getTimingWheelHorizon() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores the event chain.
 };
 
@@ -0,0 +1,459 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SensorSpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Default constructor: empty index.
+ */
+SensorSpatialIndex::SensorSpatialIndex(): isBuilt(true) {
+	std::fill(lowerCorner, lowerCorner + 3, 0.0);
+	std::fill(upperCorner, upperCorner + 3, 0.0);
+}
+
+/**
+ * @brief Constructor with all QCN sensors of a topology.
+ *
+ * @param topology Topology whose qcnSensorTrafficGeneratorMap is indexed.
+ */
+SensorSpatialIndex::SensorSpatialIndex(const Topology &topology): isBuilt(true) {
+	std::fill(lowerCorner, lowerCorner + 3, 0.0);
+	std::fill(upperCorner, upperCorner + 3, 0.0);
+	addSensors(topology);
+	build();
+}
+
+/**
+ * @brief Add an entity at a location.
+ *
+ * @param latitude Latitude of the entity.
+ * @param longitude Longitude of the entity.
+ * @param entity Entity to add.
+ */
+void SensorSpatialIndex::add(double latitude, double longitude, std::shared_ptr<Entity> entity) {
+	Entry entry;
+	GeoUtilities::toUnitVector(latitude, longitude, entry.coordinates);
+	entry.latitude = latitude;
+	entry.longitude = longitude;
+	entry.entity = std::move(entity);
+	entry.addedIndex = entries.size();
+	entries.push_back(std::move(entry));
+	isBuilt = false;
+}
+
+/**
+ * @brief Add a QCN sensor at its location.
+ *
+ * @param sensor Sensor to add.
+ */
+void SensorSpatialIndex::addSensor(std::shared_ptr<QcnSensorTrafficGenerator> sensor) {
+	double latitude = sensor->getLatitude();
+	double longitude = sensor->getLongitude();
+	add(latitude, longitude, std::move(sensor));
+}
+
+/**
+ * @brief Add all QCN sensors of a topology.
+ *
+ * @param topology Topology whose qcnSensorTrafficGeneratorMap is added.
+ */
+void SensorSpatialIndex::addSensors(const Topology &topology) {
+	entries.reserve(entries.size() + topology.qcnSensorTrafficGeneratorMap.size());
+	for (auto &sensorPair : topology.qcnSensorTrafficGeneratorMap) {
+		addSensor(sensorPair.second);
+	}
+}
+
+/**
+ * @brief Build the k-d tree, if entities were added since it was last built.
+ */
+void SensorSpatialIndex::build() {
+	if (isBuilt) {
+		return;
+	}
+	std::fill(lowerCorner, lowerCorner + 3, std::numeric_limits<double>::infinity());
+	std::fill(upperCorner, upperCorner + 3, -std::numeric_limits<double>::infinity());
+	for (auto &entry : entries) {
+		for (int axis = 0; axis < 3; ++axis) {
+			lowerCorner[axis] = std::min(lowerCorner[axis], entry.coordinates[axis]);
+			upperCorner[axis] = std::max(upperCorner[axis], entry.coordinates[axis]);
+		}
+	}
+	splitAxes.assign(entries.size(), 0);
+	buildRange(0, entries.size());
+	isBuilt = true;
+}
+
+/**
+ * @brief Build the k-d tree over a range of entries.
+ *
+ * @details 
+ * The entry at the middle of the range becomes the split entry: entries before it are not above it along the axis of widest spread, and
+ * entries after it are not below it.
+ *
+ * @param begin First entry of the range.
+ * @param end One past the last entry of the range.
+ */
+void SensorSpatialIndex::buildRange(std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end) {
+	if (end - begin <= SPATIAL_INDEX_LEAF_SIZE) {
+		return;
+	}
+	double spreads[3];
+	for (int axis = 0; axis < 3; ++axis) {
+		auto extremes = std::minmax_element(entries.begin() + begin, entries.begin() + end, [axis](const Entry &left, const Entry &right) {
+			return left.coordinates[axis] < right.coordinates[axis];
+		});
+		spreads[axis] = extremes.second->coordinates[axis] - extremes.first->coordinates[axis];
+	}
+	uint8_t splitAxis = static_cast<uint8_t>(std::max_element(spreads, spreads + 3) - spreads);
+	std::vector<Entry>::size_type middle = begin + (end - begin) / 2;
+	std::nth_element(entries.begin() + begin, entries.begin() + middle, entries.begin() + end, [splitAxis](const Entry &left, const Entry &right) {
+		return left.coordinates[splitAxis] < right.coordinates[splitAxis];
+	});
+	splitAxes[middle] = splitAxis;
+	buildRange(begin, middle);
+	buildRange(middle + 1, end);
+}
+
+/**
+ * @brief Get number of entities in the index.
+ *
+ * @return Number of entities.
+ */
+std::vector<SensorSpatialIndex::Entry>::size_type SensorSpatialIndex::getSize() const {
+	return entries.size();
+}
+
+/**
+ * @brief Find all entities within a great-circle distance of a location.
+ *
+ * @param latitude Latitude of the center.
+ * @param longitude Longitude of the center.
+ * @param radius Great-circle radius, in Km.
+ * @return Entities within the radius (inclusive), in no particular order.
+ */
+std::vector<std::shared_ptr<Entity>> SensorSpatialIndex::findWithinRadius(double latitude, double longitude, double radius) {
+	build();
+	double point[3];
+	GeoUtilities::toUnitVector(latitude, longitude, point);
+	std::vector<std::shared_ptr<Entity>> found;
+	findWithinRange(point, chordSquared(radius), 0, entries.size(), found);
+	return found;
+}
+
+/**
+ * @brief Find the entities of a range within a chord of a point.
+ *
+ * @param point Unit vector to the center.
+ * @param chordSquared Squared chord, in unit-vector space, corresponding to the radius.
+ * @param begin First entry of the range.
+ * @param end One past the last entry of the range.
+ * @param found Entities found are appended here.
+ */
+void SensorSpatialIndex::findWithinRange(const double *point, double chordSquared, std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end,
+		std::vector<std::shared_ptr<Entity>> &found) const {
+	if (end - begin <= SPATIAL_INDEX_LEAF_SIZE) {
+		for (auto i = begin; i < end; ++i) {
+			if (distanceSquared(point, entries[i].coordinates) <= chordSquared) {
+				found.push_back(entries[i].entity);
+			}
+		}
+		return;
+	}
+	std::vector<Entry>::size_type middle = begin + (end - begin) / 2;
+	if (distanceSquared(point, entries[middle].coordinates) <= chordSquared) {
+		found.push_back(entries[middle].entity);
+	}
+	double difference = point[splitAxes[middle]] - entries[middle].coordinates[splitAxes[middle]];
+	if (difference <= 0.0 || difference * difference <= chordSquared) {
+		findWithinRange(point, chordSquared, begin, middle, found);
+	}
+	if (difference >= 0.0 || difference * difference <= chordSquared) {
+		findWithinRange(point, chordSquared, middle + 1, end, found);
+	}
+}
+
+/**
+ * @brief Find the k entities nearest to a location.
+ *
+ * @param latitude Latitude of the location.
+ * @param longitude Longitude of the location.
+ * @param k Number of entities to find.
+ * @return Up to k entities, nearest first.
+ */
+std::vector<std::shared_ptr<Entity>> SensorSpatialIndex::findNearest(double latitude, double longitude, unsigned int k) {
+	build();
+	double point[3];
+	GeoUtilities::toUnitVector(latitude, longitude, point);
+	std::vector<std::pair<double, std::vector<Entry>::size_type>> nearest; // Max-heap of (squared distance, entry), at most k.
+	if (k > 0) {
+		findNearestInRange(point, k, 0, entries.size(), nearest);
+	}
+	std::sort_heap(nearest.begin(), nearest.end());
+	std::vector<std::shared_ptr<Entity>> found;
+	for (auto &nearestPair : nearest) {
+		found.push_back(entries[nearestPair.second].entity);
+	}
+	return found;
+}
+
+/**
+ * @brief Find the k entities of a range nearest to a point.
+ *
+ * @param point Unit vector to the location.
+ * @param k Number of entities to find.
+ * @param begin First entry of the range.
+ * @param end One past the last entry of the range.
+ * @param nearest Max-heap of the nearest entries found so far, updated.
+ */
+void SensorSpatialIndex::findNearestInRange(const double *point, unsigned int k, std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end,
+		std::vector<std::pair<double, std::vector<Entry>::size_type>> &nearest) const {
+	auto consider = [&](std::vector<Entry>::size_type i) {
+		double distance = distanceSquared(point, entries[i].coordinates);
+		if (nearest.size() < k) {
+			nearest.push_back(std::make_pair(distance, i));
+			std::push_heap(nearest.begin(), nearest.end());
+		} else if (distance < nearest.front().first) {
+			std::pop_heap(nearest.begin(), nearest.end());
+			nearest.back() = std::make_pair(distance, i);
+			std::push_heap(nearest.begin(), nearest.end());
+		}
+	};
+	if (end - begin <= SPATIAL_INDEX_LEAF_SIZE) {
+		for (auto i = begin; i < end; ++i) {
+			consider(i);
+		}
+		return;
+	}
+	std::vector<Entry>::size_type middle = begin + (end - begin) / 2;
+	consider(middle);
+	double difference = point[splitAxes[middle]] - entries[middle].coordinates[splitAxes[middle]];
+	// Search the side of the point first; the other side only if it may hold nearer entries.
+	if (difference <= 0.0) {
+		findNearestInRange(point, k, begin, middle, nearest);
+		if (nearest.size() < k || difference * difference < nearest.front().first) {
+			findNearestInRange(point, k, middle + 1, end, nearest);
+		}
+	} else {
+		findNearestInRange(point, k, middle + 1, end, nearest);
+		if (nearest.size() < k || difference * difference < nearest.front().first) {
+			findNearestInRange(point, k, begin, middle, nearest);
+		}
+	}
+}
+
+/**
+ * @brief Assign each entity of this index to its k nearest entities of another index.
+ *
+ * @details 
+ * For instance, with sensors in this index and servers in targetIndex, gives the k servers nearest to each sensor.
+ *
+ * @param targetIndex Index of the entities to assign to.
+ * @param k Number of entities of targetIndex assigned to each entity.
+ * @return Each entity of this index with its assigned entities, nearest first.
+ */
+std::vector<std::pair<std::shared_ptr<Entity>, std::vector<std::shared_ptr<Entity>>>> SensorSpatialIndex::assignNearest(SensorSpatialIndex &targetIndex,
+		unsigned int k) {
+	std::vector<std::pair<std::shared_ptr<Entity>, std::vector<std::shared_ptr<Entity>>>> assignments;
+	assignments.reserve(entries.size());
+	for (auto &entry : entries) {
+		assignments.push_back(std::make_pair(entry.entity, targetIndex.findNearest(entry.latitude, entry.longitude, k)));
+	}
+	return assignments;
+}
+
+/**
+ * @brief Start an expanding-ring sweep from a hypocenter.
+ *
+ * @param latitude Latitude of the epicenter.
+ * @param longitude Longitude of the epicenter.
+ * @param depth Depth of the hypocenter, in Km; zero sweeps from a location at the surface.
+ * @return Sweep, positioned before the nearest entity.
+ */
+SensorSpatialIndex::Sweep SensorSpatialIndex::sweep(double latitude, double longitude, double depth) {
+	return Sweep(*this, latitude, longitude, depth);
+}
+
+/**
+ * @brief Squared straight-line distance between two points.
+ *
+ * @param pointA First point.
+ * @param pointB Second point.
+ * @return Squared distance.
+ */
+double SensorSpatialIndex::distanceSquared(const double *pointA, const double *pointB) {
+	double deltaX = pointA[0] - pointB[0];
+	double deltaY = pointA[1] - pointB[1];
+	double deltaZ = pointA[2] - pointB[2];
+	return deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ;
+}
+
+/**
+ * @brief Squared chord, in unit-vector space, subtending a great-circle distance.
+ *
+ * @param distance Great-circle distance, in Km.
+ * @return Squared chord; distances beyond half the circumference give the diameter.
+ */
+double SensorSpatialIndex::chordSquared(double distance) {
+	if (distance < 0.0) {
+		return -1.0;
+	}
+	double chord = 2.0 * std::sin(std::min(distance / EARTH_RADIUS, GEO_PI) / 2.0);
+	return chord * chord * (1.0 + 1e-12); // Relative tolerance, such that entries exactly at the radius are found.
+}
+
+/**
+ * @brief Constructor: starts an expanding-ring sweep.
+ *
+ * @param sensorSpatialIndex Index to sweep; its k-d tree is built if needed.
+ * @param latitude Latitude of the epicenter.
+ * @param longitude Longitude of the epicenter.
+ * @param depth Depth of the hypocenter, in Km.
+ */
+SensorSpatialIndex::Sweep::Sweep(SensorSpatialIndex &sensorSpatialIndex, double latitude, double longitude, double depth): sensorSpatialIndex(sensorSpatialIndex) {
+	sensorSpatialIndex.build();
+	GeoUtilities::toUnitVector(latitude, longitude, hypocenter);
+	for (auto &coordinate : hypocenter) {
+		coordinate *= (EARTH_RADIUS - depth) / EARTH_RADIUS;
+	}
+	if (!sensorSpatialIndex.entries.empty()) {
+		pushRange(0, sensorSpatialIndex.entries.size(), sensorSpatialIndex.lowerCorner, sensorSpatialIndex.upperCorner);
+	}
+}
+
+/**
+ * @brief Queue a range of the k-d tree, keyed by the distance from the hypocenter to its bounding box.
+ *
+ * @param begin First entry of the range.
+ * @param end One past the last entry of the range.
+ * @param lowerCorner Lower corner of the box bounding the range.
+ * @param upperCorner Upper corner of the box bounding the range.
+ */
+void SensorSpatialIndex::Sweep::pushRange(std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end, const double *lowerCorner,
+		const double *upperCorner) {
+	if (begin >= end) {
+		return;
+	}
+	Item item;
+	item.distanceSquared = 0.0;
+	for (int axis = 0; axis < 3; ++axis) {
+		double outside = std::max(0.0, std::max(lowerCorner[axis] - hypocenter[axis], hypocenter[axis] - upperCorner[axis]));
+		item.distanceSquared += outside * outside;
+		item.lowerCorner[axis] = lowerCorner[axis];
+		item.upperCorner[axis] = upperCorner[axis];
+	}
+	item.begin = begin;
+	item.end = end;
+	item.isEntry = false;
+	items.push(item);
+}
+
+/**
+ * @brief Split queued ranges until the nearest item is a single entry, or no item is left.
+ */
+void SensorSpatialIndex::Sweep::expandToEntry() {
+	const std::vector<Entry> &entries = sensorSpatialIndex.entries;
+	while (!items.empty() && !items.top().isEntry) {
+		Item range = items.top();
+		items.pop();
+		Item entryItem;
+		entryItem.isEntry = true;
+		if (range.end - range.begin <= SPATIAL_INDEX_LEAF_SIZE) {
+			for (auto i = range.begin; i < range.end; ++i) {
+				entryItem.distanceSquared = distanceSquared(hypocenter, entries[i].coordinates);
+				entryItem.begin = i;
+				entryItem.end = i + 1;
+				items.push(entryItem);
+			}
+			continue;
+		}
+		std::vector<Entry>::size_type middle = range.begin + (range.end - range.begin) / 2;
+		uint8_t splitAxis = sensorSpatialIndex.splitAxes[middle];
+		entryItem.distanceSquared = distanceSquared(hypocenter, entries[middle].coordinates);
+		entryItem.begin = middle;
+		entryItem.end = middle + 1;
+		items.push(entryItem);
+		double corner[3];
+		std::copy(range.upperCorner, range.upperCorner + 3, corner);
+		corner[splitAxis] = entries[middle].coordinates[splitAxis];
+		pushRange(range.begin, middle, range.lowerCorner, corner);
+		std::copy(range.lowerCorner, range.lowerCorner + 3, corner);
+		corner[splitAxis] = entries[middle].coordinates[splitAxis];
+		pushRange(middle + 1, range.end, corner, range.upperCorner);
+	}
+}
+
+/**
+ * @brief Whether entities are left to sweep.
+ *
+ * @return True if next() returns an entity.
+ */
+bool SensorSpatialIndex::Sweep::hasNext() {
+	expandToEntry();
+	return !items.empty();
+}
+
+/**
+ * @brief Get the distance from the hypocenter to the next entity.
+ *
+ * @return Straight-line distance, in Km; infinity if no entity is left.
+ */
+double SensorSpatialIndex::Sweep::getNextDistance() {
+	expandToEntry();
+	return items.empty() ? std::numeric_limits<double>::infinity() : EARTH_RADIUS * std::sqrt(items.top().distanceSquared);
+}
+
+/**
+ * @brief Get the order of addition of the next entity, e.g., to find data kept alongside the index for that entity.
+ *
+ * @return Order of addition, 0 for the first entity added; getSize() if no entity is left.
+ */
+std::vector<SensorSpatialIndex::Entry>::size_type SensorSpatialIndex::Sweep::getNextAddedIndex() {
+	expandToEntry();
+	return items.empty() ? sensorSpatialIndex.entries.size() : sensorSpatialIndex.entries[items.top().begin].addedIndex;
+}
+
+/**
+ * @brief Get the next entity, in increasing distance from the hypocenter.
+ *
+ * @return Next entity; nullptr if no entity is left.
+ */
+std::shared_ptr<Entity> SensorSpatialIndex::Sweep::next() {
+	expandToEntry();
+	if (items.empty()) {
+		return nullptr;
+	}
+	std::vector<Entry>::size_type i = items.top().begin;
+	items.pop();
+	return sensorSpatialIndex.entries[i].entity;
+}
+
+/**
+ * @brief Expand the ring to a distance, and get the entities reached.
+ *
+ * @details 
+ * For a wave of speed v from the hypocenter, advanceTo(v * t) gives the entities reached up to time t after the origin, in arrival order.
+ *
+ * @param distance Straight-line distance from the hypocenter, in Km.
+ * @return Entities within the distance (inclusive) not yet returned, nearest first.
+ */
+std::vector<std::shared_ptr<Entity>> SensorSpatialIndex::Sweep::advanceTo(double distance) {
+	std::vector<std::shared_ptr<Entity>> reached;
+	while (getNextDistance() <= distance) {
+		reached.push_back(next());
+	}
+	return reached;
+}
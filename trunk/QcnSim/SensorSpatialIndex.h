@@ -0,0 +1,124 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+#include "GeoUtilities.h"
+#include "QcnSensorTrafficGenerator.h"
+#include "Topology.h"
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#define SPATIAL_INDEX_LEAF_SIZE 8 //!< Largest number of entries in a leaf of the k-d tree, searched linearly.
+
+/**
+ * @brief Sensor Spatial Index class.
+ * 
+ * @par Description
+ * Spatial index of entities located on the Earth surface, typically QCN sensors (see addSensors()), but also servers or other nodes given their
+ * location (see add()). It supports:
+ * - radius queries: all entities within a great-circle distance of a location (findWithinRadius());
+ * - k-nearest queries: the k entities nearest to a location, in distance order (findNearest()), and the assignment of each entity of this index
+ *   to its k nearest entities of another index, e.g., of each sensor to its nearest servers (assignNearest());
+ * - expanding-ring sweeps: the entities in increasing distance from a hypocenter, produced incrementally as the radius grows (see Sweep), such
+ *   that a wavefront reaches sensors in arrival order without sorting all sensors up front (see QuakeWaveModel).
+ *
+ * Locations are kept as Earth-centered unit vectors, in an implicit k-d tree: a single array of entries, reordered such that the entry at the
+ * middle of each range splits it along the axis of widest spread, and ranges of up to SPATIAL_INDEX_LEAF_SIZE entries are leaves. Straight-line
+ * distances between unit vectors increase with great-circle distances, thus queries need no trigonometry per entry.
+ *
+ * Entities are added first, and the tree is built on the first query or by build(); adding entities afterwards rebuilds it. Entities with equal
+ * distances are returned in an unspecified order.
+ */
+class SensorSpatialIndex {
+private:
+	/// Located entity.
+	struct Entry {
+		double coordinates[3]; //!< Unit vector to the location (Earth-centered).
+		double latitude; //!< Latitude of the location.
+		double longitude; //!< Longitude of the location.
+		std::shared_ptr<Entity> entity; //!< Entity at the location.
+		std::vector<Entry>::size_type addedIndex; //!< Order of addition of the entity; 0 for the first one.
+	};
+
+	std::vector<Entry> entries; //!< Entries, in k-d tree order once built.
+	std::vector<uint8_t> splitAxes; //!< Split axis of the range whose middle is each entry; only meaningful for entries splitting a range.
+	double lowerCorner[3]; //!< Lower corner of the box bounding all entries.
+	double upperCorner[3]; //!< Upper corner of the box bounding all entries.
+	bool isBuilt; //!< True if entries are in k-d tree order.
+
+	void buildRange(std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end);
+	void findWithinRange(const double *point, double chordSquared, std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end,
+		std::vector<std::shared_ptr<Entity>> &found) const;
+	void findNearestInRange(const double *point, unsigned int k, std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end,
+		std::vector<std::pair<double, std::vector<Entry>::size_type>> &nearest) const;
+	static double distanceSquared(const double *pointA, const double *pointB);
+	static double chordSquared(double distance);
+
+public:
+	/**
+	 * @brief Expanding-ring sweep of a SensorSpatialIndex.
+	 *
+	 * @details 
+	 * Produces the entities of the index in increasing straight-line distance from a hypocenter (a location at some depth), i.e., in the order
+	 * a wave of constant speed reaches them. The k-d tree is traversed best-first: ranges wait in a priority queue keyed by the distance to
+	 * their bounding box, and are only split when the sweep reaches them, thus the cost of each step is logarithmic and entities beyond the
+	 * current radius are never visited. The index must not change while the sweep is in use.
+	 */
+	class Sweep {
+	private:
+		/// Range of the k-d tree (or single entry) waiting to be reached.
+		struct Item {
+			double distanceSquared; //!< Squared distance to the entry, or lower bound of the distances within the range.
+			std::vector<Entry>::size_type begin; //!< First entry of the range.
+			std::vector<Entry>::size_type end; //!< One past the last entry of the range; begin + 1 for a single entry.
+			bool isEntry; //!< True if the item is a single entry, already at its exact distance.
+			double lowerCorner[3]; //!< Lower corner of the box bounding the range.
+			double upperCorner[3]; //!< Upper corner of the box bounding the range.
+			/// Priority queue order: nearest first.
+			bool operator<(const Item &item) const { return distanceSquared > item.distanceSquared; }
+		};
+
+		const SensorSpatialIndex &sensorSpatialIndex; //!< Index swept.
+		double hypocenter[3]; //!< Hypocenter, in unit-vector space (Earth radius is 1).
+		std::priority_queue<Item> items; //!< Ranges and entries not yet reached.
+
+		void pushRange(std::vector<Entry>::size_type begin, std::vector<Entry>::size_type end, const double *lowerCorner, const double *upperCorner);
+		void expandToEntry();
+
+	public:
+		Sweep(SensorSpatialIndex &sensorSpatialIndex, double latitude, double longitude, double depth);
+
+		bool hasNext();
+		double getNextDistance();
+		std::vector<Entry>::size_type getNextAddedIndex();
+		std::shared_ptr<Entity> next();
+		std::vector<std::shared_ptr<Entity>> advanceTo(double distance);
+	};
+
+	SensorSpatialIndex();
+	explicit SensorSpatialIndex(const Topology &topology);
+
+	void add(double latitude, double longitude, std::shared_ptr<Entity> entity);
+	void addSensor(std::shared_ptr<QcnSensorTrafficGenerator> sensor);
+	void addSensors(const Topology &topology);
+	void build();
+	std::vector<Entry>::size_type getSize() const;
+	std::vector<std::shared_ptr<Entity>> findWithinRadius(double latitude, double longitude, double radius);
+	std::vector<std::shared_ptr<Entity>> findNearest(double latitude, double longitude, unsigned int k);
+	std::vector<std::pair<std::shared_ptr<Entity>, std::vector<std::shared_ptr<Entity>>>> assignNearest(SensorSpatialIndex &targetIndex, unsigned int k = 1);
+	Sweep sweep(double latitude, double longitude, double depth = 0.0);
+};
@@ -0,0 +1,1156 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimulationCheckpoint.h"
+#include "AggregatePoissonTrafficGenerator.h"
+#include "DetectionData.h"
+#include "Link.h"
+#include "Node.h"
+#include "ProtocolDataUnit.h"
+#include "SeismicEventData.h"
+#include "TraceReplayTrafficGenerator.h"
+#include "TrafficGenerator.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+/**
+ * @brief Constructor.
+ *
+ * @param simulatorGlobals Reference to SimulatorGlobals object to save or restore.
+ * @param scheduler Reference to Scheduler object to save or restore.
+ */
+SimulationCheckpoint::SimulationCheckpoint(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler): simulatorGlobals(simulatorGlobals),
+		scheduler(scheduler), objectsCount(0) {
+}
+
+/**
+ * @brief Add a traffic generator that is not part of the topology (e.g., background traffic), such that its state is saved or restored.
+ *
+ * @details 
+ * Added generators follow the generators of the topology, in order of addition; to restore, the same generators must be added in the same
+ * order. Events may then reference them, e.g., the recurring events of autonomous generators.
+ *
+ * @param trafficGenerator Traffic generator to add.
+ */
+void SimulationCheckpoint::addTrafficGenerator(std::shared_ptr<TrafficGenerator> trafficGenerator) {
+	addedTrafficGenerators.push_back(trafficGenerator);
+}
+
+/**
+ * @brief Add a detection engine, such that its window and recent detections are saved or restored.
+ *
+ * @details 
+ * To restore, engines with the same configuration must be added in the same order. The engine must outlive this object, or be added again.
+ *
+ * @param detectionEngine Detection engine to add.
+ */
+void SimulationCheckpoint::addDetectionEngine(DetectionEngine &detectionEngine) {
+	detectionEngines.push_back(&detectionEngine);
+}
+
+/**
+ * @brief Add a host availability model, such that the states of its hosts and its buffered triggers are saved or restored.
+ *
+ * @details 
+ * To restore, models with the same hosts, in the same order, must be added in the same order; they need not be started. The model must
+ * outlive this object, or be added again. Its recurring event is then restored as part of the event chain.
+ *
+ * @param hostAvailabilityModel Host availability model to add.
+ */
+void SimulationCheckpoint::addHostAvailabilityModel(HostAvailabilityModel &hostAvailabilityModel) {
+	hostAvailabilityModels.push_back(&hostAvailabilityModel);
+}
+
+/**
+ * @brief Add a trickle outbox, such that its stored PDUs, its retry timers and its recurring event are saved or restored.
+ *
+ * @details 
+ * To restore, outboxes with the same configuration must be added in the same order, before any PDU is submitted to them. Uplinks must be
+ * links of the topology. The outbox must outlive this object, or be added again.
+ *
+ * @param trickleOutbox Trickle outbox to add.
+ */
+void SimulationCheckpoint::addTrickleOutbox(TrickleOutbox &trickleOutbox) {
+	trickleOutboxes.push_back(&trickleOutbox);
+}
+
+/**
+ * @brief Save the current simulation state to a checkpoint file.
+ *
+ * @param fileName Name of the checkpoint file; overwritten if it exists.
+ * @param topology Topology of the running simulation.
+ *
+ * @return CheckpointReturnType indicating whether the checkpoint was saved, or the kind of error.
+ */
+CheckpointReturnType SimulationCheckpoint::save(const std::string &fileName, const Topology &topology) {
+	errorMessage.clear();
+	buffer.clear();
+	registerTopology(topology);
+	try {
+		// Header and topology fingerprint.
+		buffer.writeBytes("QCNCKPT", 8); // Includes the terminating null.
+		buffer.writeValue<uint32_t>(CHECKPOINT_VERSION);
+		buffer.writeValue(static_cast<uint32_t>(nodes.size()));
+		buffer.writeValue(static_cast<uint32_t>(links.size()));
+		buffer.writeValue(static_cast<uint32_t>(trafficGenerators.size()));
+		buffer.writeValue(static_cast<uint32_t>(detectionEngines.size()));
+		buffer.writeValue(static_cast<uint32_t>(hostAvailabilityModels.size()));
+		buffer.writeValue(static_cast<uint32_t>(trickleOutboxes.size()));
+		for (auto &node : nodes) {
+			buffer.writeValue<uint32_t>(node->nodeId);
+		}
+
+		// Simulator globals; the random engine state is written in its standard textual representation.
+		std::ostringstream randomEngineState;
+		randomEngineState << simulatorGlobals.randomEngine;
+		buffer.writeValue(simulatorGlobals.currentAbsoluteTime);
+		buffer.writeValue(simulatorGlobals.simulationAbsoluteStartTime);
+		buffer.writeValue<uint32_t>(simulatorGlobals.seed);
+		buffer.writeValue<uint32_t>(simulatorGlobals.tokenInitialId);
+		buffer.writeValue<uint32_t>(simulatorGlobals.replication);
+		buffer.writeString(randomEngineState.str());
+
+		// Nodes.
+		for (auto &node : nodes) {
+			buffer.writeValue<uint32_t>(node->receivedBytesCount);
+			buffer.writeValue<uint32_t>(node->receivedPdusOrTokensCount);
+			buffer.writeValue<uint32_t>(node->forwardedPdusOrTokensCount);
+			buffer.writeValue<uint32_t>(node->forwardedBytesCount);
+			buffer.writeValue<uint32_t>(node->droppedPdusOrTokensCount);
+			buffer.writeValue(node->lastDelay);
+			buffer.writeValue(node->sumDelay);
+			buffer.writeValue(node->meanDelay);
+			buffer.writeValue(node->lastJitter);
+			buffer.writeValue(node->sumJitter);
+			buffer.writeValue(node->meanJitter);
+			buffer.writeValue(node->previousDelay);
+		}
+
+		// Links.
+		for (auto &link : links) {
+			buffer.writeValue<uint32_t>(link->droppedPdusCountMedium);
+			buffer.writeValue(static_cast<uint32_t>(link->inTransitQueue.size()));
+			for (auto &pdu : link->inTransitQueue) {
+				writeEntity(pdu.get());
+			}
+			writeFacility(link->transmissionServer);
+		}
+
+		// Traffic generators.
+		for (auto &trafficGenerator : trafficGenerators) {
+			writeTrafficGenerator(*trafficGenerator);
+		}
+
+		// Detection engines.
+		for (auto detectionEngine : detectionEngines) {
+			writeDetectionEngine(*detectionEngine);
+		}
+
+		// Host availability models.
+		for (auto hostAvailabilityModel : hostAvailabilityModels) {
+			writeHostAvailabilityModel(*hostAvailabilityModel);
+		}
+
+		// Trickle outboxes.
+		for (auto trickleOutbox : trickleOutboxes) {
+			writeTrickleOutbox(*trickleOutbox);
+		}
+
+		// Event chain, in order.
+		std::vector<const EventChainElement *> eventChainElements = scheduler.getOrderedElements();
+		buffer.writeValue(static_cast<uint32_t>(eventChainElements.size()));
+		for (auto eventChainElement : eventChainElements) {
+			buffer.writeValue(eventChainElement->eventTime);
+			buffer.writeValue(eventChainElement->occurAfterTime);
+			buffer.writeValue(static_cast<uint32_t>(eventChainElement->eventType));
+			writeEntity(scheduler.getPayloadEntity(eventChainElement->payload));
+			bool isLinkId = eventChainElement->payload.type == EventPayloadType::LINK_ID;
+			buffer.writeValue<uint8_t>(isLinkId ? 1 : 0);
+			if (isLinkId) {
+				buffer.writeValue(eventChainElement->payload.linkId);
+			}
+			buffer.writeValue<uint8_t>(eventChainElement->recurringEventSource != nullptr ? 1 : 0);
+		}
+	} catch (const CheckpointException &exception) {
+		errorMessage = exception.what();
+		buffer.clear();
+		return exception.checkpointReturnType;
+	}
+
+	bool isWritten = buffer.writeToFile(fileName);
+	buffer.clear();
+	entityIndexMap.clear();
+	if (!isWritten) {
+		errorMessage = "cannot write checkpoint file " + fileName;
+		return CheckpointReturnType::FILE_NOT_FOUND;
+	}
+	return CheckpointReturnType::CHECKPOINT_SAVED;
+}
+
+/**
+ * @brief Restore the simulation state from a checkpoint file.
+ *
+ * @details 
+ * The topology must have been built exactly as the one the checkpoint was saved from, and its objects must not have processed any event yet.
+ * The event chain of the scheduler is replaced by the events of the checkpoint. On error, the simulation state is undefined and must be built again.
+ *
+ * @param fileName Name of the checkpoint file.
+ * @param topology Topology of the restarted simulation.
+ *
+ * @return CheckpointReturnType indicating whether the state was restored, or the kind of error.
+ */
+CheckpointReturnType SimulationCheckpoint::restore(const std::string &fileName, const Topology &topology) {
+	errorMessage.clear();
+	if (!buffer.readFromFile(fileName)) {
+		errorMessage = "cannot read checkpoint file " + fileName;
+		return CheckpointReturnType::FILE_NOT_FOUND;
+	}
+	registerTopology(topology);
+	try {
+		// Header and topology fingerprint.
+		char magic[8];
+		buffer.readBytes(magic, 8);
+		if (std::memcmp(magic, "QCNCKPT", 8) != 0) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "not a QCNSim checkpoint");
+		}
+		uint32_t version = buffer.readValue<uint32_t>();
+		if (version != CHECKPOINT_VERSION) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "unsupported checkpoint version " + std::to_string(version));
+		}
+		uint32_t numberOfNodes = buffer.readValue<uint32_t>();
+		uint32_t numberOfLinks = buffer.readValue<uint32_t>();
+		uint32_t numberOfTrafficGenerators = buffer.readValue<uint32_t>();
+		uint32_t numberOfDetectionEngines = buffer.readValue<uint32_t>();
+		uint32_t numberOfHostAvailabilityModels = buffer.readValue<uint32_t>();
+		uint32_t numberOfTrickleOutboxes = buffer.readValue<uint32_t>();
+		if (numberOfNodes != nodes.size() || numberOfLinks != links.size() || numberOfTrafficGenerators != trafficGenerators.size() ||
+				numberOfDetectionEngines != detectionEngines.size() || numberOfHostAvailabilityModels != hostAvailabilityModels.size() ||
+				numberOfTrickleOutboxes != trickleOutboxes.size()) {
+			throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "checkpoint has " + std::to_string(numberOfNodes) + " nodes, " +
+				std::to_string(numberOfLinks) + " links, " + std::to_string(numberOfTrafficGenerators) + " traffic generators, " +
+				std::to_string(numberOfDetectionEngines) + " detection engines, " + std::to_string(numberOfHostAvailabilityModels) +
+				" host availability models and " + std::to_string(numberOfTrickleOutboxes) + " trickle outboxes");
+		}
+		for (auto &node : nodes) {
+			if (buffer.readValue<uint32_t>() != node->nodeId) {
+				throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "node IDs differ");
+			}
+		}
+
+		// Simulator globals.
+		simulatorGlobals.currentAbsoluteTime = buffer.readValue<double>();
+		simulatorGlobals.simulationAbsoluteStartTime = buffer.readValue<double>();
+		simulatorGlobals.seed = buffer.readValue<uint32_t>();
+		simulatorGlobals.tokenInitialId = buffer.readValue<uint32_t>();
+		simulatorGlobals.replication = buffer.readValue<uint32_t>();
+		std::istringstream randomEngineState(buffer.readString());
+		randomEngineState >> simulatorGlobals.randomEngine;
+		if (!randomEngineState) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid random engine state");
+		}
+
+		// Nodes.
+		for (auto &node : nodes) {
+			node->receivedBytesCount = buffer.readValue<uint32_t>();
+			node->receivedPdusOrTokensCount = buffer.readValue<uint32_t>();
+			node->forwardedPdusOrTokensCount = buffer.readValue<uint32_t>();
+			node->forwardedBytesCount = buffer.readValue<uint32_t>();
+			node->droppedPdusOrTokensCount = buffer.readValue<uint32_t>();
+			node->lastDelay = buffer.readValue<double>();
+			node->sumDelay = buffer.readValue<double>();
+			node->meanDelay = buffer.readValue<double>();
+			node->lastJitter = buffer.readValue<double>();
+			node->sumJitter = buffer.readValue<double>();
+			node->meanJitter = buffer.readValue<double>();
+			node->previousDelay = buffer.readValue<double>();
+		}
+
+		// Links. Observers are notified of links whose state changed, as if setDown() or setUp() had been called.
+		for (auto &link : links) {
+			link->droppedPdusCountMedium = buffer.readValue<uint32_t>();
+			uint32_t inTransitQueueSize = buffer.readValue<uint32_t>();
+			link->inTransitQueue.clear();
+			for (uint32_t i = 0; i < inTransitQueueSize; ++i) {
+				link->inTransitQueue.push_back(readEntityOfType<ProtocolDataUnit>());
+			}
+			bool wasUp = link->isUp();
+			readFacility(link->transmissionServer);
+			if (link->isUp() != wasUp) {
+				link->notifyLinkStateObservers(link->isUp());
+			}
+		}
+
+		// Traffic generators.
+		for (auto &trafficGenerator : trafficGenerators) {
+			readTrafficGenerator(*trafficGenerator);
+		}
+
+		// Detection engines.
+		for (auto detectionEngine : detectionEngines) {
+			readDetectionEngine(*detectionEngine);
+		}
+
+		// Host availability models.
+		for (auto hostAvailabilityModel : hostAvailabilityModels) {
+			readHostAvailabilityModel(*hostAvailabilityModel);
+		}
+
+		// Trickle outboxes.
+		for (auto trickleOutbox : trickleOutboxes) {
+			readTrickleOutbox(*trickleOutbox);
+		}
+
+		// Event chain, in order.
+		uint32_t numberOfEvents = buffer.readValue<uint32_t>();
+		scheduler.clearEventChain();
+		for (uint32_t i = 0; i < numberOfEvents; ++i) {
+			double eventTime = buffer.readValue<double>();
+			double occurAfterTime = buffer.readValue<double>();
+			EventType eventType = static_cast<EventType>(buffer.readValue<uint32_t>());
+			std::shared_ptr<Entity> entity = readEntity();
+			bool isLinkId = buffer.readValue<uint8_t>() != 0;
+			uint32_t linkId = isLinkId ? buffer.readValue<uint32_t>() : 0;
+			if (isLinkId && entity != nullptr) {
+				throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "event with both an entity and a link ID");
+			}
+			RecurringEventSource *recurringEventSource = nullptr;
+			if (buffer.readValue<uint8_t>() != 0) {
+				// Recurring events belong to autonomous traffic generators and components, which are their own entity.
+				recurringEventSource = dynamic_cast<RecurringEventSource *>(entity.get());
+				if (recurringEventSource == nullptr) {
+					throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "recurring event without recurring event source");
+				}
+				// As when scheduled, the event points to its source without owning it: the source cancels the event when destroyed.
+				entity = std::shared_ptr<Entity>(std::shared_ptr<Entity>(), entity.get());
+			}
+			// Events are stored in order: increasing sequences keep the order of events with the same time.
+			Event event = isLinkId ? Event::createLinkEvent(occurAfterTime, eventType, linkId) : Event(occurAfterTime, eventType, entity);
+			if (event.payloadType == EventPayloadType::ENTITY) {
+				event.payloadType = getPayloadType(entity.get());
+			}
+			EventChainElement eventChainElement = scheduler.createElement(eventTime, event, recurringEventSource);
+			eventChainElement.sequence = scheduler.nextSequence++;
+			scheduler.insert(eventChainElement);
+		}
+		if (buffer.getRemainingSize() != 0) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "unexpected data after end of checkpoint");
+		}
+	} catch (const CheckpointException &exception) {
+		errorMessage = exception.what();
+		buffer.clear();
+		objects.clear();
+		return exception.checkpointReturnType;
+	} catch (const BinaryBuffer::UnderflowException &exception) {
+		errorMessage = exception.what();
+		buffer.clear();
+		objects.clear();
+		return CheckpointReturnType::INVALID_CHECKPOINT;
+	} catch (const std::out_of_range &) {
+		errorMessage = "entity index out of range";
+		buffer.clear();
+		objects.clear();
+		return CheckpointReturnType::INVALID_CHECKPOINT;
+	}
+	buffer.clear();
+	objects.clear();
+	return CheckpointReturnType::CHECKPOINT_RESTORED;
+}
+
+/**
+ * @brief Get description of the last error.
+ *
+ * @return Error message; empty if the last operation succeeded.
+ */
+std::string SimulationCheckpoint::getErrorMessage() const {
+	return errorMessage;
+}
+
+/**
+ * @brief Collect the unique nodes, links and traffic generators of the topology, in map order, followed by the added traffic generators, and
+ * the added components.
+ *
+ * @param topology Topology of the simulation.
+ */
+void SimulationCheckpoint::registerTopology(const Topology &topology) {
+	nodes.clear();
+	links.clear();
+	trafficGenerators.clear();
+	components.clear();
+	entityIndexMap.clear();
+	objects.clear();
+	objectsCount = 0;
+	for (auto &nodeMapIterator : topology.nodeMap) {
+		if (entityIndexMap.emplace(nodeMapIterator.second.get(), std::make_pair(EntityTag::NODE, static_cast<uint32_t>(nodes.size()))).second) {
+			nodes.push_back(nodeMapIterator.second);
+		}
+	}
+	for (auto &linkMapIterator : topology.linkMap) {
+		std::shared_ptr<Link> link = linkMapIterator.second;
+		while (link != nullptr && entityIndexMap.emplace(link.get(), std::make_pair(EntityTag::LINK, static_cast<uint32_t>(links.size()))).second) {
+			links.push_back(link);
+			link = link->reverseLink;
+		}
+	}
+	for (auto &generatorMapIterator : topology.qcnSensorTrafficGeneratorMap) {
+		if (entityIndexMap.emplace(generatorMapIterator.second.get(),
+				std::make_pair(EntityTag::TRAFFIC_GENERATOR, static_cast<uint32_t>(trafficGenerators.size()))).second) {
+			trafficGenerators.push_back(generatorMapIterator.second);
+		}
+	}
+	for (auto &trafficGenerator : addedTrafficGenerators) {
+		if (entityIndexMap.emplace(trafficGenerator.get(),
+				std::make_pair(EntityTag::TRAFFIC_GENERATOR, static_cast<uint32_t>(trafficGenerators.size()))).second) {
+			trafficGenerators.push_back(trafficGenerator);
+		}
+	}
+	for (auto hostAvailabilityModel : hostAvailabilityModels) {
+		if (entityIndexMap.emplace(hostAvailabilityModel, std::make_pair(EntityTag::COMPONENT, static_cast<uint32_t>(components.size()))).second) {
+			components.push_back(hostAvailabilityModel);
+		}
+	}
+	for (auto trickleOutbox : trickleOutboxes) {
+		if (entityIndexMap.emplace(trickleOutbox, std::make_pair(EntityTag::COMPONENT, static_cast<uint32_t>(components.size()))).second) {
+			components.push_back(trickleOutbox);
+		}
+	}
+}
+
+/**
+ * @brief Append a reference to an entity; tokens, PDUs and data objects are appended in full the first time they are referenced.
+ *
+ * @param entity Referenced entity, or nullptr.
+ */
+void SimulationCheckpoint::writeEntity(const Entity *entity) {
+	if (entity == nullptr) {
+		buffer.writeValue(EntityTag::NO_ENTITY);
+		return;
+	}
+	auto entityIndexIterator = entityIndexMap.find(entity);
+	if (entityIndexIterator != entityIndexMap.end()) {
+		buffer.writeValue(entityIndexIterator->second.first);
+		buffer.writeValue(entityIndexIterator->second.second);
+		return;
+	}
+	// First reference to this object: index it before its contents, which may reference it back.
+	if (const ProtocolDataUnit *pdu = dynamic_cast<const ProtocolDataUnit *>(entity)) {
+		entityIndexMap.emplace(entity, std::make_pair(EntityTag::OBJECT, objectsCount++));
+		buffer.writeValue(EntityTag::NEW_PROTOCOL_DATA_UNIT);
+		writeToken(*pdu);
+		buffer.writeValue<uint16_t>(pdu->ttl);
+		buffer.writeValue<uint32_t>(pdu->pduSize);
+	} else if (const Token *token = dynamic_cast<const Token *>(entity)) {
+		entityIndexMap.emplace(entity, std::make_pair(EntityTag::OBJECT, objectsCount++));
+		buffer.writeValue(EntityTag::NEW_TOKEN);
+		writeToken(*token);
+	} else if (const SeismicEventData *seismicEventData = dynamic_cast<const SeismicEventData *>(entity)) {
+		entityIndexMap.emplace(entity, std::make_pair(EntityTag::OBJECT, objectsCount++));
+		buffer.writeValue(EntityTag::NEW_SEISMIC_EVENT_DATA);
+		buffer.writeValue<uint32_t>(seismicEventData->qcnExplorerSensorId);
+		buffer.writeValue(seismicEventData->eventTime);
+		buffer.writeValue(seismicEventData->latitude);
+		buffer.writeValue(seismicEventData->longitude);
+		buffer.writeValue(seismicEventData->magnitude);
+		buffer.writeValue(seismicEventData->distance);
+		buffer.writeValue<uint32_t>(seismicEventData->regionId);
+	} else if (const DetectionData *detectionData = dynamic_cast<const DetectionData *>(entity)) {
+		entityIndexMap.emplace(entity, std::make_pair(EntityTag::OBJECT, objectsCount++));
+		buffer.writeValue(EntityTag::NEW_DETECTION_DATA);
+		buffer.writeValue<uint32_t>(detectionData->detectionId);
+		buffer.writeValue(detectionData->detectionTime);
+		buffer.writeValue(detectionData->firstTriggerTime);
+		buffer.writeValue(detectionData->latitude);
+		buffer.writeValue(detectionData->longitude);
+		buffer.writeValue(detectionData->meanDeliveryLatency);
+		buffer.writeValue(static_cast<uint32_t>(detectionData->triggers.size()));
+		for (auto &trigger : detectionData->triggers) {
+			writeEntity(trigger.get());
+		}
+	} else {
+		throw CheckpointException(CheckpointReturnType::UNSUPPORTED_ENTITY,
+			"entity is neither part of the topology nor a token, PDU, seismic event data or detection data");
+	}
+}
+
+/**
+ * @brief Append the contents of a token (or of the token part of a PDU).
+ *
+ * @param token Token to append.
+ */
+void SimulationCheckpoint::writeToken(const Token &token) {
+	buffer.writeValue<uint32_t>(token.id);
+	buffer.writeValue<int32_t>(token.priority);
+	buffer.writeValue(token.absoluteGenerationTime);
+	buffer.writeValue<uint8_t>(token.recordThisRoute ? 1 : 0);
+	writeEntity(token.associatedEntity.get());
+	writeEntity(token.previous.get());
+	writeEntity(token.next.get());
+	writeEntity(token.nextLink.get());
+	writeEntity(token.source.get());
+	writeEntity(token.destination.get());
+	buffer.writeValue(static_cast<uint32_t>(token.route.explicitRoute.size()));
+	for (auto &hop : token.route.explicitRoute) {
+		writeEntity(hop.get());
+	}
+	buffer.writeValue<uint64_t>(token.route.explicitRouteNextHopIndex);
+	buffer.writeValue(static_cast<uint32_t>(token.route.recordedRoute.size()));
+	for (auto &hop : token.route.recordedRoute) {
+		writeEntity(hop.get());
+	}
+}
+
+/**
+ * @brief Append the state of a traffic generator, with the state of its class.
+ *
+ * @details 
+ * Distributions are written in their standard textual representation, which holds their parameters and any internal state.
+ *
+ * @param trafficGenerator Traffic generator to append.
+ */
+void SimulationCheckpoint::writeTrafficGenerator(const TrafficGenerator &trafficGenerator) {
+	buffer.writeValue<uint8_t>(trafficGenerator.isOn ? 1 : 0);
+	buffer.writeValue<uint8_t>(trafficGenerator.isAutonomous ? 1 : 0);
+	buffer.writeValue<uint32_t>(trafficGenerator.tokensGeneratedCount);
+	std::ostringstream randomStreamState;
+	randomStreamState << trafficGenerator.randomStream;
+	buffer.writeValue<uint8_t>(trafficGenerator.usesOwnRandomStream ? 1 : 0);
+	buffer.writeString(randomStreamState.str());
+	if (const AggregatePoissonTrafficGenerator *aggregatePoissonTrafficGenerator = dynamic_cast<const AggregatePoissonTrafficGenerator *>(&trafficGenerator)) {
+		const std::vector<std::shared_ptr<Entity>> &sources = aggregatePoissonTrafficGenerator->sources;
+		buffer.writeValue(static_cast<uint32_t>(sources.size()));
+		buffer.writeValue(aggregatePoissonTrafficGenerator->tau);
+		std::ostringstream distributionsState;
+		distributionsState.precision(17);
+		distributionsState << aggregatePoissonTrafficGenerator->exponentialDistribution << " " << aggregatePoissonTrafficGenerator->uniformSourceDistribution
+			<< " " << aggregatePoissonTrafficGenerator->weightedSourceDistribution;
+		buffer.writeString(distributionsState.str());
+		// Picked source, by index; the number of sources if there is none.
+		auto sourceIterator = std::find(sources.begin(), sources.end(), trafficGenerator.source);
+		buffer.writeValue(static_cast<uint32_t>(sourceIterator - sources.begin()));
+	} else if (const TraceReplayTrafficGenerator *traceReplayTrafficGenerator = dynamic_cast<const TraceReplayTrafficGenerator *>(&trafficGenerator)) {
+		// Cursor: the read-ahead block is read again from its position on restore.
+		buffer.writeValue<uint8_t>(traceReplayTrafficGenerator->traceFile.is_open() ? 1 : 0);
+		buffer.writeValue<uint8_t>(traceReplayTrafficGenerator->isBinaryTrace ? 1 : 0);
+		buffer.writeValue<int64_t>(traceReplayTrafficGenerator->readAheadBlockPosition);
+		buffer.writeValue(static_cast<uint32_t>(traceReplayTrafficGenerator->readAheadIndex));
+		buffer.writeValue(traceReplayTrafficGenerator->timeScale);
+		buffer.writeValue(traceReplayTrafficGenerator->scaleAnchorTraceTime);
+		buffer.writeValue(traceReplayTrafficGenerator->scaleAnchorReplayTime);
+		buffer.writeValue(traceReplayTrafficGenerator->lastTraceTime);
+		buffer.writeValue(traceReplayTrafficGenerator->lastReplayTime);
+		buffer.writeValue<uint8_t>(traceReplayTrafficGenerator->isLooping ? 1 : 0);
+		buffer.writeValue(traceReplayTrafficGenerator->loopOffset);
+		buffer.writeValue(traceReplayTrafficGenerator->lastRecordTime);
+		buffer.writeValue<uint8_t>(traceReplayTrafficGenerator->hasAcceptedRecordInLoop ? 1 : 0);
+		buffer.writeValue(traceReplayTrafficGenerator->currentReplayTime);
+		for (auto record : { &traceReplayTrafficGenerator->currentRecord, &traceReplayTrafficGenerator->upcomingRecord }) {
+			buffer.writeValue(record->time);
+			buffer.writeValue<uint32_t>(record->hostId);
+			buffer.writeValue<uint32_t>(record->pduSize);
+		}
+		buffer.writeValue<uint8_t>(traceReplayTrafficGenerator->hasUpcomingRecord ? 1 : 0);
+	}
+}
+
+/**
+ * @brief Append the state of a facility: counters, servers and queue.
+ *
+ * @param facility Facility to append.
+ */
+void SimulationCheckpoint::writeFacility(const Facility &facility) {
+	buffer.writeValue<uint32_t>(facility.maxRecordedQueueSize);
+	buffer.writeValue<uint32_t>(facility.queueSizeLimit);
+	buffer.writeValue<uint32_t>(facility.dequeuedTokensCount);
+	buffer.writeValue(facility.lastQueueChangeTime);
+	buffer.writeValue(facility.sumBusyTime);
+	buffer.writeValue<uint32_t>(facility.preemptedTokensCount);
+	buffer.writeValue(facility.sumLengthTimeProduct);
+	buffer.writeValue<uint32_t>(facility.releasedTokensCount);
+	buffer.writeValue<uint8_t>(facility.isUp_ ? 1 : 0);
+	buffer.writeValue<uint32_t>(facility.droppedTokensCount);
+	buffer.writeValue<uint32_t>(facility.requestsPreemptsCount);
+	buffer.writeValue(static_cast<uint32_t>(facility.servers.size()));
+	for (auto &server : facility.servers) {
+		buffer.writeValue<uint8_t>(server.isBusy ? 1 : 0);
+		writeEntity(server.token.get());
+		buffer.writeValue<uint32_t>(server.releasedTokensCount);
+		buffer.writeValue(server.serviceStartTime);
+		buffer.writeValue(server.sumBusyTime);
+	}
+	buffer.writeValue(static_cast<uint32_t>(facility.queue.size()));
+	for (auto &facilityQueueElement : facility.queue) {
+		writeEntity(facilityQueueElement.token.get());
+		buffer.writeValue(static_cast<uint32_t>(facilityQueueElement.eventType));
+		buffer.writeValue(facilityQueueElement.serviceTime);
+	}
+}
+
+/**
+ * @brief Append the state of a detection engine: configuration, window of triggers with their grid cells, recent detections and counters.
+ *
+ * @details 
+ * Cells are stored as the key of each trigger; their intrusive lists follow the window order, thus are rebuilt from it on restore.
+ *
+ * @param detectionEngine Detection engine to append.
+ */
+void SimulationCheckpoint::writeDetectionEngine(const DetectionEngine &detectionEngine) {
+	buffer.writeValue<uint32_t>(detectionEngine.minimumTriggers);
+	buffer.writeValue(detectionEngine.radius);
+	buffer.writeValue(detectionEngine.timeWindow);
+	buffer.writeValue(static_cast<uint32_t>(detectionEngine.window.size()));
+	for (auto &record : detectionEngine.window) {
+		writeEntity(record.trigger.get());
+		buffer.writeValue(record.deliveryTime);
+		buffer.writeValue<uint64_t>(record.cellKey);
+		buffer.writeValue<uint8_t>(record.isAssociated ? 1 : 0);
+	}
+	buffer.writeValue(static_cast<uint32_t>(detectionEngine.recentDetections.size()));
+	for (auto &recentDetection : detectionEngine.recentDetections) {
+		writeEntity(recentDetection.detectionData.get());
+		buffer.writeValue(recentDetection.lastEventTime);
+		buffer.writeValue(recentDetection.extent);
+	}
+	buffer.writeValue(detectionEngine.newestEventTime);
+	buffer.writeValue<uint32_t>(detectionEngine.triggersCount);
+	buffer.writeValue<uint32_t>(detectionEngine.staleTriggersCount);
+	buffer.writeValue<uint32_t>(detectionEngine.associatedTriggersCount);
+	buffer.writeValue<uint32_t>(detectionEngine.detectionsCount);
+	buffer.writeValue(detectionEngine.detectionLatencySum);
+}
+
+/**
+ * @brief Append the state of a host availability model: states of the hosts, candidate stream, own random stream, buffered triggers and counters.
+ *
+ * @details 
+ * Fractions and hosts are part of the configuration, thus only their number is stored. Buffered triggers are stored by host index.
+ *
+ * @param hostAvailabilityModel Host availability model to append.
+ */
+void SimulationCheckpoint::writeHostAvailabilityModel(const HostAvailabilityModel &hostAvailabilityModel) {
+	buffer.writeValue(static_cast<uint32_t>(hostAvailabilityModel.sensors.size()));
+	buffer.writeValue<uint8_t>(hostAvailabilityModel.isStarted ? 1 : 0);
+	std::ostringstream randomStreamState;
+	randomStreamState << hostAvailabilityModel.randomStream;
+	buffer.writeString(randomStreamState.str());
+	for (int state = 0; state < 3; ++state) {
+		buffer.writeValue(hostAvailabilityModel.meanCycles[state]);
+		buffer.writeValue(hostAvailabilityModel.maximumRates[state]);
+		buffer.writeValue<uint32_t>(hostAvailabilityModel.upCounts[state]);
+		buffer.writeValue(static_cast<uint32_t>(hostAvailabilityModel.stateBits[state].size()));
+		for (auto word : hostAvailabilityModel.stateBits[state]) {
+			buffer.writeValue<uint64_t>(word);
+		}
+	}
+	buffer.writeValue(hostAvailabilityModel.candidateRate);
+	buffer.writeValue(static_cast<uint32_t>(hostAvailabilityModel.bufferedTriggers.size()));
+	for (auto &bufferedTriggersPair : hostAvailabilityModel.bufferedTriggers) {
+		buffer.writeValue<uint32_t>(bufferedTriggersPair.first);
+		buffer.writeValue(static_cast<uint32_t>(bufferedTriggersPair.second.size()));
+		for (auto &trigger : bufferedTriggersPair.second) {
+			writeEntity(trigger.get());
+		}
+	}
+	buffer.writeValue<uint32_t>(hostAvailabilityModel.candidateTransitionsCount);
+	buffer.writeValue<uint32_t>(hostAvailabilityModel.transitionsCount);
+	buffer.writeValue<uint32_t>(hostAvailabilityModel.bufferedTriggersCount);
+	buffer.writeValue<uint32_t>(hostAvailabilityModel.droppedTriggersCount);
+}
+
+/**
+ * @brief Append the state of a trickle outbox: configuration, outboxes, timer wheel, due outboxes, recurring event time and counters.
+ *
+ * @details 
+ * Outboxes are stored by ID; their order does not matter, since retries follow the timer wheel and the due outboxes.
+ *
+ * @param trickleOutbox Trickle outbox to append.
+ */
+void SimulationCheckpoint::writeTrickleOutbox(const TrickleOutbox &trickleOutbox) {
+	buffer.writeValue<uint32_t>(trickleOutbox.capacity);
+	buffer.writeValue(trickleOutbox.initialBackoff);
+	buffer.writeValue(trickleOutbox.maximumBackoff);
+	buffer.writeValue(trickleOutbox.backoffMultiplier);
+	buffer.writeValue<uint32_t>(trickleOutbox.flushBatchSize);
+	buffer.writeValue(static_cast<uint32_t>(trickleOutbox.outboxes.size()));
+	for (auto &outboxPair : trickleOutbox.outboxes) {
+		buffer.writeValue<uint32_t>(outboxPair.first);
+		buffer.writeValue(static_cast<uint32_t>(outboxPair.second.pdus.size()));
+		for (auto &pdu : outboxPair.second.pdus) {
+			writeEntity(pdu.get());
+		}
+		writeEntity(outboxPair.second.uplink.get());
+		buffer.writeValue(outboxPair.second.backoff);
+		buffer.writeValue<uint8_t>(outboxPair.second.isTimerArmed ? 1 : 0);
+	}
+	writeTimerWheel(trickleOutbox.timerWheel);
+	buffer.writeValue(static_cast<uint32_t>(trickleOutbox.dueOutboxIds.size()));
+	for (auto outboxId : trickleOutbox.dueOutboxIds) {
+		buffer.writeValue<uint32_t>(outboxId);
+	}
+	buffer.writeValue<uint8_t>(trickleOutbox.isScheduled ? 1 : 0);
+	buffer.writeValue(trickleOutbox.scheduledTime);
+	buffer.writeValue<uint32_t>(trickleOutbox.storedPdusCount);
+	buffer.writeValue<uint32_t>(trickleOutbox.sentPdusCount);
+	buffer.writeValue<uint32_t>(trickleOutbox.flushedPdusCount);
+	buffer.writeValue<uint32_t>(trickleOutbox.droppedPdusCount);
+	buffer.writeValue<uint32_t>(trickleOutbox.retriesCount);
+	buffer.writeValue<uint32_t>(trickleOutbox.failedRetriesCount);
+	buffer.writeValue<uint32_t>(trickleOutbox.retryEventsCount);
+}
+
+/**
+ * @brief Append the state of a timer wheel: tick, number of slots, current tick, and the timers of each slot and of the overflow map, in order.
+ *
+ * @param timerWheel Timer wheel to append.
+ */
+void SimulationCheckpoint::writeTimerWheel(const TimerWheel &timerWheel) {
+	buffer.writeValue(timerWheel.tickDuration);
+	buffer.writeValue(static_cast<uint32_t>(timerWheel.slots.size()));
+	buffer.writeValue<uint64_t>(timerWheel.currentTick);
+	for (auto &slot : timerWheel.slots) {
+		buffer.writeValue(static_cast<uint32_t>(slot.size()));
+		for (auto &timer : slot) {
+			buffer.writeValue<uint64_t>(timer.first);
+			buffer.writeValue<uint32_t>(timer.second);
+		}
+	}
+	buffer.writeValue(static_cast<uint32_t>(timerWheel.overflow.size()));
+	for (auto &timer : timerWheel.overflow) {
+		buffer.writeValue<uint64_t>(timer.first);
+		buffer.writeValue<uint32_t>(timer.second);
+	}
+}
+
+/**
+ * @brief Decode a reference to an entity, rebuilding tokens, PDUs and data objects the first time they appear.
+ *
+ * @return Referenced entity, or nullptr.
+ */
+std::shared_ptr<Entity> SimulationCheckpoint::readEntity() {
+	EntityTag entityTag = buffer.readValue<EntityTag>();
+	switch (entityTag) {
+		case EntityTag::NO_ENTITY:
+			return nullptr;
+		case EntityTag::NODE:
+			return nodes.at(buffer.readValue<uint32_t>());
+		case EntityTag::LINK:
+			return links.at(buffer.readValue<uint32_t>());
+		case EntityTag::TRAFFIC_GENERATOR:
+			return trafficGenerators.at(buffer.readValue<uint32_t>());
+		case EntityTag::OBJECT:
+			return objects.at(buffer.readValue<uint32_t>());
+		case EntityTag::COMPONENT:
+			// Components are owned by the application: the reference does not own them.
+			return std::shared_ptr<Entity>(std::shared_ptr<Entity>(), components.at(buffer.readValue<uint32_t>()));
+		case EntityTag::NEW_TOKEN: {
+			// Index the object before its contents, which may reference it back.
+			auto token = std::make_shared<Token>(0, 0, nullptr, nullptr, nullptr);
+			objects.push_back(token);
+			readToken(*token);
+			return token;
+		}
+		case EntityTag::NEW_PROTOCOL_DATA_UNIT: {
+			auto pdu = std::make_shared<ProtocolDataUnit>(0, 0, nullptr, nullptr, nullptr, 0);
+			objects.push_back(pdu);
+			readToken(*pdu);
+			pdu->ttl = buffer.readValue<uint16_t>();
+			pdu->pduSize = buffer.readValue<uint32_t>();
+			return pdu;
+		}
+		case EntityTag::NEW_SEISMIC_EVENT_DATA: {
+			auto seismicEventData = std::make_shared<SeismicEventData>();
+			objects.push_back(seismicEventData);
+			seismicEventData->qcnExplorerSensorId = buffer.readValue<uint32_t>();
+			seismicEventData->eventTime = buffer.readValue<double>();
+			seismicEventData->latitude = buffer.readValue<double>();
+			seismicEventData->longitude = buffer.readValue<double>();
+			seismicEventData->magnitude = buffer.readValue<double>();
+			seismicEventData->distance = buffer.readValue<double>();
+			seismicEventData->regionId = buffer.readValue<uint32_t>();
+			return seismicEventData;
+		}
+		case EntityTag::NEW_DETECTION_DATA: {
+			auto detectionData = std::make_shared<DetectionData>();
+			objects.push_back(detectionData);
+			detectionData->detectionId = buffer.readValue<uint32_t>();
+			detectionData->detectionTime = buffer.readValue<double>();
+			detectionData->firstTriggerTime = buffer.readValue<double>();
+			detectionData->latitude = buffer.readValue<double>();
+			detectionData->longitude = buffer.readValue<double>();
+			detectionData->meanDeliveryLatency = buffer.readValue<double>();
+			uint32_t numberOfTriggers = buffer.readValue<uint32_t>();
+			for (uint32_t i = 0; i < numberOfTriggers; ++i) {
+				detectionData->triggers.push_back(readEntityOfType<SeismicEventData>());
+			}
+			return detectionData;
+		}
+		default:
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid entity tag");
+	}
+}
+
+/**
+ * @brief Decode a reference to an entity that must be of the given type (or nullptr).
+ *
+ * @return Referenced entity, or nullptr.
+ */
+template<typename T> std::shared_ptr<T> SimulationCheckpoint::readEntityOfType() {
+	std::shared_ptr<Entity> entity = readEntity();
+	std::shared_ptr<T> typedEntity = std::dynamic_pointer_cast<T>(entity);
+	if (entity != nullptr && typedEntity == nullptr) {
+		throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "unexpected entity type");
+	}
+	return typedEntity;
+}
+
+/**
+ * @brief Get the payload tag of a restored entity.
+ *
+ * @details 
+ * Restored tokens, PDUs and data objects are of exactly the classes rebuilt by readEntity(), thus tagging them after their class lets
+ * Event::getEntityAs() take the same static path as before saving.
+ *
+ * @param entity Restored entity, or nullptr.
+ * @return Payload tag of the entity.
+ */
+EventPayloadType SimulationCheckpoint::getPayloadType(const Entity *entity) {
+	if (entity == nullptr) {
+		return EventPayloadType::NO_PAYLOAD;
+	} else if (dynamic_cast<const ProtocolDataUnit *>(entity) != nullptr) {
+		return EventPayloadType::PROTOCOL_DATA_UNIT;
+	} else if (dynamic_cast<const Token *>(entity) != nullptr) {
+		return EventPayloadType::TOKEN;
+	} else if (dynamic_cast<const SeismicEventData *>(entity) != nullptr) {
+		return EventPayloadType::SEISMIC_EVENT_DATA;
+	} else if (dynamic_cast<const DetectionData *>(entity) != nullptr) {
+		return EventPayloadType::DETECTION_DATA;
+	}
+	return EventPayloadType::ENTITY;
+}
+
+/**
+ * @brief Decode the contents of a token (or of the token part of a PDU).
+ *
+ * @param token Token that receives the contents.
+ */
+void SimulationCheckpoint::readToken(Token &token) {
+	token.id = buffer.readValue<uint32_t>();
+	token.priority = buffer.readValue<int32_t>();
+	token.absoluteGenerationTime = buffer.readValue<double>();
+	token.recordThisRoute = buffer.readValue<uint8_t>() != 0;
+	token.associatedEntity = readEntity();
+	token.previous = readEntity();
+	token.next = readEntity();
+	token.nextLink = readEntity();
+	token.source = readEntity();
+	token.destination = readEntity();
+	uint32_t length = buffer.readValue<uint32_t>();
+	token.route.explicitRoute.clear();
+	for (uint32_t i = 0; i < length; ++i) {
+		token.route.explicitRoute.push_back(readEntity());
+	}
+	token.route.explicitRouteNextHopIndex = static_cast<size_t>(buffer.readValue<uint64_t>());
+	length = buffer.readValue<uint32_t>();
+	token.route.recordedRoute.clear();
+	for (uint32_t i = 0; i < length; ++i) {
+		token.route.recordedRoute.push_back(readEntity());
+	}
+}
+
+/**
+ * @brief Decode the state of a traffic generator, with the state of its class.
+ *
+ * @param trafficGenerator Traffic generator that receives the state; must be of the same class as the saved one.
+ */
+void SimulationCheckpoint::readTrafficGenerator(TrafficGenerator &trafficGenerator) {
+	trafficGenerator.isOn = buffer.readValue<uint8_t>() != 0;
+	trafficGenerator.isAutonomous = buffer.readValue<uint8_t>() != 0;
+	trafficGenerator.tokensGeneratedCount = buffer.readValue<uint32_t>();
+	trafficGenerator.usesOwnRandomStream = buffer.readValue<uint8_t>() != 0;
+	std::istringstream randomStreamState(buffer.readString());
+	randomStreamState >> trafficGenerator.randomStream;
+	if (!randomStreamState) {
+		throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid random stream state");
+	}
+	if (AggregatePoissonTrafficGenerator *aggregatePoissonTrafficGenerator = dynamic_cast<AggregatePoissonTrafficGenerator *>(&trafficGenerator)) {
+		const std::vector<std::shared_ptr<Entity>> &sources = aggregatePoissonTrafficGenerator->sources;
+		if (buffer.readValue<uint32_t>() != sources.size()) {
+			throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "number of sources of aggregate Poisson traffic generator differs");
+		}
+		aggregatePoissonTrafficGenerator->tau = buffer.readValue<double>();
+		std::istringstream distributionsState(buffer.readString());
+		distributionsState >> aggregatePoissonTrafficGenerator->exponentialDistribution >> aggregatePoissonTrafficGenerator->uniformSourceDistribution
+			>> aggregatePoissonTrafficGenerator->weightedSourceDistribution;
+		if (!distributionsState) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid distribution state");
+		}
+		uint32_t sourceIndex = buffer.readValue<uint32_t>();
+		if (sourceIndex > sources.size()) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid source index");
+		}
+		trafficGenerator.source = sourceIndex < sources.size() ? sources[sourceIndex] : nullptr;
+	} else if (TraceReplayTrafficGenerator *traceReplayTrafficGenerator = dynamic_cast<TraceReplayTrafficGenerator *>(&trafficGenerator)) {
+		bool isTraceOpen = buffer.readValue<uint8_t>() != 0;
+		bool isBinaryTrace = buffer.readValue<uint8_t>() != 0;
+		std::streamoff readAheadBlockPosition = static_cast<std::streamoff>(buffer.readValue<int64_t>());
+		uint32_t readAheadIndex = buffer.readValue<uint32_t>();
+		if (isTraceOpen != traceReplayTrafficGenerator->traceFile.is_open() || (isTraceOpen && isBinaryTrace != traceReplayTrafficGenerator->isBinaryTrace)) {
+			throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "trace of trace replay traffic generator differs");
+		}
+		if (isTraceOpen && !traceReplayTrafficGenerator->seekRecord(readAheadBlockPosition, readAheadIndex)) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid trace position");
+		}
+		traceReplayTrafficGenerator->timeScale = buffer.readValue<double>();
+		traceReplayTrafficGenerator->scaleAnchorTraceTime = buffer.readValue<double>();
+		traceReplayTrafficGenerator->scaleAnchorReplayTime = buffer.readValue<double>();
+		traceReplayTrafficGenerator->lastTraceTime = buffer.readValue<double>();
+		traceReplayTrafficGenerator->lastReplayTime = buffer.readValue<double>();
+		traceReplayTrafficGenerator->isLooping = buffer.readValue<uint8_t>() != 0;
+		traceReplayTrafficGenerator->loopOffset = buffer.readValue<double>();
+		traceReplayTrafficGenerator->lastRecordTime = buffer.readValue<double>();
+		traceReplayTrafficGenerator->hasAcceptedRecordInLoop = buffer.readValue<uint8_t>() != 0;
+		traceReplayTrafficGenerator->currentReplayTime = buffer.readValue<double>();
+		for (auto record : { &traceReplayTrafficGenerator->currentRecord, &traceReplayTrafficGenerator->upcomingRecord }) {
+			record->time = buffer.readValue<double>();
+			record->hostId = buffer.readValue<uint32_t>();
+			record->pduSize = buffer.readValue<uint32_t>();
+		}
+		traceReplayTrafficGenerator->hasUpcomingRecord = buffer.readValue<uint8_t>() != 0;
+	}
+}
+
+/**
+ * @brief Decode the state of a facility: counters, servers and queue.
+ *
+ * @param facility Facility that receives the state; must have the same number of servers as the saved one.
+ */
+void SimulationCheckpoint::readFacility(Facility &facility) {
+	facility.maxRecordedQueueSize = buffer.readValue<uint32_t>();
+	facility.queueSizeLimit = buffer.readValue<uint32_t>();
+	facility.dequeuedTokensCount = buffer.readValue<uint32_t>();
+	facility.lastQueueChangeTime = buffer.readValue<double>();
+	facility.sumBusyTime = buffer.readValue<double>();
+	facility.preemptedTokensCount = buffer.readValue<uint32_t>();
+	facility.sumLengthTimeProduct = buffer.readValue<double>();
+	facility.releasedTokensCount = buffer.readValue<uint32_t>();
+	facility.isUp_ = buffer.readValue<uint8_t>() != 0;
+	facility.droppedTokensCount = buffer.readValue<uint32_t>();
+	facility.requestsPreemptsCount = buffer.readValue<uint32_t>();
+	if (buffer.readValue<uint32_t>() != facility.servers.size()) {
+		throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "number of servers of facility " + facility.name + " differs");
+	}
+	for (auto &server : facility.servers) {
+		server.isBusy = buffer.readValue<uint8_t>() != 0;
+		server.token = readEntityOfType<Token>();
+		server.releasedTokensCount = buffer.readValue<uint32_t>();
+		server.serviceStartTime = buffer.readValue<double>();
+		server.sumBusyTime = buffer.readValue<double>();
+	}
+	uint32_t queueSize = buffer.readValue<uint32_t>();
+	facility.queue.clear();
+	for (uint32_t i = 0; i < queueSize; ++i) {
+		std::shared_ptr<Token> token = readEntityOfType<Token>();
+		EventType eventType = static_cast<EventType>(buffer.readValue<uint32_t>());
+		double serviceTime = buffer.readValue<double>();
+		facility.queue.push_back(FacilityQueueElement(token, eventType, serviceTime));
+	}
+}
+
+/**
+ * @brief Decode the state of a detection engine, and rebuild its grid cells from its window.
+ *
+ * @param detectionEngine Detection engine that receives the state; must have the same configuration as the saved one.
+ */
+void SimulationCheckpoint::readDetectionEngine(DetectionEngine &detectionEngine) {
+	unsigned int minimumTriggers = buffer.readValue<uint32_t>();
+	double radius = buffer.readValue<double>();
+	double timeWindow = buffer.readValue<double>();
+	if (minimumTriggers != detectionEngine.minimumTriggers || radius != detectionEngine.radius || timeWindow != detectionEngine.timeWindow) {
+		throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "configuration of detection engine differs");
+	}
+	detectionEngine.window.clear();
+	detectionEngine.cells.clear();
+	uint32_t windowSize = buffer.readValue<uint32_t>();
+	for (uint32_t i = 0; i < windowSize; ++i) {
+		std::shared_ptr<SeismicEventData> trigger = readEntityOfType<SeismicEventData>();
+		if (trigger == nullptr) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "detection engine trigger without seismic event data");
+		}
+		double deliveryTime = buffer.readValue<double>();
+		uint64_t cellKey = buffer.readValue<uint64_t>();
+		bool isAssociated = buffer.readValue<uint8_t>() != 0;
+		int row = detectionEngine.getRow(trigger->latitude);
+		if (cellKey != DetectionEngine::getCellKey(row, DetectionEngine::wrapColumn(detectionEngine.getColumn(row, trigger->longitude),
+				detectionEngine.getNumberOfColumns(row)))) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid grid cell of detection engine trigger");
+		}
+		DetectionEngine::TriggerRecord record = { std::move(trigger), deliveryTime, cellKey, nullptr, isAssociated };
+		detectionEngine.window.push_back(std::move(record));
+		detectionEngine.appendToCell(detectionEngine.window.back());
+	}
+	detectionEngine.recentDetections.clear();
+	uint32_t numberOfRecentDetections = buffer.readValue<uint32_t>();
+	for (uint32_t i = 0; i < numberOfRecentDetections; ++i) {
+		DetectionEngine::RecentDetection recentDetection;
+		recentDetection.detectionData = readEntityOfType<DetectionData>();
+		if (recentDetection.detectionData == nullptr) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "recent detection without detection data");
+		}
+		recentDetection.lastEventTime = buffer.readValue<double>();
+		recentDetection.extent = buffer.readValue<double>();
+		detectionEngine.recentDetections.push_back(std::move(recentDetection));
+	}
+	detectionEngine.newestEventTime = buffer.readValue<double>();
+	detectionEngine.triggersCount = buffer.readValue<uint32_t>();
+	detectionEngine.staleTriggersCount = buffer.readValue<uint32_t>();
+	detectionEngine.associatedTriggersCount = buffer.readValue<uint32_t>();
+	detectionEngine.detectionsCount = buffer.readValue<uint32_t>();
+	detectionEngine.detectionLatencySum = buffer.readValue<double>();
+}
+
+/**
+ * @brief Decode the state of a host availability model.
+ *
+ * @param hostAvailabilityModel Host availability model that receives the state; must have the same hosts as the saved one.
+ */
+void SimulationCheckpoint::readHostAvailabilityModel(HostAvailabilityModel &hostAvailabilityModel) {
+	uint32_t numberOfHosts = buffer.readValue<uint32_t>();
+	if (numberOfHosts != hostAvailabilityModel.sensors.size()) {
+		throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "number of hosts of host availability model differs");
+	}
+	hostAvailabilityModel.isStarted = buffer.readValue<uint8_t>() != 0;
+	std::istringstream randomStreamState(buffer.readString());
+	randomStreamState >> hostAvailabilityModel.randomStream;
+	if (!randomStreamState) {
+		throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid random stream state");
+	}
+	for (int state = 0; state < 3; ++state) {
+		hostAvailabilityModel.meanCycles[state] = buffer.readValue<double>();
+		hostAvailabilityModel.maximumRates[state] = buffer.readValue<double>();
+		hostAvailabilityModel.upCounts[state] = buffer.readValue<uint32_t>();
+		uint32_t numberOfWords = buffer.readValue<uint32_t>();
+		if (numberOfWords != 0 && numberOfWords != (numberOfHosts + 63) / 64) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid host states of host availability model");
+		}
+		hostAvailabilityModel.stateBits[state].clear();
+		for (uint32_t i = 0; i < numberOfWords; ++i) {
+			hostAvailabilityModel.stateBits[state].push_back(buffer.readValue<uint64_t>());
+		}
+	}
+	hostAvailabilityModel.candidateRate = buffer.readValue<double>();
+	hostAvailabilityModel.bufferedTriggers.clear();
+	uint32_t numberOfBufferingHosts = buffer.readValue<uint32_t>();
+	for (uint32_t i = 0; i < numberOfBufferingHosts; ++i) {
+		uint32_t hostIndex = buffer.readValue<uint32_t>();
+		if (hostIndex >= numberOfHosts) {
+			throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid host index of buffered trigger");
+		}
+		std::vector<std::shared_ptr<const SeismicEventData>> &triggers = hostAvailabilityModel.bufferedTriggers[hostIndex];
+		uint32_t numberOfTriggers = buffer.readValue<uint32_t>();
+		for (uint32_t j = 0; j < numberOfTriggers; ++j) {
+			std::shared_ptr<SeismicEventData> trigger = readEntityOfType<SeismicEventData>();
+			if (trigger == nullptr) {
+				throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "buffered trigger without seismic event data");
+			}
+			triggers.push_back(std::move(trigger));
+		}
+	}
+	hostAvailabilityModel.candidateTransitionsCount = buffer.readValue<uint32_t>();
+	hostAvailabilityModel.transitionsCount = buffer.readValue<uint32_t>();
+	hostAvailabilityModel.bufferedTriggersCount = buffer.readValue<uint32_t>();
+	hostAvailabilityModel.droppedTriggersCount = buffer.readValue<uint32_t>();
+}
+
+/**
+ * @brief Decode the state of a trickle outbox.
+ *
+ * @param trickleOutbox Trickle outbox that receives the state; must have the same configuration as the saved one.
+ */
+void SimulationCheckpoint::readTrickleOutbox(TrickleOutbox &trickleOutbox) {
+	unsigned int capacity = buffer.readValue<uint32_t>();
+	double initialBackoff = buffer.readValue<double>();
+	double maximumBackoff = buffer.readValue<double>();
+	double backoffMultiplier = buffer.readValue<double>();
+	unsigned int flushBatchSize = buffer.readValue<uint32_t>();
+	if (capacity != trickleOutbox.capacity || initialBackoff != trickleOutbox.initialBackoff || maximumBackoff != trickleOutbox.maximumBackoff ||
+			backoffMultiplier != trickleOutbox.backoffMultiplier || flushBatchSize != trickleOutbox.flushBatchSize) {
+		throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "configuration of trickle outbox differs");
+	}
+	trickleOutbox.outboxes.clear();
+	uint32_t numberOfOutboxes = buffer.readValue<uint32_t>();
+	for (uint32_t i = 0; i < numberOfOutboxes; ++i) {
+		TrickleOutbox::Outbox &outbox = trickleOutbox.outboxes[buffer.readValue<uint32_t>()];
+		uint32_t numberOfPdus = buffer.readValue<uint32_t>();
+		for (uint32_t j = 0; j < numberOfPdus; ++j) {
+			std::shared_ptr<ProtocolDataUnit> pdu = readEntityOfType<ProtocolDataUnit>();
+			if (pdu == nullptr) {
+				throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "outbox entry without PDU");
+			}
+			outbox.pdus.push_back(std::move(pdu));
+		}
+		outbox.uplink = readEntityOfType<Link>();
+		outbox.backoff = buffer.readValue<double>();
+		outbox.isTimerArmed = buffer.readValue<uint8_t>() != 0;
+	}
+	readTimerWheel(trickleOutbox.timerWheel);
+	trickleOutbox.dueOutboxIds.clear();
+	uint32_t numberOfDueOutboxes = buffer.readValue<uint32_t>();
+	for (uint32_t i = 0; i < numberOfDueOutboxes; ++i) {
+		trickleOutbox.dueOutboxIds.push_back(buffer.readValue<uint32_t>());
+	}
+	trickleOutbox.isScheduled = buffer.readValue<uint8_t>() != 0;
+	trickleOutbox.scheduledTime = buffer.readValue<double>();
+	trickleOutbox.storedPdusCount = buffer.readValue<uint32_t>();
+	trickleOutbox.sentPdusCount = buffer.readValue<uint32_t>();
+	trickleOutbox.flushedPdusCount = buffer.readValue<uint32_t>();
+	trickleOutbox.droppedPdusCount = buffer.readValue<uint32_t>();
+	trickleOutbox.retriesCount = buffer.readValue<uint32_t>();
+	trickleOutbox.failedRetriesCount = buffer.readValue<uint32_t>();
+	trickleOutbox.retryEventsCount = buffer.readValue<uint32_t>();
+}
+
+/**
+ * @brief Decode the state of a timer wheel.
+ *
+ * @param timerWheel Timer wheel that receives the state; must have the same tick and number of slots as the saved one.
+ */
+void SimulationCheckpoint::readTimerWheel(TimerWheel &timerWheel) {
+	double tickDuration = buffer.readValue<double>();
+	uint32_t numberOfSlots = buffer.readValue<uint32_t>();
+	if (tickDuration != timerWheel.tickDuration || numberOfSlots != timerWheel.slots.size()) {
+		throw CheckpointException(CheckpointReturnType::TOPOLOGY_MISMATCH, "configuration of timer wheel differs");
+	}
+	timerWheel.currentTick = buffer.readValue<uint64_t>();
+	timerWheel.wheelSize = 0;
+	for (uint32_t slotIndex = 0; slotIndex < numberOfSlots; ++slotIndex) {
+		std::vector<std::pair<uint64_t, uint32_t>> &slot = timerWheel.slots[slotIndex];
+		slot.clear();
+		uint32_t slotSize = buffer.readValue<uint32_t>();
+		for (uint32_t i = 0; i < slotSize; ++i) {
+			uint64_t tick = buffer.readValue<uint64_t>();
+			uint32_t timerId = buffer.readValue<uint32_t>();
+			if (tick % numberOfSlots != slotIndex || tick < timerWheel.currentTick || tick >= timerWheel.currentTick + numberOfSlots) {
+				throw CheckpointException(CheckpointReturnType::INVALID_CHECKPOINT, "invalid timer of timer wheel");
+			}
+			slot.push_back(std::make_pair(tick, timerId));
+		}
+		timerWheel.wheelSize += slotSize;
+	}
+	timerWheel.overflow.clear();
+	uint32_t overflowSize = buffer.readValue<uint32_t>();
+	for (uint32_t i = 0; i < overflowSize; ++i) {
+		uint64_t tick = buffer.readValue<uint64_t>();
+		uint32_t timerId = buffer.readValue<uint32_t>();
+		// Timers of the same tick are stored in insertion order, and inserted after those already there.
+		timerWheel.overflow.insert(timerWheel.overflow.end(), std::make_pair(tick, timerId));
+	}
+}
@@ -0,0 +1,161 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "BinaryBuffer.h"
+#include "CheckpointReturnType.h"
+#include "DetectionEngine.h"
+#include "HostAvailabilityModel.h"
+#include "TimerWheel.h"
+#include "TrickleOutbox.h"
+#include "SimulatorGlobals.h"
+#include "Scheduler.h"
+#include "Topology.h"
+#include "Facility.h"
+#include "Token.h"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#define CHECKPOINT_VERSION 18 //!< Version of the checkpoint format; checkpoints of other versions are rejected. Bump whenever the layout changes.
+
+/**
+ * @brief Simulation Checkpoint class.
+ * 
+ * @par Description
+ * Saves the dynamic state of a running simulation to a binary file and restores it later, such that the simulation resumes exactly as it
+ * would have continued: the same events, at the same times, with the same random variates. A long warm-up can then be simulated once, and
+ * many "what-if" scenarios (e.g., different link failures) forked from the saved state.
+ *
+ * The checkpoint holds:
+ * - SimulatorGlobals: clock, simulation start time, seed, token ID counter, replication number and the state of the random engine;
+ * - Scheduler: all pending events, with their entities or link IDs, including the recurring events of autonomous generators and components;
+ * - for each Node of the topology, its statistics;
+ * - for each Link (and reverse link) of the topology, its in-transit queue and the counters, servers and queue of its transmission server;
+ * - for each QCN sensor traffic generator of the topology, and each traffic generator added with addTrafficGenerator() (e.g., an
+ *   AggregatePoissonTrafficGenerator of background traffic), its on/off state, autonomous mode, generated tokens count and own random stream,
+ *   plus the state of its class (distributions and picked source of an AggregatePoissonTrafficGenerator; trace cursor, loop and time scale
+ *   anchors and records of a TraceReplayTrafficGenerator);
+ * - for each DetectionEngine added with addDetectionEngine(), its window of triggers, with the grid cells they occupy, its recent detections
+ *   and its counters;
+ * - for each HostAvailabilityModel added with addHostAvailabilityModel(), the states of its hosts, its candidate stream, its own random stream,
+ *   its buffered triggers and its counters;
+ * - for each TrickleOutbox added with addTrickleOutbox(), its outboxes (PDUs, uplink, backoff), the timers of its TimerWheel, the outboxes due
+ *   for processRetries(), the time of its recurring event and its counters;
+ * - tokens and PDUs in flight (in events, queues, servers and links), with routes, next links and contents. Objects referenced several times are stored
+ *   once and remain shared after restoring.
+ *
+ * The static configuration is not part of the checkpoint: to restart, the application builds the same topology again (e.g., with
+ * JsonScenarioLoader or TopologySnapshot), with fresh SimulatorGlobals and Scheduler objects, and then calls restore(). Nodes, links and
+ * generators are matched by their order in the topology maps, and added generators and components by their order of addition. Links restored in the down state notify their LinkStateObserver objects,
+ * thus routing tables registered on the rebuilt topology follow.
+ *
+ * Besides topology objects and added components, only Token, ProtocolDataUnit, SeismicEventData and DetectionData entities can be saved; other entities found in the
+ * simulation state (e.g., components not added to the checkpoint) cause UNSUPPORTED_ENTITY. Checkpoints must be saved between events, i.e., not while an event is being processed.
+ *
+ * @par Format versions
+ * CHECKPOINT_VERSION is incremented whenever the layout, or the meaning of a stored value (e.g., EventType numbers), changes:
+ * - 1: initial format;
+ * - 2 to 4: new event types;
+ * - 5: event payload tag and index;
+ * - 6: own random stream of the traffic generators;
+ * - 7: buffered variates of the traffic generators;
+ * - 8: autonomous mode of the traffic generators and recurring flag of the events;
+ * - 9: event payload tag and index removed; tags are recomputed from the restored entities;
+ * - 10: next link of the tokens;
+ * - 11: buffered variates of the traffic generators removed;
+ * - 12: traffic generators added outside the topology, and state of AggregatePoissonTrafficGenerator;
+ * - 13: replay state of TraceReplayTrafficGenerator;
+ * - 14: new event type;
+ * - 15: state of DetectionEngine, and DetectionData entities;
+ * - 16: state of HostAvailabilityModel, and components referenced by events;
+ * - 17: state of TrickleOutbox;
+ * - 18: link ID payloads of events.
+ */
+class SimulationCheckpoint {
+private:
+	/// Malformed or unsupported checkpoint; converted into CheckpointReturnType by save() and restore().
+	class CheckpointException: public std::runtime_error {
+	public:
+		CheckpointReturnType checkpointReturnType;
+		CheckpointException(CheckpointReturnType checkpointReturnType, const std::string &message): std::runtime_error(message),
+			checkpointReturnType(checkpointReturnType) {}
+	};
+
+	/// Kind of entity reference within the checkpoint.
+	enum class EntityTag: uint8_t {
+		NO_ENTITY,				//!< nullptr.
+		NODE,					//!< Node of the topology, followed by its index.
+		LINK,					//!< Link of the topology, followed by its index.
+		TRAFFIC_GENERATOR,		//!< Traffic generator of the topology, followed by its index.
+		OBJECT,					//!< Token, PDU or data object already stored, followed by its index.
+		NEW_TOKEN,				//!< Token stored for the first time, followed by its contents.
+		NEW_PROTOCOL_DATA_UNIT,	//!< PDU stored for the first time, followed by its contents.
+		NEW_SEISMIC_EVENT_DATA,	//!< Seismic event data stored for the first time, followed by its contents.
+		NEW_DETECTION_DATA,		//!< Detection data stored for the first time, followed by its contents.
+		COMPONENT				//!< Component added to the checkpoint (e.g., HostAvailabilityModel), followed by its index.
+	};
+
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object to save or restore.
+	Scheduler &scheduler; //!< Reference to Scheduler object to save or restore.
+	std::string errorMessage; //!< Description of the last error.
+	BinaryBuffer buffer; //!< Checkpoint contents, for saving and restoring.
+	std::vector<std::shared_ptr<Node>> nodes; //!< Unique nodes of the topology, in map order.
+	std::vector<std::shared_ptr<Link>> links; //!< Unique links of the topology, in map order, each duplex link followed by its reverse link.
+	std::vector<std::shared_ptr<TrafficGenerator>> trafficGenerators; //!< Unique traffic generators of the topology, in map order, followed by the added ones.
+	std::vector<std::shared_ptr<TrafficGenerator>> addedTrafficGenerators; //!< Traffic generators outside the topology, in order of addition.
+	std::vector<DetectionEngine *> detectionEngines; //!< Detection engines, in order of addition.
+	std::vector<HostAvailabilityModel *> hostAvailabilityModels; //!< Host availability models, in order of addition.
+	std::vector<TrickleOutbox *> trickleOutboxes; //!< Trickle outboxes, in order of addition.
+	std::vector<Entity *> components; //!< Components that events may reference (host availability models, then trickle outboxes), by index.
+	std::unordered_map<const Entity *, std::pair<EntityTag, uint32_t>> entityIndexMap; //!< Tag and index of entities already known, for saving.
+	std::vector<std::shared_ptr<Entity>> objects; //!< Tokens, PDUs and data objects already rebuilt, by index, for restoring.
+	uint32_t objectsCount; //!< Number of tokens, PDUs and data objects already stored, for saving.
+
+	void registerTopology(const Topology &topology);
+	void writeEntity(const Entity *entity);
+	void writeToken(const Token &token);
+	void writeTrafficGenerator(const TrafficGenerator &trafficGenerator);
+	void writeFacility(const Facility &facility);
+	void writeDetectionEngine(const DetectionEngine &detectionEngine);
+	void writeHostAvailabilityModel(const HostAvailabilityModel &hostAvailabilityModel);
+	void writeTrickleOutbox(const TrickleOutbox &trickleOutbox);
+	void writeTimerWheel(const TimerWheel &timerWheel);
+	std::shared_ptr<Entity> readEntity();
+	template<typename T> std::shared_ptr<T> readEntityOfType();
+	static EventPayloadType getPayloadType(const Entity *entity);
+	void readToken(Token &token);
+	void readTrafficGenerator(TrafficGenerator &trafficGenerator);
+	void readFacility(Facility &facility);
+	void readDetectionEngine(DetectionEngine &detectionEngine);
+	void readHostAvailabilityModel(HostAvailabilityModel &hostAvailabilityModel);
+	void readTrickleOutbox(TrickleOutbox &trickleOutbox);
+	void readTimerWheel(TimerWheel &timerWheel);
+
+public:
+	SimulationCheckpoint(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler);
+
+	void addTrafficGenerator(std::shared_ptr<TrafficGenerator> trafficGenerator);
+	void addDetectionEngine(DetectionEngine &detectionEngine);
+	void addHostAvailabilityModel(HostAvailabilityModel &hostAvailabilityModel);
+	void addTrickleOutbox(TrickleOutbox &trickleOutbox);
+
+	CheckpointReturnType save(const std::string &fileName, const Topology &topology);
+	CheckpointReturnType restore(const std::string &fileName, const Topology &topology);
+	std::string getErrorMessage() const;
+};
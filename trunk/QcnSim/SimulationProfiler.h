@@ -0,0 +1,182 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Event.h"
+#include "EventType.h"
+#include "ProfilerRecord.h"
+#include "Scheduler.h"
+#include "SimulatorGlobals.h"
+#include <chrono>
+#include <ostream>
+#include <string>
+
+/// Profiling policy of SimulationProfiler: measurements taken.
+struct ProfilingEnabled {
+	static const bool isEnabled = true; //!< True if measurements are taken.
+};
+
+/// Profiling policy of SimulationProfiler: no measurements; every call compiles to nothing, or to the plain scheduler call.
+struct ProfilingDisabled {
+	static const bool isEnabled = false; //!< True if measurements are taken.
+};
+
+/**
+ * @brief Simulation Profiler class template.
+ * 
+ * @par Description
+ * Instrumentation of the main loop of a driver, selected at compile time by a policy (ProfilingEnabled or ProfilingDisabled). The driver
+ * pops events with cause() and may insert its own events with schedule(), and surrounds the handling of each event with beginHandler() and
+ * endHandler():
+ * @code
+ * SimulationProfiler<ProfilingEnabled> profiler(simulatorGlobals, scheduler);
+ * while (!simulationEnded) {
+ *     currentEvent = profiler.cause();
+ *     profiler.beginHandler(currentEvent.eventType);
+ *     switch (currentEvent.eventType) { ... }
+ *     profiler.endHandler();
+ * }
+ * profiler.writeReport(std::cout);
+ * @endcode
+ * The enabled profiler counts events per EventType, times their handlers, pops and driver inserts with std::chrono::steady_clock (portable,
+ * unlike a raw cycle counter, and of nanosecond resolution in the usual platforms), and records the event chain size after each pop, along
+ * with samples of simulated against wallclock time (see ProfilerRecord). Events inserted by Link, Facility, generators, etc. are timed as part
+ * of the handler that caused them.
+ *
+ * With ProfilingDisabled, the specialization below keeps no state and its member functions are empty inline functions, thus the
+ * instrumented loop compiles to the same code as the plain one.
+ */
+template<typename ProfilingPolicy> class SimulationProfiler {
+private:
+	typedef std::chrono::steady_clock Clock; //!< Clock of the measurements.
+
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object, for the simulated time.
+	Scheduler &scheduler; //!< Reference to Scheduler object, whose events are popped and inserted.
+	ProfilerRecord profilerRecord; //!< Measurements.
+	Clock::time_point startTime; //!< Wallclock time of the construction of the profiler, i.e., of the start of the run.
+	Clock::time_point handlerStartTime; //!< Wallclock time of the last beginHandler().
+	EventType handlerEventType; //!< Event type of the last beginHandler().
+
+	/**
+	 * @brief Nanoseconds elapsed between two time points.
+	 *
+	 * @param fromTime Earlier time point.
+	 * @param toTime Later time point.
+	 * @return Nanoseconds.
+	 */
+	static int64_t getNanoseconds(Clock::time_point fromTime, Clock::time_point toTime) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(toTime - fromTime).count();
+	}
+
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param simulatorGlobals Reference to SimulatorGlobals object.
+	 * @param scheduler Reference to Scheduler object.
+	 * @param sampleInterval Number of events between progress samples.
+	 */
+	SimulationProfiler(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, unsigned int sampleInterval = PROFILER_SAMPLE_INTERVAL):
+			simulatorGlobals(simulatorGlobals), scheduler(scheduler), profilerRecord(sampleInterval), startTime(Clock::now()),
+			handlerStartTime(startTime), handlerEventType(EventType::BEGIN_SIMULATION) {
+	}
+
+	/**
+	 * @brief Pop the next event from the scheduler (see Scheduler::cause()), timing the pop and recording the event chain size.
+	 *
+	 * @return Event caused.
+	 */
+	Event cause() {
+		Clock::time_point popStartTime = Clock::now();
+		Event event = scheduler.cause();
+		Clock::time_point popEndTime = Clock::now();
+		profilerRecord.addPopTime(getNanoseconds(popStartTime, popEndTime));
+		profilerRecord.recordEventChainSize(getNanoseconds(startTime, popEndTime), simulatorGlobals.getCurrentAbsoluteTime(), scheduler.getChainSize());
+		return event;
+	}
+
+	/**
+	 * @brief Insert an event into the scheduler (see Scheduler::schedule()), timing the insert.
+	 *
+	 * @param event Event to schedule.
+	 */
+	void schedule(const Event &event) {
+		Clock::time_point insertStartTime = Clock::now();
+		scheduler.schedule(event);
+		profilerRecord.addInsertTime(getNanoseconds(insertStartTime, Clock::now()));
+	}
+
+	/**
+	 * @brief Start timing the handler of an event.
+	 *
+	 * @param eventType Type of the event.
+	 */
+	void beginHandler(EventType eventType) {
+		handlerEventType = eventType;
+		handlerStartTime = Clock::now();
+	}
+
+	/**
+	 * @brief Stop timing the handler started by beginHandler(), and count its event.
+	 */
+	void endHandler() {
+		profilerRecord.addHandlerTime(handlerEventType, getNanoseconds(handlerStartTime, Clock::now()));
+	}
+
+	/**
+	 * @brief Write the text report (see ProfilerRecord::writeReport()).
+	 *
+	 * @param outputStream Stream to write to.
+	 */
+	void writeReport(std::ostream &outputStream) const {
+		profilerRecord.writeReport(outputStream);
+	}
+
+	/**
+	 * @brief Write the Chrome trace-event JSON file of the progress of the run (see ProfilerRecord::writeChromeTrace()).
+	 *
+	 * @param fileName Name of the file.
+	 * @return True if written; false if the file could not be written.
+	 */
+	bool writeChromeTrace(const std::string &fileName) const {
+		return profilerRecord.writeChromeTrace(fileName);
+	}
+
+	/**
+	 * @brief Measurements taken so far.
+	 *
+	 * @return Pointer to the record.
+	 */
+	const ProfilerRecord *getProfilerRecord() const {
+		return &profilerRecord;
+	}
+};
+
+/**
+ * @brief Simulation Profiler with profiling disabled: no state and no measurements.
+ */
+template<> class SimulationProfiler<ProfilingDisabled> {
+private:
+	Scheduler &scheduler; //!< Reference to Scheduler object, whose events are popped and inserted.
+
+public:
+	SimulationProfiler(SimulatorGlobals &, Scheduler &scheduler, unsigned int = PROFILER_SAMPLE_INTERVAL): scheduler(scheduler) {}
+	Event cause() { return scheduler.cause(); }
+	void schedule(const Event &event) { scheduler.schedule(event); }
+	void beginHandler(EventType) {}
+	void endHandler() {}
+	void writeReport(std::ostream &) const {}
+	bool writeChromeTrace(const std::string &) const { return true; }
+	const ProfilerRecord *getProfilerRecord() const { return nullptr; }
+};
@@ -22,7 +22,7 @@
 /**
  * Default Constructor
  */
-SimulatorGlobals::SimulatorGlobals(): currentAbsoluteTime(CURRENT_ABSOLUTE_TIME), simulationAbsoluteStartTime(SIMULATION_ABSOLUTE_START_TIME), printTraceFlag(PRINT_TRACE_FLAG), version(VERSION), tokenInitialId(0) {
+SimulatorGlobals::SimulatorGlobals(): currentAbsoluteTime(CURRENT_ABSOLUTE_TIME), simulationAbsoluteStartTime(SIMULATION_ABSOLUTE_START_TIME), printTraceFlag(PRINT_TRACE_FLAG), version(VERSION), tokenInitialId(0), replication(0) {
 	initializeRandomGeneratorRandomSeed();
 }
 
@@ -34,7 +34,7 @@ SimulatorGlobals::SimulatorGlobals(): currentAbsoluteTime(CURRENT_ABSOLUTE_TIME)
  * @param printTraceFlag TRUE:  prints tracing information; FALSE:  does not print tracing information during simulation.
  * @param version Simulator current version.
  */
-SimulatorGlobals::SimulatorGlobals(double currentAbsoluteTime, double simulationAbsoluteStartTime, bool printTraceFlag, std::string version): currentAbsoluteTime(currentAbsoluteTime), simulationAbsoluteStartTime(simulationAbsoluteStartTime), printTraceFlag(printTraceFlag), version(version), tokenInitialId(0) {
+SimulatorGlobals::SimulatorGlobals(double currentAbsoluteTime, double simulationAbsoluteStartTime, bool printTraceFlag, std::string version): currentAbsoluteTime(currentAbsoluteTime), simulationAbsoluteStartTime(simulationAbsoluteStartTime), printTraceFlag(printTraceFlag), version(version), tokenInitialId(0), replication(0) {
 	initializeRandomGeneratorRandomSeed();
 }
 
@@ -48,7 +48,7 @@ SimulatorGlobals::SimulatorGlobals(double currentAbsoluteTime, double simulation
  * @param printTraceFlag TRUE:  prints tracing information; FALSE:  does not print tracing information during simulation.
  * @param version Simulator current version.
  */
-SimulatorGlobals::SimulatorGlobals(double currentAbsoluteTime, bool printTraceFlag, std::string version): currentAbsoluteTime(currentAbsoluteTime), simulationAbsoluteStartTime(currentAbsoluteTime), printTraceFlag(printTraceFlag), version(version), tokenInitialId(0) {
+SimulatorGlobals::SimulatorGlobals(double currentAbsoluteTime, bool printTraceFlag, std::string version): currentAbsoluteTime(currentAbsoluteTime), simulationAbsoluteStartTime(currentAbsoluteTime), printTraceFlag(printTraceFlag), version(version), tokenInitialId(0), replication(0) {
 	initializeRandomGeneratorRandomSeed();
 }
 
@@ -83,6 +83,43 @@ std::default_random_engine &SimulatorGlobals::getRandomNumberGeneratorEngineInst
 	return randomEngine;
 }
 
+/**
+ * Returns the replication number of this run.
+ *
+ * @return Replication number.
+ */
+unsigned int SimulatorGlobals::getReplication() const {
+	return replication;
+}
+
+/**
+ * Sets the replication number of this run.
+ *
+ * @details 
+ * Replications of a simulation use the same seed and differ by the replication number, which selects independent random streams (see
+ * createRandomStream()). Set it before creating the streams.
+ *
+ * @param replication Replication number.
+ */
+void SimulatorGlobals::setReplication(unsigned int replication) {
+	this->replication = replication;
+}
+
+/**
+ * Creates an independent random stream for a simulator component.
+ *
+ * @details 
+ * The stream is keyed by the current seed, the stream ID and the replication number, thus its sequence depends neither on other components
+ * nor on the order in which streams are created or used. Components must use distinct stream IDs. The random engine returned by
+ * getRandomNumberGeneratorEngineInstance() is not affected.
+ *
+ * @param streamId ID of the stream, unique among the components of the simulation.
+ * @return New random stream, positioned at its beginning.
+ */
+RandomStream SimulatorGlobals::createRandomStream(unsigned int streamId) const {
+	return RandomStream(seed, streamId, replication);
+}
+
 /**
  * Returns the simulation duration in time.
  *
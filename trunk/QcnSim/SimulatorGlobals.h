@@ -21,6 +21,7 @@
 
 #include <string>
 #include <random>
+#include "RandomStream.h"
 
 #define CURRENT_ABSOLUTE_TIME 0.0  //!< default currentAbsoluteTime
 // Let the default SIMULATION_ABSOLUTE_START_TIME be equal to CURRENT_ABSOLUTE_TIME.
@@ -151,6 +152,10 @@
  * Most important one is currentAbsoluteTime, which indicates the current, clock time of the simulation.
  * It also includes resources to automatically generate unique token IDs and maintain a simulator-unique
  * random number generator engine and seed.
+ *
+ * The engine is shared by every component that uses it, thus adding a component changes the numbers all others draw. Components that must
+ * stay reproducible independently of the rest (e.g., under parallel or partitioned runs) draw from their own RandomStream instead, created
+ * with createRandomStream() and keyed by seed, stream ID and replication number.
  * 
  * Changelog:
  * 
@@ -166,6 +171,7 @@ private:
 	std::default_random_engine randomEngine; //!< The Random Engine to be used by traffic generators.
 	unsigned int seed; //!< The actual seed to use (or being used) for the random number generator.
 	unsigned int tokenInitialId; //!< Initial ID for tokens generated in this simulator. To assure unique IDs, use the function getTokenNextId().
+	unsigned int replication; //!< Replication number of this run; selects independent random streams for runs with the same seed.
 	
 	void initializeRandomGeneratorRandomSeed();
 
@@ -184,6 +190,11 @@ public:
 	void setCurrentAbsoluteTime(double currentAbsoluteTime);
 	unsigned int getTokenNextId();
 	std::default_random_engine &getRandomNumberGeneratorEngineInstance();
+	unsigned int getReplication() const;
+	void setReplication(unsigned int replication);
+	RandomStream createRandomStream(unsigned int streamId) const;
+
+	/// Event traces are recorded by EventTracer; printTraceFlag only selects text traces of the drivers.
 
-	/// @todo Tracing is not yet implemented. Each class must implement its own trace routines.
+	friend class SimulationCheckpoint; //!< Saves and restores clock, token IDs and random engine state.
 };
@@ -0,0 +1,28 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+* @brief Snapshot Return Type enum class.
+*
+* @par Description
+* Types of return from TopologySnapshot functions.
+*/
+enum class SnapshotReturnType {
+	SNAPSHOT_SAVED,		//!< Snapshot was successfully written.
+	SNAPSHOT_LOADED,	//!< Snapshot was successfully read and the topology rebuilt.
+	FILE_NOT_FOUND,		//!< Snapshot file could not be opened for reading or writing.
+	INVALID_SNAPSHOT,	//!< File is not a snapshot, has an incompatible version, or is truncated or corrupted.
+	UNSUPPORTED_ENTITY	//!< Topology references an Entity that cannot be serialized (e.g., a route hop that is not a Node of the topology).
+};
@@ -0,0 +1,328 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+#include "Event.h"
+#include "EventType.h"
+#include "ExponentialTrafficGenerator.h"
+#include "Link.h"
+#include "LinkType.h"
+#include "Node.h"
+#include "NodeReturnType.h"
+#include "ProtocolDataUnit.h"
+#include "Scheduler.h"
+#include "SimulatorGlobals.h"
+#include "TrafficGenerator.h"
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Static Topology class template.
+ * 
+ * @par Description
+ * A network topology whose node, link and traffic generator types are template parameters, with a simulation kernel for the path of a PDU
+ * (generation, arrival at node, transmission, propagation). Since the driver knows the concrete types, the kernel calls them with qualified
+ * names (e.g., link->LinkClass::transmitPdu()), which are bound at compile time instead of through the virtual tables: the calls can be
+ * inlined, across translation units with link-time optimization (QCNSIM_ENABLE_LTO). The virtual classes are unchanged; a derived class,
+ * e.g., a link with another loss model, is used as a policy by passing it as the template parameter, and its own (hiding or overriding)
+ * member functions are then called directly.
+ *
+ * Nodes are indexed by their node IDs, which must be dense. Links are looked up by the previous and next hops of the PDU, or taken from
+ * the PDU itself for PDUs routed hop by hop (the link of the forwarding table entry of the previous hop); a duplex link serves both directions (its reverse link is reached
+ * through Link itself). Each generator is attached to its source node and generates
+ * PDUs of a given size along a given explicit route (or hop by hop, if the route is empty), until the generation end time given to start().
+ * @code
+ * StaticTopology<Node, Link, ExponentialTrafficGenerator> topology(simulatorGlobals, scheduler);
+ * topology.addNode(node0); topology.addNode(node1);
+ * topology.addLink(link01);
+ * topology.addGenerator(generator0, 512, route01);
+ * topology.start(10.0);
+ * scheduler.schedule(Event(100.0, EventType::END_SIMULATION, nullptr));
+ * topology.run();
+ * @endcode
+ * Events off the PDU path are left to the driver: handleEvent() returns false for them, and run() passes them to a handler. Zero-delay
+ * continuations are fused as in the drivers (see Scheduler::scheduleOrFuse()).
+ */
+template<typename NodeClass = Node, typename LinkClass = Link, typename GeneratorClass = ExponentialTrafficGenerator> class StaticTopology {
+	static_assert(std::is_base_of<Node, NodeClass>::value, "NodeClass must derive from Node.");
+	static_assert(std::is_base_of<Link, LinkClass>::value, "LinkClass must derive from Link.");
+	static_assert(std::is_base_of<TrafficGenerator, GeneratorClass>::value, "GeneratorClass must derive from TrafficGenerator.");
+
+private:
+	/// Generator attached to a source node, with the PDUs it generates.
+	struct GeneratorSlot {
+		std::shared_ptr<GeneratorClass> generator; //!< Generator; nullptr if the node has none.
+		unsigned int pduSize; //!< Size of the generated PDUs, in bytes.
+		std::vector<std::shared_ptr<Entity>> explicitRoute; //!< Explicit route of the generated PDUs.
+	};
+
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object, for the clock.
+	Scheduler &scheduler; //!< Reference to Scheduler object, whose events are handled.
+	std::vector<std::shared_ptr<NodeClass>> nodes; //!< Nodes, by node ID; nullptr for IDs not in the topology.
+	std::vector<std::shared_ptr<LinkClass>> links; //!< Links, in the order added.
+	std::vector<std::vector<std::pair<const Entity *, LinkClass *>>> linksFromNode; //!< By node ID, the links leaving the node, with the node they lead to.
+	std::vector<GeneratorSlot> generatorOfNode; //!< By node ID, the generator attached to the node.
+	double generationEndTime; //!< Absolute time after which generators stop generating PDUs.
+	uint64_t eventsCount; //!< Events handled by the kernel, including fused continuations.
+
+	/**
+	 * @brief Resize the vectors indexed by node ID, such that they hold the given node ID.
+	 *
+	 * @param nodeId Node ID.
+	 */
+	void reserveNodeId(unsigned int nodeId) {
+		if (nodeId >= nodes.size()) {
+			nodes.resize(nodeId + 1);
+			linksFromNode.resize(nodeId + 1);
+			generatorOfNode.resize(nodeId + 1);
+		}
+	}
+
+	/**
+	 * @brief Find the link between two adjacent nodes.
+	 *
+	 * @param fromNode Node the PDU leaves (previous hop).
+	 * @param toNode Node the PDU goes to (next hop).
+	 * @return Link between the nodes, or nullptr if none.
+	 */
+	LinkClass *findLink(const Entity *fromNode, const Entity *toNode) const {
+		for (auto &linkEntry : linksFromNode[static_cast<const NodeClass *>(fromNode)->NodeClass::getNodeId()]) {
+			if (linkEntry.first == toNode) {
+				return linkEntry.second;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Find the link a PDU goes through, from its previous to its next hop.
+	 *
+	 * @details 
+	 * A PDU routed hop by hop goes through the link recorded in it by its previous hop, from its forwarding table entry (see Token::nextLink);
+	 * links of forwarding tables must then be links of the topology. The PDU keeps that link until the next hop forwards it, thus it ends
+	 * propagation on the link it was transmitted on even if the entry changed meanwhile. Otherwise, the link is found by the hops.
+	 *
+	 * @param pdu PDU between its previous and next hops.
+	 * @return Link of the PDU, or nullptr if none.
+	 */
+	LinkClass *findLink(const ProtocolDataUnit &pdu) const {
+		return pdu.nextLink != nullptr ? static_cast<LinkClass *>(pdu.nextLink.get()) : findLink(pdu.previous.get(), pdu.next.get());
+	}
+
+	/**
+	 * @brief Whether an event type is handled by the kernel, i.e., belongs to the path of a PDU.
+	 *
+	 * @param eventType Event type.
+	 * @return True if handled by the kernel.
+	 */
+	static bool isPduPathEvent(EventType eventType) {
+		return eventType == EventType::TRAFFIC_GENERATOR_ARRIVAL || eventType == EventType::PDUTOKEN_ARRIVAL_AT_NODE ||
+			eventType == EventType::REQUEST_PDU_TRANSMISSION_AT_LINK || eventType == EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK ||
+			eventType == EventType::END_PROPAGATION_AT_LINK;
+	}
+
+public:
+	/**
+	 * @brief Constructor.
+	 *
+	 * @param simulatorGlobals Reference to SimulatorGlobals object.
+	 * @param scheduler Reference to Scheduler object, shared by the nodes, links and generators.
+	 */
+	StaticTopology(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler): simulatorGlobals(simulatorGlobals), scheduler(scheduler),
+		generationEndTime(0.0), eventsCount(0) {}
+
+	/**
+	 * @brief Add a node, indexed by its node ID.
+	 *
+	 * @param node Node.
+	 */
+	void addNode(std::shared_ptr<NodeClass> node) {
+		unsigned int nodeId = node->NodeClass::getNodeId();
+		reserveNodeId(nodeId);
+		nodes[nodeId] = node;
+	}
+
+	/**
+	 * @brief Add a link between two nodes already added; a duplex link is added for both directions.
+	 *
+	 * @param link Link.
+	 */
+	void addLink(std::shared_ptr<LinkClass> link) {
+		links.push_back(link);
+		linksFromNode[link->getNodeA()->getNodeId()].push_back(std::make_pair(link->getNodeB().get(), link.get()));
+		if (link->getLinkType() == LinkType::DUPLEX_LINK) {
+			linksFromNode[link->getNodeB()->getNodeId()].push_back(std::make_pair(link->getNodeA().get(), link.get()));
+		}
+	}
+
+	/**
+	 * @brief Attach a generator to its source node, which must be already added; the node may hold one generator.
+	 *
+	 * @param generator Generator, with its event type set to TRAFFIC_GENERATOR_ARRIVAL.
+	 * @param pduSize Size of the generated PDUs, in bytes.
+	 * @param explicitRoute Explicit route of the generated PDUs, from the source node to the destination node; empty for PDUs routed hop by
+	 * hop, through forwarding tables.
+	 */
+	void addGenerator(std::shared_ptr<GeneratorClass> generator, unsigned int pduSize, std::vector<std::shared_ptr<Entity>> explicitRoute) {
+		GeneratorSlot &generatorSlot = generatorOfNode[std::static_pointer_cast<NodeClass>(generator->getSource())->getNodeId()];
+		generatorSlot.generator = generator;
+		generatorSlot.pduSize = pduSize;
+		generatorSlot.explicitRoute = std::move(explicitRoute);
+	}
+
+	/**
+	 * @brief Schedule the first PDU of every generator.
+	 *
+	 * @param generationEndTime Absolute time after which generators stop generating PDUs.
+	 */
+	void start(double generationEndTime) {
+		this->generationEndTime = generationEndTime;
+		for (auto &generatorSlot : generatorOfNode) {
+			if (generatorSlot.generator != nullptr) {
+				generatorSlot.generator->GeneratorClass::createInstanceTrafficEventPdu(generatorSlot.pduSize, generatorSlot.explicitRoute);
+			}
+		}
+	}
+
+	/**
+	 * @brief Handle an event of the path of a PDU, along with its fused continuations.
+	 *
+	 * @details 
+	 * - TRAFFIC_GENERATOR_ARRIVAL: the generator of the source node generates its next PDU (until the generation end time), and the PDU
+	 *   arrives at the source node.
+	 * - PDUTOKEN_ARRIVAL_AT_NODE: the PDU ends propagation in the link it came through, if any, and is processed by the node; if forwarded,
+	 *   its transmission is requested next.
+	 * - REQUEST_PDU_TRANSMISSION_AT_LINK and END_TRANSMISSION_PROPAGATE_PDU_AT_LINK: the link between the previous and next hops of the
+	 *   PDU transmits, or propagates, the PDU. PDUs with no link to their next hop are dropped.
+	 * - END_PROPAGATION_AT_LINK: the PDU arrives at the next node.
+	 *
+	 * @param currentEvent Event just caused; on return, the last continuation handled.
+	 * @return True if handled; false if the event is off the PDU path, and left to the driver.
+	 */
+	bool handleEvent(Event &currentEvent) {
+		if (!isPduPathEvent(currentEvent.eventType)) {
+			return false;
+		}
+		std::shared_ptr<ProtocolDataUnit> pdu = currentEvent.getEntityAs<ProtocolDataUnit>();
+		bool isFused = false;
+		do {
+			++eventsCount;
+			isFused = false;
+			switch (currentEvent.eventType) {
+				case EventType::TRAFFIC_GENERATOR_ARRIVAL: {
+					GeneratorSlot &generatorSlot = generatorOfNode[static_cast<const NodeClass *>(pdu->source.get())->NodeClass::getNodeId()];
+					if (simulatorGlobals.getCurrentAbsoluteTime() < generationEndTime) {
+						generatorSlot.generator->GeneratorClass::createInstanceTrafficEventPdu(generatorSlot.pduSize, generatorSlot.explicitRoute);
+					}
+					isFused = scheduler.scheduleOrFuse(currentEvent, EventType::PDUTOKEN_ARRIVAL_AT_NODE);
+					break;
+				}
+				case EventType::PDUTOKEN_ARRIVAL_AT_NODE: {
+					NodeClass *node = static_cast<NodeClass *>(pdu->next.get());
+					if (pdu->previous != pdu->next) {
+						LinkClass *link = findLink(*pdu);
+						if (link != nullptr) {
+							link->LinkClass::endPropagation(pdu);
+						}
+					}
+					if (node->NodeClass::processAndForward(pdu) == NodeReturnType::PDU_ROUTE_UPDATED) {
+						isFused = scheduler.scheduleOrFuse(currentEvent, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK);
+					}
+					break;
+				}
+				case EventType::REQUEST_PDU_TRANSMISSION_AT_LINK: {
+					LinkClass *link = findLink(*pdu);
+					if (link != nullptr) {
+						link->LinkClass::transmitPdu(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK, pdu);
+					}
+					break;
+				}
+				case EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK: {
+					LinkClass *link = findLink(*pdu);
+					if (link != nullptr) {
+						link->LinkClass::propagatePdu(EventType::END_PROPAGATION_AT_LINK, pdu);
+					}
+					break;
+				}
+				default: // END_PROPAGATION_AT_LINK.
+					isFused = scheduler.scheduleOrFuse(currentEvent, EventType::PDUTOKEN_ARRIVAL_AT_NODE);
+					break;
+			}
+		} while (isFused);
+		return true;
+	}
+
+	/**
+	 * @brief Run the simulation: cause events and handle them, passing those off the PDU path to a handler.
+	 *
+	 * @param otherEventHandler Callable taking the Event (const Event &) and returning false to end the simulation.
+	 * @return Events handled by the kernel during this run, including fused continuations, plus events passed to the handler.
+	 */
+	template<typename EventHandler> uint64_t run(EventHandler &&otherEventHandler) {
+		uint64_t firstEventsCount = eventsCount;
+		uint64_t otherEventsCount = 0;
+		Event currentEvent;
+		while (true) {
+			currentEvent = scheduler.cause();
+			if (!handleEvent(currentEvent)) {
+				++otherEventsCount;
+				if (!otherEventHandler(static_cast<const Event &>(currentEvent))) {
+					break;
+				}
+			}
+		}
+		return eventsCount - firstEventsCount + otherEventsCount;
+	}
+
+	/**
+	 * @brief Run the simulation until END_SIMULATION; other events off the PDU path are ignored.
+	 *
+	 * @return Events handled during this run, including fused continuations and END_SIMULATION.
+	 */
+	uint64_t run() {
+		return run([](const Event &event) { return event.eventType != EventType::END_SIMULATION; });
+	}
+
+	/**
+	 * @brief Get a node by its node ID.
+	 *
+	 * @param nodeId Node ID.
+	 * @return Node, or nullptr if not in the topology.
+	 */
+	std::shared_ptr<NodeClass> getNode(unsigned int nodeId) const {
+		return nodeId < nodes.size() ? nodes[nodeId] : nullptr;
+	}
+
+	/**
+	 * @brief Get the links, in the order added.
+	 *
+	 * @return Links.
+	 */
+	const std::vector<std::shared_ptr<LinkClass>> &getLinks() const {
+		return links;
+	}
+
+	/**
+	 * @brief Get the number of events handled by the kernel, including fused continuations.
+	 *
+	 * @return Events handled.
+	 */
+	uint64_t getEventsCount() const {
+		return eventsCount;
+	}
+};
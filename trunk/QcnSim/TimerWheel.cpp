@@ -0,0 +1,152 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TimerWheel.h"
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Constructor.
+ *
+ * @param tickDuration Duration of a tick, in seconds; timers expiring within the same tick expire together.
+ * @param numberOfSlots Number of slots, i.e., of ticks covered by the wheel before timers go to the overflow map.
+ */
+TimerWheel::TimerWheel(double tickDuration, unsigned int numberOfSlots): tickDuration(tickDuration), slots(numberOfSlots > 0 ? numberOfSlots : 1),
+		currentTick(0), wheelSize(0) {
+}
+
+/**
+ * @brief Tick of a timer expiring at a given time: the first tick boundary at or after the time.
+ *
+ * @param time Absolute time, in seconds.
+ * @return Tick.
+ */
+uint64_t TimerWheel::getTick(double time) const {
+	if (time <= 0.0) {
+		return 0;
+	}
+	// Tolerance, such that times computed as tick * tickDuration map back to the same tick.
+	return static_cast<uint64_t>(std::ceil(time / tickDuration - 1e-9));
+}
+
+/**
+ * @brief Move the overflow timers now covered by the wheel into their slots; those already past expire.
+ *
+ * @param expiredTimerIds Vector to which the IDs of expired timers are appended.
+ */
+void TimerWheel::migrateOverflow(std::vector<uint32_t> &expiredTimerIds) {
+	while (!overflow.empty() && overflow.begin()->first < currentTick + slots.size()) {
+		if (overflow.begin()->first < currentTick) {
+			expiredTimerIds.push_back(overflow.begin()->second);
+		} else {
+			slots[overflow.begin()->first % slots.size()].push_back(*overflow.begin());
+			++wheelSize;
+		}
+		overflow.erase(overflow.begin());
+	}
+}
+
+/**
+ * @brief Add a timer.
+ *
+ * @details 
+ * A timer whose expiry time is already past expires on the next advance().
+ *
+ * @param expiryTime Absolute expiry time, in seconds; rounded up to the next tick boundary.
+ * @param timerId ID of the timer, returned by advance() on expiry; need not be unique.
+ */
+void TimerWheel::add(double expiryTime, uint32_t timerId) {
+	uint64_t tick = getTick(expiryTime);
+	if (tick < currentTick) {
+		tick = currentTick;
+	}
+	if (tick < currentTick + slots.size()) {
+		slots[tick % slots.size()].push_back(std::make_pair(tick, timerId));
+		++wheelSize;
+	} else {
+		overflow.insert(std::make_pair(tick, timerId));
+	}
+}
+
+/**
+ * @brief Advance the wheel up to a time, expiring all timers of the ticks up to and including the tick of that time.
+ *
+ * @details 
+ * Visits at most one slot per tick advanced, and no more than all slots; an empty wheel jumps directly to the time.
+ *
+ * @param time Absolute time, in seconds; typically the current simulation time.
+ * @param expiredTimerIds Vector to which the IDs of expired timers are appended, in expiry order (and insertion order within a tick).
+ */
+void TimerWheel::advance(double time, std::vector<uint32_t> &expiredTimerIds) {
+	uint64_t endTick = time < 0.0 ? 0 : static_cast<uint64_t>(std::floor(time / tickDuration + 1e-9)) + 1;
+	if (endTick <= currentTick) {
+		return;
+	}
+	uint64_t lastVisitedTick = currentTick + slots.size() < endTick ? currentTick + slots.size() : endTick;
+	for (uint64_t tick = currentTick; tick < lastVisitedTick && wheelSize > 0; ++tick) {
+		std::vector<std::pair<uint64_t, uint32_t>> &slot = slots[tick % slots.size()];
+		for (auto &timer : slot) {
+			expiredTimerIds.push_back(timer.second);
+		}
+		wheelSize -= slot.size();
+		slot.clear();
+	}
+	currentTick = endTick;
+	migrateOverflow(expiredTimerIds);
+}
+
+/**
+ * @brief Expiry time of the next timer to expire, i.e., the boundary of its tick.
+ *
+ * @return Absolute expiry time, in seconds; std::numeric_limits<double>::max() if there is no timer.
+ */
+double TimerWheel::getNextExpiryTime() const {
+	if (wheelSize > 0) {
+		for (uint64_t tick = currentTick; tick < currentTick + slots.size(); ++tick) {
+			if (!slots[tick % slots.size()].empty()) {
+				return tick * tickDuration;
+			}
+		}
+	}
+	if (!overflow.empty()) {
+		return overflow.begin()->first * tickDuration;
+	}
+	return std::numeric_limits<double>::max();
+}
+
+/**
+ * @brief Whether there is no timer.
+ *
+ * @return True if there is no timer.
+ */
+bool TimerWheel::isEmpty() const {
+	return wheelSize == 0 && overflow.empty();
+}
+
+/**
+ * @brief Number of timers.
+ *
+ * @return Number of timers, in the wheel and in the overflow map.
+ */
+std::vector<std::pair<uint64_t, uint32_t>>::size_type TimerWheel::getSize() const {
+	return wheelSize + overflow.size();
+}
+
+/**
+ * @brief Duration of a tick.
+ *
+ * @return Duration of a tick, in seconds.
+ */
+double TimerWheel::getTickDuration() const {
+	return tickDuration;
+}
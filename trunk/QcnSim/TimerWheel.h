@@ -0,0 +1,57 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#define TIMER_WHEEL_TICK 0.1 //!< Default tick (granularity) of a timer wheel, in seconds.
+#define TIMER_WHEEL_SLOTS 256 //!< Default number of slots of a timer wheel.
+
+/**
+ * @brief Timer Wheel class.
+ * 
+ * @par Description
+ * Hashed timing wheel of timers identified by an integer ID, with O(1) insertion. Time is divided into ticks of tickDuration seconds, and
+ * each timer expires at the end of the tick of its expiry time, i.e., is rounded up to the next tick boundary and never fires early. All timers
+ * of a tick thus expire together, and a single event per tick suffices to serve any number of them (see TrickleOutbox).
+ *
+ * The wheel covers the next numberOfSlots ticks, one slot per tick; timers further away wait in an ordered overflow map, and move into the
+ * wheel as time advances. Timers cannot be cancelled; owners ignore the expiry of timers they no longer need.
+ */
+class TimerWheel {
+private:
+	double tickDuration; //!< Duration of a tick, in seconds.
+	std::vector<std::vector<std::pair<uint64_t, uint32_t>>> slots; //!< Tick and ID of the timers of each slot; slot of tick t is t % slots.size().
+	std::multimap<uint64_t, uint32_t> overflow; //!< Timers beyond the ticks covered by the wheel, by tick.
+	uint64_t currentTick; //!< First tick not yet advanced over; the wheel covers [currentTick, currentTick + slots.size()).
+	std::vector<std::pair<uint64_t, uint32_t>>::size_type wheelSize; //!< Number of timers in the slots (not in overflow).
+
+	uint64_t getTick(double time) const;
+	void migrateOverflow(std::vector<uint32_t> &expiredTimerIds);
+
+public:
+	TimerWheel(double tickDuration = TIMER_WHEEL_TICK, unsigned int numberOfSlots = TIMER_WHEEL_SLOTS);
+
+	void add(double expiryTime, uint32_t timerId);
+	void advance(double time, std::vector<uint32_t> &expiredTimerIds);
+	double getNextExpiryTime() const;
+	bool isEmpty() const;
+	std::vector<std::pair<uint64_t, uint32_t>>::size_type getSize() const;
+	double getTickDuration() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores the timers of the slots and of the overflow map.
+};
@@ -187,6 +187,27 @@ std::vector<std::shared_ptr<Entity>> Token::getExplicitRoute() const {
 	return route.getExplicitRoute();
 }
 
+/**
+ * @brief Check whether an explicit route is attached to this token.
+ *
+ * @details 
+ * Cheaper than getExplicitRoute().empty(), since no copy of the route is made.
+ *
+ * @return True if there is an explicit route; false otherwise.
+ */
+bool Token::hasExplicitRoute() const {
+	return !route.explicitRoute.empty();
+}
+
+/**
+ * @brief Get the number of hops of the explicit route attached to this token.
+ *
+ * @return Number of hops of the explicit route; zero if there is none.
+ */
+std::vector<std::shared_ptr<Entity>>::size_type Token::getExplicitRouteSize() const {
+	return route.explicitRoute.size();
+}
+
 /**
  * @brief Get value of flag recordThisRoute.
  *
@@ -55,6 +55,7 @@ public:
 	std::shared_ptr<Entity> associatedEntity;  //!< Reference to associated Entity object (typically another child of Entity class).
 	std::shared_ptr<Entity> previous; //!< Previous entity that had this token (for token routing).
 	std::shared_ptr<Entity> next; //!< Next entity that will have to process this token (to which entity the token has to be "sent", e.g., for which request service).
+	std::shared_ptr<Entity> nextLink; //!< Link through which the token goes from previous to next, as set by the forwarding table of previous; nullptr if not informed.
 	std::shared_ptr<Entity> source; //!< Source entity of this token.
 	std::shared_ptr<Entity> destination; //!< Destination entity of this token.
 	
@@ -76,6 +77,8 @@ public:
 	virtual double getAbsoluteGenerationTime() const;
 
 	virtual std::vector<std::shared_ptr<Entity>> getExplicitRoute() const;
+	virtual bool hasExplicitRoute() const;
+	virtual std::vector<std::shared_ptr<Entity>>::size_type getExplicitRouteSize() const;
 	virtual bool isRouteBeingRecorded() const;
 	virtual std::vector<std::shared_ptr<Entity>> getRecordedRoute() const;
 	virtual void setRecordThisRoute();
@@ -102,4 +105,6 @@ public:
 	friend bool operator!=(const Token &left, const Token &right);
 
 	/// @todo Do we need a move assignment operator?
+
+	friend class SimulationCheckpoint; //!< Saves and restores tokens in flight.
 };					
\ No newline at end of file
@@ -46,6 +46,7 @@ public:
 	std::map<unsigned int, std::shared_ptr<Node>> nodeMap; //!< Holds all nodes in the network.
 	std::map<unsigned int, std::shared_ptr<Link>> linkMap; //!< Map to concentrate all network links.
 	std::map<unsigned int, std::vector<std::shared_ptr<Entity>>> explicitRouteMap; //!< Map to concentrate all explicit route objects.
+	std::map<unsigned int, std::vector<std::vector<std::shared_ptr<Entity>>>> alternateRouteMap; //!< Additional explicit routes per key, in order of preference.
 
 	std::shared_ptr<Link> findLinkByNodeB(std::shared_ptr<Node> nodeA, std::shared_ptr<Node> nodeB);
 };
\ No newline at end of file
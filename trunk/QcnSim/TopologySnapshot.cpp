@@ -0,0 +1,443 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TopologySnapshot.h"
+#include <cstring>
+
+/**
+ * @brief Constructor.
+ *
+ * @param simulatorGlobals Reference to SimulatorGlobals object, passed on to the rebuilt objects.
+ * @param scheduler Reference to Scheduler object, passed on to the rebuilt objects.
+ */
+TopologySnapshot::TopologySnapshot(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler): simulatorGlobals(simulatorGlobals), scheduler(scheduler) {
+}
+
+/**
+ * @brief Save a topology, scenario parameters and earthquakes to a snapshot file.
+ *
+ * @details 
+ * All route hops and generator sources and destinations must be nodes of the topology (i.e., present in Topology::nodeMap), and link endpoints as well;
+ * otherwise, UNSUPPORTED_ENTITY is returned and nothing is written.
+ *
+ * @param fileName Name of the snapshot file; overwritten if it exists.
+ * @param topology Topology to save.
+ * @param scenarioParameters Scenario parameters to save.
+ * @param earthquakes Earthquakes to save.
+ *
+ * @return SnapshotReturnType indicating whether the snapshot was saved, or the kind of error.
+ */
+SnapshotReturnType TopologySnapshot::save(const std::string &fileName, const Topology &topology, const ScenarioParameters &scenarioParameters,
+										  const std::vector<std::shared_ptr<EarthquakeData>> &earthquakes) {
+	errorMessage.clear();
+	buffer.clear();
+	try {
+		std::unordered_map<const Entity *, uint32_t> nodeIndexMap;
+		std::unordered_map<const Entity *, uint32_t> linkIndexMap;
+		std::unordered_map<const Entity *, uint32_t> qcnSensorTrafficGeneratorIndexMap;
+		std::vector<std::shared_ptr<Node>> nodes;
+		std::vector<std::shared_ptr<Link>> links;
+		std::vector<std::shared_ptr<QcnSensorTrafficGenerator>> qcnSensorTrafficGenerators;
+
+		// Header.
+		buffer.writeBytes("QCNSNAP", 8); // Includes the terminating null.
+		buffer.writeValue<uint32_t>(SNAPSHOT_VERSION);
+
+		// Parameters and earthquakes.
+		buffer.writeString(scenarioParameters.simulationName);
+		buffer.writeString(scenarioParameters.simulationDescription);
+		buffer.writeValue(scenarioParameters.initialClock);
+		buffer.writeValue(scenarioParameters.endClock);
+		buffer.writeValue<uint8_t>(scenarioParameters.printTraces ? 1 : 0);
+		buffer.writeValue(scenarioParameters.startRecordingTime);
+		buffer.writeValue(static_cast<uint32_t>(earthquakes.size()));
+		for (auto &earthquake : earthquakes) {
+			buffer.writeValue<uint32_t>(earthquake->earthquakeId);
+			buffer.writeValue(earthquake->magnitude);
+			buffer.writeValue(earthquake->eventTime);
+			buffer.writeValue(earthquake->sWaveSpeed);
+			buffer.writeValue(earthquake->depth);
+			buffer.writeValue(earthquake->latitude);
+			buffer.writeValue(earthquake->longitude);
+		}
+
+		// Nodes: unique objects first, then map entries as (key, object index).
+		for (auto &nodeMapIterator : topology.nodeMap) {
+			if (nodeIndexMap.emplace(nodeMapIterator.second.get(), static_cast<uint32_t>(nodes.size())).second) {
+				nodes.push_back(nodeMapIterator.second);
+			}
+		}
+		buffer.writeValue(static_cast<uint32_t>(nodes.size()));
+		for (auto &node : nodes) {
+			buffer.writeValue<uint32_t>(node->getNodeId());
+		}
+		buffer.writeValue(static_cast<uint32_t>(topology.nodeMap.size()));
+		for (auto &nodeMapIterator : topology.nodeMap) {
+			buffer.writeValue<uint32_t>(nodeMapIterator.first);
+			buffer.writeValue(nodeIndexMap.at(nodeMapIterator.second.get()));
+		}
+
+		// Links.
+		for (auto &linkMapIterator : topology.linkMap) {
+			if (linkIndexMap.emplace(linkMapIterator.second.get(), static_cast<uint32_t>(links.size())).second) {
+				links.push_back(linkMapIterator.second);
+			}
+		}
+		buffer.writeValue(static_cast<uint32_t>(links.size()));
+		for (auto &link : links) {
+			writeEntityReference(nodeIndexMap, link->getNodeA());
+			writeEntityReference(nodeIndexMap, link->getNodeB());
+			buffer.writeValue(link->getBandwidth());
+			buffer.writeValue(link->getPropagationDelay());
+			buffer.writeString(link->getName());
+			buffer.writeValue<uint8_t>(link->getLinkType() == LinkType::DUPLEX_LINK ? 1 : 0);
+			buffer.writeValue<uint32_t>(link->getTransmissionQueueSizeLimit());
+			buffer.writeValue<uint8_t>(link->isUp() ? 1 : 0);
+		}
+		buffer.writeValue(static_cast<uint32_t>(topology.linkMap.size()));
+		for (auto &linkMapIterator : topology.linkMap) {
+			buffer.writeValue<uint32_t>(linkMapIterator.first);
+			buffer.writeValue(linkIndexMap.at(linkMapIterator.second.get()));
+		}
+
+		// QCN sensor traffic generators.
+		for (auto &generatorMapIterator : topology.qcnSensorTrafficGeneratorMap) {
+			if (qcnSensorTrafficGeneratorIndexMap.emplace(generatorMapIterator.second.get(), static_cast<uint32_t>(qcnSensorTrafficGenerators.size())).second) {
+				qcnSensorTrafficGenerators.push_back(generatorMapIterator.second);
+			}
+		}
+		buffer.writeValue(static_cast<uint32_t>(qcnSensorTrafficGenerators.size()));
+		for (auto &qcnSensorTrafficGenerator : qcnSensorTrafficGenerators) {
+			const QcnSensorParameters &sensorParameters = qcnSensorTrafficGenerator->getSensorParameters();
+			buffer.writeValue(static_cast<uint32_t>(qcnSensorTrafficGenerator->getEventType()));
+			writeEntityReference(nodeIndexMap, qcnSensorTrafficGenerator->getSource());
+			writeEntityReference(nodeIndexMap, qcnSensorTrafficGenerator->getDestination());
+			buffer.writeValue<int32_t>(qcnSensorTrafficGenerator->getPriority());
+			buffer.writeValue<uint8_t>(qcnSensorTrafficGenerator->isGeneratorOn() ? 1 : 0);
+			buffer.writeValue(qcnSensorTrafficGenerator->getLatitude());
+			buffer.writeValue(qcnSensorTrafficGenerator->getLongitude());
+			buffer.writeValue<uint32_t>(qcnSensorTrafficGenerator->getQcnExplorerSensorId());
+			buffer.writeValue<uint32_t>(qcnSensorTrafficGenerator->getRegionId());
+			buffer.writeValue(sensorParameters.onFraction);
+			buffer.writeValue(sensorParameters.connectedFraction);
+			buffer.writeValue(sensorParameters.activeFraction);
+			buffer.writeValue(sensorParameters.falseTriggerRate);
+			buffer.writeValue(sensorParameters.triggerLowerBound);
+			buffer.writeValue(sensorParameters.triggerUpperBound);
+			buffer.writeValue(sensorParameters.triggerProbability);
+			buffer.writeValue<uint32_t>(sensorParameters.pduSize);
+		}
+		buffer.writeValue(static_cast<uint32_t>(topology.qcnSensorTrafficGeneratorMap.size()));
+		for (auto &generatorMapIterator : topology.qcnSensorTrafficGeneratorMap) {
+			buffer.writeValue<uint32_t>(generatorMapIterator.first);
+			buffer.writeValue(qcnSensorTrafficGeneratorIndexMap.at(generatorMapIterator.second.get()));
+		}
+
+		// Routes.
+		buffer.writeValue(static_cast<uint32_t>(topology.explicitRouteMap.size()));
+		for (auto &explicitRouteMapIterator : topology.explicitRouteMap) {
+			buffer.writeValue<uint32_t>(explicitRouteMapIterator.first);
+			writeRoute(nodeIndexMap, explicitRouteMapIterator.second);
+		}
+		buffer.writeValue(static_cast<uint32_t>(topology.alternateRouteMap.size()));
+		for (auto &alternateRouteMapIterator : topology.alternateRouteMap) {
+			buffer.writeValue<uint32_t>(alternateRouteMapIterator.first);
+			buffer.writeValue(static_cast<uint32_t>(alternateRouteMapIterator.second.size()));
+			for (auto &route : alternateRouteMapIterator.second) {
+				writeRoute(nodeIndexMap, route);
+			}
+		}
+	} catch (const SnapshotException &exception) {
+		errorMessage = exception.what();
+		buffer.clear();
+		return exception.snapshotReturnType;
+	}
+
+	bool isWritten = buffer.writeToFile(fileName);
+	buffer.clear();
+	if (!isWritten) {
+		errorMessage = "cannot write snapshot file " + fileName;
+		return SnapshotReturnType::FILE_NOT_FOUND;
+	}
+	return SnapshotReturnType::SNAPSHOT_SAVED;
+}
+
+/**
+ * @brief Load a snapshot file, rebuilding its objects into a topology.
+ *
+ * @details 
+ * Objects are added to the maps of the given topology, which is typically empty. Scenario parameters and earthquakes are then available through
+ * getScenarioParameters() and getEarthquakes(). On error, the topology may be partially filled.
+ *
+ * @param fileName Name of the snapshot file.
+ * @param topology Topology that receives the rebuilt objects.
+ *
+ * @return SnapshotReturnType indicating whether the snapshot was loaded, or the kind of error.
+ */
+SnapshotReturnType TopologySnapshot::load(const std::string &fileName, Topology &topology) {
+	errorMessage.clear();
+	// Read the whole file with one read; everything else is decoded from memory.
+	if (!buffer.readFromFile(fileName)) {
+		errorMessage = "cannot read snapshot file " + fileName;
+		return SnapshotReturnType::FILE_NOT_FOUND;
+	}
+
+	try {
+		std::vector<std::shared_ptr<Node>> nodes;
+		std::vector<std::shared_ptr<Link>> links;
+		std::vector<std::shared_ptr<QcnSensorTrafficGenerator>> qcnSensorTrafficGenerators;
+
+		// Header.
+		char magic[8];
+		buffer.readBytes(magic, 8);
+		if (std::memcmp(magic, "QCNSNAP", 8) != 0) {
+			throw SnapshotException(SnapshotReturnType::INVALID_SNAPSHOT, "not a QCNSim topology snapshot");
+		}
+		uint32_t version = buffer.readValue<uint32_t>();
+		if (version != SNAPSHOT_VERSION) {
+			throw SnapshotException(SnapshotReturnType::INVALID_SNAPSHOT, "unsupported snapshot version " + std::to_string(version));
+		}
+
+		// Parameters and earthquakes.
+		scenarioParameters = ScenarioParameters();
+		scenarioParameters.simulationName = buffer.readString();
+		scenarioParameters.simulationDescription = buffer.readString();
+		scenarioParameters.initialClock = buffer.readValue<double>();
+		scenarioParameters.endClock = buffer.readValue<double>();
+		scenarioParameters.printTraces = buffer.readValue<uint8_t>() != 0;
+		scenarioParameters.startRecordingTime = buffer.readValue<double>();
+		earthquakes.clear();
+		uint32_t count = buffer.readValue<uint32_t>();
+		for (uint32_t i = 0; i < count; ++i) {
+			// Read into locals: evaluation order of constructor arguments is unspecified.
+			unsigned int earthquakeId = buffer.readValue<uint32_t>();
+			double magnitude = buffer.readValue<double>();
+			double eventTime = buffer.readValue<double>();
+			double sWaveSpeed = buffer.readValue<double>();
+			double depth = buffer.readValue<double>();
+			double latitude = buffer.readValue<double>();
+			double longitude = buffer.readValue<double>();
+			auto earthquake = std::make_shared<EarthquakeData>(earthquakeId, magnitude, eventTime, sWaveSpeed, depth, latitude, longitude);
+			earthquakes.push_back(earthquake);
+		}
+
+		// Nodes.
+		count = buffer.readValue<uint32_t>();
+		nodes.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			nodes.push_back(std::make_shared<Node>(simulatorGlobals, buffer.readValue<uint32_t>()));
+		}
+		count = buffer.readValue<uint32_t>();
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t key = buffer.readValue<uint32_t>();
+			topology.nodeMap.emplace_hint(topology.nodeMap.end(), key, readNodeReference(nodes));
+		}
+
+		// Links.
+		count = buffer.readValue<uint32_t>();
+		links.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			std::shared_ptr<Node> nodeA = readNodeReference(nodes);
+			std::shared_ptr<Node> nodeB = readNodeReference(nodes);
+			double bandwidth = buffer.readValue<double>();
+			double propagationDelay = buffer.readValue<double>();
+			std::string name = buffer.readString();
+			LinkType linkType = (buffer.readValue<uint8_t>() != 0) ? LinkType::DUPLEX_LINK : LinkType::SIMPLEX_LINK;
+			uint32_t transmissionQueueSizeLimit = buffer.readValue<uint32_t>();
+			bool isUp = buffer.readValue<uint8_t>() != 0;
+			if (nodeA == nullptr || nodeB == nullptr) {
+				throw SnapshotException(SnapshotReturnType::INVALID_SNAPSHOT, "link without endpoint");
+			}
+			auto link = std::make_shared<Link>(nodeA, nodeB, bandwidth, propagationDelay, simulatorGlobals, scheduler, name, linkType);
+			link->setTransmissionQueueSizeLimit(transmissionQueueSizeLimit);
+			if (!isUp) {
+				link->setDown();
+			}
+			links.push_back(link);
+		}
+		count = buffer.readValue<uint32_t>();
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t key = buffer.readValue<uint32_t>();
+			uint32_t linkIndex = buffer.readValue<uint32_t>();
+			if (linkIndex >= links.size()) {
+				throw SnapshotException(SnapshotReturnType::INVALID_SNAPSHOT, "link index out of range");
+			}
+			topology.linkMap.emplace_hint(topology.linkMap.end(), key, links[linkIndex]);
+		}
+
+		// QCN sensor traffic generators.
+		count = buffer.readValue<uint32_t>();
+		qcnSensorTrafficGenerators.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			EventType eventType = static_cast<EventType>(buffer.readValue<uint32_t>());
+			std::shared_ptr<Node> source = readNodeReference(nodes);
+			std::shared_ptr<Node> destination = readNodeReference(nodes);
+			int priority = buffer.readValue<int32_t>();
+			bool isOn = buffer.readValue<uint8_t>() != 0;
+			double latitude = buffer.readValue<double>();
+			double longitude = buffer.readValue<double>();
+			unsigned int qcnExplorerSensorId = buffer.readValue<uint32_t>();
+			unsigned int regionId = buffer.readValue<uint32_t>();
+			QcnSensorParameters sensorParameters;
+			sensorParameters.onFraction = buffer.readValue<double>();
+			sensorParameters.connectedFraction = buffer.readValue<double>();
+			sensorParameters.activeFraction = buffer.readValue<double>();
+			sensorParameters.falseTriggerRate = buffer.readValue<double>();
+			sensorParameters.triggerLowerBound = buffer.readValue<double>();
+			sensorParameters.triggerUpperBound = buffer.readValue<double>();
+			sensorParameters.triggerProbability = buffer.readValue<double>();
+			sensorParameters.pduSize = buffer.readValue<uint32_t>();
+			auto qcnSensorTrafficGenerator = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler, eventType, nullptr, source, destination,
+				priority, latitude, longitude, qcnExplorerSensorId, regionId);
+			qcnSensorTrafficGenerator->setSensorParameters(sensorParameters);
+			if (isOn) {
+				qcnSensorTrafficGenerator->turnOn();
+			} else {
+				qcnSensorTrafficGenerator->turnOff();
+			}
+			qcnSensorTrafficGenerators.push_back(qcnSensorTrafficGenerator);
+		}
+		count = buffer.readValue<uint32_t>();
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t key = buffer.readValue<uint32_t>();
+			uint32_t generatorIndex = buffer.readValue<uint32_t>();
+			if (generatorIndex >= qcnSensorTrafficGenerators.size()) {
+				throw SnapshotException(SnapshotReturnType::INVALID_SNAPSHOT, "traffic generator index out of range");
+			}
+			topology.qcnSensorTrafficGeneratorMap.emplace_hint(topology.qcnSensorTrafficGeneratorMap.end(), key, qcnSensorTrafficGenerators[generatorIndex]);
+		}
+
+		// Routes.
+		count = buffer.readValue<uint32_t>();
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t key = buffer.readValue<uint32_t>();
+			topology.explicitRouteMap.emplace_hint(topology.explicitRouteMap.end(), key, readRoute(nodes));
+		}
+		count = buffer.readValue<uint32_t>();
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t key = buffer.readValue<uint32_t>();
+			uint32_t numberOfRoutes = buffer.readValue<uint32_t>();
+			std::vector<std::vector<std::shared_ptr<Entity>>> &routes = topology.alternateRouteMap[key];
+			for (uint32_t j = 0; j < numberOfRoutes; ++j) {
+				routes.push_back(readRoute(nodes));
+			}
+		}
+		if (buffer.getRemainingSize() != 0) {
+			throw SnapshotException(SnapshotReturnType::INVALID_SNAPSHOT, "unexpected data after end of snapshot");
+		}
+	} catch (const SnapshotException &exception) {
+		errorMessage = exception.what();
+		buffer.clear();
+		return exception.snapshotReturnType;
+	} catch (const BinaryBuffer::UnderflowException &exception) {
+		errorMessage = exception.what();
+		buffer.clear();
+		return SnapshotReturnType::INVALID_SNAPSHOT;
+	}
+	buffer.clear();
+	return SnapshotReturnType::SNAPSHOT_LOADED;
+}
+
+/**
+ * @brief Get scenario parameters of the last loaded snapshot.
+ *
+ * @return Scenario parameters.
+ */
+const ScenarioParameters &TopologySnapshot::getScenarioParameters() const {
+	return scenarioParameters;
+}
+
+/**
+ * @brief Get earthquakes of the last loaded snapshot.
+ *
+ * @return Earthquakes.
+ */
+const std::vector<std::shared_ptr<EarthquakeData>> &TopologySnapshot::getEarthquakes() const {
+	return earthquakes;
+}
+
+/**
+ * @brief Get description of the last error.
+ *
+ * @return Error message; empty if the last operation succeeded.
+ */
+std::string TopologySnapshot::getErrorMessage() const {
+	return errorMessage;
+}
+
+/**
+ * @brief Append a reference to a node (its index in the node table) to the snapshot data.
+ *
+ * @param nodeIndexMap Index of each node of the topology.
+ * @param entity Referenced entity; must be a node of the topology, or nullptr.
+ */
+void TopologySnapshot::writeEntityReference(const std::unordered_map<const Entity *, uint32_t> &nodeIndexMap, const std::shared_ptr<Entity> &entity) {
+	if (entity == nullptr) {
+		buffer.writeValue<uint32_t>(SNAPSHOT_NO_REFERENCE);
+		return;
+	}
+	auto nodeIndexIterator = nodeIndexMap.find(entity.get());
+	if (nodeIndexIterator == nodeIndexMap.end()) {
+		throw SnapshotException(SnapshotReturnType::UNSUPPORTED_ENTITY, "referenced entity is not a node of the topology");
+	}
+	buffer.writeValue(nodeIndexIterator->second);
+}
+
+/**
+ * @brief Append a route (length, then node references) to the snapshot data.
+ *
+ * @param nodeIndexMap Index of each node of the topology.
+ * @param route Route to append.
+ */
+void TopologySnapshot::writeRoute(const std::unordered_map<const Entity *, uint32_t> &nodeIndexMap, const std::vector<std::shared_ptr<Entity>> &route) {
+	buffer.writeValue(static_cast<uint32_t>(route.size()));
+	for (auto &hop : route) {
+		writeEntityReference(nodeIndexMap, hop);
+	}
+}
+
+/**
+ * @brief Decode a node reference from the snapshot data.
+ *
+ * @param nodes Nodes already rebuilt, by index.
+ * @return Referenced node, or nullptr for a null reference.
+ */
+std::shared_ptr<Node> TopologySnapshot::readNodeReference(const std::vector<std::shared_ptr<Node>> &nodes) {
+	uint32_t nodeIndex = buffer.readValue<uint32_t>();
+	if (nodeIndex == SNAPSHOT_NO_REFERENCE) {
+		return nullptr;
+	}
+	if (nodeIndex >= nodes.size()) {
+		throw SnapshotException(SnapshotReturnType::INVALID_SNAPSHOT, "node index out of range");
+	}
+	return nodes[nodeIndex];
+}
+
+/**
+ * @brief Decode a route from the snapshot data.
+ *
+ * @param nodes Nodes already rebuilt, by index.
+ * @return Decoded route.
+ */
+std::vector<std::shared_ptr<Entity>> TopologySnapshot::readRoute(const std::vector<std::shared_ptr<Node>> &nodes) {
+	uint32_t length = buffer.readValue<uint32_t>();
+	if (buffer.getRemainingSize() < static_cast<std::vector<char>::size_type>(length) * sizeof(uint32_t)) {
+		throw BinaryBuffer::UnderflowException();
+	}
+	std::vector<std::shared_ptr<Entity>> route;
+	route.reserve(length);
+	for (uint32_t i = 0; i < length; ++i) {
+		route.push_back(readNodeReference(nodes));
+	}
+	return route;
+}
@@ -0,0 +1,80 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Topology.h"
+#include "BinaryBuffer.h"
+#include "JsonScenarioLoader.h"
+#include "EarthquakeData.h"
+#include "SnapshotReturnType.h"
+#include "SimulatorGlobals.h"
+#include "Scheduler.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define SNAPSHOT_VERSION 1 //!< Version of the snapshot format; snapshots of other versions are rejected.
+#define SNAPSHOT_NO_REFERENCE 0xFFFFFFFF //!< Stored in place of a node index for null references.
+
+/**
+ * @brief Topology Snapshot class.
+ * 
+ * @par Description
+ * Binary serialization of a fully built Topology (nodes, links, QCN sensor traffic generators, explicit and alternate routes), together with the
+ * scenario parameters and earthquakes. A parameter sweep builds the topology once (e.g., with JsonScenarioLoader), saves it, and every run restores
+ * it from the snapshot instead of parsing and building it again.
+ *
+ * Objects shared by several map keys (e.g., one Node under several region keys) are stored once and remain shared after loading.
+ * The snapshot holds the static configuration only: statistics, queues, token contents of generators and forwarding tables are not stored.
+ *
+ * The file is read into memory with a single read and decoded in place; maps are rebuilt with insertion hints, since keys are stored in order.
+ * The format is the in-memory representation of the host (byte order, IEEE doubles), thus snapshots are meant to be reused on the same kind of
+ * machine, not exchanged.
+ */
+class TopologySnapshot {
+private:
+	/// Malformed or unsupported snapshot; converted into SnapshotReturnType by save() and load().
+	class SnapshotException: public std::runtime_error {
+	public:
+		SnapshotReturnType snapshotReturnType;
+		SnapshotException(SnapshotReturnType snapshotReturnType, const std::string &message): std::runtime_error(message),
+			snapshotReturnType(snapshotReturnType) {}
+	};
+
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object, passed on to the rebuilt objects.
+	Scheduler &scheduler; //!< Reference to Scheduler object, passed on to the rebuilt objects.
+	ScenarioParameters scenarioParameters; //!< Scenario parameters of the last loaded snapshot.
+	std::vector<std::shared_ptr<EarthquakeData>> earthquakes; //!< Earthquakes of the last loaded snapshot.
+	std::string errorMessage; //!< Description of the last error.
+	BinaryBuffer buffer; //!< Snapshot contents, for saving and loading.
+
+	void writeEntityReference(const std::unordered_map<const Entity *, uint32_t> &nodeIndexMap, const std::shared_ptr<Entity> &entity);
+	void writeRoute(const std::unordered_map<const Entity *, uint32_t> &nodeIndexMap, const std::vector<std::shared_ptr<Entity>> &route);
+	std::shared_ptr<Node> readNodeReference(const std::vector<std::shared_ptr<Node>> &nodes);
+	std::vector<std::shared_ptr<Entity>> readRoute(const std::vector<std::shared_ptr<Node>> &nodes);
+
+public:
+	TopologySnapshot(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler);
+
+	SnapshotReturnType save(const std::string &fileName, const Topology &topology, const ScenarioParameters &scenarioParameters = ScenarioParameters(),
+		const std::vector<std::shared_ptr<EarthquakeData>> &earthquakes = std::vector<std::shared_ptr<EarthquakeData>>());
+	SnapshotReturnType load(const std::string &fileName, Topology &topology);
+	const ScenarioParameters &getScenarioParameters() const;
+	const std::vector<std::shared_ptr<EarthquakeData>> &getEarthquakes() const;
+	std::string getErrorMessage() const;
+};
@@ -0,0 +1,28 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Trace Entity Kind enum class.
+ *
+ * @par Description
+ * Kind of the entity that handled an event, as recorded by EventTracer; entity IDs are unique within a kind only (e.g., node 3 and sensor 3).
+ */
+enum class TraceEntityKind: uint8_t {
+	NO_ENTITY,	//!< Event not handled by a particular entity.
+	NODE,		//!< Node, by node ID.
+	SENSOR		//!< QCN sensor, by QCNExplorer sensor ID.
+};
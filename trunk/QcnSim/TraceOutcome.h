@@ -0,0 +1,31 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Trace Outcome enum class.
+ *
+ * @par Description
+ * Outcome of the handling of an event, as recorded by EventTracer.
+ */
+enum class TraceOutcome: uint16_t {
+	HANDLED,		//!< Event handled; no particular outcome.
+	FORWARDED,		//!< Token or PDU forwarded to the next hop.
+	DELIVERED,		//!< Token or PDU delivered at its final destination.
+	DROPPED,		//!< Token or PDU dropped.
+	STORED,			//!< Token or PDU stored for later transmission (e.g., in an outbox).
+	FUSED			//!< Continuation handled directly, without an event (see Scheduler::scheduleOrFuse()).
+};
@@ -0,0 +1,557 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TraceReplayTrafficGenerator.h"
+#include "BinaryBuffer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#define TRACE_MAGIC "QCNTRACE" //!< Magic at the beginning of binary traces.
+#define TRACE_MAGIC_SIZE 8 //!< Size of TRACE_MAGIC, without terminator.
+#define TRACE_VERSION 1 //!< Version of the binary trace format.
+
+/**
+ * Constructor with parameters.
+ *
+ * @details 
+ * The generator has no trace until openTrace() is called. It is constructed off, with time scale 1 and no looping.
+ *
+ * @param simulatorGlobals Reference to SimulatorGlobals object, to get random generator info.
+ * @param scheduler Reference to Scheduler object, such that traffic generators may schedule their events.
+ * @param eventType Event type that this generator will produce.
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param source Source of the tokens of hosts not mapped with mapHost().
+ * @param destination Destination entity, to which the generated tokens will be sent (e.g., the QCN server).
+ * @param priority Token priority. Higher priority, higher number.
+ */
+TraceReplayTrafficGenerator::TraceReplayTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType,
+		std::shared_ptr<Entity> tokenContents, std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority):
+		TrafficGenerator(simulatorGlobals, scheduler, eventType, tokenContents, source, destination, priority), isBinaryTrace(false), firstRecordPosition(0),
+		readAheadBlockPosition(-1), readAheadIndex(0), readAheadBlock(TRACE_READ_AHEAD_RECORDS * TRACE_RECORD_SIZE), timeScale(1.0), scaleAnchorTraceTime(0.0), scaleAnchorReplayTime(0.0),
+		lastTraceTime(0.0), lastReplayTime(0.0), isLooping(false), loopOffset(0.0), lastRecordTime(0.0), hasAcceptedRecordInLoop(false), currentReplayTime(0.0),
+		defaultSource(source), hasUpcomingRecord(false) {
+	currentRecord = TraceRecord();
+	upcomingRecord = TraceRecord();
+}
+
+/**
+ * @brief Open a trace for replay.
+ *
+ * @details 
+ * Detects the format from the first bytes of the file, and restarts the replay from the beginning of the trace: the first record arrives
+ * after its (scaled) time, counted from the first call to createInstanceTrafficEvent() or turnOnAutonomous().
+ *
+ * @param fileName Name of the trace file, binary or CSV.
+ * @return TRACE_OPENED if successful; FILE_NOT_FOUND if the file cannot be opened; INVALID_TRACE if a binary trace has an incompatible
+ *         version or truncated header.
+ */
+TraceReturnType TraceReplayTrafficGenerator::openTrace(const std::string &fileName) {
+	traceFile.close();
+	traceFile.clear();
+	readAheadRecords.clear();
+	readAheadIndex = 0;
+	scaleAnchorTraceTime = 0.0;
+	scaleAnchorReplayTime = 0.0;
+	lastTraceTime = 0.0;
+	lastReplayTime = 0.0;
+	loopOffset = 0.0;
+	lastRecordTime = 0.0;
+	hasAcceptedRecordInLoop = false;
+	currentReplayTime = 0.0;
+	hasUpcomingRecord = false;
+	traceFile.open(fileName, std::ios::in | std::ios::binary);
+	if (!traceFile) {
+		return TraceReturnType::FILE_NOT_FOUND;
+	}
+	char magic[TRACE_MAGIC_SIZE];
+	if (traceFile.read(magic, TRACE_MAGIC_SIZE) && std::memcmp(magic, TRACE_MAGIC, TRACE_MAGIC_SIZE) == 0) {
+		uint32_t version = 0;
+		if (!traceFile.read(reinterpret_cast<char *>(&version), sizeof(version)) || version != TRACE_VERSION) {
+			traceFile.close();
+			return TraceReturnType::INVALID_TRACE;
+		}
+		isBinaryTrace = true;
+		firstRecordPosition = traceFile.tellg();
+	} else {
+		isBinaryTrace = false;
+		traceFile.clear();
+		traceFile.seekg(0);
+		firstRecordPosition = 0;
+	}
+	readAheadBlockPosition = firstRecordPosition;
+	return TraceReturnType::TRACE_OPENED;
+}
+
+/**
+ * @brief Write records as a binary trace.
+ *
+ * @details 
+ * Binary traces replay faster than CSV ones; use this to convert logs once.
+ *
+ * @param fileName Name of the trace file to write.
+ * @param records Records, sorted by time.
+ * @return TRACE_WRITTEN if successful; FILE_NOT_FOUND if the file cannot be written.
+ */
+TraceReturnType TraceReplayTrafficGenerator::writeBinaryTrace(const std::string &fileName, const std::vector<TraceRecord> &records) {
+	BinaryBuffer buffer;
+	buffer.writeBytes(TRACE_MAGIC, TRACE_MAGIC_SIZE);
+	buffer.writeValue<uint32_t>(TRACE_VERSION);
+	for (auto &record : records) {
+		buffer.writeValue<double>(record.time);
+		buffer.writeValue<uint32_t>(record.hostId);
+		buffer.writeValue<uint32_t>(record.pduSize);
+	}
+	return buffer.writeToFile(fileName) ? TraceReturnType::TRACE_WRITTEN : TraceReturnType::FILE_NOT_FOUND;
+}
+
+/**
+ * @brief Read the next block of records from the trace file.
+ *
+ * @details 
+ * Binary traces are read with a single read per block; CSV traces line by line, skipping lines that are not records.
+ *
+ * @return True if at least one record was read; false at the end of the trace (or if no trace is open).
+ */
+bool TraceReplayTrafficGenerator::fillReadAhead() {
+	readAheadRecords.clear();
+	readAheadIndex = 0;
+	if (!traceFile.is_open()) {
+		readAheadBlockPosition = -1;
+		return false;
+	}
+	readAheadBlockPosition = traceFile.tellg(); // -1 if the end of the trace was reached.
+	if (isBinaryTrace) {
+		traceFile.read(readAheadBlock.data(), static_cast<std::streamsize>(readAheadBlock.size()));
+		std::streamsize numberOfRecords = traceFile.gcount() / TRACE_RECORD_SIZE; // A truncated last record is ignored.
+		readAheadRecords.resize(static_cast<std::vector<TraceRecord>::size_type>(numberOfRecords));
+		for (std::streamsize i = 0; i < numberOfRecords; ++i) {
+			const char *recordBytes = readAheadBlock.data() + i * TRACE_RECORD_SIZE;
+			std::memcpy(&readAheadRecords[i].time, recordBytes, sizeof(double));
+			std::memcpy(&readAheadRecords[i].hostId, recordBytes + sizeof(double), sizeof(uint32_t));
+			std::memcpy(&readAheadRecords[i].pduSize, recordBytes + sizeof(double) + sizeof(uint32_t), sizeof(uint32_t));
+		}
+	} else {
+		std::string line;
+		while (readAheadRecords.size() < TRACE_READ_AHEAD_RECORDS && std::getline(traceFile, line)) {
+			const char *field = line.c_str();
+			while (*field == ' ' || *field == '\t') {
+				++field;
+			}
+			if (!((*field >= '0' && *field <= '9') || *field == '.' || *field == '-' || *field == '+')) {
+				continue; // Header or blank line.
+			}
+			TraceRecord record;
+			char *end;
+			record.time = std::strtod(field, &end);
+			if (*end != ',') {
+				continue;
+			}
+			record.hostId = static_cast<uint32_t>(std::strtoul(end + 1, &end, 10));
+			if (*end != ',') {
+				continue;
+			}
+			record.pduSize = static_cast<uint32_t>(std::strtoul(end + 1, &end, 10));
+			readAheadRecords.push_back(record);
+		}
+	}
+	return !readAheadRecords.empty();
+}
+
+/**
+ * @brief Move the cursor to a record, given by the position of its read-ahead block and its index within the block (e.g., to restore a checkpoint).
+ *
+ * @param readAheadBlockPosition Position in the trace file of the first record of the block; -1 for the end of the trace.
+ * @param readAheadIndex Index of the record within the block.
+ * @return True if successful; false if no trace is open or the block does not hold the record.
+ */
+bool TraceReplayTrafficGenerator::seekRecord(std::streamoff readAheadBlockPosition, std::vector<TraceRecord>::size_type readAheadIndex) {
+	if (!traceFile.is_open()) {
+		return false;
+	}
+	traceFile.clear();
+	if (readAheadBlockPosition < 0) {
+		// End of the trace: the next read fails, as after the last block.
+		traceFile.seekg(0, std::ios::end);
+		readAheadRecords.clear();
+		this->readAheadIndex = 0;
+		this->readAheadBlockPosition = -1;
+		return readAheadIndex == 0;
+	}
+	traceFile.seekg(readAheadBlockPosition);
+	fillReadAhead(); // Empty at the end of the trace.
+	if (readAheadIndex > readAheadRecords.size()) {
+		return false;
+	}
+	this->readAheadIndex = readAheadIndex;
+	return true;
+}
+
+/**
+ * @brief Read the next record to replay.
+ *
+ * @details 
+ * Skips hosts out of the subset and restarts the trace at its end if looping (unless no record of the last loop passed the subset).
+ * Each loop starts after the time of the last record of the previous loop.
+ *
+ * @param record Record read, with its time including the loop offset and time scale (see setTimeScale()).
+ * @return True if a record was read; false at the end of the trace.
+ */
+bool TraceReplayTrafficGenerator::readNextRecord(TraceRecord &record) {
+	for (;;) {
+		if (readAheadIndex >= readAheadRecords.size() && !fillReadAhead()) {
+			if (!isLooping || !hasAcceptedRecordInLoop) {
+				return false;
+			}
+			traceFile.clear();
+			traceFile.seekg(firstRecordPosition);
+			loopOffset += lastRecordTime;
+			lastRecordTime = 0.0;
+			hasAcceptedRecordInLoop = false;
+			if (!fillReadAhead()) {
+				return false;
+			}
+		}
+		const TraceRecord &nextRecord = readAheadRecords[readAheadIndex++];
+		lastRecordTime = nextRecord.time;
+		if (!hostSubset.empty() && hostSubset.count(nextRecord.hostId) == 0) {
+			continue;
+		}
+		hasAcceptedRecordInLoop = true;
+		record = nextRecord;
+		lastTraceTime = nextRecord.time + loopOffset;
+		lastReplayTime = scaleAnchorReplayTime + (lastTraceTime - scaleAnchorTraceTime) * timeScale;
+		record.time = lastReplayTime;
+		return true;
+	}
+}
+
+/**
+ * @brief Advance to the next record, for createInstanceTrafficEvent() and its variants.
+ *
+ * @details 
+ * Sets the source of the generator to the source of the host of the record. Turns the generator off at the end of the trace.
+ *
+ * @param interval Time until the arrival of the record.
+ * @return True if there is a record to generate; false if the generator is off or the trace has ended.
+ */
+bool TraceReplayTrafficGenerator::advanceRecord(double &interval) {
+	if (!isOn) {
+		return false;
+	}
+	if (!readNextRecord(currentRecord)) {
+		turnOff();
+		return false;
+	}
+	selectHostSource();
+	interval = std::max(0.0, currentRecord.time - currentReplayTime);
+	currentReplayTime = std::max(currentReplayTime, currentRecord.time);
+	return true;
+}
+
+/**
+ * @brief Set the source of the generator to the source of the host of the current record.
+ */
+void TraceReplayTrafficGenerator::selectHostSource() {
+	auto hostSource = hostSources.find(currentRecord.hostId);
+	source = hostSource != hostSources.end() ? hostSource->second : defaultSource;
+}
+
+/**
+ * @brief Generate the interval until the next arrival, for autonomous mode.
+ *
+ * @details 
+ * The record that was upcoming becomes the current record (the arrival just fired, to be materialized), and the next record becomes upcoming.
+ * At the end of the trace, the recurring event is parked at infinity.
+ *
+ * @return Time until the arrival of the upcoming record; infinity at the end of the trace.
+ */
+double TraceReplayTrafficGenerator::generateInterval() {
+	if (hasUpcomingRecord) {
+		currentRecord = upcomingRecord;
+	}
+	hasUpcomingRecord = readNextRecord(upcomingRecord);
+	if (!hasUpcomingRecord) {
+		return std::numeric_limits<double>::infinity();
+	}
+	double interval = std::max(0.0, upcomingRecord.time - currentReplayTime);
+	currentReplayTime = std::max(currentReplayTime, upcomingRecord.time);
+	return interval;
+}
+
+/**
+ * @brief Set the time scale of the replay.
+ *
+ * @details 
+ * Applies to records read from now on. Only the trace time elapsed since the last record read is scaled with the new factor, thus
+ * changing the scale mid-run does not make the replay jump back or forth.
+ *
+ * @param timeScale Factor applied to trace times (e.g., 0.5 replays twice as fast, 2.0 twice as slow).
+ */
+void TraceReplayTrafficGenerator::setTimeScale(double timeScale) {
+	scaleAnchorTraceTime = lastTraceTime;
+	scaleAnchorReplayTime = lastReplayTime;
+	this->timeScale = timeScale;
+}
+
+/**
+ * @brief Set whether the trace restarts at its end.
+ *
+ * @param isLooping True to loop the trace; false to stop (and turn the generator off) at its end.
+ */
+void TraceReplayTrafficGenerator::setLooping(bool isLooping) {
+	this->isLooping = isLooping;
+}
+
+/**
+ * @brief Restrict the replay to a subset of hosts.
+ *
+ * @param hostSubset IDs of the hosts to replay; empty to replay all hosts.
+ */
+void TraceReplayTrafficGenerator::setHostSubset(const std::unordered_set<uint32_t> &hostSubset) {
+	this->hostSubset = hostSubset;
+}
+
+/**
+ * @brief Map a host of the trace to the entity that sources its tokens (e.g., the Node of the sensor).
+ *
+ * @param hostId ID of the host in the trace.
+ * @param source Source entity of the tokens of this host.
+ */
+void TraceReplayTrafficGenerator::mapHost(uint32_t hostId, std::shared_ptr<Entity> source) {
+	hostSources[hostId] = source;
+}
+
+/**
+ * @brief Return whether this generator can run in autonomous mode.
+ *
+ * @return True: intervals come from the trace.
+ */
+bool TraceReplayTrafficGenerator::supportsAutonomousMode() const {
+	return true;
+}
+
+/**
+ * Creates an instance of trace traffic event.
+ *
+ * @details 
+ * Reads the next record, then calls parent function and complements with event generation at the time of the record.
+ * Uses member variable tokenContents.
+ *
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> TraceReplayTrafficGenerator::createInstanceTrafficEvent(bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(recordRoute);
+	scheduler.schedule(Event(interval, eventType, token));
+	return token;
+}
+
+/**
+ * Creates an instance of trace traffic event.
+ *
+ * @details 
+ * Reads the next record, then calls parent function and complements with event generation at the time of the record.
+ * Uses parameter tokenContents.
+ *
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> TraceReplayTrafficGenerator::createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(tokenContents, recordRoute);
+	scheduler.schedule(Event(interval, eventType, token));
+	return token;
+}
+
+/**
+ * Creates an instance of trace traffic event.
+ *
+ * @details 
+ * Reads the next record, then calls parent function and complements with event generation at the time of the record.
+ * Uses member variable tokenContents and parameter explicit route.
+ *
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> TraceReplayTrafficGenerator::createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(explicitRoute, recordRoute);
+	scheduler.schedule(Event(interval, eventType, token));
+	return token;
+}
+
+/**
+ * Creates an instance of trace traffic event.
+ *
+ * @details 
+ * Reads the next record, then calls parent function and complements with event generation at the time of the record.
+ * Uses parameter tokenContents and explicit route.
+ *
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> TraceReplayTrafficGenerator::createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute,
+																				bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(tokenContents, explicitRoute, recordRoute);
+	scheduler.schedule(Event(interval, eventType, token));
+	return token;
+}
+
+/**
+ * @brief Creates an instance of trace traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate, if the record has no size (zero).
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return PDU that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> TraceReplayTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(TrafficGenerator::createInstanceTrafficEvent(recordRoute),
+		currentRecord.pduSize != 0 ? currentRecord.pduSize : pduSize));
+	scheduler.schedule(Event(interval, eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Creates an instance of trace traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate, if the record has no size (zero).
+ * @param pduContents Reference to Entity object that will be carried by the token.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return PDU that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> TraceReplayTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> pduContents,
+																							bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(TrafficGenerator::createInstanceTrafficEvent(pduContents, recordRoute),
+		currentRecord.pduSize != 0 ? currentRecord.pduSize : pduSize));
+	scheduler.schedule(Event(interval, eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Creates an instance of trace traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate, if the record has no size (zero).
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return PDU that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> TraceReplayTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, std::vector<std::shared_ptr<Entity>> explicitRoute,
+																							bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(TrafficGenerator::createInstanceTrafficEvent(explicitRoute, recordRoute),
+		currentRecord.pduSize != 0 ? currentRecord.pduSize : pduSize));
+	scheduler.schedule(Event(interval, eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Creates an instance of trace traffic event with PDU.
+ *
+ * @param pduSize Size of PDU to generate, if the record has no size (zero).
+ * @param tokenContents Reference to Entity object that will be carried by the token.
+ * @param explicitRoute Vector containing a list of Entity objects representing the route to be followed by a token/PDU.
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return PDU that was generated, if generator is On and the trace has not ended. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> TraceReplayTrafficGenerator::createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents,
+																							std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute) {
+	double interval;
+	if (!advanceRecord(interval)) {
+		return nullptr;
+	}
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(TrafficGenerator::createInstanceTrafficEvent(tokenContents, explicitRoute, recordRoute),
+		currentRecord.pduSize != 0 ? currentRecord.pduSize : pduSize));
+	scheduler.schedule(Event(interval, eventType, pdu));
+	return pdu;
+}
+
+/**
+ * @brief Create the token of the arrival just fired, from the source of its host, without scheduling any event (autonomous mode).
+ *
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> TraceReplayTrafficGenerator::materializeToken(bool recordRoute) {
+	selectHostSource();
+	return TrafficGenerator::materializeToken(recordRoute);
+}
+
+/**
+ * @brief Create the PDU of the arrival just fired, from the source of its host, without scheduling any event (autonomous mode).
+ *
+ * @param pduSize Size of PDU to generate, if the record has no size (zero).
+ * @param recordRoute True if this generated PDU should record the route it follows. False otherwise. Default is false.
+ * @return PDU that was generated, if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> TraceReplayTrafficGenerator::materializePdu(unsigned int pduSize, bool recordRoute) {
+	selectHostSource();
+	return TrafficGenerator::materializePdu(currentRecord.pduSize != 0 ? currentRecord.pduSize : pduSize, recordRoute);
+}
+
+/**
+ * @brief Return the record of the last arrival generated (or fired, in autonomous mode).
+ *
+ * @return Current record, with its time scaled and including the loop offset.
+ */
+const TraceReplayTrafficGenerator::TraceRecord &TraceReplayTrafficGenerator::getCurrentRecord() const {
+	return currentRecord;
+}
+
+/**
+ * @brief Return the time scale of the replay.
+ *
+ * @return Time scale.
+ */
+double TraceReplayTrafficGenerator::getTimeScale() const {
+	return timeScale;
+}
+
+/**
+ * @brief Return whether the trace restarts at its end.
+ *
+ * @return True if looping.
+ */
+bool TraceReplayTrafficGenerator::isTraceLooping() const {
+	return isLooping;
+}
@@ -0,0 +1,123 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "TrafficGenerator.h"
+#include "EventType.h"
+#include "ProtocolDataUnit.h"
+#include "TraceReturnType.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#define TRACE_READ_AHEAD_RECORDS 4096 //!< Maximum number of trace records held in memory at once.
+#define TRACE_RECORD_SIZE 16 //!< Size of a record in binary traces: time (double), host ID (uint32) and PDU size (uint32).
+
+/**
+* @brief Trace Replay Traffic Generator.
+*
+* @par Description
+* This class replays real trickle-message logs of QCN servers through the simulated network, instead of synthetic arrivals. Each trace record
+* has the time of the message (in seconds since the beginning of the trace), the ID of the host that sent it and the message size in bytes.
+* Records must be sorted by time; a record earlier than the previous one arrives with no delay.
+*
+* Traces are streamed: at most TRACE_READ_AHEAD_RECORDS records are in memory, so traces of any length can be replayed. Two formats are read,
+* detected by their first bytes:
+* - binary: the magic "QCNTRACE", a 32-bit version, then records of TRACE_RECORD_SIZE bytes (see writeBinaryTrace()); fastest;
+* - CSV: one "time,hostId,pduSize" record per line; lines that do not start with a number (e.g., headers) are skipped.
+*
+* Replay may be scaled in time (setTimeScale()), restricted to a subset of hosts (setHostSubset()) and looped (setLooping()). Each host may be
+* mapped to its own source entity (mapHost()), which becomes the source of its tokens; other hosts use the source given to the constructor.
+*
+* As with the other generators, each call to createInstanceTrafficEvent() (or its PDU variants) creates the token of the next record and schedules
+* its arrival event; the generator turns itself off at the end of the trace. PDUs take the size of the record, if not zero. Autonomous mode is
+* supported, with the host and size of the arrival applied when it is materialized.
+*
+* SimulationCheckpoint saves the replay state of generators added with SimulationCheckpoint::addTrafficGenerator(): the cursor (file position of
+* the read-ahead block and index of the next record within it), the loop and time scale anchors, and the current and upcoming records. To
+* restore, the generator must have opened the same trace, with the same host subset and mappings.
+*/
+class TraceReplayTrafficGenerator: public TrafficGenerator {
+public:
+	/// Record of a trace.
+	struct TraceRecord {
+		double time;			//!< Time of the message, in seconds since the beginning of the trace.
+		uint32_t hostId;		//!< ID of the host that sent the message.
+		uint32_t pduSize;		//!< Size of the message, in bytes.
+	};
+
+private:
+	std::ifstream traceFile; //!< Trace being replayed.
+	bool isBinaryTrace; //!< True if the trace is binary; false if CSV.
+	std::streampos firstRecordPosition; //!< Position of the first record in the trace file, to loop.
+	std::streamoff readAheadBlockPosition; //!< Position in the trace file of the first record of readAheadRecords; -1 past the end of the trace.
+	std::vector<TraceRecord> readAheadRecords; //!< Records read ahead from the trace file.
+	std::vector<TraceRecord>::size_type readAheadIndex; //!< Index of the next record to replay within readAheadRecords.
+	std::vector<char> readAheadBlock; //!< Raw block of binary records, sized for TRACE_READ_AHEAD_RECORDS records.
+	double timeScale; //!< Factor applied to trace times (e.g., 0.5 replays twice as fast).
+	double scaleAnchorTraceTime; //!< Trace time (with loop offset) of the last record replayed before the last change of time scale.
+	double scaleAnchorReplayTime; //!< Scaled time of that record; later records are scaled from this point on.
+	double lastTraceTime; //!< Trace time (with loop offset) of the last record replayed.
+	double lastReplayTime; //!< Scaled time of the last record replayed.
+	bool isLooping; //!< True if the trace restarts at its end.
+	double loopOffset; //!< Trace time added to the records of the current loop.
+	double lastRecordTime; //!< Trace time of the last record read in the current loop, filtered or not.
+	bool hasAcceptedRecordInLoop; //!< True if a record of the current loop passed the host subset.
+	double currentReplayTime; //!< Scaled time of the last arrival scheduled, relative to the beginning of the replay.
+	std::unordered_set<uint32_t> hostSubset; //!< Hosts to replay; all hosts if empty.
+	std::unordered_map<uint32_t, std::shared_ptr<Entity>> hostSources; //!< Source entity of each mapped host.
+	std::shared_ptr<Entity> defaultSource; //!< Source of the tokens of hosts not mapped.
+	TraceRecord currentRecord; //!< Record of the arrival being generated (or fired, in autonomous mode).
+	TraceRecord upcomingRecord; //!< Record of the next arrival, in autonomous mode.
+	bool hasUpcomingRecord; //!< True if upcomingRecord is valid (autonomous mode).
+
+	bool fillReadAhead();
+	bool seekRecord(std::streamoff readAheadBlockPosition, std::vector<TraceRecord>::size_type readAheadIndex);
+	bool readNextRecord(TraceRecord &record);
+	bool advanceRecord(double &interval);
+	void selectHostSource();
+	double generateInterval() override;
+	
+public:
+	TraceReplayTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
+								std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority);
+
+	TraceReturnType openTrace(const std::string &fileName);
+	static TraceReturnType writeBinaryTrace(const std::string &fileName, const std::vector<TraceRecord> &records);
+	void setTimeScale(double timeScale);
+	void setLooping(bool isLooping);
+	void setHostSubset(const std::unordered_set<uint32_t> &hostSubset);
+	void mapHost(uint32_t hostId, std::shared_ptr<Entity> source);
+
+	bool supportsAutonomousMode() const override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(bool recordRoute = false) override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
+	std::shared_ptr<Token> materializeToken(bool recordRoute = false) override;
+	std::shared_ptr<ProtocolDataUnit> materializePdu(unsigned int pduSize, bool recordRoute = false) override;
+	const TraceRecord &getCurrentRecord() const;
+	double getTimeScale() const;
+	bool isTraceLooping() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores the replay state.
+};
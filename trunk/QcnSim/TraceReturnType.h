@@ -0,0 +1,27 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+* @brief Trace Return Type enum class.
+*
+* @par Description
+* Types of return from TraceReplayTrafficGenerator and EventTracer trace functions.
+*/
+enum class TraceReturnType {
+	TRACE_OPENED,		//!< Trace was successfully opened for replay, reading or recording.
+	TRACE_WRITTEN,		//!< Binary trace was successfully written.
+	FILE_NOT_FOUND,		//!< Trace file could not be opened for reading or writing.
+	INVALID_TRACE		//!< File has the binary trace magic but an incompatible version or a truncated header.
+};
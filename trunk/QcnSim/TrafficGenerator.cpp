@@ -36,14 +36,16 @@
  */
 TrafficGenerator::TrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority): scheduler(scheduler), simulatorGlobals(simulatorGlobals), eventType(eventType),
-		tokenContents(tokenContents), source(source), destination(destination), priority(priority), isOn(false), tokensGeneratedCount(0) {
+		tokenContents(tokenContents), source(source), destination(destination), priority(priority), isOn(false), isAutonomous(false), tokensGeneratedCount(0), usesOwnRandomStream(false) {
 }
 
 /**
  * Constructor with parameters, seed as parameter.
  * 
  * @details 
- * Seed is defined here from parameters. The generator is constructed off by default.
+ * Seed is defined here from parameters: it keys the own random stream of this generator (stream 0 of that seed), and the engine shared
+ * through SimulatorGlobals is left untouched. Thus generators constructed with the same seed produce the same sequence, regardless of other
+ * generators; use setRandomStream() to give them distinct streams. The generator is constructed off by default.
  *
  * @param simulatorGlobals Reference to SimulatorGlobals object, to get random generator info.
  * @param scheduler Reference to Scheduler object, such that traffic generators may schedule their events.
@@ -52,12 +54,12 @@ TrafficGenerator::TrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler
  * @param source Entity to which the generator is attached (to which tokens are generated).
  * @param destination Destination entity, to which the generated tokens will be sent.
  * @param priority Token priority. Higher priority, higher number.
- * @param seed Seed to the default random number generator, to be passed to SimulatorGlobals object.
+ * @param seed Seed for the own random stream of this generator.
  */
 TrafficGenerator::TrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, unsigned int seed): scheduler(scheduler), simulatorGlobals(simulatorGlobals), eventType(eventType),
-		tokenContents(tokenContents), source(source), destination(destination), priority(priority), isOn(false), tokensGeneratedCount(0) {
-	simulatorGlobals.seedRandomNumberGenerator(seed);
+		tokenContents(tokenContents), source(source), destination(destination), priority(priority), isOn(false), isAutonomous(false), tokensGeneratedCount(0),
+		randomStream(seed, 0, simulatorGlobals.getReplication()), usesOwnRandomStream(true) {
 }
 
 /**
@@ -185,6 +187,121 @@ void TrafficGenerator::turnOn() {
  */
 void TrafficGenerator::turnOff() {
 	this->isOn = false;
+	if (isAutonomous) {
+		scheduler.cancelRecurring(*this);
+		isAutonomous = false;
+	}
+}
+
+/**
+ * @brief Destructor.
+ *
+ * @details 
+ * An autonomous generator removes its recurring event from the event chain, since the Scheduler refers to it.
+ */
+TrafficGenerator::~TrafficGenerator() {
+	if (isAutonomous) {
+		scheduler.cancelRecurring(*this);
+	}
+}
+
+/**
+ * @brief Turns generator On, in autonomous mode.
+ *
+ * @details 
+ * Instead of scheduling a new event with a new token on every createInstanceTrafficEvent() call, the generator schedules a single recurring
+ * event (see Scheduler::scheduleRecurring()) of its eventType. Each time the event is caused, the Scheduler moves it to the next arrival, with
+ * an interval from generateInterval(), so the driver no longer calls createInstanceTrafficEvent() in its arrival handler. The entity of the
+ * event is this generator (a non-owning pointer), and no token exists until the driver calls materializeToken() or materializePdu(), e.g.,
+ * only for arrivals that actually enter the network. turnOff() removes the recurring event.
+ *
+ * An autonomous generator must not be moved or copied while on, since the Scheduler refers to it.
+ *
+ * @return True if autonomous mode started; false if this generator does not support it (see supportsAutonomousMode()) or is already autonomous.
+ */
+bool TrafficGenerator::turnOnAutonomous() {
+	if (!supportsAutonomousMode() || isAutonomous) {
+		return false;
+	}
+	isOn = true;
+	isAutonomous = true;
+	// Aliasing constructor with an empty owner: the event points to this generator without owning it.
+	scheduler.scheduleRecurring(Event(generateInterval(), eventType, std::shared_ptr<const Entity>(std::shared_ptr<const Entity>(), this)), *this);
+	return true;
+}
+
+/**
+ * @brief Return whether this generator can run in autonomous mode.
+ *
+ * @details 
+ * Only generators with intervals of their own (i.e., that override generateInterval()) support it; generators triggered by the driver,
+ * such as QcnSensorTrafficGenerator, do not.
+ *
+ * @return True if autonomous mode is supported. This implementation returns false.
+ */
+bool TrafficGenerator::supportsAutonomousMode() const {
+	return false;
+}
+
+/**
+ * @brief Return whether this generator is in autonomous mode.
+ *
+ * @return True if autonomous; false otherwise.
+ */
+bool TrafficGenerator::isGeneratorAutonomous() const {
+	return isAutonomous;
+}
+
+/**
+ * @brief Generate the interval until the next arrival.
+ *
+ * @details 
+ * Used in autonomous mode. Child classes supporting autonomous mode override this with the interval of their distribution.
+ *
+ * @return Interval until the next arrival. This implementation returns zero.
+ */
+double TrafficGenerator::generateInterval() {
+	return 0.0;
+}
+
+/**
+ * @brief Interval until the next occurrence of the recurring event of an autonomous generator.
+ *
+ * @return Interval from generateInterval().
+ */
+double TrafficGenerator::nextOccurAfterTime() {
+	return generateInterval();
+}
+
+/**
+ * @brief Create the token of the current arrival, without scheduling any event.
+ *
+ * @details 
+ * For autonomous mode, where the arrival events are scheduled by the generator itself.
+ *
+ * @param recordRoute True if this generated token should record the route it follows. False otherwise. Default is false.
+ * @return Token that was generated, if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<Token> TrafficGenerator::materializeToken(bool recordRoute) {
+	return TrafficGenerator::createInstanceTrafficEvent(recordRoute);
+}
+
+/**
+ * @brief Create the PDU of the current arrival, without scheduling any event.
+ *
+ * @details 
+ * For autonomous mode, where the arrival events are scheduled by the generator itself.
+ *
+ * @param pduSize Size of PDU to generate.
+ * @param recordRoute True if this generated PDU should record the route it follows. False otherwise. Default is false.
+ * @return PDU that was generated, if generator is On. Otherwise, returns nullptr.
+ */
+std::shared_ptr<ProtocolDataUnit> TrafficGenerator::materializePdu(unsigned int pduSize, bool recordRoute) {
+	std::shared_ptr<Token> token = TrafficGenerator::createInstanceTrafficEvent(recordRoute);
+	if (token == nullptr) {
+		return nullptr;
+	}
+	return std::make_shared<ProtocolDataUnit>(token, pduSize);
 }
 
 /**
@@ -250,6 +367,48 @@ std::shared_ptr<Entity> TrafficGenerator::getDestination() const {
 	return destination;
 }
 
+/**
+ * Get priority of the tokens generated.
+ *
+ * @return Token priority. Higher priority, higher number.
+ */
+int TrafficGenerator::getPriority() const {
+	return priority;
+}
+
+/**
+ * Get generator state.
+ *
+ * @return True if generator is on (and generating traffic); false if generator is off.
+ */
+bool TrafficGenerator::isGeneratorOn() const {
+	return isOn;
+}
+
+/**
+ * Give this generator its own random stream.
+ *
+ * @details 
+ * From now on, variates are drawn from a stream created by SimulatorGlobals::createRandomStream() (keyed by the current seed, streamId and the
+ * replication number) instead of the engine shared by all generators. The sequence of this generator then depends neither on other generators
+ * nor on the order in which they are created or used. Set the seed and replication number of SimulatorGlobals before calling this function.
+ *
+ * @param streamId ID of the stream, unique among the components of the simulation (e.g., the QCN Explorer sensor ID).
+ */
+void TrafficGenerator::setRandomStream(unsigned int streamId) {
+	randomStream = simulatorGlobals.createRandomStream(streamId);
+	usesOwnRandomStream = true;
+}
+
+/**
+ * Return whether this generator draws variates from its own random stream.
+ *
+ * @return True if it uses its own random stream; false if it uses the engine shared through SimulatorGlobals.
+ */
+bool TrafficGenerator::hasOwnRandomStream() const {
+	return usesOwnRandomStream;
+}
+
 /**
  * Get value of counter for tokens (or traffic events) generated.
  *
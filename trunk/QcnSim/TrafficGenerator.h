@@ -25,7 +25,10 @@
 #include "Token.h"
 #include "EventType.h"
 #include "ProtocolDataUnit.h"
+#include "RandomStream.h"
+#include "RecurringEventSource.h"
 #include <memory>
+#include <vector>
 
 /**
  * @brief TrafficGenerator parent class.
@@ -38,8 +41,12 @@
  * The Traffic Generator is also a child of Entity abstract class, such that Traffic Generators can be included as entities into tokens, events, etc.
  * Common, for all child classes, are reference members to scheduler, such that the traffic generators can schedule their events directly.
  *
+ * Generators with intervals of their own (see supportsAutonomousMode()) may also run in autonomous mode (see turnOnAutonomous()): the generator
+ * keeps a single recurring event in the event chain, which the Scheduler moves to the next arrival, and tokens or PDUs are only created when
+ * the driver materializes them (see materializeToken() and materializePdu()).
+ *
  */
-class TrafficGenerator: public Entity {
+class TrafficGenerator: public Entity, public RecurringEventSource {
 protected:
 	Scheduler &scheduler;	//!< Reference to Scheduler object, such that traffic generators may schedule their events.
 	SimulatorGlobals &simulatorGlobals;  //!< Reference to SimulatorGlobals object, to get random generator info
@@ -49,7 +56,10 @@ protected:
 	std::shared_ptr<Entity> destination; //!< Destination entity, to which the generated tokens will be sent.
 	int priority;  //!< Token priority. Higher priority, higher number.
 	bool isOn; //!< True if generator is on (and generating traffic); false if generator is off.
+	bool isAutonomous; //!< True if generator is in autonomous mode, i.e., has a recurring event in the event chain.
 	unsigned int tokensGeneratedCount; //!< Count of tokens (events) generated by this traffic generator.
+	RandomStream randomStream; //!< Own random stream of this generator; used instead of the engine of SimulatorGlobals if usesOwnRandomStream is true.
+	bool usesOwnRandomStream; //!< True if variates are drawn from randomStream; false if drawn from the engine shared through SimulatorGlobals.
 	
 	TrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority);
@@ -64,12 +74,35 @@ protected:
 	virtual std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, bool recordRoute = false) =0;
 	virtual std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) =0;
 	virtual std::shared_ptr<ProtocolDataUnit> createInstanceTrafficEventPdu(unsigned int pduSize, std::shared_ptr<Entity> tokenContents, std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) =0;
+	virtual double generateInterval();
+
+	/**
+	 * @brief Draw a variate from a distribution, using the own random stream if set, or else the engine of SimulatorGlobals.
+	 *
+	 * @param distribution Distribution (e.g., std::exponential_distribution) from which to draw.
+	 * @return Variate.
+	 */
+	template<typename Distribution> typename Distribution::result_type generateVariate(Distribution &distribution) {
+		return usesOwnRandomStream ? distribution(randomStream) : distribution(simulatorGlobals.getRandomNumberGeneratorEngineInstance());
+	}
 
 public:
+	virtual ~TrafficGenerator();
+
 	virtual void turnOn();
 	virtual void turnOff();
+	virtual bool turnOnAutonomous();
+	virtual bool supportsAutonomousMode() const;
+	virtual bool isGeneratorAutonomous() const;
+	double nextOccurAfterTime() override;
+	virtual std::shared_ptr<Token> materializeToken(bool recordRoute = false);
+	virtual std::shared_ptr<ProtocolDataUnit> materializePdu(unsigned int pduSize, bool recordRoute = false);
 	virtual void setTokenContents(std::shared_ptr<Entity> tokenContents);
 	virtual unsigned int getTokensGeneratedCount() const;
+	virtual int getPriority() const;
+	virtual bool isGeneratorOn() const;
+	virtual void setRandomStream(unsigned int streamId);
+	virtual bool hasOwnRandomStream() const;
 	virtual EventType getEventType() const;
 	virtual void setEventType(EventType eventType);
 	virtual std::shared_ptr<Entity> getTokenContents() const;
@@ -77,4 +110,6 @@ public:
 	virtual void setSource(std::shared_ptr<Entity> source);
 	virtual std::shared_ptr<Entity> getDestination() const;
 	virtual void setDestination(std::shared_ptr<Entity> destination);
+
+	friend class SimulationCheckpoint; //!< Saves and restores generator state.
 };
\ No newline at end of file
@@ -0,0 +1,307 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TrickleOutbox.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Constructor.
+ *
+ * @param simulatorGlobals SimulatorGlobals object.
+ * @param scheduler Scheduler object, for the recurring event and the flushed PDUs.
+ * @param retryEventType Type of the recurring event of retries.
+ * @param transmitEventType Type of the events of PDUs sent, typically a transmission request at the uplink.
+ * @param tickDuration Tick of the timer wheel; retries due within the same tick are served by the same event.
+ */
+TrickleOutbox::TrickleOutbox(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType retryEventType, EventType transmitEventType,
+		double tickDuration): scheduler(scheduler), simulatorGlobals(simulatorGlobals), retryEventType(retryEventType), transmitEventType(transmitEventType),
+		timerWheel(tickDuration), capacity(OUTBOX_CAPACITY), initialBackoff(OUTBOX_INITIAL_BACKOFF), maximumBackoff(OUTBOX_MAXIMUM_BACKOFF),
+		backoffMultiplier(OUTBOX_BACKOFF_MULTIPLIER), flushBatchSize(OUTBOX_FLUSH_BATCH_SIZE), isScheduled(false), scheduledTime(0.0), storedPdusCount(0),
+		sentPdusCount(0), flushedPdusCount(0), droppedPdusCount(0), retriesCount(0), failedRetriesCount(0), retryEventsCount(0) {
+}
+
+/**
+ * @brief Destructor. Removes the recurring event from the event chain, if any.
+ */
+TrickleOutbox::~TrickleOutbox() {
+	if (isScheduled) {
+		scheduler.cancelRecurring(*this);
+	}
+}
+
+/**
+ * @brief Set the maximum number of PDUs of each outbox.
+ *
+ * @param capacity Capacity of each outbox; at least 1.
+ */
+void TrickleOutbox::setCapacity(unsigned int capacity) {
+	this->capacity = std::max(capacity, 1u);
+}
+
+/**
+ * @brief Set the exponential backoff of the retries.
+ *
+ * @details 
+ * Applies to outboxes created afterwards, and to the outboxes already created from their next retry on.
+ *
+ * @param initialBackoff Delay of the first retry after a PDU is stored in an empty outbox, in seconds.
+ * @param maximumBackoff Maximum delay between retries, in seconds.
+ * @param backoffMultiplier Factor by which the delay grows after each failed retry.
+ */
+void TrickleOutbox::setBackoff(double initialBackoff, double maximumBackoff, double backoffMultiplier) {
+	this->initialBackoff = initialBackoff;
+	this->maximumBackoff = std::max(maximumBackoff, initialBackoff);
+	this->backoffMultiplier = backoffMultiplier;
+}
+
+/**
+ * @brief Set the maximum number of PDUs sent by one successful retry.
+ *
+ * @param flushBatchSize Maximum number of PDUs flushed at once; at least 1.
+ */
+void TrickleOutbox::setFlushBatchSize(unsigned int flushBatchSize) {
+	this->flushBatchSize = std::max(flushBatchSize, 1u);
+}
+
+/**
+ * @brief Arm the retry timer of an outbox, and move the recurring event earlier if the timer is now the first to expire.
+ *
+ * @param outboxId ID of the outbox.
+ * @param outbox Outbox.
+ * @param delay Delay of the retry, in seconds.
+ */
+void TrickleOutbox::armTimer(uint32_t outboxId, Outbox &outbox, double delay) {
+	double currentTime = simulatorGlobals.getCurrentAbsoluteTime();
+	timerWheel.add(currentTime + delay, outboxId);
+	outbox.isTimerArmed = true;
+	double nextExpiryTime = timerWheel.getNextExpiryTime();
+	if (isScheduled && nextExpiryTime >= scheduledTime) {
+		return;
+	}
+	if (isScheduled) {
+		scheduler.cancelRecurring(*this);
+	}
+	// Aliasing constructor with an empty owner: the event points to this outbox without owning it.
+	scheduler.scheduleRecurring(Event(std::max(nextExpiryTime - currentTime, 0.0), retryEventType, std::shared_ptr<const Entity>(std::shared_ptr<const Entity>(), this)), *this);
+	isScheduled = true;
+	scheduledTime = nextExpiryTime;
+}
+
+/**
+ * @brief Schedule the transmission of a PDU now.
+ *
+ * @param pdu PDU to send.
+ */
+void TrickleOutbox::send(std::shared_ptr<ProtocolDataUnit> pdu) {
+	scheduler.schedule(Event(0.0, transmitEventType, std::move(pdu)));
+}
+
+/**
+ * @brief Send a PDU leaving its source, or store it until its uplink is up.
+ *
+ * @details 
+ * PDUs are sent in order: while PDUs are waiting in the outbox, new ones wait behind them, even if the uplink is already up again.
+ *
+ * @param outboxId ID of the outbox, e.g., the QCNExplorer sensor ID of the source of the PDU.
+ * @param pdu PDU, already forwarded by its source node (i.e., whose next hop is set).
+ * @param uplink Link to the next hop of the PDU; its state tells whether the host is connected.
+ * @return PDU_SENT if the PDU was scheduled for transmission; PDU_STORED or PDU_STORED_OLDEST_DROPPED if it waits in the outbox.
+ */
+OutboxReturnType TrickleOutbox::submit(uint32_t outboxId, std::shared_ptr<ProtocolDataUnit> pdu, std::shared_ptr<Link> uplink) {
+	auto outboxIterator = outboxes.find(outboxId);
+	if (outboxIterator == outboxes.end()) {
+		outboxIterator = outboxes.emplace(outboxId, Outbox()).first;
+		outboxIterator->second.backoff = initialBackoff;
+		outboxIterator->second.isTimerArmed = false;
+	}
+	Outbox &outbox = outboxIterator->second;
+	outbox.uplink = std::move(uplink);
+	if (outbox.pdus.empty() && outbox.uplink->isUp()) {
+		send(std::move(pdu));
+		++sentPdusCount;
+		return OutboxReturnType::PDU_SENT;
+	}
+	OutboxReturnType outboxReturnType = OutboxReturnType::PDU_STORED;
+	if (outbox.pdus.size() >= capacity) {
+		outbox.pdus.pop_front();
+		++droppedPdusCount;
+		outboxReturnType = OutboxReturnType::PDU_STORED_OLDEST_DROPPED;
+	}
+	outbox.pdus.push_back(std::move(pdu));
+	++storedPdusCount;
+	if (!outbox.isTimerArmed) {
+		armTimer(outboxId, outbox, outbox.backoff);
+	}
+	return outboxReturnType;
+}
+
+/**
+ * @brief Process the retries due; to be called by the driver upon each recurring event.
+ *
+ * @details 
+ * For each outbox whose timer expired: if its uplink is up, up to flushBatchSize PDUs are sent, and the delay is reset (PDUs left are
+ * retried on the next tick); otherwise, the delay grows and the timer is armed again.
+ *
+ * @return Number of PDUs sent.
+ */
+unsigned int TrickleOutbox::processRetries() {
+	++retryEventsCount;
+	std::vector<uint32_t> outboxIds;
+	outboxIds.swap(dueOutboxIds);
+	unsigned int flushedCount = 0;
+	for (auto outboxId : outboxIds) {
+		auto outboxIterator = outboxes.find(outboxId);
+		if (outboxIterator == outboxes.end()) {
+			continue;
+		}
+		Outbox &outbox = outboxIterator->second;
+		outbox.isTimerArmed = false;
+		if (outbox.pdus.empty()) {
+			continue;
+		}
+		++retriesCount;
+		if (!outbox.uplink->isUp()) {
+			++failedRetriesCount;
+			outbox.backoff = std::min(outbox.backoff * backoffMultiplier, maximumBackoff);
+			armTimer(outboxId, outbox, outbox.backoff);
+			continue;
+		}
+		for (unsigned int batchCount = 0; batchCount < flushBatchSize && !outbox.pdus.empty(); ++batchCount) {
+			send(std::move(outbox.pdus.front()));
+			outbox.pdus.pop_front();
+			++flushedCount;
+		}
+		outbox.backoff = initialBackoff;
+		if (!outbox.pdus.empty()) {
+			armTimer(outboxId, outbox, timerWheel.getTickDuration());
+		}
+	}
+	flushedPdusCount += flushedCount;
+	return flushedCount;
+}
+
+/**
+ * @brief Interval until the next retry timer expires.
+ *
+ * @details 
+ * Called by the Scheduler upon each recurring event: the timers expired up to now are collected for processRetries(). With no timer left,
+ * the event is parked at the end of time, until a new timer moves it earlier.
+ *
+ * @return Interval until the next expiry, in seconds.
+ */
+double TrickleOutbox::nextOccurAfterTime() {
+	double currentTime = simulatorGlobals.getCurrentAbsoluteTime();
+	timerWheel.advance(currentTime, dueOutboxIds);
+	scheduledTime = timerWheel.getNextExpiryTime();
+	if (scheduledTime == std::numeric_limits<double>::max()) {
+		return std::numeric_limits<double>::max();
+	}
+	return std::max(scheduledTime - currentTime, 0.0);
+}
+
+/**
+ * @brief Number of PDUs waiting in an outbox.
+ *
+ * @param outboxId ID of the outbox.
+ * @return Number of PDUs waiting; zero if the outbox does not exist.
+ */
+std::deque<std::shared_ptr<ProtocolDataUnit>>::size_type TrickleOutbox::getOutboxSize(uint32_t outboxId) const {
+	auto outboxIterator = outboxes.find(outboxId);
+	return outboxIterator == outboxes.end() ? 0 : outboxIterator->second.pdus.size();
+}
+
+/**
+ * @brief Number of PDUs waiting in all outboxes.
+ *
+ * @return Number of PDUs waiting.
+ */
+std::deque<std::shared_ptr<ProtocolDataUnit>>::size_type TrickleOutbox::getStoredPdusSize() const {
+	std::deque<std::shared_ptr<ProtocolDataUnit>>::size_type storedPdusSize = 0;
+	for (auto &outboxPair : outboxes) {
+		storedPdusSize += outboxPair.second.pdus.size();
+	}
+	return storedPdusSize;
+}
+
+/**
+ * @brief Number of retry timers armed.
+ *
+ * @return Number of timers in the timer wheel.
+ */
+std::vector<std::pair<uint64_t, uint32_t>>::size_type TrickleOutbox::getPendingRetriesSize() const {
+	return timerWheel.getSize();
+}
+
+/**
+ * @brief Number of PDUs stored.
+ *
+ * @return Number of PDUs stored in the outboxes, including those dropped later.
+ */
+unsigned int TrickleOutbox::getStoredPdusCount() const {
+	return storedPdusCount;
+}
+
+/**
+ * @brief Number of PDUs sent right away by submit().
+ *
+ * @return Number of PDUs sent without being stored.
+ */
+unsigned int TrickleOutbox::getSentPdusCount() const {
+	return sentPdusCount;
+}
+
+/**
+ * @brief Number of PDUs sent from the outboxes.
+ *
+ * @return Number of PDUs flushed by retries.
+ */
+unsigned int TrickleOutbox::getFlushedPdusCount() const {
+	return flushedPdusCount;
+}
+
+/**
+ * @brief Number of PDUs dropped from full outboxes.
+ *
+ * @return Number of PDUs dropped.
+ */
+unsigned int TrickleOutbox::getDroppedPdusCount() const {
+	return droppedPdusCount;
+}
+
+/**
+ * @brief Number of retries.
+ *
+ * @return Number of retries of non-empty outboxes.
+ */
+unsigned int TrickleOutbox::getRetriesCount() const {
+	return retriesCount;
+}
+
+/**
+ * @brief Number of retries with the uplink still down.
+ *
+ * @return Number of failed retries.
+ */
+unsigned int TrickleOutbox::getFailedRetriesCount() const {
+	return failedRetriesCount;
+}
+
+/**
+ * @brief Number of recurring events processed.
+ *
+ * @return Number of calls to processRetries().
+ */
+unsigned int TrickleOutbox::getRetryEventsCount() const {
+	return retryEventsCount;
+}
@@ -0,0 +1,115 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Entity.h"
+#include "EventType.h"
+#include "Link.h"
+#include "OutboxReturnType.h"
+#include "ProtocolDataUnit.h"
+#include "RecurringEventSource.h"
+#include "Scheduler.h"
+#include "SimulatorGlobals.h"
+#include "TimerWheel.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#define OUTBOX_CAPACITY 64 //!< Default maximum number of PDUs stored in each outbox.
+#define OUTBOX_INITIAL_BACKOFF 1.0 //!< Default delay of the first retry after a PDU is stored, in seconds.
+#define OUTBOX_MAXIMUM_BACKOFF 64.0 //!< Default maximum delay between retries, in seconds.
+#define OUTBOX_BACKOFF_MULTIPLIER 2.0 //!< Default factor by which the delay grows after each failed retry.
+#define OUTBOX_FLUSH_BATCH_SIZE 32 //!< Default maximum number of PDUs sent by one successful retry.
+
+/**
+ * @brief Trickle Outbox class.
+ * 
+ * @par Description
+ * Client-side store-and-forward of trickle messages (e.g., sensor triggers), as done by BOINC clients: instead of being dropped at a link that
+ * is down, PDUs wait in a persistent outbox per host (e.g., per QCN sensor), and are sent when connectivity returns.
+ *
+ * The driver hands each PDU leaving its source to submit(), with the uplink, i.e., the first link of its route. If the uplink is up and the
+ * outbox empty, the PDU is scheduled for transmission right away; otherwise, it is stored, and the outbox arms a retry timer. Each outbox holds
+ * up to capacity PDUs, dropping the oldest when full. On a retry, if the uplink is up, the outbox flushes up to flushBatchSize PDUs at once,
+ * in order (the rest on the next tick), and its delay is reset; if still down, the delay grows by backoffMultiplier, up to maximumBackoff.
+ * Flushed PDUs are scheduled with zero delay as transmitEventType events (REQUEST_PDU_TRANSMISSION_AT_LINK by default), as the driver would.
+ *
+ * Retry timers are coalesced into a TimerWheel: all retries of the same tick are served by one recurring event (type TRICKLE_RETRY by default),
+ * thus an outage of 10,000 hosts keeps a single pending event in the event chain, not one per host. On each of these events, the driver calls
+ * processRetries().
+ *
+ * Only PDUs submitted while disconnected are protected: PDUs already in the network when a link goes down are still lost. SimulationCheckpoint
+ * saves the outboxes, their timer wheel and the recurring event of an outbox added with SimulationCheckpoint::addTrickleOutbox().
+ */
+class TrickleOutbox: public Entity, public RecurringEventSource {
+private:
+	/// Outbox of a host.
+	struct Outbox {
+		std::deque<std::shared_ptr<ProtocolDataUnit>> pdus; //!< PDUs waiting, oldest first.
+		std::shared_ptr<Link> uplink; //!< First link of the route of the last PDU submitted.
+		double backoff; //!< Delay of the next retry, in seconds.
+		bool isTimerArmed; //!< True if a retry timer is in the wheel.
+	};
+
+	Scheduler &scheduler; //!< Reference to Scheduler object, for the recurring event and the flushed PDUs.
+	SimulatorGlobals &simulatorGlobals; //!< Reference to SimulatorGlobals object, for the clock.
+	EventType retryEventType; //!< Type of the recurring event of retries.
+	EventType transmitEventType; //!< Type of the events of PDUs sent.
+	TimerWheel timerWheel; //!< Retry timers, by outbox ID.
+	std::unordered_map<uint32_t, Outbox> outboxes; //!< Outboxes, by ID.
+	std::vector<uint32_t> dueOutboxIds; //!< IDs of the outboxes whose timers expired on the last recurring event, for processRetries().
+	unsigned int capacity; //!< Maximum number of PDUs of each outbox.
+	double initialBackoff; //!< Delay of the first retry.
+	double maximumBackoff; //!< Maximum delay between retries.
+	double backoffMultiplier; //!< Factor of growth of the delay after a failed retry.
+	unsigned int flushBatchSize; //!< Maximum number of PDUs sent by one retry.
+	bool isScheduled; //!< True if the recurring event is in the event chain.
+	double scheduledTime; //!< Absolute time of the recurring event, if scheduled.
+	unsigned int storedPdusCount; //!< Number of PDUs stored.
+	unsigned int sentPdusCount; //!< Number of PDUs sent right away by submit().
+	unsigned int flushedPdusCount; //!< Number of PDUs sent from the outboxes.
+	unsigned int droppedPdusCount; //!< Number of PDUs dropped from full outboxes.
+	unsigned int retriesCount; //!< Number of retries.
+	unsigned int failedRetriesCount; //!< Number of retries with the uplink still down.
+	unsigned int retryEventsCount; //!< Number of recurring events processed.
+
+	void armTimer(uint32_t outboxId, Outbox &outbox, double delay);
+	void send(std::shared_ptr<ProtocolDataUnit> pdu);
+
+public:
+	TrickleOutbox(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType retryEventType = EventType::TRICKLE_RETRY,
+		EventType transmitEventType = EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, double tickDuration = TIMER_WHEEL_TICK);
+	virtual ~TrickleOutbox();
+
+	void setCapacity(unsigned int capacity);
+	void setBackoff(double initialBackoff, double maximumBackoff, double backoffMultiplier = OUTBOX_BACKOFF_MULTIPLIER);
+	void setFlushBatchSize(unsigned int flushBatchSize);
+	OutboxReturnType submit(uint32_t outboxId, std::shared_ptr<ProtocolDataUnit> pdu, std::shared_ptr<Link> uplink);
+	unsigned int processRetries();
+	double nextOccurAfterTime() override;
+	std::deque<std::shared_ptr<ProtocolDataUnit>>::size_type getOutboxSize(uint32_t outboxId) const;
+	std::deque<std::shared_ptr<ProtocolDataUnit>>::size_type getStoredPdusSize() const;
+	std::vector<std::pair<uint64_t, uint32_t>>::size_type getPendingRetriesSize() const;
+	unsigned int getStoredPdusCount() const;
+	unsigned int getSentPdusCount() const;
+	unsigned int getFlushedPdusCount() const;
+	unsigned int getDroppedPdusCount() const;
+	unsigned int getRetriesCount() const;
+	unsigned int getFailedRetriesCount() const;
+	unsigned int getRetryEventsCount() const;
+
+	friend class SimulationCheckpoint; //!< Saves and restores the outboxes, the timer wheel and the recurring event.
+};
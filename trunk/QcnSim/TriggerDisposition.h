@@ -0,0 +1,26 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/**
+* @brief Trigger Disposition enum class.
+*
+* @par Description
+* What happens to a sensor trigger, given the availability of its host (see HostAvailabilityModel::filterTrigger()).
+*/
+enum class TriggerDisposition {
+	DELIVER,	//!< Host is on, active and connected: the trigger is sent now.
+	BUFFER,		//!< Host is on and active, but disconnected: the trigger is kept and sent when the host connects again.
+	DROP		//!< Host is off, or the QCN client is not active: the trigger never happens.
+};
@@ -52,7 +52,7 @@ WeibullTrafficGenerator::WeibullTrafficGenerator(SimulatorGlobals &simulatorGlob
  * @param priority Token priority. Higher priority, higher number.
  * @param scale Scale parameter of the Weibull distribution.
  * @param shape Shape parameter of the Weibull distribution.
- * @param seed Seed to the default random number generator, to be passed to SimulatorGlobals object.
+ * @param seed Seed for the own random stream of this generator (see TrafficGenerator).
  */
 WeibullTrafficGenerator::WeibullTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, double scale, double shape, unsigned int seed): TrafficGenerator(simulatorGlobals, scheduler, eventType, tokenContents,
@@ -149,7 +149,7 @@ std::shared_ptr<Token> WeibullTrafficGenerator::createInstanceTrafficEvent(std::
  *
  * @details 
  * The Weibull variate is generated using C++11 Random library and uses the random number generator obtained from SimulatorGlobals,
- * such that its global seed can be utilized.
+ * such that its global seed can be utilized, or the own random stream of this generator, if set (see TrafficGenerator::setRandomStream()).
  *
  * @return Weibull distribution variate based on member variables scale and shape.
  */
@@ -157,7 +157,7 @@ double WeibullTrafficGenerator::generateWeibullVariate() {
 	// Have not seen different behavior with or without static below, per unit testing.
 	// The pseudorandom sequence seems to be unique per simulation, not per generator; the former is the expected behavior.
 	std::weibull_distribution<double> weibullGenerator(shape, scale);
-	return weibullGenerator(simulatorGlobals.getRandomNumberGeneratorEngineInstance());
+	return generateVariate(weibullGenerator);
 }
 
 /**
@@ -274,4 +274,22 @@ std::shared_ptr<ProtocolDataUnit> WeibullTrafficGenerator::createInstanceTraffic
 		scheduler.schedule(Event(generateWeibullVariate(), eventType, pdu));
 	}
 	return pdu;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Generate the interval until the next arrival, for autonomous mode.
+ *
+ * @return Next Weibull variate.
+ */
+double WeibullTrafficGenerator::generateInterval() {
+	return generateWeibullVariate();
+}
+
+/**
+ * @brief Return whether this generator can run in autonomous mode.
+ *
+ * @return True: intervals come from the Weibull distribution.
+ */
+bool WeibullTrafficGenerator::supportsAutonomousMode() const {
+	return true;
+}
@@ -36,6 +36,7 @@ private:
 	double scale;  //!< Scale parameter of the Weibull distribution.
 	double shape;  //!< Shape parameter of the Weibull distribution.
 	double generateWeibullVariate();
+	double generateInterval() override;
 	
 public:
 	WeibullTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
@@ -43,6 +44,7 @@ public:
 	WeibullTrafficGenerator(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, EventType eventType, std::shared_ptr<Entity> tokenContents,
 		std::shared_ptr<Entity> source, std::shared_ptr<Entity> destination, int priority, double scale, double shape, unsigned int seed);
 
+	bool supportsAutonomousMode() const override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::shared_ptr<Entity> tokenContents, bool recordRoute = false) override;
 	std::shared_ptr<Token> createInstanceTrafficEvent(std::vector<std::shared_ptr<Entity>> explicitRoute, bool recordRoute = false) override;
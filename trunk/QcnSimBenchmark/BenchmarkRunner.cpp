@@ -0,0 +1,225 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkRunner.h"
+#include "../QcnSim/JsonReader.h"
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Constructor.
+ *
+ * @param scale Scale factor passed to the workloads; 1 is the default size of each benchmark.
+ * @param repetitions Timed repetitions of each benchmark; at least 1.
+ */
+BenchmarkRunner::BenchmarkRunner(unsigned int scale, unsigned int repetitions): scale(scale > 0 ? scale : 1),
+		repetitions(repetitions > 0 ? repetitions : 1) {
+}
+
+/**
+ * @brief Register a benchmark.
+ *
+ * @param name Name of the benchmark; unique, used to match baselines.
+ * @param benchmarkKind Micro or macro benchmark.
+ * @param unit What an operation is (e.g., "events").
+ * @param benchmarkFunction Workload; returns the number of operations performed.
+ */
+void BenchmarkRunner::add(const std::string &name, BenchmarkKind benchmarkKind, const std::string &unit, BenchmarkFunction benchmarkFunction) {
+	Benchmark benchmark = { name, benchmarkKind, unit, benchmarkFunction };
+	benchmarks.push_back(benchmark);
+}
+
+/**
+ * @brief Only run the benchmarks whose names contain a text.
+ *
+ * @param filter Text; empty runs all benchmarks.
+ */
+void BenchmarkRunner::setFilter(const std::string &filter) {
+	this->filter = filter;
+}
+
+/**
+ * @brief Run the benchmarks that pass the filter: a warm-up run, then the timed repetitions.
+ *
+ * @param progressStream Stream to which one line per benchmark is written.
+ */
+void BenchmarkRunner::run(std::ostream &progressStream) {
+	benchmarkResults.clear();
+	for (auto &benchmark : benchmarks) {
+		if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+			continue;
+		}
+		BenchmarkResult benchmarkResult = { benchmark.name, benchmark.benchmarkKind, benchmark.unit, 0, std::numeric_limits<double>::max(), 0.0, 0.0, -1 };
+		benchmark.benchmarkFunction(scale); // Warm-up: caches, allocator, lazy initializations.
+		for (unsigned int repetition = 0; repetition < repetitions; ++repetition) {
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+			benchmarkResult.operationsCount = benchmark.benchmarkFunction(scale);
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+			benchmarkResult.bestSeconds = std::min(benchmarkResult.bestSeconds, seconds);
+			benchmarkResult.meanSeconds += seconds / repetitions;
+		}
+		benchmarkResult.operationsPerSecond = benchmarkResult.bestSeconds > 0.0 ? benchmarkResult.operationsCount / benchmarkResult.bestSeconds : 0.0;
+		benchmarkResult.peakRssKilobytes = getPeakRssKilobytes();
+		benchmarkResults.push_back(benchmarkResult);
+		progressStream << std::left << std::setw(40) << benchmark.name << std::right << std::setw(16) << std::fixed << std::setprecision(0)
+			<< benchmarkResult.operationsPerSecond << " " << benchmark.unit << "/s" << std::setw(12) << std::setprecision(6)
+			<< benchmarkResult.bestSeconds << " s" << std::endl;
+	}
+	progressStream.unsetf(std::ios::fixed);
+}
+
+/**
+ * @brief Write the results as JSON: date, scale, repetitions, and one object per benchmark.
+ *
+ * @param outputStream Stream to write to.
+ */
+void BenchmarkRunner::writeJson(std::ostream &outputStream) const {
+	std::time_t now = std::time(nullptr);
+	char dateText[32];
+	std::strftime(dateText, sizeof(dateText), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+	outputStream << "{" << std::endl;
+	outputStream << "  \"date\": \"" << dateText << "\"," << std::endl;
+	outputStream << "  \"scale\": " << scale << "," << std::endl;
+	outputStream << "  \"repetitions\": " << repetitions << "," << std::endl;
+	outputStream << "  \"benchmarks\": [";
+	for (std::vector<BenchmarkResult>::size_type resultIndex = 0; resultIndex < benchmarkResults.size(); ++resultIndex) {
+		const BenchmarkResult &benchmarkResult = benchmarkResults[resultIndex];
+		outputStream << (resultIndex > 0 ? "," : "") << std::endl << std::setprecision(10);
+		outputStream << "    {\"name\": \"" << benchmarkResult.name << "\", \"kind\": \""
+			<< (benchmarkResult.benchmarkKind == BenchmarkKind::MICRO ? "micro" : "macro") << "\", \"unit\": \"" << benchmarkResult.unit
+			<< "\", \"operations\": " << benchmarkResult.operationsCount << ", \"bestSeconds\": " << benchmarkResult.bestSeconds
+			<< ", \"meanSeconds\": " << benchmarkResult.meanSeconds << ", \"operationsPerSecond\": " << benchmarkResult.operationsPerSecond
+			<< ", \"peakRssKilobytes\": " << benchmarkResult.peakRssKilobytes << "}";
+	}
+	outputStream << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+/**
+ * @brief Compare the results with a baseline JSON file written by writeJson(), reporting regressions and improvements.
+ *
+ * @param fileName Name of the baseline file.
+ * @param tolerance Fraction of the baseline rate; a benchmark slower than (1 - tolerance) times its baseline rate is a regression.
+ * @param reportStream Stream to which the comparison is written.
+ * @return True if no benchmark regressed; false if some did, or the baseline could not be read.
+ */
+bool BenchmarkRunner::compareWithBaseline(const std::string &fileName, double tolerance, std::ostream &reportStream) const {
+	std::map<std::string, double> baselineRates;
+	if (!readJson(fileName, baselineRates)) {
+		reportStream << "Could not read baseline " << fileName << "." << std::endl;
+		return false;
+	}
+	bool isWithinTolerance = true;
+	for (auto &benchmarkResult : benchmarkResults) {
+		std::map<std::string, double>::const_iterator baselineIterator = baselineRates.find(benchmarkResult.name);
+		if (baselineIterator == baselineRates.end() || baselineIterator->second <= 0.0) {
+			reportStream << std::left << std::setw(40) << benchmarkResult.name << " no baseline" << std::endl;
+			continue;
+		}
+		double ratio = benchmarkResult.operationsPerSecond / baselineIterator->second;
+		bool isRegression = ratio < 1.0 - tolerance;
+		isWithinTolerance = isWithinTolerance && !isRegression;
+		reportStream << std::left << std::setw(40) << benchmarkResult.name << std::right << std::setw(9) << std::fixed << std::setprecision(1)
+			<< (ratio - 1.0) * 100.0 << " %" << (isRegression ? "  REGRESSION" : "") << std::endl;
+	}
+	reportStream.unsetf(std::ios::fixed);
+	return isWithinTolerance;
+}
+
+/**
+ * @brief Results of the benchmarks run, in order.
+ *
+ * @return Reference to the results.
+ */
+const std::vector<BenchmarkResult> &BenchmarkRunner::getBenchmarkResults() const {
+	return benchmarkResults;
+}
+
+/**
+ * @brief Read the rates of a JSON file written by writeJson().
+ *
+ * @param fileName Name of the file.
+ * @param operationsPerSecond Map to which the operations per second are added, by benchmark name.
+ * @return True if read; false if the file could not be opened or is malformed.
+ */
+bool BenchmarkRunner::readJson(const std::string &fileName, std::map<std::string, double> &operationsPerSecond) {
+	std::ifstream inputFile(fileName);
+	if (!inputFile) {
+		return false;
+	}
+	try {
+		JsonReader jsonReader(inputFile);
+		std::string memberName;
+		std::string value;
+		jsonReader.beginObject();
+		while (jsonReader.nextMember(memberName)) {
+			if (memberName != "benchmarks") {
+				jsonReader.skipValue();
+				continue;
+			}
+			jsonReader.beginArray();
+			while (jsonReader.nextElement()) {
+				std::string benchmarkName;
+				double rate = 0.0;
+				jsonReader.beginObject();
+				while (jsonReader.nextMember(memberName)) {
+					if (memberName == "name") {
+						jsonReader.readString(benchmarkName);
+					} else if (memberName == "operationsPerSecond") {
+						jsonReader.readScalar(value);
+						rate = std::stod(value);
+					} else {
+						jsonReader.skipValue();
+					}
+				}
+				operationsPerSecond[benchmarkName] = rate;
+			}
+		}
+	} catch (const std::exception &) { // JsonReaderException, or a rate that is not a number.
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Peak resident set size of the process.
+ *
+ * @return Peak RSS, in KiB; -1 if unknown.
+ */
+long BenchmarkRunner::getPeakRssKilobytes() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS processMemoryCounters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &processMemoryCounters, sizeof(processMemoryCounters))) {
+		return static_cast<long>(processMemoryCounters.PeakWorkingSetSize / 1024);
+	}
+	return -1;
+#else
+	struct rusage resourceUsage;
+	if (getrusage(RUSAGE_SELF, &resourceUsage) != 0) {
+		return -1;
+	}
+#ifdef __APPLE__
+	return static_cast<long>(resourceUsage.ru_maxrss / 1024); // Bytes on macOS.
+#else
+	return static_cast<long>(resourceUsage.ru_maxrss); // KiB on Linux.
+#endif
+#endif
+}
@@ -0,0 +1,90 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define BENCHMARK_REPETITIONS 3 //!< Default number of timed repetitions of each benchmark; the best one is reported.
+#define BENCHMARK_REGRESSION_TOLERANCE 0.10 //!< Default fraction of the baseline rate below which a benchmark is a regression.
+
+/// Kind of benchmark.
+enum class BenchmarkKind {
+	MICRO,	//!< Single operation of a class (e.g., schedule and cause, Facility request and release).
+	MACRO	//!< Whole scenario, driven by a main loop.
+};
+
+/// Result of a benchmark.
+struct BenchmarkResult {
+	std::string name; //!< Name of the benchmark.
+	BenchmarkKind benchmarkKind; //!< Micro or macro benchmark.
+	std::string unit; //!< What an operation is (e.g., "events", "variates").
+	uint64_t operationsCount; //!< Operations of one repetition.
+	double bestSeconds; //!< Wallclock time of the fastest repetition.
+	double meanSeconds; //!< Mean wallclock time of the repetitions.
+	double operationsPerSecond; //!< Operations per second of the fastest repetition.
+	long peakRssKilobytes; //!< Peak resident set size of the process after the benchmark, in KiB; -1 if unknown.
+};
+
+/**
+ * @brief Benchmark Runner class.
+ * 
+ * @par Description
+ * Runs named benchmarks and reports their rates as JSON, for tracking performance over time. A benchmark is a function that runs a
+ * workload, sized by a scale factor, and returns the number of operations it performed (e.g., events caused); the runner times a warm-up
+ * run and BENCHMARK_REPETITIONS timed runs, and reports the best rate, i.e., the one least disturbed by the machine.
+ *
+ * Peak RSS is the high-water mark of the whole process, thus it only grows from one benchmark to the next; run a single benchmark (see
+ * setFilter()) to measure its own peak.
+ *
+ * Results may be compared with a baseline JSON file written by an earlier run (see compareWithBaseline()): benchmarks slower than the
+ * baseline by more than the tolerance are reported as regressions.
+ */
+class BenchmarkRunner {
+public:
+	typedef std::function<uint64_t(unsigned int scale)> BenchmarkFunction; //!< Workload; returns the number of operations performed.
+
+private:
+	/// Registered benchmark.
+	struct Benchmark {
+		std::string name; //!< Name of the benchmark.
+		BenchmarkKind benchmarkKind; //!< Micro or macro benchmark.
+		std::string unit; //!< What an operation is.
+		BenchmarkFunction benchmarkFunction; //!< Workload.
+	};
+
+	std::vector<Benchmark> benchmarks; //!< Registered benchmarks, in order.
+	std::vector<BenchmarkResult> benchmarkResults; //!< Results of the benchmarks run.
+	std::string filter; //!< Only benchmarks whose names contain this text run; empty runs all.
+	unsigned int scale; //!< Scale factor passed to the workloads.
+	unsigned int repetitions; //!< Timed repetitions of each benchmark.
+
+	static long getPeakRssKilobytes();
+
+public:
+	BenchmarkRunner(unsigned int scale = 1, unsigned int repetitions = BENCHMARK_REPETITIONS);
+
+	void add(const std::string &name, BenchmarkKind benchmarkKind, const std::string &unit, BenchmarkFunction benchmarkFunction);
+	void setFilter(const std::string &filter);
+	void run(std::ostream &progressStream);
+	void writeJson(std::ostream &outputStream) const;
+	bool compareWithBaseline(const std::string &fileName, double tolerance, std::ostream &reportStream) const;
+	const std::vector<BenchmarkResult> &getBenchmarkResults() const;
+
+	static bool readJson(const std::string &fileName, std::map<std::string, double> &operationsPerSecond);
+};
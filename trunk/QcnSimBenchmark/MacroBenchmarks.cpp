@@ -0,0 +1,290 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MacroBenchmarks.h"
+#include "../QcnSim/SimulatorGlobals.h"
+#include "../QcnSim/Scheduler.h"
+#include "../QcnSim/Facility.h"
+#include "../QcnSim/Link.h"
+#include "../QcnSim/Node.h"
+#include "../QcnSim/Message.h"
+#include "../QcnSim/Token.h"
+#include "../QcnSim/ProtocolDataUnit.h"
+#include "../QcnSim/ExponentialTrafficGenerator.h"
+#include "../QcnSim/StaticTopology.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#define MM1_SIMULATION_TIME 25000.0 //!< Simulated time of the M/M/1 benchmark at scale 1, in seconds (about 190000 events).
+#define MULTIPLE_SIMULATION_TIME 500.0 //!< Simulated time of the multiple links benchmark at scale 1, in seconds (about 250000 events).
+#define MULTIPLE_LINKS 100 //!< Links (and generators) of the multiple links benchmark.
+#define CCGRID_TRIGGERS 20000 //!< Sensor triggers of the CCGrid burst benchmark at scale 1.
+#define CCGRID_BURST_DURATION 10.0 //!< Time over which the triggers of the CCGrid burst benchmark arrive, in seconds.
+#define CCGRID_PDU_SIZE 512 //!< PDU size of the CCGrid burst benchmark, in bytes.
+
+/**
+ * @brief M/M/1 queue, as QcnSimMm1: exponential arrivals (tau 0.4 s) at a single server with exponential service times (0.1 s).
+ *
+ * @param scale Scale factor of the simulated time.
+ * @return Events caused.
+ */
+static uint64_t runMm1(unsigned int scale) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "M/M/1 Queue");
+	Scheduler scheduler(simulatorGlobals);
+	std::mt19937 randomEngine(1);
+	std::exponential_distribution<double> exponentialVariate(1 / 0.1);
+	std::shared_ptr<Facility> facility = std::make_shared<Facility>("Single server facility", simulatorGlobals, scheduler);
+	std::shared_ptr<Message> tokenContents = std::make_shared<Message>("Message within token");
+	std::shared_ptr<Message> source = std::make_shared<Message>("Source");
+	ExponentialTrafficGenerator exponentialGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, facility, 1, 0.4, 1);
+	exponentialGenerator.setRandomStream(1);
+	exponentialGenerator.turnOn();
+	exponentialGenerator.createInstanceTrafficEvent();
+	scheduler.schedule(Event(MM1_SIMULATION_TIME * scale, EventType::END_SIMULATION, nullptr));
+
+	uint64_t eventsCount = 0;
+	bool simulationEnded = false;
+	while (!simulationEnded) {
+		Event currentEvent = scheduler.cause();
+		++eventsCount;
+		std::shared_ptr<const Token> token = std::static_pointer_cast<const Token>(currentEvent.entity);
+		switch (currentEvent.eventType) {
+			case EventType::TRAFFIC_GENERATOR_ARRIVAL:
+				scheduler.schedule(Event(0.0, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY, token));
+				exponentialGenerator.createInstanceTrafficEvent();
+				break;
+			case EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY:
+				if (facility->request(token, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY) == FacilityReturnType::TOKEN_PUT_IN_SERVICE) {
+					scheduler.schedule(Event(exponentialVariate(randomEngine), EventType::RELEASE_TOKEN_FROM_SERVICE_AT_FACILITY, token));
+				}
+				break;
+			case EventType::RELEASE_TOKEN_FROM_SERVICE_AT_FACILITY:
+				facility->release(token);
+				break;
+			default:
+				simulationEnded = true;
+				break;
+		}
+	}
+	return eventsCount;
+}
+
+/**
+ * @brief Multiple links, as QcnSimMultiple: MULTIPLE_LINKS exponential sources, each served by its own link (single server), then by
+ * a central facility of 4 servers, or by a backup facility after half of the simulated time.
+ *
+ * @param scale Scale factor of the simulated time.
+ * @return Events caused.
+ */
+static uint64_t runMultiple(unsigned int scale) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "Multiple links");
+	Scheduler scheduler(simulatorGlobals);
+	std::mt19937 randomEngine(1);
+	std::exponential_distribution<double> exponentialVariateLink(1 / 0.1);
+	std::exponential_distribution<double> exponentialVariateCentralServer(1 / 0.05);
+	std::uniform_int_distribution<int> uniformVariate(0, 1);
+	std::shared_ptr<Facility> centralFacility = std::make_shared<Facility>("Central Facility", 4, simulatorGlobals, scheduler);
+	std::shared_ptr<Facility> backupFacility = std::make_shared<Facility>("Backup Facility", 4, simulatorGlobals, scheduler);
+	std::shared_ptr<Message> tokenContents = std::make_shared<Message>("Message within token");
+	std::vector<std::unique_ptr<ExponentialTrafficGenerator>> exponentialGenerators;
+	std::map<const Entity *, ExponentialTrafficGenerator *> generatorOfLink;
+	for (unsigned int linkIndex = 0; linkIndex < MULTIPLE_LINKS; ++linkIndex) {
+		std::shared_ptr<Facility> facility = std::make_shared<Facility>("Simplex link", simulatorGlobals, scheduler);
+		exponentialGenerators.emplace_back(new ExponentialTrafficGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL,
+			tokenContents, facility, facility, 1, 1.0, 1));
+		exponentialGenerators.back()->setRandomStream(linkIndex);
+		exponentialGenerators.back()->turnOn();
+		exponentialGenerators.back()->createInstanceTrafficEvent();
+		generatorOfLink[facility.get()] = exponentialGenerators.back().get();
+	}
+	double simulationTime = MULTIPLE_SIMULATION_TIME * scale;
+	scheduler.schedule(Event(simulationTime, EventType::END_SIMULATION, nullptr));
+	scheduler.schedule(Event(simulationTime / 2, EventType::ACTIVATE_BACKUP_FACILITY, nullptr));
+
+	uint64_t eventsCount = 0;
+	bool isBackupServerActive = false;
+	bool simulationEnded = false;
+	while (!simulationEnded) {
+		Event currentEvent = scheduler.cause();
+		++eventsCount;
+		std::shared_ptr<Token> token = std::const_pointer_cast<Token>(std::static_pointer_cast<const Token>(currentEvent.entity));
+		switch (currentEvent.eventType) {
+			case EventType::TRAFFIC_GENERATOR_ARRIVAL:
+				scheduler.schedule(Event(0.0, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY, token));
+				generatorOfLink[token->source.get()]->createInstanceTrafficEvent();
+				break;
+			case EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY:
+				if (std::static_pointer_cast<Facility>(token->destination)->request(token, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY) == FacilityReturnType::TOKEN_PUT_IN_SERVICE) {
+					scheduler.schedule(Event(exponentialVariateLink(randomEngine), EventType::RELEASE_TOKEN_FROM_SERVICE_AT_FACILITY, token));
+				}
+				break;
+			case EventType::RELEASE_TOKEN_FROM_SERVICE_AT_FACILITY:
+				std::static_pointer_cast<Facility>(token->destination)->release(token);
+				if (token->destination != centralFacility && token->destination != backupFacility) {
+					// Served by its link: on to the central facility, or to either facility once the backup is active.
+					if (isBackupServerActive && uniformVariate(randomEngine) == 0) {
+						token->destination = backupFacility;
+					} else {
+						token->destination = centralFacility;
+					}
+					scheduler.schedule(Event(0.0, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_CENTRAL_FACILITY, token));
+				}
+				break;
+			case EventType::REQUEST_SERVICE_FOR_TOKEN_AT_CENTRAL_FACILITY:
+				if (std::static_pointer_cast<Facility>(token->destination)->request(token, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_CENTRAL_FACILITY) == FacilityReturnType::TOKEN_PUT_IN_SERVICE) {
+					scheduler.schedule(Event(exponentialVariateCentralServer(randomEngine), EventType::RELEASE_TOKEN_FROM_SERVICE_AT_FACILITY, token));
+				}
+				break;
+			case EventType::ACTIVATE_BACKUP_FACILITY:
+				isBackupServerActive = true;
+				break;
+			default:
+				simulationEnded = true;
+				break;
+		}
+	}
+	return eventsCount;
+}
+
+/**
+ * @brief Burst of sensor triggers, as QcnSimCCGrid: CCGRID_TRIGGERS PDUs (times the scale) arrive within CCGRID_BURST_DURATION at the 4
+ * region meta-nodes, and are transmitted through the region links (bandwidths and delays of the CCGrid map) to the BOINC servers.
+ *
+ * @param scale Scale factor of the number of triggers.
+ * @return Events handled, including fused continuations.
+ */
+static uint64_t runCcGridBurst(unsigned int scale) {
+	const double bandwidths[] = { 8700000, 3000000, 5000000, 5000000 };
+	const double propagationDelays[] = { 0.03, 0.05, 0.05, 0.05 };
+	const unsigned int regionsCount = 4;
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "CCGrid burst");
+	Scheduler scheduler(simulatorGlobals);
+	scheduler.setFusion(true);
+	std::shared_ptr<Message> tokenContents = std::make_shared<Message>("Trigger");
+	std::vector<std::shared_ptr<Node>> nodes; // Region meta-nodes (IDs 0 to 3), then BOINC servers (IDs 4 to 7).
+	std::vector<std::shared_ptr<Link>> linkOfNode(2 * regionsCount); // Link by the ID of the node it leads to.
+	std::vector<std::vector<std::shared_ptr<Entity>>> routes;
+	std::vector<std::unique_ptr<ExponentialTrafficGenerator>> exponentialGenerators;
+	for (unsigned int nodeId = 0; nodeId < 2 * regionsCount; ++nodeId) {
+		nodes.push_back(std::make_shared<Node>(simulatorGlobals, nodeId));
+	}
+	double tau = CCGRID_BURST_DURATION * regionsCount / (static_cast<double>(CCGRID_TRIGGERS) * scale); // Interarrival time per region.
+	for (unsigned int region = 0; region < regionsCount; ++region) {
+		linkOfNode[regionsCount + region] = std::make_shared<Link>(nodes[region], nodes[regionsCount + region], bandwidths[region],
+			propagationDelays[region], simulatorGlobals, scheduler);
+		routes.push_back(std::vector<std::shared_ptr<Entity>>({ nodes[region], nodes[regionsCount + region] }));
+		exponentialGenerators.emplace_back(new ExponentialTrafficGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL,
+			tokenContents, nodes[region], nodes[regionsCount + region], 1, tau, 1));
+		exponentialGenerators.back()->setRandomStream(region);
+		exponentialGenerators.back()->turnOn();
+		exponentialGenerators.back()->createInstanceTrafficEventPdu(CCGRID_PDU_SIZE, routes.back());
+	}
+	scheduler.schedule(Event(CCGRID_BURST_DURATION * 10, EventType::END_SIMULATION, nullptr));
+
+	uint64_t eventsCount = 0;
+	bool isFused = false;
+	bool simulationEnded = false;
+	Event currentEvent;
+	std::shared_ptr<ProtocolDataUnit> pdu(nullptr);
+	while (!simulationEnded) {
+		if (!isFused) {
+			currentEvent = scheduler.cause();
+			pdu = std::const_pointer_cast<ProtocolDataUnit>(std::static_pointer_cast<const ProtocolDataUnit>(currentEvent.entity));
+		}
+		isFused = false;
+		++eventsCount;
+		switch (currentEvent.eventType) {
+			case EventType::TRAFFIC_GENERATOR_ARRIVAL: {
+				scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pdu));
+				unsigned int region = std::static_pointer_cast<Node>(pdu->source)->getNodeId();
+				if (simulatorGlobals.getCurrentAbsoluteTime() < CCGRID_BURST_DURATION) {
+					exponentialGenerators[region]->createInstanceTrafficEventPdu(CCGRID_PDU_SIZE, routes[region]);
+				}
+				break;
+			}
+			case EventType::PDUTOKEN_ARRIVAL_AT_NODE: {
+				std::shared_ptr<Node> node = std::static_pointer_cast<Node>(pdu->next);
+				if (linkOfNode[node->getNodeId()] != nullptr) {
+					linkOfNode[node->getNodeId()]->endPropagation(pdu);
+				}
+				if (node->processAndForward(pdu) != NodeReturnType::FINAL_DESTINATION) {
+					isFused = scheduler.scheduleOrFuse(currentEvent, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK);
+				}
+				break;
+			}
+			case EventType::REQUEST_PDU_TRANSMISSION_AT_LINK:
+				linkOfNode[std::static_pointer_cast<Node>(pdu->next)->getNodeId()]->transmitPdu(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK,
+					EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK, pdu);
+				break;
+			case EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK:
+				linkOfNode[std::static_pointer_cast<Node>(pdu->next)->getNodeId()]->propagatePdu(EventType::END_PROPAGATION_AT_LINK, pdu);
+				break;
+			case EventType::END_PROPAGATION_AT_LINK:
+				isFused = scheduler.scheduleOrFuse(currentEvent, EventType::PDUTOKEN_ARRIVAL_AT_NODE);
+				break;
+			default:
+				simulationEnded = true;
+				break;
+		}
+	}
+	return eventsCount;
+}
+
+/**
+ * @brief The CCGrid burst scenario of runCcGridBurst(), run by the StaticTopology kernel: node, link and generator types are template
+ * parameters, and their member functions are called without virtual dispatch.
+ *
+ * @param scale Scale factor of the number of triggers.
+ * @return Events handled, including fused continuations.
+ */
+static uint64_t runCcGridBurstStatic(unsigned int scale) {
+	const double bandwidths[] = { 8700000, 3000000, 5000000, 5000000 };
+	const double propagationDelays[] = { 0.03, 0.05, 0.05, 0.05 };
+	const unsigned int regionsCount = 4;
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "CCGrid burst (static topology)");
+	Scheduler scheduler(simulatorGlobals);
+	scheduler.setFusion(true);
+	std::shared_ptr<Message> tokenContents = std::make_shared<Message>("Trigger");
+	StaticTopology<Node, Link, ExponentialTrafficGenerator> staticTopology(simulatorGlobals, scheduler);
+	for (unsigned int nodeId = 0; nodeId < 2 * regionsCount; ++nodeId) {
+		staticTopology.addNode(std::make_shared<Node>(simulatorGlobals, nodeId));
+	}
+	double tau = CCGRID_BURST_DURATION * regionsCount / (static_cast<double>(CCGRID_TRIGGERS) * scale); // Interarrival time per region.
+	for (unsigned int region = 0; region < regionsCount; ++region) {
+		std::shared_ptr<Node> regionNode = staticTopology.getNode(region);
+		std::shared_ptr<Node> serverNode = staticTopology.getNode(regionsCount + region);
+		staticTopology.addLink(std::make_shared<Link>(regionNode, serverNode, bandwidths[region], propagationDelays[region], simulatorGlobals, scheduler));
+		std::shared_ptr<ExponentialTrafficGenerator> exponentialGenerator = std::make_shared<ExponentialTrafficGenerator>(simulatorGlobals, scheduler,
+			EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, regionNode, serverNode, 1, tau, 1);
+		exponentialGenerator->setRandomStream(region);
+		exponentialGenerator->turnOn();
+		staticTopology.addGenerator(exponentialGenerator, CCGRID_PDU_SIZE, std::vector<std::shared_ptr<Entity>>({ regionNode, serverNode }));
+	}
+	staticTopology.start(CCGRID_BURST_DURATION);
+	scheduler.schedule(Event(CCGRID_BURST_DURATION * 10, EventType::END_SIMULATION, nullptr));
+	return staticTopology.run();
+}
+
+/**
+ * @brief Register the macro-benchmarks: M/M/1, multiple links and CCGrid burst scenarios, the latter also with the static topology kernel.
+ *
+ * @param benchmarkRunner Runner to register with.
+ */
+void registerMacroBenchmarks(BenchmarkRunner &benchmarkRunner) {
+	benchmarkRunner.add("Mm1", BenchmarkKind::MACRO, "events", runMm1);
+	benchmarkRunner.add("Multiple/100Links", BenchmarkKind::MACRO, "events", runMultiple);
+	benchmarkRunner.add("CcGridBurst", BenchmarkKind::MACRO, "events", runCcGridBurst);
+	benchmarkRunner.add("CcGridBurst/StaticTopology", BenchmarkKind::MACRO, "events", runCcGridBurstStatic);
+}
@@ -0,0 +1,202 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MicroBenchmarks.h"
+#include "../QcnSim/SimulatorGlobals.h"
+#include "../QcnSim/Scheduler.h"
+#include "../QcnSim/Facility.h"
+#include "../QcnSim/Link.h"
+#include "../QcnSim/Node.h"
+#include "../QcnSim/Message.h"
+#include "../QcnSim/Token.h"
+#include "../QcnSim/ProtocolDataUnit.h"
+#include "../QcnSim/ExponentialTrafficGenerator.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#define MICRO_BENCHMARK_OPERATIONS 200000 //!< Operations of a micro-benchmark at scale 1.
+#define MICRO_BENCHMARK_GENERATORS 100 //!< Generators of the autonomous generators micro-benchmark.
+
+/**
+ * @brief Hold model: with chainSize events pending, repeatedly cause the next event and schedule a new one at an exponential delay.
+ *
+ * @param chainSize Number of events pending.
+ * @param operationsCount Number of cause and schedule pairs.
+ * @return Operations performed.
+ */
+static uint64_t runSchedulerHold(unsigned int chainSize, uint64_t operationsCount) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SchedulerHold");
+	Scheduler scheduler(simulatorGlobals);
+	std::mt19937 randomEngine(1);
+	std::exponential_distribution<double> exponentialVariate(1.0);
+	for (unsigned int eventIndex = 0; eventIndex < chainSize; ++eventIndex) {
+		scheduler.schedule(Event(exponentialVariate(randomEngine), EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr));
+	}
+	for (uint64_t operation = 0; operation < operationsCount; ++operation) {
+		scheduler.cause();
+		scheduler.schedule(Event(exponentialVariate(randomEngine), EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr));
+	}
+	return operationsCount;
+}
+
+/**
+ * @brief Zero-delay events: repeatedly schedule an event with zero delay and cause it, with 1000 future events pending.
+ *
+ * @param operationsCount Number of schedule and cause pairs.
+ * @return Operations performed.
+ */
+static uint64_t runSchedulerZeroDelay(uint64_t operationsCount) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SchedulerZeroDelay");
+	Scheduler scheduler(simulatorGlobals);
+	for (unsigned int eventIndex = 0; eventIndex < 1000; ++eventIndex) {
+		scheduler.schedule(Event(1.0 + eventIndex, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr));
+	}
+	for (uint64_t operation = 0; operation < operationsCount; ++operation) {
+		scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, nullptr));
+		scheduler.cause();
+	}
+	return operationsCount;
+}
+
+/**
+ * @brief Facility request and release: four tokens request a single server; the queued ones are served as the server is released.
+ *
+ * @param operationsCount Number of tokens served (rounded down to a multiple of four).
+ * @return Operations performed.
+ */
+static uint64_t runFacilityRequestRelease(uint64_t operationsCount) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "FacilityRequestRelease");
+	Scheduler scheduler(simulatorGlobals);
+	Facility facility("Benchmark facility", simulatorGlobals, scheduler);
+	std::shared_ptr<Message> message = std::make_shared<Message>("Benchmark");
+	std::vector<std::shared_ptr<const Token>> tokens;
+	for (unsigned int tokenId = 1; tokenId <= 4; ++tokenId) {
+		tokens.push_back(std::make_shared<Token>(tokenId, 1, message, message, message));
+	}
+	uint64_t servedCount = 0;
+	while (servedCount + tokens.size() <= operationsCount) {
+		for (auto &token : tokens) {
+			facility.request(token, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY);
+		}
+		facility.release(tokens.front());
+		++servedCount;
+		while (scheduler.getChainSize() > 0) {
+			std::shared_ptr<const Token> token = std::static_pointer_cast<const Token>(scheduler.cause().entity);
+			facility.request(token, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY);
+			facility.release(token);
+			++servedCount;
+		}
+	}
+	return servedCount;
+}
+
+/**
+ * @brief Link transmission and propagation: each PDU is transmitted, propagated and delivered, through the events of the link.
+ *
+ * @param operationsCount Number of PDUs.
+ * @return Operations performed.
+ */
+static uint64_t runLinkTransmitPropagate(uint64_t operationsCount) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "LinkTransmitPropagate");
+	Scheduler scheduler(simulatorGlobals);
+	std::shared_ptr<Node> node0 = std::make_shared<Node>(simulatorGlobals, 0);
+	std::shared_ptr<Node> node1 = std::make_shared<Node>(simulatorGlobals, 1);
+	Link link(node0, node1, 5000000, 0.05, simulatorGlobals, scheduler);
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(simulatorGlobals, 1, nullptr, node0, node1, node0, node1, 512));
+	for (uint64_t operation = 0; operation < operationsCount; ++operation) {
+		link.transmitPdu(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK, pdu);
+		scheduler.cause();
+		link.propagatePdu(EventType::END_PROPAGATION_AT_LINK, pdu);
+		scheduler.cause();
+		link.endPropagation(pdu);
+	}
+	return operationsCount;
+}
+
+/**
+ * @brief Interarrival variates of an exponential generator, from the shared engine or from its own (buffered) random stream.
+ *
+ * @param usesOwnRandomStream True to draw from an own random stream.
+ * @param operationsCount Number of variates.
+ * @return Operations performed.
+ */
+static uint64_t runExponentialVariates(bool usesOwnRandomStream, uint64_t operationsCount) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "ExponentialVariates");
+	Scheduler scheduler(simulatorGlobals);
+	std::shared_ptr<Message> message = std::make_shared<Message>("Benchmark");
+	ExponentialTrafficGenerator exponentialGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, message, message, message, 1, 0.5, 1);
+	if (usesOwnRandomStream) {
+		exponentialGenerator.setRandomStream(1);
+	}
+	double sum = 0.0;
+	for (uint64_t operation = 0; operation < operationsCount; ++operation) {
+		sum += exponentialGenerator.nextOccurAfterTime();
+	}
+	return sum > 0.0 ? operationsCount : 0;
+}
+
+/**
+ * @brief Autonomous generators: MICRO_BENCHMARK_GENERATORS exponential generators keep recurring events in the scheduler, which are caused.
+ *
+ * @param operationsCount Number of arrivals.
+ * @return Operations performed.
+ */
+static uint64_t runAutonomousGenerators(uint64_t operationsCount) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "AutonomousGenerators");
+	Scheduler scheduler(simulatorGlobals);
+	std::shared_ptr<Message> message = std::make_shared<Message>("Benchmark");
+	std::vector<std::unique_ptr<ExponentialTrafficGenerator>> exponentialGenerators;
+	for (unsigned int generatorIndex = 0; generatorIndex < MICRO_BENCHMARK_GENERATORS; ++generatorIndex) {
+		exponentialGenerators.emplace_back(new ExponentialTrafficGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, message,
+			message, message, 1, 1.0, 1));
+		exponentialGenerators.back()->setRandomStream(generatorIndex);
+		exponentialGenerators.back()->turnOnAutonomous();
+	}
+	for (uint64_t operation = 0; operation < operationsCount; ++operation) {
+		scheduler.cause();
+	}
+	return operationsCount;
+}
+
+/**
+ * @brief Register the micro-benchmarks: scheduler, Facility, Link and generators.
+ *
+ * @param benchmarkRunner Runner to register with.
+ */
+void registerMicroBenchmarks(BenchmarkRunner &benchmarkRunner) {
+	for (unsigned int chainSize : { 10, 1000, 100000 }) {
+		benchmarkRunner.add("SchedulerHold/" + std::to_string(chainSize), BenchmarkKind::MICRO, "events", [chainSize](unsigned int scale) {
+			return runSchedulerHold(chainSize, static_cast<uint64_t>(MICRO_BENCHMARK_OPERATIONS) * scale);
+		});
+	}
+	benchmarkRunner.add("SchedulerZeroDelay", BenchmarkKind::MICRO, "events", [](unsigned int scale) {
+		return runSchedulerZeroDelay(static_cast<uint64_t>(MICRO_BENCHMARK_OPERATIONS) * scale);
+	});
+	benchmarkRunner.add("FacilityRequestRelease", BenchmarkKind::MICRO, "tokens", [](unsigned int scale) {
+		return runFacilityRequestRelease(static_cast<uint64_t>(MICRO_BENCHMARK_OPERATIONS) * scale);
+	});
+	benchmarkRunner.add("LinkTransmitPropagate", BenchmarkKind::MICRO, "PDUs", [](unsigned int scale) {
+		return runLinkTransmitPropagate(static_cast<uint64_t>(MICRO_BENCHMARK_OPERATIONS) * scale);
+	});
+	benchmarkRunner.add("ExponentialVariates/SharedEngine", BenchmarkKind::MICRO, "variates", [](unsigned int scale) {
+		return runExponentialVariates(false, static_cast<uint64_t>(MICRO_BENCHMARK_OPERATIONS) * 5 * scale);
+	});
+	benchmarkRunner.add("ExponentialVariates/OwnStream", BenchmarkKind::MICRO, "variates", [](unsigned int scale) {
+		return runExponentialVariates(true, static_cast<uint64_t>(MICRO_BENCHMARK_OPERATIONS) * 5 * scale);
+	});
+	benchmarkRunner.add("AutonomousGenerators", BenchmarkKind::MICRO, "events", [](unsigned int scale) {
+		return runAutonomousGenerators(static_cast<uint64_t>(MICRO_BENCHMARK_OPERATIONS) * scale);
+	});
+}
@@ -0,0 +1,90 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// QcnSimBenchmark.cpp : Runs the micro- and macro-benchmarks and writes their rates as JSON.
+//
+
+#include "BenchmarkRunner.h"
+#include "MicroBenchmarks.h"
+#include "MacroBenchmarks.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Run the benchmarks.
+ *
+ * @details
+ * Usage: QcnSimBenchmark [--filter <text>] [--scale <factor>] [--repetitions <count>] [--output <JSON file>] [--baseline <JSON file>]
+ * [--tolerance <fraction>]
+ *
+ * Results go to the output file (default: standard output). With a baseline, the results are compared with it and the exit code is 2 if
+ * some benchmark regressed by more than the tolerance (default BENCHMARK_REGRESSION_TOLERANCE).
+ *
+ * @return 0 if done; 1 upon bad arguments or output file; 2 upon regression.
+ */
+int main(int argc, char *argv[]) {
+	std::string filter;
+	std::string outputFileName;
+	std::string baselineFileName;
+	unsigned long scale = 1;
+	unsigned long repetitions = BENCHMARK_REPETITIONS;
+	double tolerance = BENCHMARK_REGRESSION_TOLERANCE;
+	for (int argumentIndex = 1; argumentIndex < argc; argumentIndex += 2) {
+		if (argumentIndex + 1 >= argc) {
+			std::cout << "Missing value of " << argv[argumentIndex] << "." << std::endl;
+			return 1;
+		}
+		std::string value = argv[argumentIndex + 1];
+		if (std::strcmp(argv[argumentIndex], "--filter") == 0) {
+			filter = value;
+		} else if (std::strcmp(argv[argumentIndex], "--scale") == 0) {
+			scale = std::stoul(value);
+		} else if (std::strcmp(argv[argumentIndex], "--repetitions") == 0) {
+			repetitions = std::stoul(value);
+		} else if (std::strcmp(argv[argumentIndex], "--output") == 0) {
+			outputFileName = value;
+		} else if (std::strcmp(argv[argumentIndex], "--baseline") == 0) {
+			baselineFileName = value;
+		} else if (std::strcmp(argv[argumentIndex], "--tolerance") == 0) {
+			tolerance = std::stod(value);
+		} else {
+			std::cout << "Usage: " << argv[0] << " [--filter <text>] [--scale <factor>] [--repetitions <count>] [--output <JSON file>]"
+				" [--baseline <JSON file>] [--tolerance <fraction>]" << std::endl;
+			return 1;
+		}
+	}
+
+	BenchmarkRunner benchmarkRunner(static_cast<unsigned int>(scale), static_cast<unsigned int>(repetitions));
+	registerMicroBenchmarks(benchmarkRunner);
+	registerMacroBenchmarks(benchmarkRunner);
+	benchmarkRunner.setFilter(filter);
+	// Progress to standard error, such that standard output holds just the JSON when no output file is given.
+	benchmarkRunner.run(std::cerr);
+
+	if (outputFileName.empty()) {
+		benchmarkRunner.writeJson(std::cout);
+	} else {
+		std::ofstream outputFile(outputFileName);
+		if (!outputFile) {
+			std::cout << "Could not open " << outputFileName << "." << std::endl;
+			return 1;
+		}
+		benchmarkRunner.writeJson(outputFile);
+	}
+	if (!baselineFileName.empty() && !benchmarkRunner.compareWithBaseline(baselineFileName, tolerance, std::cerr)) {
+		return 2;
+	}
+	return 0;
+}
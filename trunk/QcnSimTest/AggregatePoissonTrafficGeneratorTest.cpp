@@ -0,0 +1,101 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "AggregatePoissonTrafficGeneratorTest.h"
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+AggregatePoissonTrafficGeneratorTest::AggregatePoissonTrafficGeneratorTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "AggregatePoissonTrafficGeneratorTest")),
+		scheduler(Scheduler(simulatorGlobals)), destination(std::make_shared<Message>("This is a dummy entity for destination.")),
+		tokenContents(std::make_shared<Message>("This is a dummy Token contents.")) {
+	simulatorGlobals.seedRandomNumberGenerator(1); // Use a fixed seed here for the tests.
+	for (int i = 0; i < 4; ++i) {
+		sources.push_back(std::make_shared<Message>("This is a dummy entity for source."));
+	}
+}
+
+/// Identical sources: aggregate rate and uniform choice of source, with one pending event.
+TEST_F(AggregatePoissonTrafficGeneratorTest, UniformSources) {
+	AggregatePoissonTrafficGenerator aggregateGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, sources, destination, 1, 4.0);
+	aggregateGenerator.setRandomStream(1);
+	EXPECT_DOUBLE_EQ(1.0, aggregateGenerator.getTau());
+	EXPECT_EQ(4, aggregateGenerator.getNumberOfSources());
+	EXPECT_EQ(nullptr, aggregateGenerator.createInstanceTrafficEvent()); // Off.
+	aggregateGenerator.turnOn();
+	int numberOfSamples = 40000;
+	std::vector<double> intervals;
+	std::map<const Entity*, int> sourceCounts;
+	for (int i = 0; i < numberOfSamples; ++i) {
+		std::shared_ptr<Token> token = aggregateGenerator.createInstanceTrafficEvent();
+		ASSERT_NE(nullptr, token);
+		EXPECT_EQ(destination, token->destination);
+		EXPECT_EQ(token->source, token->next);
+		++sourceCounts[token->source.get()];
+		EXPECT_EQ(1, scheduler.getChainSize());
+		intervals.push_back(scheduler.cause().occurAfterTime);
+	}
+	auto cdf = [](double x) {return GoodnessOfFit::exponentialCdf(x, 1.0);};
+	EXPECT_LE(GoodnessOfFit::kolmogorovSmirnovStatistic(intervals, cdf), GoodnessOfFit::kolmogorovSmirnovCriticalValue(intervals.size()));
+	ASSERT_EQ(4, sourceCounts.size());
+	for (auto &source : sources) {
+		EXPECT_NEAR(numberOfSamples / 4, sourceCounts[source.get()], numberOfSamples / 100);
+	}
+}
+
+/// Sources with individual rates: arrivals per source in proportion to the rates.
+TEST_F(AggregatePoissonTrafficGeneratorTest, WeightedSources) {
+	std::vector<double> sourceTaus = {1.0, 2.0, 4.0, 8.0};
+	AggregatePoissonTrafficGenerator aggregateGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, sources, destination, 1, sourceTaus);
+	aggregateGenerator.setRandomStream(2);
+	EXPECT_DOUBLE_EQ(1.0 / 1.875, aggregateGenerator.getTau());
+	aggregateGenerator.turnOn();
+	int numberOfSamples = 60000;
+	std::vector<double> intervals;
+	std::map<const Entity*, int> sourceCounts;
+	for (int i = 0; i < numberOfSamples; ++i) {
+		std::shared_ptr<ProtocolDataUnit> pdu = aggregateGenerator.createInstanceTrafficEventPdu(100);
+		ASSERT_NE(nullptr, pdu);
+		++sourceCounts[pdu->source.get()];
+		intervals.push_back(scheduler.cause().occurAfterTime);
+	}
+	double tau = aggregateGenerator.getTau();
+	auto cdf = [tau](double x) {return GoodnessOfFit::exponentialCdf(x, tau);};
+	EXPECT_LE(GoodnessOfFit::kolmogorovSmirnovStatistic(intervals, cdf), GoodnessOfFit::kolmogorovSmirnovCriticalValue(intervals.size()));
+	for (std::vector<double>::size_type i = 0; i < sources.size(); ++i) {
+		double expectedCount = numberOfSamples * (1 / sourceTaus[i]) / 1.875;
+		EXPECT_NEAR(expectedCount, sourceCounts[sources[i].get()], numberOfSamples / 100) << "source " << i;
+	}
+}
+
+/// Autonomous mode: the source is picked when the arrival is materialized.
+TEST_F(AggregatePoissonTrafficGeneratorTest, Autonomous) {
+	AggregatePoissonTrafficGenerator aggregateGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, sources, destination, 1, 4.0);
+	EXPECT_TRUE(aggregateGenerator.turnOnAutonomous());
+	std::map<const Entity*, int> sourceCounts;
+	for (int i = 0; i < 1000; ++i) {
+		Event event = scheduler.cause();
+		EXPECT_EQ(&aggregateGenerator, event.entity.get());
+		std::shared_ptr<ProtocolDataUnit> pdu = aggregateGenerator.materializePdu(100);
+		ASSERT_NE(nullptr, pdu);
+		++sourceCounts[pdu->source.get()];
+	}
+	EXPECT_EQ(1, scheduler.getChainSize());
+	EXPECT_EQ(4, sourceCounts.size());
+	EXPECT_EQ(1000, aggregateGenerator.getTokensGeneratedCount());
+	aggregateGenerator.turnOff();
+	EXPECT_EQ(0, scheduler.getChainSize());
+}
@@ -0,0 +1,164 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "DetectionEngineTest.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+DetectionEngineTest::DetectionEngineTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "DetectionEngineTest")), scheduler(Scheduler(simulatorGlobals)) {
+}
+
+/**
+ * Deliver a trigger to the engine at the given time.
+ */
+std::shared_ptr<DetectionData> DetectionEngineTest::deliver(DetectionEngine &detectionEngine, double deliveryTime, unsigned int sensorId, double latitude,
+		double longitude, double eventTime) {
+	simulatorGlobals.setCurrentAbsoluteTime(deliveryTime);
+	return detectionEngine.ingest(std::make_shared<SeismicEventData>(sensorId, latitude, longitude, 5.0, eventTime, 0.0, 1));
+}
+
+/// N triggers within R Km in T seconds declare a detection, scheduled with its latency metrics.
+TEST_F(DetectionEngineTest, Detection) {
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, 4, 50.0, 5.0);
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 10.5, 1, 34.00, -118.00, 10.0));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 11.0, 2, 34.10, -118.10, 10.2));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 11.5, 3, 34.20, -117.90, 10.4));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 11.6, 4, 36.00, -118.00, 10.5)); // 220 Km away.
+	EXPECT_EQ(0, scheduler.getChainSize());
+	std::shared_ptr<DetectionData> detectionData = deliver(detectionEngine, 12.0, 5, 33.90, -118.05, 10.6);
+	ASSERT_NE(nullptr, detectionData);
+	EXPECT_EQ(1, detectionData->detectionId);
+	ASSERT_EQ(4, detectionData->triggers.size());
+	EXPECT_EQ(1, detectionData->triggers[0]->qcnExplorerSensorId);
+	EXPECT_EQ(5, detectionData->triggers[3]->qcnExplorerSensorId);
+	EXPECT_DOUBLE_EQ(12.0, detectionData->detectionTime);
+	EXPECT_DOUBLE_EQ(10.0, detectionData->firstTriggerTime);
+	EXPECT_DOUBLE_EQ(2.0, detectionData->getDetectionLatency());
+	EXPECT_NEAR((0.5 + 0.8 + 1.1 + 1.4) / 4.0, detectionData->meanDeliveryLatency, 1e-12);
+	EXPECT_NEAR(34.05, detectionData->latitude, 1e-12);
+	EXPECT_NEAR(-118.0125, detectionData->longitude, 1e-12);
+	Event event = scheduler.cause();
+	EXPECT_EQ(EventType::EARTHQUAKE_DETECTION, event.eventType);
+	EXPECT_EQ(detectionData, event.entity);
+	EXPECT_DOUBLE_EQ(12.0, simulatorGlobals.getCurrentAbsoluteTime());
+
+	// Later triggers of the same earthquake, even as the wavefront moves on, belong to the detection.
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 12.5, 6, 34.45, -118.00, 11.0));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 12.6, 7, 34.85, -118.00, 12.0));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 12.7, 8, 35.25, -118.00, 13.0));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 12.8, 9, 35.65, -118.00, 14.0));
+	EXPECT_EQ(1, detectionEngine.getDetectionsCount());
+	EXPECT_EQ(4, detectionEngine.getAssociatedTriggersCount());
+	EXPECT_EQ(9, detectionEngine.getTriggersCount());
+	EXPECT_DOUBLE_EQ(2.0, detectionEngine.getMeanDetectionLatency());
+}
+
+/// Triggers too far apart in space or time do not declare detections; old triggers leave the window.
+TEST_F(DetectionEngineTest, WindowAndSeparation) {
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, 3, 30.0, 5.0);
+	// Spread along a line, 50 Km apart.
+	for (unsigned int i = 0; i < 10; ++i) {
+		EXPECT_EQ(nullptr, deliver(detectionEngine, 1.0 + i * 0.1, i, 40.0, -100.0 + i * 0.59, 1.0));
+	}
+	EXPECT_EQ(10, detectionEngine.getWindowSize());
+	// Close in space, 6 seconds apart.
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 3.0, 100, -20.0, 150.0, 2.0));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 9.0, 101, -20.0, 150.01, 8.0));
+	EXPECT_EQ(1, detectionEngine.getWindowSize()); // Triggers before time 3.0 left the window.
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 15.0, 102, -20.0, 150.02, 14.0));
+	EXPECT_EQ(1, detectionEngine.getWindowSize());
+	// Delivered too late to be associated.
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 16.0, 103, -20.0, 150.03, 8.5));
+	EXPECT_EQ(1, detectionEngine.getStaleTriggersCount());
+	EXPECT_EQ(0, detectionEngine.getDetectionsCount());
+	EXPECT_DOUBLE_EQ(0.0, detectionEngine.getMeanDetectionLatency());
+	// Near the pole and near the cell boundaries, neighbors are still found.
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 17.0, 200, 88.0, 10.0, 15.0));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 17.0, 201, 88.05, 12.0, 15.0));
+	EXPECT_NE(nullptr, deliver(detectionEngine, 17.0, 202, 87.9, 7.0, 15.0));
+}
+
+/// Triggers on both sides of the antimeridian are associated, with the centroid on the antimeridian.
+TEST_F(DetectionEngineTest, Antimeridian) {
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, 4, 50.0, 5.0);
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 1.0, 1, -17.0, 179.9, 0.5));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 1.1, 2, -17.0, -179.9, 0.5));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 1.2, 3, -17.1, 179.95, 0.5));
+	std::shared_ptr<DetectionData> detectionData = deliver(detectionEngine, 1.3, 4, -17.1, -179.95, 0.5);
+	ASSERT_NE(nullptr, detectionData);
+	EXPECT_EQ(4, detectionData->triggers.size());
+	EXPECT_NEAR(-17.05, detectionData->latitude, 1e-9);
+	EXPECT_NEAR(180.0, std::abs(detectionData->longitude), 1e-9);
+	// A later trigger across the antimeridian belongs to the detection.
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 1.4, 5, -17.2, 179.8, 1.0));
+	EXPECT_EQ(1, detectionEngine.getAssociatedTriggersCount());
+}
+
+/// A radius of zero is raised to DETECTION_MINIMUM_RADIUS: only co-located triggers are associated.
+TEST_F(DetectionEngineTest, ZeroRadius) {
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, 2, 0.0, 5.0);
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 1.0, 1, 34.0, -118.0, 0.5));
+	EXPECT_EQ(nullptr, deliver(detectionEngine, 1.1, 2, 34.01, -118.0, 0.5));
+	EXPECT_NE(nullptr, deliver(detectionEngine, 1.2, 3, 34.0, -118.0, 0.5));
+	EXPECT_EQ(1, detectionEngine.getDetectionsCount());
+}
+
+/// Simultaneous earthquakes far apart are detected separately.
+TEST_F(DetectionEngineTest, SeparateEarthquakes) {
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, 3, 50.0, 10.0);
+	std::vector<std::pair<double, double>> epicenters = {{34.0, -118.0}, {38.0, -122.0}};
+	unsigned int detections = 0;
+	for (unsigned int i = 0; i < 6; ++i) {
+		auto &epicenter = epicenters[i % 2];
+		auto detectionData = deliver(detectionEngine, 1.0 + i * 0.1, i, epicenter.first + (i / 2) * 0.05, epicenter.second, 0.5);
+		if (detectionData != nullptr) {
+			++detections;
+			EXPECT_NEAR(epicenter.first + 0.05, detectionData->latitude, 1e-9);
+		}
+	}
+	EXPECT_EQ(2, detections);
+	EXPECT_EQ(2, scheduler.getChainSize());
+}
+
+/// Ingestion rate of background triggers (noise) spread over a continent.
+TEST_F(DetectionEngineTest, IngestionRate) {
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, 10, 50.0, 5.0);
+	std::mt19937 engine(2014);
+	std::uniform_real_distribution<double> latitudeDistribution(25.0, 50.0);
+	std::uniform_real_distribution<double> longitudeDistribution(-125.0, -65.0);
+	const unsigned int numberOfTriggers = 100000;
+	std::vector<std::shared_ptr<SeismicEventData>> triggers;
+	for (unsigned int i = 0; i < numberOfTriggers; ++i) {
+		double eventTime = i * 1e-5; // 100k triggers per second.
+		triggers.push_back(std::make_shared<SeismicEventData>(i, latitudeDistribution(engine), longitudeDistribution(engine), 3.0, eventTime, 0.0, 1));
+	}
+	auto startTime = std::chrono::steady_clock::now();
+	for (auto &trigger : triggers) {
+		simulatorGlobals.setCurrentAbsoluteTime(trigger->eventTime + 0.5);
+		detectionEngine.ingest(trigger);
+	}
+	double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "[ DETECTION] " << static_cast<unsigned int>(numberOfTriggers / elapsedTime) << " triggers/s" << std::endl;
+	RecordProperty("DetectionTriggersPerSecond", std::to_string(static_cast<unsigned int>(numberOfTriggers / elapsedTime)));
+	EXPECT_EQ(numberOfTriggers, detectionEngine.getTriggersCount());
+	EXPECT_EQ(0, detectionEngine.getStaleTriggersCount());
+}
@@ -32,6 +32,10 @@
 #include "../QcnSim/EventChainElement.h"
 #include "../QcnSim/Event.h"
 #include "../QcnSim/EventType.h"
+#include "../QcnSim/Link.h"
+#include "../QcnSim/ProtocolDataUnit.h"
+#include "../QcnSim/SeismicEventData.h"
+#include "../QcnSim/Token.h"
 #include <list>
 #include <queue>
 
@@ -131,4 +135,70 @@ TEST(EventTest, PriorityQueue) {
 	// Is the head element, elementFirst? It should not, since operator < overloading is not being "inverted" for priority_queue container.
 	EXPECT_FALSE(elementFirst == eventChain.top());
 
-}
\ No newline at end of file
+}
+/// Subclass of ProtocolDataUnit, without a payload tag of its own.
+class DerivedProtocolDataUnit: public ProtocolDataUnit {
+public:
+	DerivedProtocolDataUnit(std::shared_ptr<Token> token, unsigned int pduSize): ProtocolDataUnit(token, pduSize) {}
+};
+
+/// Tests the payload tags of typed entities and the typed access to entities.
+TEST(EventTest, EntityPayload) {
+	std::shared_ptr<Token> token = std::make_shared<Token>(1, 0, nullptr, nullptr, nullptr);
+	std::shared_ptr<ProtocolDataUnit> pdu = std::make_shared<ProtocolDataUnit>(token, 100);
+	std::shared_ptr<SeismicEventData> seismicEventData = std::make_shared<SeismicEventData>();
+
+	// Tags follow the class of the pointer, if it has a tag of its own.
+	Event pduEvent(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pdu);
+	EXPECT_EQ(EventPayloadType::PROTOCOL_DATA_UNIT, pduEvent.payloadType);
+	EXPECT_EQ(EventPayloadType::PROTOCOL_DATA_UNIT, Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, std::shared_ptr<const ProtocolDataUnit>(pdu)).payloadType);
+	EXPECT_EQ(EventPayloadType::TOKEN, Event(1.0, EventType::TRAFFIC_GENERATOR_ARRIVAL, token).payloadType);
+	EXPECT_EQ(EventPayloadType::TOKEN, Event(1.0, EventType::TRAFFIC_GENERATOR_ARRIVAL, std::shared_ptr<Token>(pdu)).payloadType);
+	EXPECT_EQ(EventPayloadType::SEISMIC_EVENT_DATA, Event(1.0, EventType::SEISMIC_EVENT_DETECTION, seismicEventData).payloadType);
+	EXPECT_EQ(EventPayloadType::ENTITY, Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, std::shared_ptr<const Entity>(pdu)).payloadType);
+	EXPECT_EQ(EventPayloadType::NO_PAYLOAD, Event(1.0, EventType::END_SIMULATION, nullptr).payloadType);
+	EXPECT_EQ(EventPayloadType::NO_PAYLOAD, Event(1.0, EventType::END_SIMULATION, std::shared_ptr<ProtocolDataUnit>()).payloadType);
+	// Pointers that do not own the entity, and link IDs.
+	std::shared_ptr<const ProtocolDataUnit> pduPointer(std::shared_ptr<const ProtocolDataUnit>(), pdu.get());
+	EXPECT_EQ(EventPayloadType::ENTITY_POINTER, Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pduPointer).payloadType);
+	EXPECT_EQ(pdu, Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pduPointer).getEntityAs<ProtocolDataUnit>());
+	Event linkEvent = Event::createLinkEvent(1.0, EventType::SET_LINK_DOWN, 7);
+	EXPECT_EQ(EventPayloadType::LINK_ID, linkEvent.payloadType);
+	EXPECT_EQ(7, linkEvent.linkId);
+	EXPECT_EQ(nullptr, linkEvent.getEntityAs<Link>());
+	EXPECT_NE(linkEvent, Event::createLinkEvent(1.0, EventType::SET_LINK_DOWN, 8));
+
+	// Typed access, tagged and untagged, to the same (non-const) object.
+	EXPECT_EQ(pdu, pduEvent.getEntityAs<ProtocolDataUnit>());
+	EXPECT_EQ(pdu, pduEvent.getEntityAs<Token>());
+	EXPECT_EQ(pdu, pduEvent.getEntityAs<const ProtocolDataUnit>());
+	EXPECT_EQ(pdu, Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, std::shared_ptr<const Entity>(pdu)).getEntityAs<ProtocolDataUnit>());
+	EXPECT_EQ(pdu, Event(1.0, EventType::TRAFFIC_GENERATOR_ARRIVAL, std::shared_ptr<Token>(pdu)).getEntityAs<ProtocolDataUnit>());
+	EXPECT_EQ(nullptr, pduEvent.getEntityAs<SeismicEventData>());
+	EXPECT_EQ(nullptr, Event(1.0, EventType::TRAFFIC_GENERATOR_ARRIVAL, token).getEntityAs<ProtocolDataUnit>());
+	EXPECT_EQ(seismicEventData, Event(1.0, EventType::SEISMIC_EVENT_DETECTION, seismicEventData).getEntityAs<SeismicEventData>());
+	EXPECT_EQ(nullptr, Event(1.0, EventType::END_SIMULATION, nullptr).getEntityAs<ProtocolDataUnit>());
+	pduEvent.getEntityAs<ProtocolDataUnit>()->setPduSize(200);
+	EXPECT_EQ(200, pdu->getPduSize());
+
+	// The tag is not part of the contents of the event.
+	EXPECT_EQ(pduEvent, Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, std::shared_ptr<const Entity>(pdu)));
+}
+
+/// Subclasses of tagged classes are untagged, and are never converted with a static cast from the tag of their base class.
+TEST(EventTest, DerivedEntityPayload) {
+	std::shared_ptr<Token> token = std::make_shared<Token>(1, 0, nullptr, nullptr, nullptr);
+	std::shared_ptr<ProtocolDataUnit> pdu = std::make_shared<ProtocolDataUnit>(token, 100);
+	std::shared_ptr<DerivedProtocolDataUnit> derivedPdu = std::make_shared<DerivedProtocolDataUnit>(token, 100);
+
+	Event derivedPduEvent(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, derivedPdu);
+	EXPECT_EQ(EventPayloadType::ENTITY, derivedPduEvent.payloadType);
+	EXPECT_EQ(derivedPdu, derivedPduEvent.getEntityAs<DerivedProtocolDataUnit>());
+	EXPECT_EQ(derivedPdu, derivedPduEvent.getEntityAs<ProtocolDataUnit>());
+	// A plain PDU tagged PROTOCOL_DATA_UNIT is not a DerivedProtocolDataUnit.
+	EXPECT_EQ(nullptr, Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pdu).getEntityAs<DerivedProtocolDataUnit>());
+	// A derived PDU scheduled as a ProtocolDataUnit is tagged as such, and still converts to its own class.
+	Event pduEvent(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, std::shared_ptr<ProtocolDataUnit>(derivedPdu));
+	EXPECT_EQ(EventPayloadType::PROTOCOL_DATA_UNIT, pduEvent.payloadType);
+	EXPECT_EQ(derivedPdu, pduEvent.getEntityAs<DerivedProtocolDataUnit>());
+}
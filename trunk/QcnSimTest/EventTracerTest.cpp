@@ -0,0 +1,161 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventTracerTest.h"
+#include <cstdio>
+#include <fstream>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+EventTracerTest::EventTracerTest(): traceFileName("EventTracerTest.bin") {
+}
+
+/**
+ * Destructor.
+ *
+ * Remove the trace file.
+ */
+EventTracerTest::~EventTracerTest() {
+	eventTracer.stop();
+	std::remove(traceFileName.c_str());
+}
+
+/// Records are written in order, with their fields, and read back; nothing is recorded before start() or after stop().
+TEST_F(EventTracerTest, RecordAndRead) {
+	eventTracer.record(0.5, EventType::BEGIN_SIMULATION, TraceEntityKind::NODE, 1, 1);
+	EXPECT_FALSE(eventTracer.isRecording());
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, eventTracer.start(traceFileName));
+	EXPECT_TRUE(eventTracer.isRecording());
+	eventTracer.record(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, TraceEntityKind::NODE, 3, 17, TraceOutcome::FORWARDED);
+	eventTracer.record(1.25, EventType::END_PROPAGATION_AT_LINK, TraceEntityKind::NODE, 4, 17, TraceOutcome::FUSED);
+	eventTracer.record(2.0, EventType::END_SIMULATION, TraceEntityKind::NO_ENTITY, EVENT_TRACE_NO_ENTITY, 0);
+	eventTracer.record(2.5, EventType::SEISMIC_EVENT_DETECTION, TraceEntityKind::SENSOR, 3, 0, TraceOutcome::DROPPED);
+	EXPECT_EQ(4, eventTracer.getRecordsCount());
+	eventTracer.stop();
+	EXPECT_FALSE(eventTracer.isRecording());
+	eventTracer.record(3.0, EventType::END_SIMULATION, TraceEntityKind::NO_ENTITY, 0, 0);
+
+	std::vector<EventTraceRecord> traceRecords;
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, EventTracer::readTrace(traceFileName, traceRecords));
+	ASSERT_EQ(4, traceRecords.size());
+	EXPECT_EQ(1.0, traceRecords[0].time);
+	EXPECT_EQ(static_cast<uint16_t>(EventType::PDUTOKEN_ARRIVAL_AT_NODE), traceRecords[0].eventType);
+	EXPECT_EQ(static_cast<uint8_t>(TraceEntityKind::NODE), traceRecords[0].entityKind);
+	EXPECT_EQ(3, traceRecords[0].entityId);
+	EXPECT_EQ(17, traceRecords[0].tokenId);
+	EXPECT_EQ(static_cast<uint16_t>(TraceOutcome::FORWARDED), traceRecords[0].outcome);
+	EXPECT_EQ(1.25, traceRecords[1].time);
+	EXPECT_EQ(static_cast<uint16_t>(EventType::END_SIMULATION), traceRecords[2].eventType);
+	EXPECT_EQ(static_cast<uint16_t>(TraceOutcome::HANDLED), traceRecords[2].outcome);
+	// Node 3 and sensor 3 are different entities.
+	EXPECT_EQ(static_cast<uint8_t>(TraceEntityKind::SENSOR), traceRecords[3].entityKind);
+	EXPECT_EQ(3, traceRecords[3].entityId);
+	EXPECT_EQ("1.000000000 PDUTOKEN_ARRIVAL_AT_NODE entity=node:3 token=17 FORWARDED", EventTracer::formatRecord(traceRecords[0]));
+	EXPECT_EQ("1.250000000 END_PROPAGATION_AT_LINK entity=node:4 token=17 FUSED", EventTracer::formatRecord(traceRecords[1]));
+	EXPECT_EQ("2.000000000 END_SIMULATION entity=- token=0 HANDLED", EventTracer::formatRecord(traceRecords[2]));
+	EXPECT_EQ("2.500000000 SEISMIC_EVENT_DETECTION entity=sensor:3 token=0 DROPPED", EventTracer::formatRecord(traceRecords[3]));
+}
+
+/// A token crossing several nodes is traced with each node as entity.
+TEST_F(EventTracerTest, MultiNodeTrace) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "EventTracerTest");
+	std::vector<std::shared_ptr<Entity>> nodes;
+	for (unsigned int nodeId : {1, 10, 888}) {
+		nodes.push_back(std::make_shared<Node>(simulatorGlobals, nodeId));
+	}
+	std::shared_ptr<Token> token = std::make_shared<Token>(simulatorGlobals, 1, nullptr, nodes.front(), nodes.back());
+	token->setExplicitRoute(nodes);
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, eventTracer.start(traceFileName));
+	std::shared_ptr<Node> hop = std::dynamic_pointer_cast<Node>(nodes.front());
+	for (unsigned int i = 0; i < nodes.size(); ++i) {
+		// As in the drivers, the traced entity is the node the token is at.
+		bool isDelivered = hop->processAndForward(token) == NodeReturnType::FINAL_DESTINATION;
+		eventTracer.record(i * 0.5, EventType::PDUTOKEN_ARRIVAL_AT_NODE, TraceEntityKind::NODE, hop->getNodeId(), token->id,
+			isDelivered ? TraceOutcome::DELIVERED : TraceOutcome::FORWARDED);
+		hop = std::dynamic_pointer_cast<Node>(token->next);
+	}
+	eventTracer.stop();
+
+	std::vector<EventTraceRecord> traceRecords;
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, EventTracer::readTrace(traceFileName, traceRecords));
+	ASSERT_EQ(3, traceRecords.size());
+	EXPECT_EQ(1, traceRecords[0].entityId);
+	EXPECT_EQ(10, traceRecords[1].entityId);
+	EXPECT_EQ(888, traceRecords[2].entityId);
+	EXPECT_EQ(static_cast<uint8_t>(TraceEntityKind::NODE), traceRecords[2].entityKind);
+	EXPECT_EQ(static_cast<uint16_t>(TraceOutcome::DELIVERED), traceRecords[2].outcome);
+	EXPECT_EQ(token->id, traceRecords[2].tokenId);
+}
+
+/// Records are filtered by event type and by entity, of the given kind only.
+TEST_F(EventTracerTest, Filters) {
+	eventTracer.setAllEventTypesFilter(false);
+	eventTracer.setEventTypeFilter(EventType::PDUTOKEN_ARRIVAL_AT_NODE, true);
+	eventTracer.setEventTypeFilter(EventType::END_SIMULATION, true);
+	eventTracer.setEventTypeFilter(EventType::END_SIMULATION, false);
+	eventTracer.addEntityFilter(TraceEntityKind::NODE, 7);
+	eventTracer.addEntityFilter(TraceEntityKind::NODE, 2);
+	eventTracer.addEntityFilter(TraceEntityKind::NODE, 7);
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, eventTracer.start(traceFileName));
+	for (uint32_t entityId = 0; entityId < 10; ++entityId) {
+		eventTracer.record(entityId, EventType::PDUTOKEN_ARRIVAL_AT_NODE, TraceEntityKind::NODE, entityId, 0);
+		eventTracer.record(entityId, EventType::PDUTOKEN_ARRIVAL_AT_NODE, TraceEntityKind::SENSOR, entityId, 0);
+		eventTracer.record(entityId, EventType::END_PROPAGATION_AT_LINK, TraceEntityKind::NODE, entityId, 0);
+		eventTracer.record(entityId, EventType::END_SIMULATION, TraceEntityKind::NODE, entityId, 0);
+	}
+	eventTracer.clearEntityFilter();
+	eventTracer.record(20.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, TraceEntityKind::SENSOR, 20, 0);
+	eventTracer.stop();
+	EXPECT_EQ(3, eventTracer.getRecordsCount());
+
+	std::vector<EventTraceRecord> traceRecords;
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, EventTracer::readTrace(traceFileName, traceRecords));
+	ASSERT_EQ(3, traceRecords.size());
+	EXPECT_EQ(2, traceRecords[0].entityId);
+	EXPECT_EQ(7, traceRecords[1].entityId);
+	EXPECT_EQ(static_cast<uint8_t>(TraceEntityKind::NODE), traceRecords[1].entityKind);
+	EXPECT_EQ(20, traceRecords[2].entityId);
+	EXPECT_EQ(static_cast<uint8_t>(TraceEntityKind::SENSOR), traceRecords[2].entityKind);
+}
+
+/// A small ring buffer wraps around many times; the writer thread keeps up, and no record is lost or reordered.
+TEST_F(EventTracerTest, RingBufferWrapAround) {
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, eventTracer.start(traceFileName, 50));
+	for (uint32_t tokenId = 0; tokenId < 20000; ++tokenId) {
+		eventTracer.record(tokenId * 0.001, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, TraceEntityKind::NODE, tokenId % 7, tokenId);
+	}
+	eventTracer.stop();
+	EXPECT_EQ(20000, eventTracer.getRecordsCount());
+
+	std::vector<EventTraceRecord> traceRecords;
+	ASSERT_EQ(TraceReturnType::TRACE_OPENED, EventTracer::readTrace(traceFileName, traceRecords));
+	ASSERT_EQ(20000, traceRecords.size());
+	for (uint32_t tokenId = 0; tokenId < 20000; ++tokenId) {
+		ASSERT_EQ(tokenId, traceRecords[tokenId].tokenId);
+		ASSERT_EQ(tokenId % 7, traceRecords[tokenId].entityId);
+	}
+}
+
+/// Missing files and files that are not event traces are rejected.
+TEST_F(EventTracerTest, InvalidTrace) {
+	std::vector<EventTraceRecord> traceRecords;
+	EXPECT_EQ(TraceReturnType::FILE_NOT_FOUND, EventTracer::readTrace("NoSuchEventTrace.bin", traceRecords));
+	std::ofstream traceFile(traceFileName);
+	traceFile << "QCNTRACE not an event trace";
+	traceFile.close();
+	EXPECT_EQ(TraceReturnType::INVALID_TRACE, EventTracer::readTrace(traceFileName, traceRecords));
+	EXPECT_TRUE(traceRecords.empty());
+}
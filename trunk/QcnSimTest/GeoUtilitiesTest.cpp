@@ -0,0 +1,44 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../gtest/include/gtest/gtest.h"
+#include "../QcnSim/GeoUtilities.h"
+#include <cmath>
+
+/// Unit vectors of the poles, the equator and an arbitrary location.
+TEST(GeoUtilitiesTest, UnitVector) {
+	double coordinates[3];
+	GeoUtilities::toUnitVector(90.0, 0.0, coordinates);
+	EXPECT_NEAR(0.0, coordinates[0], 1e-15);
+	EXPECT_NEAR(0.0, coordinates[1], 1e-15);
+	EXPECT_DOUBLE_EQ(1.0, coordinates[2]);
+	GeoUtilities::toUnitVector(0.0, 90.0, coordinates);
+	EXPECT_NEAR(0.0, coordinates[0], 1e-15);
+	EXPECT_DOUBLE_EQ(1.0, coordinates[1]);
+	EXPECT_DOUBLE_EQ(0.0, coordinates[2]);
+	GeoUtilities::toUnitVector(37.5, -121.25, coordinates);
+	EXPECT_DOUBLE_EQ(1.0, coordinates[0] * coordinates[0] + coordinates[1] * coordinates[1] + coordinates[2] * coordinates[2]);
+	EXPECT_DOUBLE_EQ(std::sin(37.5 * GEO_DEGREES_TO_RADIANS), coordinates[2]);
+}
+
+/// Great-circle distances along a meridian, along the equator, between antipodes, and their symmetry.
+TEST(GeoUtilitiesTest, GreatCircleDistance) {
+	double oneDegree = EARTH_RADIUS * GEO_DEGREES_TO_RADIANS;
+	EXPECT_NEAR(111.195, oneDegree, 0.001);
+	EXPECT_DOUBLE_EQ(0.0, GeoUtilities::greatCircleDistance(36.0, -120.0, 36.0, -120.0));
+	EXPECT_NEAR(oneDegree, GeoUtilities::greatCircleDistance(36.0, -120.0, 37.0, -120.0), 1e-9);
+	EXPECT_NEAR(10.0 * oneDegree, GeoUtilities::greatCircleDistance(0.0, 175.0, 0.0, -175.0), 1e-9); // Across the antimeridian.
+	EXPECT_NEAR(GEO_PI * EARTH_RADIUS, GeoUtilities::greatCircleDistance(45.0, 10.0, -45.0, -170.0), 1e-6);
+	EXPECT_DOUBLE_EQ(GeoUtilities::greatCircleDistance(34.0, -118.0, 40.7, -74.0), GeoUtilities::greatCircleDistance(40.7, -74.0, 34.0, -118.0));
+}
@@ -0,0 +1,130 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "HostAvailabilityModelTest.h"
+#include <cmath>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+HostAvailabilityModelTest::HostAvailabilityModelTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "HostAvailabilityModelTest")),
+		scheduler(Scheduler(simulatorGlobals)) {
+	simulatorGlobals.seedRandomNumberGenerator(2014);
+}
+
+/**
+ * Create a sensor with the given availability fractions.
+ */
+std::shared_ptr<QcnSensorTrafficGenerator> HostAvailabilityModelTest::createSensor(unsigned int sensorId, double onFraction, double connectedFraction,
+		double activeFraction) {
+	auto sensor = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, nullptr,
+		nullptr, 1, 0.0, 0.0, sensorId);
+	QcnSensorParameters sensorParameters;
+	sensorParameters.onFraction = onFraction;
+	sensorParameters.connectedFraction = connectedFraction;
+	sensorParameters.activeFraction = activeFraction;
+	sensor->setSensorParameters(sensorParameters);
+	return sensor;
+}
+
+/// Hosts are up the fractions of time of their parameters, with a single event in the event chain.
+TEST_F(HostAvailabilityModelTest, StationaryFractions) {
+	HostAvailabilityModel hostAvailabilityModel(simulatorGlobals, scheduler);
+	const unsigned int numberOfHosts = 2000;
+	for (unsigned int sensorId = 0; sensorId < numberOfHosts; ++sensorId) {
+		// Half of the hosts with other fractions, such that thinning rejects candidates.
+		hostAvailabilityModel.addSensor(sensorId % 2 == 0 ? createSensor(sensorId, 0.8, 0.5, 0.9) : createSensor(sensorId, 0.6, 0.5, 0.7));
+	}
+	hostAvailabilityModel.setMeanCycle(HostAvailabilityModel::HostState::ON, 20.0);
+	hostAvailabilityModel.setMeanCycle(HostAvailabilityModel::HostState::CONNECTED, 10.0);
+	hostAvailabilityModel.setMeanCycle(HostAvailabilityModel::HostState::ACTIVE, 10.0);
+	hostAvailabilityModel.start();
+	EXPECT_EQ(numberOfHosts, hostAvailabilityModel.getNumberOfHosts());
+	EXPECT_EQ(1, scheduler.getChainSize());
+	EXPECT_NEAR(0.7, hostAvailabilityModel.getHostsUpCount(HostAvailabilityModel::HostState::ON) / static_cast<double>(numberOfHosts), 0.05);
+
+	HostAvailabilityModel::HostState states[] = {HostAvailabilityModel::HostState::ON, HostAvailabilityModel::HostState::CONNECTED,
+		HostAvailabilityModel::HostState::ACTIVE};
+	double expectedFractions[] = {0.7, 0.5, 0.8};
+	double upTimes[3] = {0.0, 0.0, 0.0};
+	double lastTime = 0.0;
+	while (simulatorGlobals.getCurrentAbsoluteTime() < 200.0) {
+		Event event = scheduler.cause();
+		for (int state = 0; state < 3; ++state) {
+			upTimes[state] += hostAvailabilityModel.getHostsUpCount(states[state]) * (simulatorGlobals.getCurrentAbsoluteTime() - lastTime);
+		}
+		lastTime = simulatorGlobals.getCurrentAbsoluteTime();
+		ASSERT_EQ(EventType::HOST_AVAILABILITY_TRANSITION, event.eventType);
+		EXPECT_EQ(&hostAvailabilityModel, event.entity.get());
+		hostAvailabilityModel.processTransition();
+		ASSERT_EQ(1, scheduler.getChainSize());
+	}
+	for (int state = 0; state < 3; ++state) {
+		EXPECT_NEAR(expectedFractions[state], upTimes[state] / (lastTime * numberOfHosts), 0.02) << "State " << state;
+	}
+	// Thinning: 2000 hosts, each flipping about every 4 to 16 seconds per state, over 200 seconds.
+	EXPECT_GT(hostAvailabilityModel.getTransitionsCount(), 100000);
+	EXPECT_LT(hostAvailabilityModel.getTransitionsCount(), hostAvailabilityModel.getCandidateTransitionsCount());
+
+	hostAvailabilityModel.stop();
+	EXPECT_EQ(0, scheduler.getChainSize());
+}
+
+/// Hosts always available never change state, and their triggers are delivered.
+TEST_F(HostAvailabilityModelTest, AlwaysAvailable) {
+	HostAvailabilityModel hostAvailabilityModel(simulatorGlobals, scheduler);
+	hostAvailabilityModel.addSensor(createSensor(1, 1.0, 1.0, 1.0));
+	hostAvailabilityModel.addSensor(createSensor(2, 0.0, 1.0, 1.0));
+	auto trigger = std::make_shared<SeismicEventData>(1, 0.0, 0.0, 5.0, 1.0, 10.0, 1);
+	auto unknownSensorTrigger = std::make_shared<SeismicEventData>(99, 0.0, 0.0, 5.0, 1.0, 10.0, 1);
+	auto offHostTrigger = std::make_shared<SeismicEventData>(2, 0.0, 0.0, 5.0, 1.0, 10.0, 1);
+	EXPECT_EQ(TriggerDisposition::DELIVER, hostAvailabilityModel.filterTrigger(offHostTrigger)); // Not started.
+	hostAvailabilityModel.start();
+	EXPECT_TRUE(std::isinf(hostAvailabilityModel.nextOccurAfterTime()));
+	EXPECT_TRUE(hostAvailabilityModel.isHostUp(HostAvailabilityModel::HostState::ON, 1));
+	EXPECT_FALSE(hostAvailabilityModel.isHostUp(HostAvailabilityModel::HostState::ON, 2));
+	EXPECT_EQ(TriggerDisposition::DELIVER, hostAvailabilityModel.filterTrigger(trigger));
+	EXPECT_EQ(TriggerDisposition::DELIVER, hostAvailabilityModel.filterTrigger(unknownSensorTrigger));
+	EXPECT_EQ(TriggerDisposition::DROP, hostAvailabilityModel.filterTrigger(offHostTrigger));
+	EXPECT_EQ(1, hostAvailabilityModel.getDroppedTriggersCount());
+	EXPECT_FALSE(hostAvailabilityModel.processTransition());
+}
+
+/// Triggers of disconnected hosts are buffered and scheduled again when the host connects.
+TEST_F(HostAvailabilityModelTest, BufferedTriggers) {
+	HostAvailabilityModel hostAvailabilityModel(simulatorGlobals, scheduler);
+	hostAvailabilityModel.addSensor(createSensor(1, 1.0, 0.5, 1.0));
+	hostAvailabilityModel.start();
+	// Run until the host is disconnected.
+	while (hostAvailabilityModel.isHostUp(HostAvailabilityModel::HostState::CONNECTED, 1)) {
+		scheduler.cause();
+		hostAvailabilityModel.processTransition();
+	}
+	auto trigger = std::make_shared<SeismicEventData>(1, 0.0, 0.0, 5.0, simulatorGlobals.getCurrentAbsoluteTime(), 10.0, 1);
+	EXPECT_EQ(TriggerDisposition::BUFFER, hostAvailabilityModel.filterTrigger(trigger));
+	EXPECT_EQ(1, hostAvailabilityModel.getBufferedTriggersCount());
+	Event event;
+	do {
+		event = scheduler.cause();
+		if (event.eventType == EventType::HOST_AVAILABILITY_TRANSITION) {
+			hostAvailabilityModel.processTransition();
+		}
+	} while (event.eventType == EventType::HOST_AVAILABILITY_TRANSITION);
+	EXPECT_EQ(EventType::SEISMIC_EVENT_DETECTION, event.eventType);
+	EXPECT_EQ(trigger, event.entity);
+	EXPECT_TRUE(hostAvailabilityModel.isHostUp(HostAvailabilityModel::HostState::CONNECTED, 1));
+	EXPECT_EQ(TriggerDisposition::DELIVER, hostAvailabilityModel.filterTrigger(trigger));
+}
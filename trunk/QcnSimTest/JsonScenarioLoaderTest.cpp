@@ -0,0 +1,177 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "JsonScenarioLoaderTest.h"
+
+const std::string JsonScenarioLoaderTest::exampleScenario = R"({
+    "parameters": { "simName": "testSim", "simDesc": "", "initalClock": 10000, "endClock": 10100, "printTraces": false, "startRecTime": 10050 },
+    "earthquakes": [
+        { "ID": "1", "magnitude": "6.5", "time": "10", "swaveSpeed": "10", "depth": "15",
+          "location": { "lat": "40.463666324587685", "lng": "-75.95878601074219" } }
+    ],
+    "sensors": [
+        { "ID": "2", "onFrac": "0.9", "connFrac": "0.78", "actFrac": "0.9", "flaseTrigRate": "6.63", "trigLowerBound": "0.098",
+          "trigUpperBound": "0.196", "trigProb": "0.5", "pduSize": "1000",
+          "location": { "lat": "41.934976500546604", "lng": "-77.21122741699219" },
+          "routes": [ [ "4", "5" ] ] },
+        { "ID": "3", "onFrac": "0.9", "connFrac": "0.78", "actFrac": "0.89", "flaseTrigRate": "6.63", "trigLowerBound": "0.098",
+          "trigUpperBound": "0.196", "trigProb": "0.5",
+          "location": { "lat": "41.75492216766298", "lng": "-77.98027038574219" },
+          "routes": [ [ "4", "5" ], [ "8", "4", "5" ] ] }
+    ],
+    "nodes": [
+        { "ID": "4", "location": { "lat": "41.75492216766298", "lng": "-78.98027038574219" } },
+        { "ID": "5", "location": { "lat": "42.75492216766298", "lng": "-77.98027038574219" } },
+        { "ID": "8", "location": { "lat": "42.75492216766298", "lng": "-77.98027038574219" } }
+    ],
+    "links": [
+        { "ID": "6", "src": "2", "dest": "4", "bandwidth": "10", "medium": "wireless" },
+        { "ID": "7", "src": "4", "dest": "5", "bandwidth": "100", "medium": "fiber" },
+        { "ID": "9", "src": "3", "dest": "8", "bandwidth": "2", "medium": "wireless" },
+        { "ID": "10", "src": "8", "dest": "4", "bandwidth": "7", "medium": "wire" },
+        { "ID": "11", "src": "3", "dest": "4", "bandwidth": "7", "medium": "wire" }
+    ]
+})";
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+JsonScenarioLoaderTest::JsonScenarioLoaderTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "JsonScenarioLoaderTest")), 
+		scheduler(Scheduler(simulatorGlobals)) {
+}
+
+/**
+ * Load scenario from a string.
+ */
+ScenarioLoaderReturnType JsonScenarioLoaderTest::loadFromString(JsonScenarioLoader &jsonScenarioLoader, const std::string &scenario) {
+	std::istringstream inputStream(scenario);
+	return jsonScenarioLoader.load(inputStream);
+}
+
+/// Load the documented example scenario, check created objects.
+TEST_F(JsonScenarioLoaderTest, ExampleScenario) {
+	JsonScenarioLoader jsonScenarioLoader(simulatorGlobals, scheduler, topology);
+	ASSERT_EQ(ScenarioLoaderReturnType::SCENARIO_LOADED, loadFromString(jsonScenarioLoader, exampleScenario)) << jsonScenarioLoader.getErrorMessage();
+	// Parameters and earthquakes.
+	EXPECT_EQ("testSim", jsonScenarioLoader.getScenarioParameters().simulationName);
+	EXPECT_EQ(10000.0, jsonScenarioLoader.getScenarioParameters().initialClock);
+	EXPECT_EQ(10100.0, jsonScenarioLoader.getScenarioParameters().endClock);
+	EXPECT_FALSE(jsonScenarioLoader.getScenarioParameters().printTraces);
+	EXPECT_EQ(10050.0, jsonScenarioLoader.getScenarioParameters().startRecordingTime);
+	ASSERT_EQ(1, jsonScenarioLoader.getEarthquakes().size());
+	EXPECT_EQ(1, jsonScenarioLoader.getEarthquakes().at(0)->earthquakeId);
+	EXPECT_DOUBLE_EQ(6.5, jsonScenarioLoader.getEarthquakes().at(0)->magnitude);
+	EXPECT_DOUBLE_EQ(15.0, jsonScenarioLoader.getEarthquakes().at(0)->depth);
+	EXPECT_DOUBLE_EQ(-75.95878601074219, jsonScenarioLoader.getEarthquakes().at(0)->longitude);
+	// Nodes: 3 nodes and 2 sensors, with dense node IDs in creation order.
+	EXPECT_EQ(5, topology.nodeMap.size());
+	EXPECT_EQ(0, topology.nodeMap.at(2)->getNodeId());
+	EXPECT_EQ(2, topology.nodeMap.at(4)->getNodeId());
+	// Sensors.
+	ASSERT_EQ(2, topology.qcnSensorTrafficGeneratorMap.size());
+	auto sensor2 = topology.qcnSensorTrafficGeneratorMap.at(2);
+	auto sensor3 = topology.qcnSensorTrafficGeneratorMap.at(3);
+	EXPECT_EQ(2, sensor2->getQcnExplorerSensorId());
+	EXPECT_DOUBLE_EQ(41.934976500546604, sensor2->getLatitude());
+	EXPECT_DOUBLE_EQ(0.78, sensor2->getSensorParameters().connectedFraction);
+	EXPECT_DOUBLE_EQ(6.63, sensor2->getSensorParameters().falseTriggerRate);
+	EXPECT_EQ(1000, sensor2->getSensorParameters().pduSize);
+	EXPECT_EQ(0, sensor3->getSensorParameters().pduSize); // Not informed.
+	EXPECT_DOUBLE_EQ(0.89, sensor3->getSensorParameters().activeFraction);
+	EXPECT_EQ(topology.nodeMap.at(2), sensor2->getSource());
+	EXPECT_EQ(topology.nodeMap.at(5), sensor2->getDestination());
+	// Routes: sensor node is prepended.
+	EXPECT_EQ(std::vector<std::shared_ptr<Entity>>({ topology.nodeMap.at(3), topology.nodeMap.at(4), topology.nodeMap.at(5) }), topology.explicitRouteMap.at(3));
+	ASSERT_EQ(1, topology.alternateRouteMap.at(3).size());
+	EXPECT_EQ(std::vector<std::shared_ptr<Entity>>({ topology.nodeMap.at(3), topology.nodeMap.at(8), topology.nodeMap.at(4), topology.nodeMap.at(5) }),
+		topology.alternateRouteMap.at(3).at(0));
+	EXPECT_EQ(0, topology.alternateRouteMap.count(2));
+	// Links.
+	ASSERT_EQ(5, topology.linkMap.size());
+	EXPECT_EQ(topology.nodeMap.at(4), topology.linkMap.at(7)->getNodeA());
+	EXPECT_EQ(topology.nodeMap.at(5), topology.linkMap.at(7)->getNodeB());
+	EXPECT_DOUBLE_EQ(100000000.0, topology.linkMap.at(7)->getBandwidth());
+	EXPECT_EQ("7", topology.linkMap.at(7)->getName());
+	// Nodes 4 and 5 are 1 degree of latitude and 1 of longitude apart: about 138 Km, i.e., about 0.69 ms in fiber.
+	EXPECT_NEAR(0.00069, topology.linkMap.at(7)->getPropagationDelay(), 0.00002);
+	// Nodes 5 and 8 share the same location, and wire and fiber have the same propagation speed: links 8-4 and 4-5 have the same delay.
+	EXPECT_DOUBLE_EQ(topology.linkMap.at(7)->getPropagationDelay(), topology.linkMap.at(10)->getPropagationDelay());
+}
+
+/// Malformed JSON must be reported with line and column.
+TEST_F(JsonScenarioLoaderTest, SyntaxErrors) {
+	JsonScenarioLoader jsonScenarioLoader(simulatorGlobals, scheduler, topology);
+	EXPECT_EQ(ScenarioLoaderReturnType::SYNTAX_ERROR, loadFromString(jsonScenarioLoader, "{\n \"nodes\": [\n { \"ID\": \"4\" \"location\": {} } ] }"));
+	EXPECT_EQ("line 3, column 14: expected ',', found '\"'", jsonScenarioLoader.getErrorMessage());
+	EXPECT_EQ(ScenarioLoaderReturnType::SYNTAX_ERROR, loadFromString(jsonScenarioLoader, "{ \"nodes\": [ ], }"));
+	EXPECT_EQ(ScenarioLoaderReturnType::SYNTAX_ERROR, loadFromString(jsonScenarioLoader, "{ \"nodes\": [ "));
+	EXPECT_EQ(ScenarioLoaderReturnType::SYNTAX_ERROR, loadFromString(jsonScenarioLoader, "{ } { }"));
+	EXPECT_EQ(ScenarioLoaderReturnType::SYNTAX_ERROR, loadFromString(jsonScenarioLoader, "{ \"a\": tru }"));
+	EXPECT_EQ(ScenarioLoaderReturnType::FILE_NOT_FOUND, jsonScenarioLoader.load("this file does not exist.json"));
+	// Unknown members and sections are skipped, including nested values and escapes.
+	EXPECT_EQ(ScenarioLoaderReturnType::SCENARIO_LOADED, loadFromString(jsonScenarioLoader,
+		"{ \"comment\": { \"a\": [1, 2.5e3, true, null, \"x\\\"\\u00e9\"] }, \"parameters\": { \"simName\": \"caf\\u00e9\" } }"));
+	EXPECT_EQ("caf\xc3\xa9", jsonScenarioLoader.getScenarioParameters().simulationName);
+}
+
+/// Schema violations must be reported with the path to the offending element.
+TEST_F(JsonScenarioLoaderTest, SchemaErrors) {
+	JsonScenarioLoader jsonScenarioLoader(simulatorGlobals, scheduler, topology);
+	EXPECT_EQ(ScenarioLoaderReturnType::SCHEMA_ERROR, loadFromString(jsonScenarioLoader,
+		"{ \"sensors\": [ { \"ID\": \"1\", \"location\": { \"lat\": \"1\", \"lng\": \"2\" } },\n { \"ID\": \"2\", \"location\": { \"lat\": \"x\", \"lng\": \"2\" } } ] }"));
+	EXPECT_EQ("sensors[1].location.lat: expected a number, found \"x\" (line 2)", jsonScenarioLoader.getErrorMessage());
+
+	Topology topologyUnknownNode;
+	JsonScenarioLoader jsonScenarioLoaderUnknownNode(simulatorGlobals, scheduler, topologyUnknownNode);
+	EXPECT_EQ(ScenarioLoaderReturnType::SCHEMA_ERROR, loadFromString(jsonScenarioLoaderUnknownNode,
+		"{ \"sensors\": [ { \"ID\": \"1\", \"location\": { \"lat\": \"1\", \"lng\": \"2\" }, \"routes\": [ [ \"99\" ] ] } ] }"));
+	EXPECT_EQ("sensors[0].routes[0]: unknown node ID 99", jsonScenarioLoaderUnknownNode.getErrorMessage());
+
+	Topology topologyDuplicate;
+	JsonScenarioLoader jsonScenarioLoaderDuplicate(simulatorGlobals, scheduler, topologyDuplicate);
+	EXPECT_EQ(ScenarioLoaderReturnType::SCHEMA_ERROR, loadFromString(jsonScenarioLoaderDuplicate,
+		"{ \"nodes\": [ { \"ID\": \"4\", \"location\": { \"lat\": \"1\", \"lng\": \"2\" } }, { \"ID\": \"4\", \"location\": { \"lat\": \"1\", \"lng\": \"2\" } } ] }"));
+	EXPECT_EQ("nodes[1].ID: duplicate node or sensor ID 4 (line 1)", jsonScenarioLoaderDuplicate.getErrorMessage());
+
+	Topology topologyLink;
+	JsonScenarioLoader jsonScenarioLoaderLink(simulatorGlobals, scheduler, topologyLink);
+	EXPECT_EQ(ScenarioLoaderReturnType::SCHEMA_ERROR, loadFromString(jsonScenarioLoaderLink,
+		"{ \"links\": [ { \"ID\": \"6\", \"src\": \"2\", \"dest\": \"4\", \"bandwidth\": \"10\", \"medium\": \"smoke\" } ] }"));
+	EXPECT_EQ("links[0].medium: unknown medium \"smoke\" (expected \"fiber\", \"wire\" or \"wireless\") (line 1)", jsonScenarioLoaderLink.getErrorMessage());
+	EXPECT_EQ(ScenarioLoaderReturnType::SCHEMA_ERROR, loadFromString(jsonScenarioLoaderLink,
+		"{ \"links\": [ { \"ID\": \"6\", \"src\": \"2\", \"dest\": \"4\", \"bandwidth\": \"10\" } ] }"));
+	EXPECT_EQ("links[0].src: unknown node or sensor ID 2", jsonScenarioLoaderLink.getErrorMessage());
+	EXPECT_EQ(ScenarioLoaderReturnType::SCHEMA_ERROR, loadFromString(jsonScenarioLoaderLink, "{ \"earthquakes\": [ { \"magnitude\": \"5\" } ] }"));
+	EXPECT_EQ("earthquakes[0]: missing required member \"ID\" (line 1)", jsonScenarioLoaderLink.getErrorMessage());
+}
+
+/// Load a large, generated scenario: many sensors sharing one route.
+TEST_F(JsonScenarioLoaderTest, LargeScenario) {
+	const unsigned int numberOfSensors = 100000;
+	std::ostringstream scenario;
+	scenario << "{ \"nodes\": [ { \"ID\": \"1\", \"location\": { \"lat\": \"0\", \"lng\": \"0\" } } ],\n\"sensors\": [\n";
+	for (unsigned int i = 0; i < numberOfSensors; ++i) {
+		scenario << (i == 0 ? "" : ",\n") << "{ \"ID\": \"" << i + 10 << "\", \"onFrac\": \"0.5\", \"location\": { \"lat\": \"" << (i % 90) <<
+			"\", \"lng\": \"1\" }, \"routes\": [ [ \"1\" ] ] }";
+	}
+	scenario << "] }";
+	JsonScenarioLoader jsonScenarioLoader(simulatorGlobals, scheduler, topology);
+	ASSERT_EQ(ScenarioLoaderReturnType::SCENARIO_LOADED, loadFromString(jsonScenarioLoader, scenario.str())) << jsonScenarioLoader.getErrorMessage();
+	EXPECT_EQ(numberOfSensors, topology.qcnSensorTrafficGeneratorMap.size());
+	EXPECT_EQ(numberOfSensors + 1, topology.nodeMap.size());
+	EXPECT_EQ(numberOfSensors, topology.explicitRouteMap.size());
+	EXPECT_EQ(topology.nodeMap.at(1), topology.qcnSensorTrafficGeneratorMap.at(numberOfSensors + 9)->getDestination());
+	EXPECT_DOUBLE_EQ(0.5, topology.qcnSensorTrafficGeneratorMap.at(numberOfSensors + 9)->getSensorParameters().onFraction);
+}
@@ -813,6 +813,34 @@ TEST_F(LinkTest, DuplexLinkAndDrop) {
 	EXPECT_EQ(5, link.getMaxRecordedTransmissionQueueSize());
 }
 
+/// Test topology change notifications (link down/up) to LinkStateObserver objects, including forwarding tables.
+TEST_F(LinkTest, LinkStateObservers) {
+	auto node0 = std::make_shared<Node>(simulatorGlobals, 0);
+	auto node1 = std::make_shared<Node>(simulatorGlobals, 1);
+	auto link = std::make_shared<Link>(node0, node1, 8000, 2, simulatorGlobals, scheduler, "", LinkType::DUPLEX_LINK);
+	auto forwardingTable = std::make_shared<ForwardingTable>(2);
+	forwardingTable->setEntry(1, node1, link);
+	forwardingTable->setEntry(0, node0); // No link informed; must not be affected.
+	link->addLinkStateObserver(forwardingTable);
+	EXPECT_EQ(node1, forwardingTable->getNextHop(1));
+	// Link down: entry through the link is suspended.
+	link->setDown();
+	EXPECT_EQ(nullptr, forwardingTable->findEntry(1));
+	EXPECT_EQ(node0, forwardingTable->getNextHop(0));
+	// Setting down again must not change anything.
+	link->setDown();
+	EXPECT_EQ(nullptr, forwardingTable->findEntry(1));
+	// Link up: entry restored.
+	link->setUp();
+	EXPECT_EQ(node1, forwardingTable->getNextHop(1));
+	EXPECT_EQ(link, forwardingTable->getNextLink(1));
+	// Observer no longer exists; link must simply skip it.
+	forwardingTable.reset();
+	link->setDown();
+	EXPECT_FALSE(link->isUp());
+	EXPECT_FALSE(link->getReverseLink()->isUp());
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -767,4 +767,124 @@ TEST_F(NodeTest, PDUStatisticsExceededTTL) {
 	EXPECT_EQ(0, nodeVector.at(2)->getForwardedBytesCount());
 	// Kill pdu3.
 	pdu3.reset();
-}
\ No newline at end of file
+}
+
+/// Test ForwardingTable entries.
+TEST_F(NodeTest, ForwardingTable) {
+	auto nodeA = std::make_shared<Node>(simulatorGlobals, 0);
+	auto nodeB = std::make_shared<Node>(simulatorGlobals, 1);
+	ForwardingTable forwardingTable(2);
+	EXPECT_EQ(2, forwardingTable.getSize());
+	EXPECT_EQ(nullptr, forwardingTable.findEntry(0));
+	EXPECT_EQ(nullptr, forwardingTable.getNextHop(1));
+	EXPECT_EQ(nullptr, forwardingTable.getNextHop(10)); // Out of range; no entry.
+	forwardingTable.setEntry(1, nodeB);
+	EXPECT_EQ(nodeB, forwardingTable.getNextHop(1));
+	EXPECT_EQ(nullptr, forwardingTable.getNextLink(1));
+	// Setting an entry beyond the current size must grow the table.
+	forwardingTable.setEntry(5, nodeA, nodeB);
+	EXPECT_EQ(6, forwardingTable.getSize());
+	EXPECT_EQ(nodeA, forwardingTable.getNextHop(5));
+	EXPECT_EQ(nodeB, forwardingTable.getNextLink(5));
+	forwardingTable.removeEntry(5);
+	EXPECT_EQ(nullptr, forwardingTable.findEntry(5));
+	EXPECT_EQ(6, forwardingTable.getSize());
+}
+
+/// Test hop-by-hop routing through forwarding tables, with PDUs without explicit route.
+TEST_F(NodeTest, HopByHopRouting) {
+	// Build a line of 4 nodes: 0 - 1 - 2 - 3. Nodes 1 and 2 share the same table object, since they have identical entries towards node 3.
+	std::vector<std::shared_ptr<Node>> nodeVector;
+	for (unsigned int i = 0; i < 4; ++i) {
+		nodeVector.push_back(std::make_shared<Node>(simulatorGlobals, i));
+		EXPECT_EQ(i, nodeVector.at(i)->getNodeId());
+	}
+	auto tableNode0 = std::make_shared<ForwardingTable>(4);
+	tableNode0->setEntry(3, nodeVector.at(1));
+	auto tableTransit = std::make_shared<ForwardingTable>(4);
+	tableTransit->setEntry(3, nodeVector.at(3)); // Not quite right for node 1, but will test table sharing: node 1 "jumps" straight to 3.
+	nodeVector.at(0)->setForwardingTable(tableNode0);
+	nodeVector.at(1)->setForwardingTable(tableTransit);
+	nodeVector.at(2)->setForwardingTable(tableTransit);
+	EXPECT_EQ(tableTransit, nodeVector.at(2)->getForwardingTable());
+	EXPECT_EQ(nullptr, nodeVector.at(3)->getForwardingTable());
+
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(simulatorGlobals, 1, nullptr, nodeVector.at(0), nodeVector.at(3), 1000));
+	pdu->setTtl(10);
+	pdu->setRecordThisRoute();
+	EXPECT_FALSE(pdu->hasExplicitRoute());
+	EXPECT_EQ(NodeReturnType::PDU_ROUTE_UPDATED, nodeVector.at(0)->processAndForward(pdu));
+	EXPECT_EQ(nodeVector.at(0), pdu->previous);
+	EXPECT_EQ(nodeVector.at(1), pdu->next);
+	EXPECT_EQ(NodeReturnType::PDU_ROUTE_UPDATED, std::dynamic_pointer_cast<Node>(pdu->next)->processAndForward(pdu));
+	EXPECT_EQ(nodeVector.at(3), pdu->next);
+	EXPECT_EQ(NodeReturnType::FINAL_DESTINATION, std::dynamic_pointer_cast<Node>(pdu->next)->processAndForward(pdu));
+	EXPECT_EQ(8, pdu->getTtl());
+	std::vector<std::shared_ptr<Entity>> expectedRoute;
+	expectedRoute.push_back(nodeVector.at(0));
+	expectedRoute.push_back(nodeVector.at(1));
+	expectedRoute.push_back(nodeVector.at(3));
+	EXPECT_EQ(expectedRoute, pdu->getRecordedRoute());
+
+	// No table entry towards node 2: PDU must be dropped at node 0.
+	std::shared_ptr<ProtocolDataUnit> pduNoRoute(new ProtocolDataUnit(simulatorGlobals, 1, nullptr, nodeVector.at(0), nodeVector.at(2), 1000));
+	EXPECT_EQ(NodeReturnType::ROUTE_NOT_FOUND, nodeVector.at(0)->processAndForward(pduNoRoute));
+	EXPECT_EQ(1, nodeVector.at(0)->getDroppedPdusOrTokensCount());
+	EXPECT_EQ(1, nodeVector.at(0)->getForwardedPdusOrTokensCount());
+
+	// Explicit route takes precedence over the forwarding table.
+	std::vector<std::shared_ptr<Entity>> explicitRoute;
+	explicitRoute.push_back(nodeVector.at(0));
+	explicitRoute.push_back(nodeVector.at(2));
+	explicitRoute.push_back(nodeVector.at(3));
+	std::shared_ptr<Token> token(new Token(simulatorGlobals, 1, nullptr, nodeVector.at(0), nodeVector.at(3), explicitRoute));
+	EXPECT_TRUE(token->hasExplicitRoute());
+	EXPECT_EQ(NodeReturnType::PDU_ROUTE_UPDATED, nodeVector.at(0)->processAndForward(token));
+	EXPECT_EQ(nodeVector.at(2), token->next);
+}
+
+/// Hop-by-hop tokens record the link of the forwarding table entry they leave through, and keep it if the entry changes afterwards.
+TEST_F(NodeTest, NextLink) {
+	auto nodeA = std::make_shared<Node>(simulatorGlobals, 0);
+	auto nodeB = std::make_shared<Node>(simulatorGlobals, 1);
+	auto link = std::make_shared<Link>(nodeA, nodeB, 1000000, 0.01, simulatorGlobals, scheduler);
+	auto otherLink = std::make_shared<Link>(nodeA, nodeB, 1000000, 0.01, simulatorGlobals, scheduler);
+	auto forwardingTable = std::make_shared<ForwardingTable>(2);
+	nodeA->setForwardingTable(forwardingTable);
+	forwardingTable->setEntry(1, nodeB);
+	auto token = std::make_shared<Token>(simulatorGlobals, 1, nullptr, nodeA, nodeB, nodeA, nodeA);
+	EXPECT_EQ(NodeReturnType::PDU_ROUTE_UPDATED, nodeA->processAndForward(token));
+	EXPECT_EQ(nullptr, token->nextLink); // Entry without link.
+	forwardingTable->setEntry(1, nodeB, link);
+	token = std::make_shared<Token>(simulatorGlobals, 1, nullptr, nodeA, nodeB, nodeA, nodeA);
+	EXPECT_EQ(NodeReturnType::PDU_ROUTE_UPDATED, nodeA->processAndForward(token));
+	EXPECT_EQ(link, token->nextLink);
+	// The entry changes, or is suspended, while the token is on its way.
+	forwardingTable->setEntry(1, nodeB, otherLink);
+	link->addLinkStateObserver(forwardingTable);
+	otherLink->addLinkStateObserver(forwardingTable);
+	otherLink->setDown();
+	EXPECT_EQ(link, token->nextLink);
+	// Explicit routes do not use the table.
+	auto routedToken = std::make_shared<Token>(simulatorGlobals, 1, nullptr, nodeA, nodeB, nodeA, nodeA, std::vector<std::shared_ptr<Entity>>({ nodeA, nodeB }));
+	routedToken->nextLink = link;
+	EXPECT_EQ(NodeReturnType::PDU_ROUTE_UPDATED, nodeA->processAndForward(routedToken));
+	EXPECT_EQ(nullptr, routedToken->nextLink);
+}
+
+/// An explicit route that does not lead away from the node drops the token instead of looping.
+TEST_F(NodeTest, MalformedExplicitRoute) {
+	auto nodeA = std::make_shared<Node>(simulatorGlobals, 0);
+	auto nodeB = std::make_shared<Node>(simulatorGlobals, 1);
+	std::vector<std::shared_ptr<Entity>> explicitRoute({ nodeA, nodeA });
+	std::shared_ptr<Token> token(new Token(simulatorGlobals, 1, nullptr, nodeA, nodeB, nodeA, nodeA, explicitRoute));
+	EXPECT_EQ(2, token->getExplicitRouteSize());
+	EXPECT_EQ(NodeReturnType::ROUTE_NOT_FOUND, nodeA->processAndForward(token));
+	EXPECT_EQ(1, nodeA->getDroppedPdusOrTokensCount());
+	EXPECT_EQ(0, nodeA->getForwardedPdusOrTokensCount());
+	std::shared_ptr<ProtocolDataUnit> pdu(new ProtocolDataUnit(simulatorGlobals, 1, nullptr, nodeA, nodeB, nodeA, nodeA, 1000, explicitRoute));
+	pdu->setTtl(10);
+	EXPECT_EQ(NodeReturnType::ROUTE_NOT_FOUND, nodeA->processAndForward(pdu));
+	EXPECT_EQ(2, nodeA->getDroppedPdusOrTokensCount());
+	EXPECT_EQ(10, pdu->getTtl());
+}
@@ -34,6 +34,7 @@
 #include "../QcnSim/SimulatorGlobals.h"
 #include "../QcnSim/Scheduler.h"
 #include "../QcnSim/Node.h"
+#include "../QcnSim/Link.h"
 #include "../QcnSim/Route.h"
 #include "../QcnSim/Token.h"
 #include <vector>
@@ -0,0 +1,218 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "QuakeWaveModelTest.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+QuakeWaveModelTest::QuakeWaveModelTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "QuakeWaveModelTest")), scheduler(Scheduler(simulatorGlobals)),
+		earthquake(EarthquakeData(1, 5.0, 100.0, 3.5, 10.0, 0.0, 0.0)) {
+	simulatorGlobals.seedRandomNumberGenerator(12345);
+}
+
+/**
+ * Create a sensor with the given location and trigger parameters.
+ */
+std::shared_ptr<QcnSensorTrafficGenerator> QuakeWaveModelTest::createSensor(unsigned int sensorId, double latitude, double longitude,
+		double triggerLowerBound, double triggerUpperBound, double triggerProbability) {
+	auto sensor = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, nullptr,
+		nullptr, 1, latitude, longitude, sensorId, sensorId * 10);
+	QcnSensorParameters sensorParameters;
+	sensorParameters.triggerLowerBound = triggerLowerBound;
+	sensorParameters.triggerUpperBound = triggerUpperBound;
+	sensorParameters.triggerProbability = triggerProbability;
+	sensor->setSensorParameters(sensorParameters);
+	return sensor;
+}
+
+/// Hypocentral distances and P/S arrival times.
+TEST_F(QuakeWaveModelTest, DistancesAndArrivalTimes) {
+	QuakeWaveModel quakeWaveModel(simulatorGlobals);
+	quakeWaveModel.addSensor(createSensor(1, 0.0, 0.0, 0.0, 0.0, 1.0)); // At the epicenter.
+	quakeWaveModel.addSensor(createSensor(2, 1.0, 0.0, 0.0, 0.0, 1.0)); // One degree north.
+	quakeWaveModel.addSensor(createSensor(3, 0.0, -90.0, 0.0, 0.0, 1.0)); // A quarter of the Earth west.
+	EXPECT_EQ(3, quakeWaveModel.getNumberOfSensors());
+	quakeWaveModel.evaluate(earthquake);
+	double chordOneDegree = 2.0 * std::sin(GEO_PI / 360.0);
+	std::vector<double> expectedDistances = {10.0, std::sqrt(100.0 + EARTH_RADIUS * (EARTH_RADIUS - 10.0) * chordOneDegree * chordOneDegree),
+		std::sqrt(EARTH_RADIUS * EARTH_RADIUS + (EARTH_RADIUS - 10.0) * (EARTH_RADIUS - 10.0))};
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_NEAR(expectedDistances[i], quakeWaveModel.getHypocentralDistances()[i], 1e-6);
+		EXPECT_NEAR(100.0 + expectedDistances[i] / 3.5, quakeWaveModel.getSWaveArrivalTimes()[i], 1e-9);
+		EXPECT_NEAR(100.0 + expectedDistances[i] / (3.5 * QUAKE_P_TO_S_WAVE_SPEED_RATIO), quakeWaveModel.getPWaveArrivalTimes()[i], 1e-9);
+		EXPECT_LT(quakeWaveModel.getPWaveArrivalTimes()[i], quakeWaveModel.getSWaveArrivalTimes()[i]);
+	}
+	// One degree is about 111.2 Km.
+	EXPECT_NEAR(111.2, std::sqrt(expectedDistances[1] * expectedDistances[1] - 100.0), 0.1);
+	// Without S-wave speed, the default is used.
+	earthquake.sWaveSpeed = 0.0;
+	quakeWaveModel.evaluate(earthquake);
+	EXPECT_NEAR(100.0 + 10.0 / QUAKE_DEFAULT_S_WAVE_SPEED, quakeWaveModel.getSWaveArrivalTimes()[0], 1e-9);
+}
+
+/// Peak accelerations follow the attenuation relation; trigger probabilities follow the sensor bounds.
+TEST_F(QuakeWaveModelTest, AttenuationAndProbabilities) {
+	QuakeWaveModel quakeWaveModel(simulatorGlobals);
+	quakeWaveModel.addSensor(createSensor(1, 0.0, 0.0, 1.0, 2.0, 0.5)); // Acceleration below the lower bound.
+	quakeWaveModel.addSensor(createSensor(2, 0.0, 0.0, 0.1, 0.2, 0.5)); // Acceleration above the upper bound.
+	quakeWaveModel.addSensor(createSensor(3, 0.0, 0.0, 0.1, 10.0, 0.3)); // Acceleration within bounds.
+	quakeWaveModel.addSensor(createSensor(4, 0.0, 0.0, 0.0, 0.0, 0.7)); // Bounds not given.
+	quakeWaveModel.addSensor(createSensor(5, 0.0, 5.0, 0.0, 0.0, 1.0)); // Farther away.
+	quakeWaveModel.evaluate(earthquake);
+	double expectedAcceleration = std::pow(10.0, QUAKE_ATTENUATION_CONSTANT + QUAKE_ATTENUATION_MAGNITUDE * 5.0) / (10.0 + QUAKE_ATTENUATION_NEAR_FIELD);
+	EXPECT_NEAR(expectedAcceleration, quakeWaveModel.getPeakAccelerations()[0], 1e-12);
+	EXPECT_LT(quakeWaveModel.getPeakAccelerations()[4], quakeWaveModel.getPeakAccelerations()[0]);
+	std::vector<double> expectedProbabilities = {0.0, 1.0, 0.3, 0.7, 1.0};
+	for (int i = 0; i < 5; ++i) {
+		EXPECT_DOUBLE_EQ(expectedProbabilities[i], quakeWaveModel.getTriggerProbabilities()[i]);
+	}
+	quakeWaveModel.setAttenuation(0.0, 1.0, 2.0, 0.0);
+	quakeWaveModel.evaluate(earthquake);
+	EXPECT_NEAR(1e5 / 100.0, quakeWaveModel.getPeakAccelerations()[0], 1e-9);
+}
+
+/// Triggers are drawn from the probabilities, ordered by time, and scheduled as seismic event detections as the wavefront advances.
+TEST_F(QuakeWaveModelTest, Triggers) {
+	Topology topology;
+	topology.qcnSensorTrafficGeneratorMap[1] = createSensor(1, 1.0, 0.0, 0.0, 0.0, 1.0);
+	topology.qcnSensorTrafficGeneratorMap[2] = createSensor(2, 0.5, 0.0, 0.0, 0.0, 1.0);
+	topology.qcnSensorTrafficGeneratorMap[3] = createSensor(3, 0.0, 0.0, 0.0, 0.0, 0.0);
+	QuakeWaveModel quakeWaveModel(simulatorGlobals);
+	quakeWaveModel.addSensors(topology);
+	std::vector<std::shared_ptr<SeismicEventData>> triggers = quakeWaveModel.generateTriggers(earthquake);
+	quakeWaveModel.evaluate(earthquake);
+	ASSERT_EQ(2, triggers.size());
+	EXPECT_EQ(2, triggers[0]->qcnExplorerSensorId); // Nearer, thus first.
+	EXPECT_EQ(20, triggers[0]->regionId);
+	EXPECT_DOUBLE_EQ(0.5, triggers[0]->latitude);
+	EXPECT_DOUBLE_EQ(5.0, triggers[0]->magnitude);
+	EXPECT_DOUBLE_EQ(quakeWaveModel.getSWaveArrivalTimes()[1], triggers[0]->eventTime);
+	EXPECT_DOUBLE_EQ(quakeWaveModel.getHypocentralDistances()[1], triggers[0]->distance);
+	EXPECT_EQ(1, triggers[1]->qcnExplorerSensorId);
+
+	// Before the origin time, the first batch is empty, and the wavefront advances one step before each arrival.
+	simulatorGlobals.setCurrentAbsoluteTime(50.0);
+	EXPECT_EQ(0, quakeWaveModel.scheduleTriggers(earthquake, scheduler));
+	EXPECT_EQ(1, quakeWaveModel.getNumberOfWavefronts());
+	Event event = scheduler.cause();
+	EXPECT_EQ(EventType::QUAKE_WAVEFRONT_ADVANCE, event.eventType);
+	EXPECT_DOUBLE_EQ(quakeWaveModel.getSWaveArrivalTimes()[2] - QUAKE_WAVEFRONT_STEP, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(0, quakeWaveModel.advanceWavefront(*std::dynamic_pointer_cast<const EarthquakeData>(event.entity), scheduler)); // Probability 0.
+	event = scheduler.cause();
+	EXPECT_EQ(EventType::QUAKE_WAVEFRONT_ADVANCE, event.eventType);
+	EXPECT_DOUBLE_EQ(quakeWaveModel.getSWaveArrivalTimes()[1] - QUAKE_WAVEFRONT_STEP, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(1, quakeWaveModel.advanceWavefront(*std::dynamic_pointer_cast<const EarthquakeData>(event.entity), scheduler));
+	event = scheduler.cause();
+	EXPECT_EQ(EventType::SEISMIC_EVENT_DETECTION, event.eventType);
+	EXPECT_DOUBLE_EQ(quakeWaveModel.getSWaveArrivalTimes()[1], simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(2, std::dynamic_pointer_cast<const SeismicEventData>(event.entity)->qcnExplorerSensorId);
+	event = scheduler.cause();
+	EXPECT_EQ(EventType::QUAKE_WAVEFRONT_ADVANCE, event.eventType);
+	EXPECT_EQ(1, quakeWaveModel.advanceWavefront(*std::dynamic_pointer_cast<const EarthquakeData>(event.entity), scheduler));
+	EXPECT_EQ(0, quakeWaveModel.getNumberOfWavefronts()); // Last sensor reached.
+	event = scheduler.cause();
+	EXPECT_EQ(EventType::SEISMIC_EVENT_DETECTION, event.eventType);
+	EXPECT_DOUBLE_EQ(quakeWaveModel.getSWaveArrivalTimes()[0], simulatorGlobals.getCurrentAbsoluteTime());
+}
+
+/// Scheduled batches give the same triggers as the whole sweep, each scheduled less than one wavefront step ahead; sensors beyond the reach
+/// of the earthquake are not swept.
+TEST_F(QuakeWaveModelTest, WavefrontBatches) {
+	QuakeWaveModel quakeWaveModel(simulatorGlobals);
+	QuakeWaveModel sameStreamModel(simulatorGlobals);
+	for (int i = 0; i < 2000; ++i) {
+		auto sensor = createSensor(i, (i % 40) * 0.05, (i / 40) * 0.05, 0.05, 1.0, 0.5);
+		quakeWaveModel.addSensor(sensor);
+		sameStreamModel.addSensor(sensor);
+	}
+	std::vector<std::shared_ptr<SeismicEventData>> triggers = sameStreamModel.generateTriggers(earthquake);
+	sameStreamModel.evaluate(earthquake);
+	int reachableSensors = 0;
+	for (auto acceleration : sameStreamModel.getPeakAccelerations()) {
+		reachableSensors += acceleration >= 0.05 ? 1 : 0;
+	}
+	ASSERT_GT(reachableSensors, 100);
+	ASSERT_LT(reachableSensors, 2000);
+	ASSERT_FALSE(triggers.empty());
+
+	simulatorGlobals.setCurrentAbsoluteTime(100.0);
+	scheduler.schedule(Event(1000.0, EventType::END_SIMULATION, nullptr));
+	unsigned int scheduledTriggers = quakeWaveModel.scheduleTriggers(earthquake, scheduler);
+	unsigned int advances = 0;
+	std::vector<std::shared_ptr<SeismicEventData>>::size_type triggerIndex = 0;
+	for (Event event = scheduler.cause(); event.eventType != EventType::END_SIMULATION; event = scheduler.cause()) {
+		if (event.eventType == EventType::QUAKE_WAVEFRONT_ADVANCE) {
+			++advances;
+			scheduledTriggers += quakeWaveModel.advanceWavefront(*std::dynamic_pointer_cast<const EarthquakeData>(event.entity), scheduler);
+			continue;
+		}
+		ASSERT_LT(triggerIndex, triggers.size());
+		auto trigger = std::dynamic_pointer_cast<const SeismicEventData>(event.entity);
+		EXPECT_EQ(triggers[triggerIndex]->qcnExplorerSensorId, trigger->qcnExplorerSensorId);
+		EXPECT_DOUBLE_EQ(trigger->eventTime, simulatorGlobals.getCurrentAbsoluteTime());
+		++triggerIndex;
+	}
+	EXPECT_EQ(triggers.size(), triggerIndex);
+	EXPECT_EQ(triggers.size(), scheduledTriggers);
+	EXPECT_GT(advances, 1);
+	EXPECT_EQ(0, quakeWaveModel.getNumberOfWavefronts());
+}
+
+/// The fraction of sensors triggered matches the trigger probability, and draws are reproducible.
+TEST_F(QuakeWaveModelTest, TriggerFraction) {
+	QuakeWaveModel quakeWaveModel(simulatorGlobals);
+	QuakeWaveModel sameStreamModel(simulatorGlobals);
+	const int numberOfSensors = 20000;
+	for (int i = 0; i < numberOfSensors; ++i) {
+		auto sensor = createSensor(i, (i % 200) * 0.01, (i / 200) * 0.01, 0.0, 0.0, 0.3);
+		quakeWaveModel.addSensor(sensor);
+		sameStreamModel.addSensor(sensor);
+	}
+	std::vector<std::shared_ptr<SeismicEventData>> triggers = quakeWaveModel.generateTriggers(earthquake);
+	EXPECT_NEAR(0.3, static_cast<double>(triggers.size()) / numberOfSensors, 0.02);
+	std::vector<std::shared_ptr<SeismicEventData>> sameTriggers = sameStreamModel.generateTriggers(earthquake);
+	ASSERT_EQ(triggers.size(), sameTriggers.size());
+	for (std::vector<std::shared_ptr<SeismicEventData>>::size_type i = 0; i < triggers.size(); ++i) {
+		EXPECT_EQ(triggers[i]->qcnExplorerSensorId, sameTriggers[i]->qcnExplorerSensorId);
+	}
+}
+
+/// Evaluation time of a quake over many sensors.
+TEST_F(QuakeWaveModelTest, EvaluationRate) {
+	QuakeWaveModel quakeWaveModel(simulatorGlobals);
+	const int numberOfSensors = 1000000;
+	auto sensor = createSensor(1, 0.0, 0.0, 0.0, 0.0, 1.0);
+	for (int i = 0; i < numberOfSensors; ++i) {
+		sensor->setLatitude(-60.0 + (i % 1000) * 0.12);
+		sensor->setLongitude(-180.0 + (i / 1000) * 0.36);
+		quakeWaveModel.addSensor(sensor);
+	}
+	auto startTime = std::chrono::steady_clock::now();
+	quakeWaveModel.evaluate(earthquake);
+	double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "[   QUAKE  ] " << numberOfSensors << " sensors evaluated in " << elapsedTime * 1000.0 << " ms" << std::endl;
+	RecordProperty("QuakeEvaluationMilliseconds", std::to_string(static_cast<int>(elapsedTime * 1000.0)));
+	EXPECT_EQ(numberOfSensors, quakeWaveModel.getHypocentralDistances().size());
+	for (std::vector<double>::size_type i = 0; i < quakeWaveModel.getHypocentralDistances().size(); i += 997) {
+		EXPECT_GE(quakeWaveModel.getHypocentralDistances()[i], 10.0 - 1e-9);
+		EXPECT_LE(quakeWaveModel.getHypocentralDistances()[i], 2.0 * EARTH_RADIUS);
+	}
+}
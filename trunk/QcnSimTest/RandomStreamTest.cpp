@@ -0,0 +1,153 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "RandomStreamTest.h"
+#include <random>
+#include <sstream>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+RandomStreamTest::RandomStreamTest(): source(std::make_shared<Message>("This is a dummy entity for source.")),
+		destination(std::make_shared<Message>("This is a dummy entity for destination.")) {
+}
+
+/**
+ * Generate traffic events and return their interarrival times.
+ */
+std::vector<double> RandomStreamTest::generateIntervals(ExponentialTrafficGenerator &exponentialTrafficGenerator, Scheduler &scheduler,
+														int numberOfIntervals) {
+	std::vector<double> intervals;
+	exponentialTrafficGenerator.turnOn();
+	for (int i = 0; i < numberOfIntervals; ++i) {
+		exponentialTrafficGenerator.createInstanceTrafficEvent();
+		intervals.push_back(scheduler.cause().occurAfterTime);
+	}
+	return intervals;
+}
+
+/// Philox4x32-10 known answers, from the Random123 test vectors.
+TEST_F(RandomStreamTest, KnownAnswers) {
+	uint32_t result[4];
+	const uint32_t zeroCounter[4] = {0, 0, 0, 0};
+	const uint32_t zeroKey[2] = {0, 0};
+	RandomStream::philox4x32(zeroCounter, zeroKey, result);
+	EXPECT_EQ(0x6627e8d5, result[0]);
+	EXPECT_EQ(0xe169c58d, result[1]);
+	EXPECT_EQ(0xbc57ac4c, result[2]);
+	EXPECT_EQ(0x9b00dbd8, result[3]);
+	const uint32_t onesCounter[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+	const uint32_t onesKey[2] = {0xffffffff, 0xffffffff};
+	RandomStream::philox4x32(onesCounter, onesKey, result);
+	EXPECT_EQ(0x408f276d, result[0]);
+	EXPECT_EQ(0x41c83b0e, result[1]);
+	EXPECT_EQ(0xa20bc7c6, result[2]);
+	EXPECT_EQ(0x6d5451fd, result[3]);
+	const uint32_t piCounter[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+	const uint32_t piKey[2] = {0xa4093822, 0x299f31d0};
+	RandomStream::philox4x32(piCounter, piKey, result);
+	EXPECT_EQ(0xd16cfe09, result[0]);
+	EXPECT_EQ(0x94fdcceb, result[1]);
+	EXPECT_EQ(0x5001e420, result[2]);
+	EXPECT_EQ(0x24126ea1, result[3]);
+	// The stream returns the blocks of its counter in order, starting at block zero.
+	RandomStream randomStream(0, 0, 0);
+	EXPECT_EQ(0x6627e8d5, randomStream());
+}
+
+/// Streams with the same key repeat, streams with different keys differ; discard and text state.
+TEST_F(RandomStreamTest, Streams) {
+	RandomStream randomStream(7, 1, 0);
+	RandomStream sameStream(7, 1, 0);
+	RandomStream otherStream(7, 2, 0);
+	RandomStream otherReplication(7, 1, 1);
+	std::vector<uint32_t> sequence;
+	for (int i = 0; i < 20; ++i) {
+		sequence.push_back(randomStream());
+	}
+	int equalToOtherStream = 0;
+	int equalToOtherReplication = 0;
+	for (int i = 0; i < 20; ++i) {
+		EXPECT_EQ(sequence[i], sameStream());
+		equalToOtherStream += (sequence[i] == otherStream()) ? 1 : 0;
+		equalToOtherReplication += (sequence[i] == otherReplication()) ? 1 : 0;
+	}
+	EXPECT_EQ(0, equalToOtherStream);
+	EXPECT_EQ(0, equalToOtherReplication);
+	// Discarding n numbers is the same as drawing them, whatever the position within a block.
+	for (unsigned int start = 0; start < 4; ++start) {
+		for (unsigned int skip = 0; skip < 10; ++skip) {
+			RandomStream discardingStream(7, 1, 0);
+			discardingStream.discard(start);
+			discardingStream.discard(skip);
+			EXPECT_EQ(sequence[start + skip], discardingStream()) << "start " << start << ", skip " << skip;
+		}
+	}
+	// Text state round trip.
+	RandomStream savedStream(7, 1, 0);
+	savedStream.discard(5);
+	std::stringstream state;
+	state << savedStream;
+	RandomStream restoredStream;
+	state >> restoredStream;
+	ASSERT_FALSE(state.fail());
+	EXPECT_EQ(savedStream, restoredStream);
+	EXPECT_EQ(sequence[5], restoredStream());
+	EXPECT_NE(savedStream, restoredStream);
+	// Usable with the standard distributions.
+	std::uniform_int_distribution<int> uniformDistribution(1, 6);
+	for (int i = 0; i < 100; ++i) {
+		int variate = uniformDistribution(randomStream);
+		EXPECT_GE(variate, 1);
+		EXPECT_LE(variate, 6);
+	}
+}
+
+/// Generators with own streams are not affected by other generators nor by the shared engine.
+TEST_F(RandomStreamTest, TrafficGeneratorStreams) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "RandomStreamTest");
+	Scheduler scheduler(simulatorGlobals);
+	simulatorGlobals.seedRandomNumberGenerator(42);
+	ExponentialTrafficGenerator firstGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, source, destination, 1, 2.0);
+	EXPECT_FALSE(firstGenerator.hasOwnRandomStream());
+	firstGenerator.setRandomStream(1);
+	EXPECT_TRUE(firstGenerator.hasOwnRandomStream());
+	std::vector<double> intervals = generateIntervals(firstGenerator, scheduler, 10);
+
+	// Same seed, but another generator created first and drawing in between, the shared engine reseeded, and a seeded generator created.
+	SimulatorGlobals otherSimulatorGlobals(0.0, 0.0, false, "RandomStreamTest");
+	Scheduler otherScheduler(otherSimulatorGlobals);
+	otherSimulatorGlobals.seedRandomNumberGenerator(42);
+	ExponentialTrafficGenerator secondGenerator(otherSimulatorGlobals, otherScheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, source, destination, 1, 2.0);
+	secondGenerator.setRandomStream(2);
+	ExponentialTrafficGenerator sameGenerator(otherSimulatorGlobals, otherScheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, source, destination, 1, 2.0);
+	sameGenerator.setRandomStream(1);
+	std::vector<double> secondIntervals = generateIntervals(secondGenerator, otherScheduler, 5);
+	otherSimulatorGlobals.seedRandomNumberGenerator(99);
+	ExponentialTrafficGenerator seededGenerator(otherSimulatorGlobals, otherScheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, source, destination, 1, 2.0, 5);
+	EXPECT_TRUE(seededGenerator.hasOwnRandomStream());
+	generateIntervals(seededGenerator, otherScheduler, 5);
+	EXPECT_EQ(99, otherSimulatorGlobals.getRandomNumberGeneratorSeed()); // The seeded generator does not reseed the shared engine.
+	EXPECT_EQ(intervals, generateIntervals(sameGenerator, otherScheduler, 10));
+	EXPECT_NE(intervals[0], secondIntervals[0]);
+
+	// Another replication gets another sequence.
+	otherSimulatorGlobals.seedRandomNumberGenerator(42);
+	otherSimulatorGlobals.setReplication(1);
+	ExponentialTrafficGenerator replicatedGenerator(otherSimulatorGlobals, otherScheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, source, destination, 1, 2.0);
+	replicatedGenerator.setRandomStream(1);
+	EXPECT_NE(intervals, generateIntervals(replicatedGenerator, otherScheduler, 10));
+}
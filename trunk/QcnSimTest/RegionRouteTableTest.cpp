@@ -0,0 +1,188 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RegionRouteTableTest.h"
+
+/**
+ * Constructor.
+ *
+ * Do initializations here. Builds two regions (1 and 2) sharing a backup route.
+ */
+RegionRouteTableTest::RegionRouteTableTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "RegionRouteTableTest")), 
+		scheduler(Scheduler(simulatorGlobals)), regionRouteTable(std::make_shared<RegionRouteTable>()) {
+	for (unsigned int i = 0; i < 4; ++i) {
+		nodeVector.push_back(std::make_shared<Node>(simulatorGlobals, i));
+	}
+	primaryLink = std::make_shared<Link>(nodeVector.at(0), nodeVector.at(1), 8000, 0.1, simulatorGlobals, scheduler, "primary");
+	backupLink = std::make_shared<Link>(nodeVector.at(2), nodeVector.at(3), 8000, 0.1, simulatorGlobals, scheduler, "backup");
+	for (unsigned int regionId = 1; regionId <= 2; ++regionId) {
+		regionRouteTable->addRoute(regionId, nodeVector.at(0), nodeVector.at(1), std::vector<std::shared_ptr<Entity>>({ nodeVector.at(0), nodeVector.at(1) }),
+			std::vector<std::shared_ptr<Link>>({ primaryLink }));
+		regionRouteTable->addRoute(regionId, nodeVector.at(2), nodeVector.at(3), std::vector<std::shared_ptr<Entity>>({ nodeVector.at(2), nodeVector.at(3) }),
+			std::vector<std::shared_ptr<Link>>({ backupLink }));
+	}
+	primaryLink->addLinkStateObserver(regionRouteTable);
+	backupLink->addLinkStateObserver(regionRouteTable);
+}
+
+/// Test routes and active route selection.
+TEST_F(RegionRouteTableTest, Routes) {
+	EXPECT_EQ(2, regionRouteTable->getNumberOfRegions());
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(nodeVector.at(1), regionRouteTable->getActiveRoute(1).destination);
+	EXPECT_EQ(0, regionRouteTable->getRerouteCount());
+	// Administrative reroute of one region only.
+	regionRouteTable->setActiveRoute(2, 1);
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(2));
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(nodeVector.at(3), regionRouteTable->getActiveRoute(2).destination);
+	EXPECT_EQ(1, regionRouteTable->getRerouteCount());
+	// Unknown region or route.
+	EXPECT_THROW(regionRouteTable->getActiveRoute(3), std::out_of_range);
+	EXPECT_THROW(regionRouteTable->setActiveRoute(1, 2), std::out_of_range);
+}
+
+/// Test failover and failback upon link state changes.
+TEST_F(RegionRouteTableTest, LinkFailure) {
+	primaryLink->setDown();
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(2));
+	EXPECT_EQ(2, regionRouteTable->getRerouteCount());
+	// Backup fails too: no usable route, keep the current one.
+	backupLink->setDown();
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(1));
+	// Primary comes back: fail back.
+	primaryLink->setUp();
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(2));
+	EXPECT_EQ(4, regionRouteTable->getRerouteCount());
+}
+
+/// Test that a link going down does not reselect regions whose active route does not use it.
+TEST_F(RegionRouteTableTest, LinkFailureKeepsUnaffectedRoutes) {
+	// Region 3 has three routes; the last one is set administratively.
+	auto thirdLink = std::make_shared<Link>(nodeVector.at(2), nodeVector.at(1), 8000, 0.1, simulatorGlobals, scheduler, "third");
+	regionRouteTable->addRoute(3, nodeVector.at(0), nodeVector.at(1), std::vector<std::shared_ptr<Entity>>({ nodeVector.at(0), nodeVector.at(1) }),
+		std::vector<std::shared_ptr<Link>>({ primaryLink }));
+	regionRouteTable->addRoute(3, nodeVector.at(2), nodeVector.at(3), std::vector<std::shared_ptr<Entity>>({ nodeVector.at(2), nodeVector.at(3) }),
+		std::vector<std::shared_ptr<Link>>({ backupLink }));
+	regionRouteTable->addRoute(3, nodeVector.at(2), nodeVector.at(1), std::vector<std::shared_ptr<Entity>>({ nodeVector.at(2), nodeVector.at(1) }),
+		std::vector<std::shared_ptr<Link>>({ thirdLink }));
+	thirdLink->addLinkStateObserver(regionRouteTable);
+	regionRouteTable->setActiveRoute(3, 2);
+	// Primary goes down: regions 1 and 2 fail over, region 3 is not on the primary route and keeps its route.
+	primaryLink->setDown();
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(2));
+	EXPECT_EQ(2, regionRouteTable->getActiveRouteIndex(3));
+	// Third link goes down: region 3 falls back to the most preferred usable route.
+	thirdLink->setDown();
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(3));
+	// Primary comes back: regions fail back; region 3 cannot return to the third route yet and takes the most preferred one.
+	primaryLink->setUp();
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(3));
+	// Third link comes back: region 3 returns to the route it was switched from.
+	thirdLink->setUp();
+	EXPECT_EQ(2, regionRouteTable->getActiveRouteIndex(3));
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+}
+
+/// Test that an administrative route is not undone when another link comes up.
+TEST_F(RegionRouteTableTest, LinkUpKeepsAdministrativeRoute) {
+	regionRouteTable->setActiveRoute(2, 1);
+	primaryLink->setDown();
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(2));
+	primaryLink->setUp();
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(2));
+	EXPECT_EQ(3, regionRouteTable->getRerouteCount());
+}
+
+/// Test that an administrative route fails over when its link goes down, and is restored when it comes up.
+TEST_F(RegionRouteTableTest, AdministrativeRouteFailback) {
+	regionRouteTable->setActiveRoute(2, 1);
+	backupLink->setDown();
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(2));
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	backupLink->setUp();
+	EXPECT_EQ(1, regionRouteTable->getActiveRouteIndex(2));
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	// A new administrative choice cancels the pending failback.
+	backupLink->setDown();
+	regionRouteTable->setActiveRoute(2, 0);
+	backupLink->setUp();
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(2));
+}
+
+/// Test the split of the sources of a region between two routes.
+TEST_F(RegionRouteTableTest, SplitRoute) {
+	const unsigned int sourcesCount = 10000;
+	EXPECT_FALSE(regionRouteTable->isRegionSplit(1));
+	regionRouteTable->setSplitRoute(1, 1, 0.5, 12345);
+	EXPECT_TRUE(regionRouteTable->isRegionSplit(1));
+	EXPECT_FALSE(regionRouteTable->isRegionSplit(2));
+	EXPECT_EQ(0, regionRouteTable->getActiveRouteIndex(1));
+	std::vector<bool> isSplit(sourcesCount);
+	unsigned int splitCount = 0;
+	for (unsigned int sourceKey = 0; sourceKey < sourcesCount; ++sourceKey) {
+		isSplit[sourceKey] = regionRouteTable->getActiveRoute(1, sourceKey).destination == nodeVector.at(3);
+		splitCount += isSplit[sourceKey] ? 1 : 0;
+		// Region 2 is not split.
+		EXPECT_EQ(nodeVector.at(1), regionRouteTable->getActiveRoute(2, sourceKey).destination);
+	}
+	EXPECT_NEAR(0.5, static_cast<double>(splitCount) / sourcesCount, 0.02);
+	// Each source keeps its share.
+	for (unsigned int sourceKey = 0; sourceKey < sourcesCount; ++sourceKey) {
+		EXPECT_EQ(isSplit[sourceKey], regionRouteTable->getActiveRoute(1, sourceKey).destination == nodeVector.at(3));
+	}
+	// The split route down: all sources follow the active route.
+	backupLink->setDown();
+	for (unsigned int sourceKey = 0; sourceKey < sourcesCount; ++sourceKey) {
+		EXPECT_EQ(nodeVector.at(1), regionRouteTable->getActiveRoute(1, sourceKey).destination);
+	}
+	backupLink->setUp();
+	// Bounds of the fraction.
+	regionRouteTable->setSplitRoute(1, 1, 1.0, 12345);
+	regionRouteTable->setSplitRoute(2, 1, 0.0, 12345);
+	for (unsigned int sourceKey = 0; sourceKey < sourcesCount; ++sourceKey) {
+		EXPECT_EQ(nodeVector.at(3), regionRouteTable->getActiveRoute(1, sourceKey).destination);
+		EXPECT_EQ(nodeVector.at(1), regionRouteTable->getActiveRoute(2, sourceKey).destination);
+	}
+	regionRouteTable->clearSplitRoute(1);
+	EXPECT_FALSE(regionRouteTable->isRegionSplit(1));
+	EXPECT_EQ(nodeVector.at(1), regionRouteTable->getActiveRoute(1, 0).destination);
+	EXPECT_THROW(regionRouteTable->setSplitRoute(1, 2, 0.5, 0), std::out_of_range);
+}
+
+/// Test QCN sensor PDUs routed through the region route table.
+TEST_F(RegionRouteTableTest, QcnSensorTrafficGenerator) {
+	QcnSensorTrafficGenerator qcnSensorTrafficGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, nodeVector.at(0),
+		nodeVector.at(1), 1, 0.0, 0.0, 100, 1);
+	qcnSensorTrafficGenerator.turnOn();
+	auto pdu = qcnSensorTrafficGenerator.createInstanceTrafficEventPdu(512, nullptr, *regionRouteTable);
+	EXPECT_EQ(nodeVector.at(0), pdu->source);
+	EXPECT_EQ(nodeVector.at(1), pdu->destination);
+	EXPECT_EQ(nodeVector.at(0), pdu->next);
+	EXPECT_EQ(1, scheduler.getChainSize());
+	// Fail the primary link; the generator itself is not modified, but its next PDU follows the backup route.
+	primaryLink->setDown();
+	pdu = qcnSensorTrafficGenerator.createInstanceTrafficEventPdu(512, nullptr, *regionRouteTable);
+	EXPECT_EQ(nodeVector.at(2), pdu->source);
+	EXPECT_EQ(nodeVector.at(3), pdu->destination);
+	EXPECT_EQ(nodeVector.at(2), pdu->previous);
+	EXPECT_EQ(std::vector<std::shared_ptr<Entity>>({ nodeVector.at(2), nodeVector.at(3) }), pdu->getExplicitRoute());
+	EXPECT_EQ(nodeVector.at(0), qcnSensorTrafficGenerator.getSource());
+	EXPECT_EQ(1, qcnSensorTrafficGenerator.getRegionId());
+}
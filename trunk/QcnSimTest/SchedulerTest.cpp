@@ -355,4 +355,210 @@ TEST_F(SchedulerTest, RemoveEventFromChain) {
 	// Remove events from token4. None.
 	EXPECT_EQ(0, scheduler.removeEvents(token4));
 	EXPECT_EQ(2, scheduler.getChainSize());
-}
\ No newline at end of file
+}
+/// Events are caused in the same exact order with and without the timing wheel: zero and short delays, ties, events beyond the horizon and scheduleFront().
+TEST_F(SchedulerTest, TimingWheelExactOrder) {
+	std::vector<std::shared_ptr<Token>> tokens;
+	for (unsigned int i = 0; i < 64; ++i) {
+		tokens.push_back(std::make_shared<Token>(i, 0, nullptr, nullptr, nullptr));
+	}
+	// Runs the same workload on a scheduler and returns the times and entities of the events caused, in order.
+	auto runWorkload = [&tokens](unsigned int wheelLevels) {
+		SimulatorGlobals workloadGlobals(0.0, 0.0, false, "TimingWheelExactOrder");
+		Scheduler workloadScheduler(workloadGlobals);
+		workloadScheduler.setTimingWheel(0.001, wheelLevels);
+		std::mt19937 engine(2014);
+		std::uniform_int_distribution<unsigned int> tokenDistribution(0, static_cast<unsigned int>(tokens.size() - 1));
+		std::uniform_int_distribution<int> kindDistribution(0, 9);
+		std::exponential_distribution<double> shortDelayDistribution(5000.0);
+		std::uniform_real_distribution<double> farDelayDistribution(1.0, 2000.0);
+		auto scheduleRandom = [&]() {
+			std::shared_ptr<Token> token = tokens[tokenDistribution(engine)];
+			int kind = kindDistribution(engine);
+			if (kind < 3) {
+				workloadScheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, token));
+			} else if (kind < 6) {
+				workloadScheduler.schedule(Event(shortDelayDistribution(engine), EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, token));
+			} else if (kind < 8) {
+				// Transmission times, multiples of the same value: ties across ticks.
+				workloadScheduler.schedule(Event(0.0004 * (1 + kind), EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK, token));
+			} else if (kind < 9) {
+				workloadScheduler.schedule(Event(farDelayDistribution(engine), EventType::TRAFFIC_GENERATOR_ARRIVAL, token));
+			} else {
+				workloadScheduler.scheduleFront(Event(0.0, EventType::BEGIN_SIMULATION, token));
+			}
+		};
+		for (int i = 0; i < 2000; ++i) {
+			scheduleRandom();
+		}
+		std::vector<std::pair<double, const Entity *>> causedEvents;
+		while (workloadScheduler.getChainSize() > 0) {
+			Event event = workloadScheduler.cause();
+			causedEvents.push_back(std::make_pair(workloadGlobals.getCurrentAbsoluteTime(), event.entity.get()));
+			if (causedEvents.size() < 50000) {
+				// One new event per event caused, on average.
+				int newEventsCount = kindDistribution(engine);
+				newEventsCount = newEventsCount == 0 ? 0 : (newEventsCount < 9 ? 1 : 2);
+				for (int i = 0; i < newEventsCount; ++i) {
+					scheduleRandom();
+				}
+			}
+		}
+		return causedEvents;
+	};
+	std::vector<std::pair<double, const Entity *>> listEvents = runWorkload(0);
+	std::vector<std::pair<double, const Entity *>> wheelEvents = runWorkload(SCHEDULER_WHEEL_LEVELS);
+	std::vector<std::pair<double, const Entity *>> shallowWheelEvents = runWorkload(1);
+	ASSERT_EQ(listEvents.size(), wheelEvents.size());
+	ASSERT_EQ(listEvents.size(), shallowWheelEvents.size());
+	EXPECT_GT(listEvents.size(), 50000u);
+	for (std::vector<std::pair<double, const Entity *>>::size_type i = 0; i < listEvents.size(); ++i) {
+		ASSERT_EQ(listEvents[i], wheelEvents[i]) << "at event " << i;
+		ASSERT_EQ(listEvents[i], shallowWheelEvents[i]) << "at event " << i;
+		if (i > 0) {
+			ASSERT_LE(listEvents[i - 1].first, listEvents[i].first);
+		}
+	}
+}
+
+/// Events move between the timing wheel and the event chain when the wheel is configured; removal and sizes cover both.
+TEST_F(SchedulerTest, TimingWheelConfiguration) {
+	EXPECT_NEAR(SCHEDULER_WHEEL_TICK * SCHEDULER_WHEEL_SLOTS * SCHEDULER_WHEEL_SLOTS * SCHEDULER_WHEEL_SLOTS, scheduler.getTimingWheelHorizon(), 1e-9);
+	std::shared_ptr<Message> message1(new Message("near"));
+	std::shared_ptr<Message> message2(new Message("far"));
+	scheduler.schedule(Event(0.0005, EventType::BEGIN_SIMULATION, message1));
+	scheduler.schedule(Event(0.02, EventType::BEGIN_SIMULATION, message1));
+	scheduler.schedule(Event(5000.0, EventType::END_SIMULATION, message2));
+	scheduler.schedule(Event(0.02, EventType::BEGIN_SIMULATION, message2));
+	EXPECT_EQ(4, scheduler.getChainSize());
+	scheduler.setTimingWheel(1.0, 0);
+	EXPECT_EQ(0.0, scheduler.getTimingWheelHorizon());
+	EXPECT_EQ(4, scheduler.getChainSize());
+	scheduler.setTimingWheel(0.0001, 2);
+	EXPECT_EQ(2, scheduler.removeEvents(message2));
+	EXPECT_EQ(2, scheduler.getChainSize());
+	Event event = scheduler.cause();
+	EXPECT_EQ(0.0005, simulatorGlobals.getCurrentAbsoluteTime());
+	event = scheduler.cause();
+	EXPECT_EQ(0.02, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(0, scheduler.getChainSize());
+}
+
+/// Zero-delay events come after the events already scheduled for the current time, and scheduleFront() events before them, as in a single list.
+TEST_F(SchedulerTest, ZeroDelayQueue) {
+	std::vector<std::shared_ptr<Message>> messages;
+	for (auto name : {"A", "B", "C", "Z1", "Z2", "Z3", "F1", "F2", "Removed"}) {
+		messages.push_back(std::make_shared<Message>(name));
+	}
+	scheduler.schedule(Event(1.0, EventType::BEGIN_SIMULATION, messages[0]));
+	scheduler.schedule(Event(1.0, EventType::BEGIN_SIMULATION, messages[1]));
+	scheduler.schedule(Event(1.0, EventType::BEGIN_SIMULATION, messages[2]));
+	scheduler.schedule(Event(2.0, EventType::END_SIMULATION, nullptr));
+	EXPECT_EQ(messages[0], scheduler.cause().entity);
+	EXPECT_EQ(1.0, simulatorGlobals.getCurrentAbsoluteTime());
+	scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, messages[3]));
+	scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, messages[8]));
+	scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, messages[4]));
+	scheduler.scheduleFront(Event(0.0, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY, messages[6]));
+	scheduler.scheduleFront(Event(0.0, EventType::REQUEST_SERVICE_FOR_TOKEN_AT_FACILITY, messages[7]));
+	EXPECT_EQ(8, scheduler.getChainSize());
+	EXPECT_EQ(1, scheduler.removeEvents(messages[8]));
+	EXPECT_EQ(7, scheduler.getChainSize());
+	EXPECT_EQ(messages[7], scheduler.cause().entity);
+	EXPECT_EQ(messages[6], scheduler.cause().entity);
+	EXPECT_EQ(messages[1], scheduler.cause().entity);
+	scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, messages[5]));
+	EXPECT_EQ(messages[2], scheduler.cause().entity);
+	EXPECT_EQ(messages[3], scheduler.cause().entity);
+	EXPECT_EQ(messages[4], scheduler.cause().entity);
+	EXPECT_EQ(messages[5], scheduler.cause().entity);
+	EXPECT_EQ(1.0, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(EventType::END_SIMULATION, scheduler.cause().eventType);
+	EXPECT_EQ(2.0, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(0, scheduler.getChainSize());
+}
+
+/// Continuations are fused only when nothing else is pending at the current time; verification mode causes them instead, with the same result.
+TEST_F(SchedulerTest, Fusion) {
+	auto messageA = std::make_shared<Message>("A");
+	auto messageB = std::make_shared<Message>("B");
+	scheduler.schedule(Event(1.0, EventType::END_PROPAGATION_AT_LINK, messageA));
+	scheduler.schedule(Event(1.0, EventType::END_PROPAGATION_AT_LINK, messageB));
+	scheduler.schedule(Event(2.0, EventType::END_SIMULATION, nullptr));
+	// Fusion off: always scheduled.
+	Event event = scheduler.cause();
+	EXPECT_FALSE(scheduler.scheduleOrFuse(event, EventType::PDUTOKEN_ARRIVAL_AT_NODE));
+	EXPECT_EQ(3, scheduler.getChainSize());
+	EXPECT_EQ(0, scheduler.getFusedEventsCount());
+	// Fusion on, but B is pending at the current time: scheduled after B.
+	scheduler.setFusion(true);
+	event = scheduler.cause();
+	EXPECT_EQ(messageB, event.entity);
+	EXPECT_FALSE(scheduler.isCurrentTimeDrained());
+	EXPECT_FALSE(scheduler.scheduleOrFuse(event, EventType::PDUTOKEN_ARRIVAL_AT_NODE));
+	event = scheduler.cause();
+	EXPECT_EQ(messageA, event.entity);
+	EXPECT_FALSE(scheduler.isCurrentTimeDrained());
+	event = scheduler.cause();
+	EXPECT_EQ(messageB, event.entity);
+	EXPECT_EQ(EventType::PDUTOKEN_ARRIVAL_AT_NODE, event.eventType);
+	EXPECT_TRUE(scheduler.isCurrentTimeDrained());
+	// Current time drained: fused, with nothing scheduled.
+	EXPECT_TRUE(scheduler.scheduleOrFuse(event, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK));
+	EXPECT_EQ(messageB, event.entity);
+	EXPECT_EQ(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, event.eventType);
+	EXPECT_EQ(1, scheduler.getChainSize());
+	EXPECT_EQ(1, scheduler.getFusedEventsCount());
+	// Verification mode: scheduled and caused, giving the same event.
+	scheduler.setFusion(true, true);
+	EXPECT_TRUE(scheduler.scheduleOrFuse(event, EventType::PDUTOKEN_ARRIVAL_AT_NODE));
+	EXPECT_EQ(messageB, event.entity);
+	EXPECT_EQ(EventType::PDUTOKEN_ARRIVAL_AT_NODE, event.eventType);
+	EXPECT_EQ(1.0, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(1, scheduler.getChainSize());
+	EXPECT_EQ(2, scheduler.getFusedEventsCount());
+	EXPECT_EQ(EventType::END_SIMULATION, scheduler.cause().eventType);
+}
+
+/// Payloads within the event chain: owned entities are kept until caused or removed, entity pointers and link IDs are carried as they are.
+TEST_F(SchedulerTest, EventPayloads) {
+	std::shared_ptr<Token> token = std::make_shared<Token>(1, 0, nullptr, nullptr, nullptr);
+	std::shared_ptr<Message> message = std::make_shared<Message>("removed");
+	std::shared_ptr<Message> component = std::make_shared<Message>("not owned");
+	std::weak_ptr<Token> tokenReference = token;
+	std::weak_ptr<Message> messageReference = message;
+	scheduler.schedule(Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, token));
+	scheduler.schedule(Event(2.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, message));
+	scheduler.schedule(Event(3.0, EventType::BEGIN_SIMULATION, std::shared_ptr<const Entity>(std::shared_ptr<const Entity>(), component.get())));
+	scheduler.schedule(Event::createLinkEvent(4.0, EventType::SET_LINK_DOWN, 42));
+	token.reset();
+	message.reset();
+	// The event chain owns the token and the message.
+	EXPECT_FALSE(tokenReference.expired());
+	EXPECT_FALSE(messageReference.expired());
+	EXPECT_EQ(1, scheduler.removeEvents(messageReference.lock()));
+	EXPECT_TRUE(messageReference.expired());
+
+	Event event = scheduler.cause();
+	EXPECT_EQ(EventPayloadType::TOKEN, event.payloadType);
+	EXPECT_EQ(tokenReference.lock(), event.getEntityAs<Token>());
+	event = scheduler.cause();
+	EXPECT_TRUE(tokenReference.expired());
+	EXPECT_EQ(EventPayloadType::ENTITY_POINTER, event.payloadType);
+	EXPECT_EQ(component, event.getEntityAs<Message>());
+	EXPECT_EQ(0, event.entity.use_count());
+	event = scheduler.cause();
+	EXPECT_EQ(EventPayloadType::LINK_ID, event.payloadType);
+	EXPECT_EQ(EventType::SET_LINK_DOWN, event.eventType);
+	EXPECT_EQ(42, event.linkId);
+	EXPECT_EQ(nullptr, event.entity);
+	EXPECT_EQ(0, scheduler.getChainSize());
+
+	// Slots are reused: entities scheduled later are kept as well.
+	for (uint32_t tokenId = 0; tokenId < 10; ++tokenId) {
+		scheduler.schedule(Event(tokenId, EventType::PDUTOKEN_ARRIVAL_AT_NODE, std::make_shared<Token>(tokenId, 0, nullptr, nullptr, nullptr)));
+	}
+	for (uint32_t tokenId = 0; tokenId < 10; ++tokenId) {
+		EXPECT_EQ(tokenId, scheduler.cause().getEntityAs<Token>()->id);
+	}
+}
@@ -38,6 +38,9 @@
 #include "../QcnSim/Message.h"
 #include "../QcnSim/Token.h"
 #include <memory>
+#include <random>
+#include <utility>
+#include <vector>
 
 
 /// Fixture for Scheduler Tests.
@@ -0,0 +1,165 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "SensorSpatialIndexTest.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#define SPATIAL_TEST_NUMBER_OF_SENSORS 5000 //!< Number of sensors of the test topology.
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+SensorSpatialIndexTest::SensorSpatialIndexTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "SensorSpatialIndexTest")), scheduler(Scheduler(simulatorGlobals)) {
+	std::mt19937 engine(2014);
+	std::uniform_real_distribution<double> latitudeDistribution(32.0, 42.0);
+	std::uniform_real_distribution<double> longitudeDistribution(-124.0, -114.0);
+	for (unsigned int sensorId = 1; sensorId <= SPATIAL_TEST_NUMBER_OF_SENSORS; ++sensorId) {
+		topology.qcnSensorTrafficGeneratorMap[sensorId] = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler,
+			EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, nullptr, nullptr, 1, latitudeDistribution(engine), longitudeDistribution(engine), sensorId);
+	}
+}
+
+/**
+ * Straight-line distance between a hypocenter and a sensor at the surface, in Km.
+ */
+double SensorSpatialIndexTest::hypocentralDistance(double latitude, double longitude, double depth, double sensorLatitude, double sensorLongitude) {
+	double angle = GeoUtilities::greatCircleDistance(latitude, longitude, sensorLatitude, sensorLongitude) / EARTH_RADIUS;
+	double hypocenterRadius = EARTH_RADIUS - depth;
+	return std::sqrt(EARTH_RADIUS * EARTH_RADIUS + hypocenterRadius * hypocenterRadius - 2.0 * EARTH_RADIUS * hypocenterRadius * std::cos(angle));
+}
+
+/// Radius queries find exactly the sensors found by brute force.
+TEST_F(SensorSpatialIndexTest, RadiusQuery) {
+	SensorSpatialIndex sensorSpatialIndex(topology);
+	EXPECT_EQ(SPATIAL_TEST_NUMBER_OF_SENSORS, sensorSpatialIndex.getSize());
+	std::vector<double> radii = {0.0, 5.0, 50.0, 200.0, 20000.0};
+	for (auto radius : radii) {
+		std::vector<unsigned int> expectedIds;
+		for (auto &sensorPair : topology.qcnSensorTrafficGeneratorMap) {
+			if (GeoUtilities::greatCircleDistance(37.0, -119.0, sensorPair.second->getLatitude(), sensorPair.second->getLongitude()) <= radius) {
+				expectedIds.push_back(sensorPair.first);
+			}
+		}
+		std::vector<unsigned int> foundIds;
+		for (auto &entity : sensorSpatialIndex.findWithinRadius(37.0, -119.0, radius)) {
+			foundIds.push_back(std::static_pointer_cast<QcnSensorTrafficGenerator>(entity)->getQcnExplorerSensorId());
+		}
+		std::sort(foundIds.begin(), foundIds.end());
+		EXPECT_EQ(expectedIds, foundIds) << "Radius " << radius;
+	}
+	// A sensor exactly at the center is found with radius zero.
+	auto sensor = topology.qcnSensorTrafficGeneratorMap.at(42);
+	auto found = sensorSpatialIndex.findWithinRadius(sensor->getLatitude(), sensor->getLongitude(), 0.0);
+	ASSERT_EQ(1, found.size());
+	EXPECT_EQ(sensor, found[0]);
+}
+
+/// k-nearest queries return the nearest sensors in distance order; sensors are assigned to their nearest servers.
+TEST_F(SensorSpatialIndexTest, NearestAndAssignment) {
+	SensorSpatialIndex sensorSpatialIndex;
+	sensorSpatialIndex.addSensors(topology);
+	std::vector<std::pair<double, unsigned int>> distances;
+	for (auto &sensorPair : topology.qcnSensorTrafficGeneratorMap) {
+		distances.push_back(std::make_pair(GeoUtilities::greatCircleDistance(34.0, -118.0, sensorPair.second->getLatitude(), sensorPair.second->getLongitude()),
+			sensorPair.first));
+	}
+	std::sort(distances.begin(), distances.end());
+	std::vector<std::shared_ptr<Entity>> nearest = sensorSpatialIndex.findNearest(34.0, -118.0, 25);
+	ASSERT_EQ(25, nearest.size());
+	for (int i = 0; i < 25; ++i) {
+		EXPECT_EQ(distances[i].second, std::static_pointer_cast<QcnSensorTrafficGenerator>(nearest[i])->getQcnExplorerSensorId());
+	}
+	EXPECT_EQ(SPATIAL_TEST_NUMBER_OF_SENSORS, sensorSpatialIndex.findNearest(34.0, -118.0, SPATIAL_TEST_NUMBER_OF_SENSORS + 10).size());
+	EXPECT_TRUE(sensorSpatialIndex.findNearest(34.0, -118.0, 0).empty());
+
+	// Servers at Los Angeles, San Francisco and Las Vegas.
+	SensorSpatialIndex serverIndex;
+	std::vector<std::pair<double, double>> serverLocations = {{34.05, -118.24}, {37.77, -122.42}, {36.17, -115.14}};
+	std::vector<std::shared_ptr<Entity>> servers;
+	for (auto &location : serverLocations) {
+		servers.push_back(std::make_shared<Message>("Server."));
+		serverIndex.add(location.first, location.second, servers.back());
+	}
+	auto assignments = sensorSpatialIndex.assignNearest(serverIndex, 2);
+	ASSERT_EQ(SPATIAL_TEST_NUMBER_OF_SENSORS, assignments.size());
+	for (auto &assignment : assignments) {
+		auto sensor = std::static_pointer_cast<QcnSensorTrafficGenerator>(assignment.first);
+		std::vector<std::pair<double, std::shared_ptr<Entity>>> serverDistances;
+		for (std::vector<std::shared_ptr<Entity>>::size_type i = 0; i < servers.size(); ++i) {
+			serverDistances.push_back(std::make_pair(GeoUtilities::greatCircleDistance(serverLocations[i].first, serverLocations[i].second, sensor->getLatitude(),
+				sensor->getLongitude()), servers[i]));
+		}
+		std::sort(serverDistances.begin(), serverDistances.end());
+		ASSERT_EQ(2, assignment.second.size());
+		EXPECT_EQ(serverDistances[0].second, assignment.second[0]);
+		EXPECT_EQ(serverDistances[1].second, assignment.second[1]);
+	}
+}
+
+/// Sweeps return sensors in increasing hypocentral distance, incrementally.
+TEST_F(SensorSpatialIndexTest, Sweep) {
+	SensorSpatialIndex sensorSpatialIndex(topology);
+	std::vector<double> expectedDistances;
+	for (auto &sensorPair : topology.qcnSensorTrafficGeneratorMap) {
+		expectedDistances.push_back(hypocentralDistance(36.0, -120.0, 15.0, sensorPair.second->getLatitude(), sensorPair.second->getLongitude()));
+	}
+	std::sort(expectedDistances.begin(), expectedDistances.end());
+	SensorSpatialIndex::Sweep sweep = sensorSpatialIndex.sweep(36.0, -120.0, 15.0);
+	std::vector<std::shared_ptr<Entity>> reached = sweep.advanceTo(100.0);
+	std::vector<double>::size_type expectedReached = std::upper_bound(expectedDistances.begin(), expectedDistances.end(), 100.0) - expectedDistances.begin();
+	EXPECT_EQ(expectedReached, reached.size());
+	std::vector<double>::size_type i = reached.size();
+	while (sweep.hasNext()) {
+		ASSERT_LT(i, expectedDistances.size());
+		EXPECT_NEAR(expectedDistances[i], sweep.getNextDistance(), 1e-6);
+		auto sensor = std::static_pointer_cast<QcnSensorTrafficGenerator>(sweep.next());
+		EXPECT_NEAR(expectedDistances[i], hypocentralDistance(36.0, -120.0, 15.0, sensor->getLatitude(), sensor->getLongitude()), 1e-6);
+		++i;
+	}
+	EXPECT_EQ(expectedDistances.size(), i);
+	EXPECT_EQ(nullptr, sweep.next());
+	EXPECT_TRUE(std::isinf(sweep.getNextDistance()));
+
+	SensorSpatialIndex emptyIndex;
+	EXPECT_FALSE(emptyIndex.sweep(36.0, -120.0).hasNext());
+	EXPECT_TRUE(emptyIndex.findWithinRadius(36.0, -120.0, 100.0).empty());
+}
+
+/// A wavefront sweep reaches sensors in the order of the S-wave arrival times of QuakeWaveModel.
+TEST_F(SensorSpatialIndexTest, WavefrontArrivalOrder) {
+	EarthquakeData earthquake(1, 6.0, 10.0, 3.5, 8.0, 37.5, -121.0);
+	QuakeWaveModel quakeWaveModel(simulatorGlobals);
+	quakeWaveModel.addSensors(topology);
+	quakeWaveModel.evaluate(earthquake);
+	std::vector<double> arrivalTimes = quakeWaveModel.getSWaveArrivalTimes();
+	std::sort(arrivalTimes.begin(), arrivalTimes.end());
+	SensorSpatialIndex sensorSpatialIndex(topology);
+	SensorSpatialIndex::Sweep sweep = sensorSpatialIndex.sweep(earthquake.latitude, earthquake.longitude, earthquake.depth);
+	std::vector<double>::size_type arrivals = 0;
+	for (double time = earthquake.eventTime; arrivals < arrivalTimes.size(); time += 5.0) {
+		for (auto &entity : sweep.advanceTo((time - earthquake.eventTime) * earthquake.sWaveSpeed)) {
+			auto sensor = std::static_pointer_cast<QcnSensorTrafficGenerator>(entity);
+			double arrivalTime = earthquake.eventTime + hypocentralDistance(earthquake.latitude, earthquake.longitude, earthquake.depth,
+				sensor->getLatitude(), sensor->getLongitude()) / earthquake.sWaveSpeed;
+			EXPECT_NEAR(arrivalTimes[arrivals], arrivalTime, 1e-6);
+			EXPECT_LE(arrivalTime, time + 1e-9);
+			++arrivals;
+		}
+	}
+	EXPECT_FALSE(sweep.hasNext());
+}
@@ -0,0 +1,630 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "SimulationCheckpointTest.h"
+#include "../QcnSim/AggregatePoissonTrafficGenerator.h"
+#include "../QcnSim/DetectionEngine.h"
+#include "../QcnSim/EarthquakeData.h"
+#include "../QcnSim/HostAvailabilityModel.h"
+#include "../QcnSim/SeismicEventData.h"
+#include "../QcnSim/TraceReplayTrafficGenerator.h"
+#include "../QcnSim/TrickleOutbox.h"
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+
+const std::string SimulationCheckpointTest::checkpointFileName = "SimulationCheckpointTest.bin";
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+SimulationCheckpointTest::SimulationCheckpointTest() {
+}
+
+/**
+ * Destructor.
+ *
+ * Do cleanup here.
+ */
+SimulationCheckpointTest::~SimulationCheckpointTest() {
+	std::remove(checkpointFileName.c_str());
+}
+
+/**
+ * Build sensor -> router -> server, with a slow first link so that PDUs queue up, and one sensor.
+ */
+void SimulationCheckpointTest::buildTopology(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, Topology &topology) {
+	topology.nodeMap[1] = std::make_shared<Node>(simulatorGlobals, 0);
+	topology.nodeMap[2] = std::make_shared<Node>(simulatorGlobals, 1);
+	topology.nodeMap[3] = std::make_shared<Node>(simulatorGlobals, 2);
+	topology.linkMap[12] = std::make_shared<Link>(topology.nodeMap.at(1), topology.nodeMap.at(2), 8000.0, 0.05, simulatorGlobals, scheduler, "slow");
+	topology.linkMap[23] = std::make_shared<Link>(topology.nodeMap.at(2), topology.nodeMap.at(3), 1e6, 0.01, simulatorGlobals, scheduler, "fast",
+		LinkType::DUPLEX_LINK);
+	topology.qcnSensorTrafficGeneratorMap[7] = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler,
+		EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, topology.nodeMap.at(1), topology.nodeMap.at(3), 1, 41.0, -77.0, 7, 1);
+	topology.qcnSensorTrafficGeneratorMap[7]->turnOn();
+	topology.explicitRouteMap[7] = {topology.nodeMap.at(1), topology.nodeMap.at(2), topology.nodeMap.at(3)};
+}
+
+/**
+ * Process up to numberOfEvents events, or until the end of the simulation, recording each one (time, type, PDU ID) into trace.
+ *
+ * Seismic detections arrive with exponential interarrival times drawn from the simulator random engine, and each one makes the sensor send a PDU.
+ */
+void SimulationCheckpointTest::runSimulation(SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, Topology &topology, unsigned int numberOfEvents,
+											 std::vector<std::string> &trace) {
+	std::exponential_distribution<double> interarrival(10.0);
+	for (unsigned int i = 0; i < numberOfEvents && scheduler.getChainSize() > 0; ++i) {
+		Event currentEvent = scheduler.cause();
+		std::shared_ptr<ProtocolDataUnit> pdu = std::dynamic_pointer_cast<ProtocolDataUnit>(std::const_pointer_cast<Entity>(currentEvent.entity));
+		std::ostringstream traceLine;
+		traceLine.precision(17);
+		traceLine << simulatorGlobals.getCurrentAbsoluteTime() << " " << static_cast<int>(currentEvent.eventType) << " " << ((pdu != nullptr) ? pdu->id : 0);
+		trace.push_back(traceLine.str());
+		std::shared_ptr<Link> link; // Link towards the next hop of the PDU.
+		if (pdu != nullptr) {
+			for (auto &linkMapIterator : topology.linkMap) {
+				if (linkMapIterator.second->getNodeB() == pdu->next) {
+					link = linkMapIterator.second;
+				}
+			}
+		}
+		switch (currentEvent.eventType) {
+			case EventType::END_SIMULATION:
+				return;
+			case EventType::SEISMIC_EVENT_DETECTION: {
+				auto seismicEventData = std::dynamic_pointer_cast<SeismicEventData>(std::const_pointer_cast<Entity>(currentEvent.entity));
+				topology.qcnSensorTrafficGeneratorMap.at(seismicEventData->qcnExplorerSensorId)->createInstanceTrafficEventPdu(1000, seismicEventData,
+					topology.explicitRouteMap.at(seismicEventData->qcnExplorerSensorId));
+				double nextTime = interarrival(simulatorGlobals.getRandomNumberGeneratorEngineInstance());
+				scheduler.schedule(Event(nextTime, EventType::SEISMIC_EVENT_DETECTION, std::make_shared<SeismicEventData>(7, 41.0, -77.0, 5.0,
+					simulatorGlobals.getCurrentAbsoluteTime() + nextTime, 10.0, 1)));
+				break;
+			}
+			case EventType::TRAFFIC_GENERATOR_ARRIVAL:
+			case EventType::END_PROPAGATION_AT_LINK:
+				scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pdu));
+				break;
+			case EventType::PDUTOKEN_ARRIVAL_AT_NODE:
+				if (link != nullptr) {
+					link->endPropagation(pdu);
+				}
+				if (std::dynamic_pointer_cast<Node>(pdu->next)->processAndForward(pdu) != NodeReturnType::FINAL_DESTINATION) {
+					scheduler.schedule(Event(0.0, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, pdu));
+				}
+				break;
+			case EventType::REQUEST_PDU_TRANSMISSION_AT_LINK:
+				link->transmitPdu(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK, pdu);
+				break;
+			case EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK:
+				link->propagatePdu(EventType::END_PROPAGATION_AT_LINK, pdu);
+				break;
+			default:
+				FAIL() << "Unexpected event type " << static_cast<int>(currentEvent.eventType);
+		}
+	}
+}
+
+/// Checkpoint in the middle of a run, restore into a rebuilt simulation, check that both continue identically.
+TEST_F(SimulationCheckpointTest, RestartIsIdentical) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	buildTopology(simulatorGlobals, scheduler, topology);
+	simulatorGlobals.seedRandomNumberGenerator(12345);
+	scheduler.schedule(Event(0.0, EventType::SEISMIC_EVENT_DETECTION, std::make_shared<SeismicEventData>(7, 41.0, -77.0, 5.0, 0.0, 10.0, 1)));
+	scheduler.schedule(Event(20.0, EventType::END_SIMULATION, nullptr));
+	std::vector<std::string> trace;
+	runSimulation(simulatorGlobals, scheduler, topology, 500, trace);
+	// Warm state: PDUs queued at the slow link, in service and in transit.
+	ASSERT_GT(topology.linkMap.at(12)->getTransmissionQueueSize(), 0);
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+	trace.clear();
+	runSimulation(simulatorGlobals, scheduler, topology, std::numeric_limits<unsigned int>::max(), trace);
+
+	// Rebuild the simulation from scratch, restore and run to the end.
+	SimulatorGlobals restartedSimulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler restartedScheduler(restartedSimulatorGlobals);
+	Topology restartedTopology;
+	buildTopology(restartedSimulatorGlobals, restartedScheduler, restartedTopology);
+	SimulationCheckpoint restartedCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, restartedCheckpoint.restore(checkpointFileName, restartedTopology))
+		<< restartedCheckpoint.getErrorMessage();
+	std::vector<std::string> restartedTrace;
+	runSimulation(restartedSimulatorGlobals, restartedScheduler, restartedTopology, std::numeric_limits<unsigned int>::max(), restartedTrace);
+
+	ASSERT_GT(trace.size(), 500);
+	EXPECT_EQ(trace, restartedTrace);
+	EXPECT_EQ(simulatorGlobals.getCurrentAbsoluteTime(), restartedSimulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(simulatorGlobals.getTokenNextId(), restartedSimulatorGlobals.getTokenNextId());
+	EXPECT_EQ(topology.nodeMap.at(3)->getReceivedPdusOrTokensCount(), restartedTopology.nodeMap.at(3)->getReceivedPdusOrTokensCount());
+	EXPECT_EQ(topology.nodeMap.at(3)->getSumPduOrTokenDelay(), restartedTopology.nodeMap.at(3)->getSumPduOrTokenDelay());
+	EXPECT_EQ(topology.nodeMap.at(3)->getSumPduOrTokenJitter(), restartedTopology.nodeMap.at(3)->getSumPduOrTokenJitter());
+	EXPECT_EQ(topology.linkMap.at(12)->getTransmissionQueueSize(), restartedTopology.linkMap.at(12)->getTransmissionQueueSize());
+	EXPECT_EQ(topology.linkMap.at(12)->getMaxRecordedTransmissionQueueSize(), restartedTopology.linkMap.at(12)->getMaxRecordedTransmissionQueueSize());
+	EXPECT_EQ(topology.qcnSensorTrafficGeneratorMap.at(7)->getTokensGeneratedCount(),
+		restartedTopology.qcnSensorTrafficGeneratorMap.at(7)->getTokensGeneratedCount());
+}
+
+/// Links restored in the down state are down and notify their observers.
+TEST_F(SimulationCheckpointTest, LinkDown) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	buildTopology(simulatorGlobals, scheduler, topology);
+	topology.linkMap.at(23)->setDown();
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+
+	Topology restartedTopology;
+	buildTopology(simulatorGlobals, scheduler, restartedTopology);
+	auto forwardingTable = std::make_shared<ForwardingTable>();
+	forwardingTable->setEntry(2, restartedTopology.nodeMap.at(3), restartedTopology.linkMap.at(23));
+	restartedTopology.linkMap.at(23)->addLinkStateObserver(forwardingTable);
+	ASSERT_NE(nullptr, forwardingTable->findEntry(2));
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, simulationCheckpoint.restore(checkpointFileName, restartedTopology))
+		<< simulationCheckpoint.getErrorMessage();
+	EXPECT_FALSE(restartedTopology.linkMap.at(23)->isUp());
+	EXPECT_FALSE(restartedTopology.linkMap.at(23)->getReverseLink()->isUp());
+	EXPECT_TRUE(restartedTopology.linkMap.at(12)->isUp());
+	EXPECT_EQ(nullptr, forwardingTable->findEntry(2));
+}
+
+/// Payload tags are recomputed from the restored entities; link IDs are restored as they are.
+TEST_F(SimulationCheckpointTest, PayloadTags) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	buildTopology(simulatorGlobals, scheduler, topology);
+	std::shared_ptr<ProtocolDataUnit> pdu = topology.qcnSensorTrafficGeneratorMap.at(7)->createInstanceTrafficEventPdu(1000, nullptr,
+		topology.explicitRouteMap.at(7));
+	scheduler.schedule(Event(0.5, EventType::PDUTOKEN_ARRIVAL_AT_NODE, std::shared_ptr<const Entity>(pdu)));
+	scheduler.schedule(Event(0.6, EventType::SEISMIC_EVENT_DETECTION, std::make_shared<SeismicEventData>(7, 41.0, -77.0, 5.0, 0.6, 10.0, 1)));
+	scheduler.schedule(Event::createLinkEvent(0.65, EventType::SET_LINK_DOWN, 23));
+	scheduler.schedule(Event(0.7, EventType::END_SIMULATION, nullptr));
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+
+	Topology restartedTopology;
+	buildTopology(simulatorGlobals, scheduler, restartedTopology);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, simulationCheckpoint.restore(checkpointFileName, restartedTopology))
+		<< simulationCheckpoint.getErrorMessage();
+	// Generator arrival, then the events above, in order.
+	Event event = scheduler.cause();
+	EXPECT_EQ(EventPayloadType::PROTOCOL_DATA_UNIT, event.payloadType);
+	std::shared_ptr<ProtocolDataUnit> restoredPdu = event.getEntityAs<ProtocolDataUnit>();
+	ASSERT_NE(nullptr, restoredPdu);
+	EXPECT_EQ(pdu->id, restoredPdu->id);
+	event = scheduler.cause();
+	EXPECT_EQ(EventType::PDUTOKEN_ARRIVAL_AT_NODE, event.eventType);
+	EXPECT_EQ(EventPayloadType::PROTOCOL_DATA_UNIT, event.payloadType);
+	EXPECT_EQ(restoredPdu, event.getEntityAs<ProtocolDataUnit>());
+	event = scheduler.cause();
+	EXPECT_EQ(EventPayloadType::SEISMIC_EVENT_DATA, event.payloadType);
+	ASSERT_NE(nullptr, event.getEntityAs<SeismicEventData>());
+	EXPECT_EQ(7, event.getEntityAs<SeismicEventData>()->qcnExplorerSensorId);
+	event = scheduler.cause();
+	EXPECT_EQ(EventPayloadType::LINK_ID, event.payloadType);
+	EXPECT_EQ(23, event.linkId);
+	event = scheduler.cause();
+	EXPECT_EQ(EventPayloadType::NO_PAYLOAD, event.payloadType);
+}
+
+/// Autonomous aggregate Poisson generator added to the checkpoint: the restarted generator draws the same arrivals from the same sources.
+TEST_F(SimulationCheckpointTest, AggregatePoissonTrafficGenerator) {
+	auto buildGenerator = [](SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, Topology &topology) {
+		return std::make_shared<AggregatePoissonTrafficGenerator>(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr,
+			std::vector<std::shared_ptr<Entity>>({ topology.nodeMap.at(1), topology.nodeMap.at(2), topology.nodeMap.at(3) }), topology.nodeMap.at(3), 1,
+			std::vector<double>({ 1.0, 2.0, 4.0 }));
+	};
+	auto runGenerator = [](SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, AggregatePoissonTrafficGenerator &generator, unsigned int numberOfEvents,
+			std::vector<std::string> &trace) {
+		for (unsigned int i = 0; i < numberOfEvents; ++i) {
+			scheduler.cause();
+			std::shared_ptr<Token> token = generator.materializeToken();
+			std::ostringstream traceLine;
+			traceLine.precision(17);
+			traceLine << simulatorGlobals.getCurrentAbsoluteTime() << " " << std::dynamic_pointer_cast<Node>(token->source)->getNodeId() << " " << token->id;
+			trace.push_back(traceLine.str());
+		}
+	};
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	buildTopology(simulatorGlobals, scheduler, topology);
+	auto generator = buildGenerator(simulatorGlobals, scheduler, topology);
+	generator->setRandomStream(5);
+	ASSERT_TRUE(generator->turnOnAutonomous());
+	std::vector<std::string> trace;
+	runGenerator(simulatorGlobals, scheduler, *generator, 100, trace);
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	simulationCheckpoint.addTrafficGenerator(generator);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+	trace.clear();
+	runGenerator(simulatorGlobals, scheduler, *generator, 100, trace);
+
+	// The restarted generator is neither on nor on its own stream until restored.
+	SimulatorGlobals restartedSimulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler restartedScheduler(restartedSimulatorGlobals);
+	Topology restartedTopology;
+	buildTopology(restartedSimulatorGlobals, restartedScheduler, restartedTopology);
+	auto restartedGenerator = buildGenerator(restartedSimulatorGlobals, restartedScheduler, restartedTopology);
+	SimulationCheckpoint restartedCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, restartedCheckpoint.restore(checkpointFileName, restartedTopology));
+	restartedCheckpoint.addTrafficGenerator(restartedGenerator);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, restartedCheckpoint.restore(checkpointFileName, restartedTopology))
+		<< restartedCheckpoint.getErrorMessage();
+	EXPECT_TRUE(restartedGenerator->isGeneratorAutonomous());
+	std::vector<std::string> restartedTrace;
+	runGenerator(restartedSimulatorGlobals, restartedScheduler, *restartedGenerator, 100, restartedTrace);
+	EXPECT_EQ(trace, restartedTrace);
+	EXPECT_EQ(generator->getTokensGeneratedCount(), restartedGenerator->getTokensGeneratedCount());
+	EXPECT_EQ(generator->getTau(), restartedGenerator->getTau());
+}
+
+/// Detection engine added to the checkpoint: the restarted engine keeps its window, grid cells and recent detections, and declares the same
+/// detections from the same triggers.
+TEST_F(SimulationCheckpointTest, DetectionEngine) {
+	struct Trigger {
+		double deliveryTime;
+		unsigned int sensorId;
+		double latitude;
+		double longitude;
+		double eventTime;
+	};
+	// Earthquake A is detected before the checkpoint, and later triggers join its detection; earthquake B, 550 Km away, is detected after it.
+	const std::vector<Trigger> triggers = { { 10.5, 1, 34.00, -118.00, 10.0 }, { 11.0, 2, 34.10, -118.10, 10.2 }, { 11.1, 11, 38.00, -122.00, 10.3 },
+		{ 11.5, 3, 34.20, -117.90, 10.4 }, { 11.6, 12, 38.10, -122.10, 10.5 }, { 12.0, 4, 33.90, -118.05, 10.6 },
+		{ 12.5, 5, 34.45, -118.00, 11.0 }, { 12.6, 13, 37.90, -121.90, 11.1 }, { 12.7, 14, 38.05, -122.05, 11.2 }, { 12.8, 6, 34.85, -118.00, 12.0 } };
+	const std::vector<Trigger>::size_type checkpointIndex = 6;
+	auto deliverTriggers = [&triggers](SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, DetectionEngine &detectionEngine,
+			std::vector<Trigger>::size_type first, std::vector<Trigger>::size_type last, std::vector<std::string> &trace) {
+		for (auto i = first; i < last; ++i) {
+			simulatorGlobals.setCurrentAbsoluteTime(triggers[i].deliveryTime);
+			std::shared_ptr<DetectionData> detectionData = detectionEngine.ingest(std::make_shared<SeismicEventData>(triggers[i].sensorId,
+				triggers[i].latitude, triggers[i].longitude, 5.0, triggers[i].eventTime, 0.0, 1));
+			trace.push_back(std::to_string(triggers[i].sensorId) + " " + std::to_string(detectionData != nullptr ? detectionData->detectionId : 0));
+		}
+		while (scheduler.getChainSize() > 0) {
+			Event event = scheduler.cause();
+			auto detectionData = std::dynamic_pointer_cast<const DetectionData>(event.entity);
+			std::ostringstream traceLine;
+			traceLine.precision(17);
+			traceLine << simulatorGlobals.getCurrentAbsoluteTime() << " " << detectionData->detectionId << " " << detectionData->triggers.size() << " "
+				<< detectionData->latitude << " " << detectionData->longitude << " " << detectionData->meanDeliveryLatency;
+			trace.push_back(traceLine.str());
+		}
+		std::ostringstream traceLine;
+		traceLine.precision(17);
+		traceLine << detectionEngine.getWindowSize() << " " << detectionEngine.getTriggersCount() << " " << detectionEngine.getStaleTriggersCount() << " "
+			<< detectionEngine.getAssociatedTriggersCount() << " " << detectionEngine.getDetectionsCount() << " " << detectionEngine.getMeanDetectionLatency();
+		trace.push_back(traceLine.str());
+	};
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	DetectionEngine detectionEngine(simulatorGlobals, scheduler, 4, 50.0, 5.0);
+	std::vector<std::string> trace;
+	for (std::vector<Trigger>::size_type i = 0; i < checkpointIndex; ++i) {
+		simulatorGlobals.setCurrentAbsoluteTime(triggers[i].deliveryTime);
+		detectionEngine.ingest(std::make_shared<SeismicEventData>(triggers[i].sensorId, triggers[i].latitude, triggers[i].longitude, 5.0,
+			triggers[i].eventTime, 0.0, 1));
+	}
+	ASSERT_EQ(1, detectionEngine.getDetectionsCount());
+	ASSERT_EQ(1, scheduler.getChainSize()); // Detection event pending, sharing its triggers with the window.
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	simulationCheckpoint.addDetectionEngine(detectionEngine);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+	deliverTriggers(simulatorGlobals, scheduler, detectionEngine, checkpointIndex, triggers.size(), trace);
+	EXPECT_EQ(2, detectionEngine.getDetectionsCount());
+	EXPECT_EQ(2, detectionEngine.getAssociatedTriggersCount());
+
+	// Engines must be added, with the same configuration.
+	SimulatorGlobals restartedSimulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler restartedScheduler(restartedSimulatorGlobals);
+	Topology restartedTopology;
+	SimulationCheckpoint restartedCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, restartedCheckpoint.restore(checkpointFileName, restartedTopology));
+	DetectionEngine otherDetectionEngine(restartedSimulatorGlobals, restartedScheduler, 4, 60.0, 5.0);
+	SimulationCheckpoint otherCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	otherCheckpoint.addDetectionEngine(otherDetectionEngine);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, otherCheckpoint.restore(checkpointFileName, restartedTopology));
+	DetectionEngine restartedDetectionEngine(restartedSimulatorGlobals, restartedScheduler, 4, 50.0, 5.0);
+	restartedCheckpoint.addDetectionEngine(restartedDetectionEngine);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, restartedCheckpoint.restore(checkpointFileName, restartedTopology))
+		<< restartedCheckpoint.getErrorMessage();
+	EXPECT_EQ(checkpointIndex, restartedDetectionEngine.getWindowSize());
+	std::vector<std::string> restartedTrace;
+	deliverTriggers(restartedSimulatorGlobals, restartedScheduler, restartedDetectionEngine, checkpointIndex, triggers.size(), restartedTrace);
+	EXPECT_EQ(trace, restartedTrace);
+}
+
+/// Host availability model added to the checkpoint: the restarted model keeps the states of its hosts, its buffered triggers and its recurring
+/// event, and goes through the same transitions.
+TEST_F(SimulationCheckpointTest, HostAvailabilityModel) {
+	const unsigned int numberOfHosts = 100;
+	auto buildModel = [numberOfHosts](SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, HostAvailabilityModel &hostAvailabilityModel) {
+		for (unsigned int sensorId = 0; sensorId < numberOfHosts; ++sensorId) {
+			auto sensor = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr,
+				nullptr, nullptr, 1, 0.0, 0.0, sensorId);
+			QcnSensorParameters sensorParameters;
+			sensorParameters.onFraction = sensorId % 2 == 0 ? 0.9 : 0.7;
+			sensorParameters.connectedFraction = 0.5;
+			sensorParameters.activeFraction = 0.95;
+			sensor->setSensorParameters(sensorParameters);
+			hostAvailabilityModel.addSensor(sensor);
+		}
+		hostAvailabilityModel.setMeanCycle(HostAvailabilityModel::HostState::CONNECTED, 20.0);
+	};
+	// Every third transition, a trigger of the next host is filtered; buffered triggers come back as SEISMIC_EVENT_DETECTION events.
+	auto runModel = [numberOfHosts](SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, HostAvailabilityModel &hostAvailabilityModel,
+			unsigned int numberOfEvents, std::vector<std::string> &trace) {
+		for (unsigned int i = 0; i < numberOfEvents; ++i) {
+			Event event = scheduler.cause();
+			std::ostringstream traceLine;
+			traceLine.precision(17);
+			traceLine << simulatorGlobals.getCurrentAbsoluteTime() << " " << static_cast<int>(event.eventType);
+			if (event.eventType == EventType::HOST_AVAILABILITY_TRANSITION) {
+				traceLine << " " << hostAvailabilityModel.processTransition();
+				if (hostAvailabilityModel.getCandidateTransitionsCount() % 3 == 0) {
+					unsigned int sensorId = hostAvailabilityModel.getCandidateTransitionsCount() / 3 % numberOfHosts;
+					traceLine << " " << static_cast<int>(hostAvailabilityModel.filterTrigger(std::make_shared<SeismicEventData>(sensorId, 0.0, 0.0, 5.0,
+						simulatorGlobals.getCurrentAbsoluteTime(), 10.0, 1)));
+				}
+			} else {
+				traceLine << " " << event.getEntityAs<const SeismicEventData>()->qcnExplorerSensorId;
+			}
+			for (auto hostState : { HostAvailabilityModel::HostState::ON, HostAvailabilityModel::HostState::CONNECTED, HostAvailabilityModel::HostState::ACTIVE }) {
+				traceLine << " " << hostAvailabilityModel.getHostsUpCount(hostState);
+			}
+			trace.push_back(traceLine.str());
+		}
+	};
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	HostAvailabilityModel hostAvailabilityModel(simulatorGlobals, scheduler);
+	buildModel(simulatorGlobals, scheduler, hostAvailabilityModel);
+	hostAvailabilityModel.start();
+	std::vector<std::string> trace;
+	runModel(simulatorGlobals, scheduler, hostAvailabilityModel, 300, trace);
+	ASSERT_GT(hostAvailabilityModel.getBufferedTriggersCount(), 0); // Some triggers wait for their hosts to connect.
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	simulationCheckpoint.addHostAvailabilityModel(hostAvailabilityModel);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+	trace.clear();
+	runModel(simulatorGlobals, scheduler, hostAvailabilityModel, 1000, trace);
+
+	// Models must be added, with the same hosts; the restarted model is not started, its recurring event comes from the checkpoint.
+	SimulatorGlobals restartedSimulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler restartedScheduler(restartedSimulatorGlobals);
+	Topology restartedTopology;
+	SimulationCheckpoint restartedCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, restartedCheckpoint.restore(checkpointFileName, restartedTopology));
+	HostAvailabilityModel emptyHostAvailabilityModel(restartedSimulatorGlobals, restartedScheduler);
+	SimulationCheckpoint emptyCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	emptyCheckpoint.addHostAvailabilityModel(emptyHostAvailabilityModel);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, emptyCheckpoint.restore(checkpointFileName, restartedTopology));
+	HostAvailabilityModel restartedHostAvailabilityModel(restartedSimulatorGlobals, restartedScheduler);
+	buildModel(restartedSimulatorGlobals, restartedScheduler, restartedHostAvailabilityModel);
+	restartedCheckpoint.addHostAvailabilityModel(restartedHostAvailabilityModel);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, restartedCheckpoint.restore(checkpointFileName, restartedTopology))
+		<< restartedCheckpoint.getErrorMessage();
+	std::vector<std::string> restartedTrace;
+	runModel(restartedSimulatorGlobals, restartedScheduler, restartedHostAvailabilityModel, 1000, restartedTrace);
+	EXPECT_EQ(trace, restartedTrace);
+	EXPECT_EQ(hostAvailabilityModel.getTransitionsCount(), restartedHostAvailabilityModel.getTransitionsCount());
+	EXPECT_EQ(hostAvailabilityModel.getBufferedTriggersCount(), restartedHostAvailabilityModel.getBufferedTriggersCount());
+	EXPECT_EQ(hostAvailabilityModel.getDroppedTriggersCount(), restartedHostAvailabilityModel.getDroppedTriggersCount());
+
+	// The restored recurring event belongs to the restarted model, which removes it when stopped.
+	restartedHostAvailabilityModel.stop();
+	while (restartedScheduler.getChainSize() > 0) {
+		EXPECT_NE(EventType::HOST_AVAILABILITY_TRANSITION, restartedScheduler.cause().eventType);
+	}
+}
+
+/// Autonomous trace replay added to the checkpoint, in both trace formats: the restarted generator resumes at the same record, with the
+/// same loop and time scale anchors, across read-ahead blocks and loops.
+TEST_F(SimulationCheckpointTest, TraceReplayTrafficGenerator) {
+	std::vector<TraceReplayTrafficGenerator::TraceRecord> records;
+	for (uint32_t i = 0; i < 2 * TRACE_READ_AHEAD_RECORDS + 100; ++i) {
+		TraceReplayTrafficGenerator::TraceRecord record;
+		record.time = i * 0.01; record.hostId = i % 7; record.pduSize = 100 + i % 5; records.push_back(record);
+	}
+	ASSERT_EQ(TraceReturnType::TRACE_WRITTEN, TraceReplayTrafficGenerator::writeBinaryTrace("checkpointReplay.trace", records));
+	{
+		std::ofstream outputFile("checkpointReplay.csv");
+		outputFile.precision(17);
+		outputFile << "time,hostId,pduSize" << std::endl;
+		for (auto &record : records) {
+			outputFile << record.time << "," << record.hostId << "," << record.pduSize << std::endl;
+		}
+	}
+	auto runGenerator = [](SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, TraceReplayTrafficGenerator &generator, unsigned int numberOfEvents,
+			std::vector<std::string> &trace) {
+		for (unsigned int i = 0; i < numberOfEvents; ++i) {
+			scheduler.cause();
+			std::shared_ptr<ProtocolDataUnit> pdu = generator.materializePdu(500);
+			std::ostringstream traceLine;
+			traceLine.precision(17);
+			traceLine << simulatorGlobals.getCurrentAbsoluteTime() << " " << pdu->getPduSize() << " " << generator.getCurrentRecord().hostId;
+			trace.push_back(traceLine.str());
+		}
+	};
+	for (auto traceFileName : { "checkpointReplay.trace", "checkpointReplay.csv" }) {
+		SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+		Scheduler scheduler(simulatorGlobals);
+		Topology topology;
+		buildTopology(simulatorGlobals, scheduler, topology);
+		auto generator = std::make_shared<TraceReplayTrafficGenerator>(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr,
+			topology.nodeMap.at(1), topology.nodeMap.at(3), 1);
+		ASSERT_EQ(TraceReturnType::TRACE_OPENED, generator->openTrace(traceFileName));
+		generator->setLooping(true);
+		ASSERT_TRUE(generator->turnOnAutonomous());
+		std::vector<std::string> trace;
+		runGenerator(simulatorGlobals, scheduler, *generator, 1000, trace);
+		generator->setTimeScale(0.5);
+		runGenerator(simulatorGlobals, scheduler, *generator, TRACE_READ_AHEAD_RECORDS, trace);
+		SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+		simulationCheckpoint.addTrafficGenerator(generator);
+		ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+		trace.clear();
+		runGenerator(simulatorGlobals, scheduler, *generator, 2 * TRACE_READ_AHEAD_RECORDS, trace);
+
+		// The restarted generator only opens the trace; time scale, looping and position come from the checkpoint.
+		SimulatorGlobals restartedSimulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+		Scheduler restartedScheduler(restartedSimulatorGlobals);
+		Topology restartedTopology;
+		buildTopology(restartedSimulatorGlobals, restartedScheduler, restartedTopology);
+		auto restartedGenerator = std::make_shared<TraceReplayTrafficGenerator>(restartedSimulatorGlobals, restartedScheduler,
+			EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, restartedTopology.nodeMap.at(1), restartedTopology.nodeMap.at(3), 1);
+		SimulationCheckpoint restartedCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+		restartedCheckpoint.addTrafficGenerator(restartedGenerator);
+		EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, restartedCheckpoint.restore(checkpointFileName, restartedTopology)) << traceFileName;
+		ASSERT_EQ(TraceReturnType::TRACE_OPENED, restartedGenerator->openTrace(traceFileName));
+		ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, restartedCheckpoint.restore(checkpointFileName, restartedTopology))
+			<< restartedCheckpoint.getErrorMessage();
+		EXPECT_DOUBLE_EQ(0.5, restartedGenerator->getTimeScale());
+		EXPECT_TRUE(restartedGenerator->isTraceLooping());
+		std::vector<std::string> restartedTrace;
+		runGenerator(restartedSimulatorGlobals, restartedScheduler, *restartedGenerator, 2 * TRACE_READ_AHEAD_RECORDS, restartedTrace);
+		EXPECT_EQ(trace, restartedTrace) << traceFileName;
+	}
+	std::remove("checkpointReplay.trace");
+	std::remove("checkpointReplay.csv");
+}
+
+/// Trickle outbox added to the checkpoint: the restarted outbox keeps its stored PDUs, its retry timers (in the wheel and in the overflow map)
+/// and its recurring event, and retries and flushes the same PDUs at the same times.
+TEST_F(SimulationCheckpointTest, TrickleOutbox) {
+	const unsigned int numberOfOutboxes = 5;
+	// Each SEISMIC_EVENT_DETECTION event submits a PDU to the next outbox and schedules the next one; the uplink goes down and up every 80 PDUs
+	// (56 seconds), long enough for the backoff to leave the 25.6 seconds covered by the wheel.
+	auto runOutbox = [numberOfOutboxes](SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, Topology &topology, TrickleOutbox &trickleOutbox,
+			unsigned int numberOfEvents, std::vector<std::string> &trace) {
+		std::shared_ptr<Link> uplink = topology.linkMap.at(12);
+		for (unsigned int i = 0; i < numberOfEvents; ++i) {
+			Event event = scheduler.cause();
+			std::ostringstream traceLine;
+			traceLine.precision(17);
+			traceLine << simulatorGlobals.getCurrentAbsoluteTime() << " " << static_cast<int>(event.eventType);
+			if (event.eventType == EventType::TRICKLE_RETRY) {
+				traceLine << " " << trickleOutbox.processRetries();
+			} else if (event.eventType == EventType::REQUEST_PDU_TRANSMISSION_AT_LINK) {
+				traceLine << " " << event.getEntityAs<const ProtocolDataUnit>()->id;
+			} else if (event.eventType == EventType::SEISMIC_EVENT_DETECTION) {
+				unsigned int sensorId = event.getEntityAs<const SeismicEventData>()->qcnExplorerSensorId;
+				if (sensorId % 80 == 0 && uplink->isUp()) {
+					uplink->setDown();
+				} else if (sensorId % 80 == 0) {
+					uplink->setUp();
+				}
+				auto pdu = std::make_shared<ProtocolDataUnit>(simulatorGlobals, 1, nullptr, topology.nodeMap.at(1), topology.nodeMap.at(3),
+					topology.nodeMap.at(1), topology.nodeMap.at(2), 100);
+				traceLine << " " << pdu->id << " " << static_cast<int>(trickleOutbox.submit(sensorId % numberOfOutboxes, pdu, uplink));
+				scheduler.schedule(Event(0.7, EventType::SEISMIC_EVENT_DETECTION, std::make_shared<SeismicEventData>(sensorId + 1, 41.0, -77.0, 5.0,
+					simulatorGlobals.getCurrentAbsoluteTime() + 0.7, 10.0, 1)));
+			}
+			traceLine << " " << trickleOutbox.getStoredPdusSize() << " " << trickleOutbox.getPendingRetriesSize();
+			trace.push_back(traceLine.str());
+		}
+	};
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	buildTopology(simulatorGlobals, scheduler, topology);
+	TrickleOutbox trickleOutbox(simulatorGlobals, scheduler);
+	trickleOutbox.setCapacity(8);
+	scheduler.schedule(Event(0.0, EventType::SEISMIC_EVENT_DETECTION, std::make_shared<SeismicEventData>(1, 41.0, -77.0, 5.0, 0.0, 10.0, 1)));
+	std::vector<std::string> trace;
+	// Checkpoint during the first outage, after five failed retries of each outbox: their next retries, 32 seconds later, are beyond the wheel.
+	while (topology.linkMap.at(12)->isUp() || trickleOutbox.getFailedRetriesCount() < 5 * numberOfOutboxes) {
+		runOutbox(simulatorGlobals, scheduler, topology, trickleOutbox, 1, trace);
+	}
+	ASSERT_GT(trickleOutbox.getStoredPdusSize(), 0);
+	ASSERT_EQ(numberOfOutboxes, trickleOutbox.getPendingRetriesSize());
+	ASSERT_GT(trickleOutbox.getDroppedPdusCount(), 0);
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	simulationCheckpoint.addTrickleOutbox(trickleOutbox);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology)) << simulationCheckpoint.getErrorMessage();
+	trace.clear();
+	runOutbox(simulatorGlobals, scheduler, topology, trickleOutbox, 1000, trace);
+	EXPECT_GT(trickleOutbox.getFlushedPdusCount(), 0);
+
+	// Outboxes must be added, with the same configuration.
+	SimulatorGlobals restartedSimulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler restartedScheduler(restartedSimulatorGlobals);
+	Topology restartedTopology;
+	buildTopology(restartedSimulatorGlobals, restartedScheduler, restartedTopology);
+	SimulationCheckpoint restartedCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, restartedCheckpoint.restore(checkpointFileName, restartedTopology));
+	TrickleOutbox otherTrickleOutbox(restartedSimulatorGlobals, restartedScheduler);
+	SimulationCheckpoint otherCheckpoint(restartedSimulatorGlobals, restartedScheduler);
+	otherCheckpoint.addTrickleOutbox(otherTrickleOutbox);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, otherCheckpoint.restore(checkpointFileName, restartedTopology));
+	TrickleOutbox restartedTrickleOutbox(restartedSimulatorGlobals, restartedScheduler);
+	restartedTrickleOutbox.setCapacity(8);
+	restartedCheckpoint.addTrickleOutbox(restartedTrickleOutbox);
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_RESTORED, restartedCheckpoint.restore(checkpointFileName, restartedTopology))
+		<< restartedCheckpoint.getErrorMessage();
+	std::vector<std::string> restartedTrace;
+	runOutbox(restartedSimulatorGlobals, restartedScheduler, restartedTopology, restartedTrickleOutbox, 1000, restartedTrace);
+	EXPECT_EQ(trace, restartedTrace);
+	EXPECT_EQ(trickleOutbox.getFlushedPdusCount(), restartedTrickleOutbox.getFlushedPdusCount());
+	EXPECT_EQ(trickleOutbox.getFailedRetriesCount(), restartedTrickleOutbox.getFailedRetriesCount());
+	EXPECT_EQ(trickleOutbox.getRetryEventsCount(), restartedTrickleOutbox.getRetryEventsCount());
+}
+
+/// Missing and foreign files, different topologies and unsupported entities.
+TEST_F(SimulationCheckpointTest, InvalidCheckpoints) {
+	SimulatorGlobals simulatorGlobals(0.0, 0.0, false, "SimulationCheckpointTest");
+	Scheduler scheduler(simulatorGlobals);
+	Topology topology;
+	buildTopology(simulatorGlobals, scheduler, topology);
+	SimulationCheckpoint simulationCheckpoint(simulatorGlobals, scheduler);
+	std::remove(checkpointFileName.c_str());
+	EXPECT_EQ(CheckpointReturnType::FILE_NOT_FOUND, simulationCheckpoint.restore(checkpointFileName, topology));
+	{
+		std::ofstream outputFile(checkpointFileName, std::ios::binary);
+		outputFile << "not a checkpoint at all";
+	}
+	EXPECT_EQ(CheckpointReturnType::INVALID_CHECKPOINT, simulationCheckpoint.restore(checkpointFileName, topology));
+
+	// Checkpoint of an older format version.
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology));
+	{
+		std::fstream checkpointFile(checkpointFileName, std::ios::in | std::ios::out | std::ios::binary);
+		uint32_t olderVersion = CHECKPOINT_VERSION - 1;
+		checkpointFile.seekp(8); // Version follows the 8-byte magic.
+		checkpointFile.write(reinterpret_cast<const char *>(&olderVersion), sizeof(olderVersion));
+	}
+	EXPECT_EQ(CheckpointReturnType::INVALID_CHECKPOINT, simulationCheckpoint.restore(checkpointFileName, topology));
+	EXPECT_NE(std::string::npos, simulationCheckpoint.getErrorMessage().find("version"));
+
+	// Restore into a topology with one more node.
+	ASSERT_EQ(CheckpointReturnType::CHECKPOINT_SAVED, simulationCheckpoint.save(checkpointFileName, topology));
+	topology.nodeMap[4] = std::make_shared<Node>(simulatorGlobals, 3);
+	EXPECT_EQ(CheckpointReturnType::TOPOLOGY_MISMATCH, simulationCheckpoint.restore(checkpointFileName, topology));
+	EXPECT_FALSE(simulationCheckpoint.getErrorMessage().empty());
+
+	// Event carrying an entity that cannot be serialized.
+	scheduler.schedule(Event(1.0, EventType::SEISMIC_EVENT_DETECTION, std::make_shared<EarthquakeData>()));
+	EXPECT_EQ(CheckpointReturnType::UNSUPPORTED_ENTITY, simulationCheckpoint.save(checkpointFileName, topology));
+}
@@ -0,0 +1,101 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimulationProfilerTest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+SimulationProfilerTest::SimulationProfilerTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "SimulationProfilerTest")),
+		scheduler(Scheduler(simulatorGlobals)) {
+}
+
+/**
+ * Schedule three arrivals and the end of the simulation.
+ */
+void SimulationProfilerTest::scheduleEvents() {
+	scheduler.schedule(Event(1.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, nullptr));
+	scheduler.schedule(Event(2.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, nullptr));
+	scheduler.schedule(Event(3.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, nullptr));
+	scheduler.schedule(Event(4.0, EventType::END_SIMULATION, nullptr));
+}
+
+/// Events are counted per type and timed, with pops, driver inserts, event chain size and progress samples; the report and trace are written.
+TEST_F(SimulationProfilerTest, Enabled) {
+	SimulationProfiler<ProfilingEnabled> profiler(simulatorGlobals, scheduler, 2);
+	scheduleEvents();
+	Event currentEvent;
+	do {
+		currentEvent = profiler.cause();
+		profiler.beginHandler(currentEvent.eventType);
+		if (currentEvent.eventType == EventType::PDUTOKEN_ARRIVAL_AT_NODE && simulatorGlobals.getCurrentAbsoluteTime() == 1.0) {
+			profiler.schedule(Event(0.5, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, nullptr));
+		}
+		profiler.endHandler();
+	} while (currentEvent.eventType != EventType::END_SIMULATION);
+	const ProfilerRecord *profilerRecord = profiler.getProfilerRecord();
+	ASSERT_NE(nullptr, profilerRecord);
+	EXPECT_EQ(3, profilerRecord->getEventCount(EventType::PDUTOKEN_ARRIVAL_AT_NODE));
+	EXPECT_EQ(1, profilerRecord->getEventCount(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK));
+	EXPECT_EQ(1, profilerRecord->getEventCount(EventType::END_SIMULATION));
+	EXPECT_EQ(0, profilerRecord->getEventCount(EventType::BEGIN_SIMULATION));
+	EXPECT_LE(0, profilerRecord->getHandlerNanoseconds(EventType::PDUTOKEN_ARRIVAL_AT_NODE));
+	EXPECT_EQ(5, profilerRecord->getPopCount());
+	EXPECT_EQ(1, profilerRecord->getInsertCount());
+	EXPECT_EQ(3, profilerRecord->getMaximumEventChainSize());
+	EXPECT_DOUBLE_EQ((3 + 3 + 2 + 1 + 0) / 5.0, profilerRecord->getMeanEventChainSize());
+	// Samples at the first, third and fifth pops.
+	ASSERT_EQ(3, profilerRecord->getProgressSamples().size());
+	EXPECT_EQ(1.0, profilerRecord->getProgressSamples()[0].simulatedTime);
+	EXPECT_EQ(3, profilerRecord->getProgressSamples()[0].eventChainSize);
+	EXPECT_EQ(2.0, profilerRecord->getProgressSamples()[1].simulatedTime);
+	EXPECT_EQ(4.0, profilerRecord->getProgressSamples()[2].simulatedTime);
+	EXPECT_LE(profilerRecord->getProgressSamples()[0].wallclockNanoseconds, profilerRecord->getProgressSamples()[2].wallclockNanoseconds);
+
+	std::ostringstream report;
+	profiler.writeReport(report);
+	EXPECT_NE(std::string::npos, report.str().find("PDUTOKEN_ARRIVAL_AT_NODE"));
+	EXPECT_NE(std::string::npos, report.str().find("REQUEST_PDU_TRANSMISSION_AT_LINK"));
+	EXPECT_EQ(std::string::npos, report.str().find("BEGIN_SIMULATION"));
+	EXPECT_TRUE(profiler.writeChromeTrace("SimulationProfilerTest.json"));
+	std::ifstream traceFile("SimulationProfilerTest.json");
+	std::string trace((std::istreambuf_iterator<char>(traceFile)), std::istreambuf_iterator<char>());
+	traceFile.close();
+	EXPECT_EQ(0, trace.find("{\"traceEvents\":["));
+	EXPECT_NE(std::string::npos, trace.find("\"ph\":\"C\""));
+	EXPECT_NE(std::string::npos, trace.find("\"events\":3"));
+	std::remove("SimulationProfilerTest.json");
+}
+
+/// The disabled profiler keeps no state and only forwards to the scheduler.
+TEST_F(SimulationProfilerTest, Disabled) {
+	SimulationProfiler<ProfilingDisabled> profiler(simulatorGlobals, scheduler);
+	EXPECT_TRUE(std::is_empty<ProfilingDisabled>::value);
+	EXPECT_EQ(sizeof(Scheduler *), sizeof(profiler));
+	scheduleEvents();
+	profiler.schedule(Event(0.5, EventType::BEGIN_SIMULATION, nullptr));
+	EXPECT_EQ(EventType::BEGIN_SIMULATION, profiler.cause().eventType);
+	EXPECT_EQ(0.5, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(4, scheduler.getChainSize());
+	EXPECT_EQ(nullptr, profiler.getProfilerRecord());
+	std::ostringstream report;
+	profiler.writeReport(report);
+	EXPECT_TRUE(report.str().empty());
+}
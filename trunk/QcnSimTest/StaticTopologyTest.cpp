@@ -0,0 +1,304 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "StaticTopologyTest.h"
+#include <map>
+#include <utility>
+
+/**
+ * Constructor of the counting link.
+ */
+CountingLink::CountingLink(std::shared_ptr<Node> nodeA, std::shared_ptr<Node> nodeB, double bandwidth, double propagationDelay,
+		SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, LinkType linkType): Link(nodeA, nodeB, bandwidth, propagationDelay,
+		simulatorGlobals, scheduler, "", linkType), transmissionRequestsCount(0) {
+}
+
+/**
+ * Count the transmission request, then transmit as Link does.
+ */
+LinkReturnType CountingLink::transmitPdu(EventType transmitEventType, EventType endTransmitEventType, std::shared_ptr<const ProtocolDataUnit> pdu) {
+	++transmissionRequestsCount;
+	return Link::transmitPdu(transmitEventType, endTransmitEventType, pdu);
+}
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+StaticTopologyTest::StaticTopologyTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "StaticTopologyTest")),
+		scheduler(Scheduler(simulatorGlobals)), tokenContents(std::make_shared<Message>("Message within PDU")) {
+	simulatorGlobals.seedRandomNumberGenerator(1);
+	for (unsigned int nodeId = 0; nodeId < 4; ++nodeId) {
+		nodes.push_back(std::make_shared<Node>(simulatorGlobals, nodeId));
+	}
+	links.push_back(std::make_shared<CountingLink>(nodes[0], nodes[2], 1000000, 0.01, simulatorGlobals, scheduler));
+	links.push_back(std::make_shared<CountingLink>(nodes[1], nodes[2], 2000000, 0.02, simulatorGlobals, scheduler));
+	links.push_back(std::make_shared<CountingLink>(nodes[2], nodes[3], 1500000, 0.03, simulatorGlobals, scheduler));
+	for (unsigned int source = 0; source < 2; ++source) {
+		routes.push_back(std::vector<std::shared_ptr<Entity>>({ nodes[source], nodes[2], nodes[3] }));
+		generators.push_back(std::make_shared<ExponentialTrafficGenerator>(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL,
+			tokenContents, nodes[source], nodes[3], 1, 0.005, 1));
+		generators.back()->setRandomStream(source);
+		generators.back()->turnOn();
+	}
+}
+
+/**
+ * Run the scenario of the fixture with a driver loop of its own, through the virtual classes.
+ *
+ * @param generationEndTime Time after which the generators stop.
+ * @param simulationTime Time of the end of the simulation.
+ * @return Events caused.
+ */
+unsigned int StaticTopologyTest::runWithVirtualCalls(double generationEndTime, double simulationTime) {
+	std::map<std::pair<const Entity *, const Entity *>, std::shared_ptr<Link>> linkOfHops;
+	for (auto &link : links) {
+		linkOfHops[std::make_pair(link->getNodeA().get(), link->getNodeB().get())] = link;
+	}
+	for (unsigned int source = 0; source < 2; ++source) {
+		generators[source]->createInstanceTrafficEventPdu(512, routes[source]);
+	}
+	scheduler.schedule(Event(simulationTime, EventType::END_SIMULATION, nullptr));
+	unsigned int eventsCount = 0;
+	bool simulationEnded = false;
+	while (!simulationEnded) {
+		Event currentEvent = scheduler.cause();
+		++eventsCount;
+		std::shared_ptr<ProtocolDataUnit> pdu = std::const_pointer_cast<ProtocolDataUnit>(std::static_pointer_cast<const ProtocolDataUnit>(currentEvent.entity));
+		switch (currentEvent.eventType) {
+			case EventType::TRAFFIC_GENERATOR_ARRIVAL:
+				if (simulatorGlobals.getCurrentAbsoluteTime() < generationEndTime) {
+					generators[std::static_pointer_cast<Node>(pdu->source)->getNodeId()]->createInstanceTrafficEventPdu(512, routes[std::static_pointer_cast<Node>(pdu->source)->getNodeId()]);
+				}
+				scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pdu));
+				break;
+			case EventType::PDUTOKEN_ARRIVAL_AT_NODE:
+				if (pdu->previous != pdu->next) {
+					linkOfHops.at(std::make_pair(pdu->previous.get(), pdu->next.get()))->endPropagation(pdu);
+				}
+				if (std::static_pointer_cast<Node>(pdu->next)->processAndForward(pdu) == NodeReturnType::PDU_ROUTE_UPDATED) {
+					scheduler.schedule(Event(0.0, EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, pdu));
+				}
+				break;
+			case EventType::REQUEST_PDU_TRANSMISSION_AT_LINK:
+				linkOfHops.at(std::make_pair(pdu->previous.get(), pdu->next.get()))->transmitPdu(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK,
+					EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK, pdu);
+				break;
+			case EventType::END_TRANSMISSION_PROPAGATE_PDU_AT_LINK:
+				linkOfHops.at(std::make_pair(pdu->previous.get(), pdu->next.get()))->propagatePdu(EventType::END_PROPAGATION_AT_LINK, pdu);
+				break;
+			case EventType::END_PROPAGATION_AT_LINK:
+				scheduler.schedule(Event(0.0, EventType::PDUTOKEN_ARRIVAL_AT_NODE, pdu));
+				break;
+			default:
+				simulationEnded = true;
+				break;
+		}
+	}
+	return eventsCount;
+}
+
+/// All PDUs generated reach the destination through the router, and each link transmits the PDUs of its sources, with static calls to the link policy.
+TEST_F(StaticTopologyTest, Delivery) {
+	StaticTopology<Node, CountingLink, ExponentialTrafficGenerator> staticTopology(simulatorGlobals, scheduler);
+	for (auto &node : nodes) {
+		staticTopology.addNode(node);
+	}
+	for (auto &link : links) {
+		staticTopology.addLink(link);
+	}
+	for (unsigned int source = 0; source < 2; ++source) {
+		staticTopology.addGenerator(generators[source], 512, routes[source]);
+	}
+	EXPECT_EQ(nodes[2], staticTopology.getNode(2));
+	EXPECT_EQ(nullptr, staticTopology.getNode(4));
+	EXPECT_EQ(3, staticTopology.getLinks().size());
+	staticTopology.start(1.0);
+	scheduler.schedule(Event(10.0, EventType::END_SIMULATION, nullptr));
+	uint64_t eventsCount = staticTopology.run();
+	unsigned int generatedCount = generators[0]->getTokensGeneratedCount() + generators[1]->getTokensGeneratedCount();
+	EXPECT_LT(300, generatedCount);
+	EXPECT_EQ(generatedCount, nodes[3]->getReceivedPdusOrTokensCount());
+	EXPECT_EQ(generatedCount, nodes[2]->getForwardedPdusOrTokensCount());
+	// Requests are counted once per PDU, plus once again for PDUs enqueued and later taken from the queue.
+	EXPECT_LE(generators[0]->getTokensGeneratedCount(), links[0]->transmissionRequestsCount);
+	EXPECT_LE(generators[1]->getTokensGeneratedCount(), links[1]->transmissionRequestsCount);
+	EXPECT_LE(generatedCount, links[2]->transmissionRequestsCount);
+	EXPECT_LT(0, links[2]->getMaxRecordedTransmissionQueueSize());
+	for (auto &link : links) {
+		EXPECT_EQ(0, link->getInTransitQueueSize());
+		EXPECT_EQ(0, link->getTransmissionQueueSize());
+	}
+	// Per PDU: generation, 3 arrivals, 2 transmission requests, ends of transmission and ends of propagation; plus the requests of enqueued PDUs
+	// and END_SIMULATION.
+	uint64_t transmissionRequestsCount = links[0]->transmissionRequestsCount + links[1]->transmissionRequestsCount + links[2]->transmissionRequestsCount;
+	EXPECT_EQ(static_cast<uint64_t>(generatedCount) * 8 + transmissionRequestsCount + 1, eventsCount);
+	EXPECT_EQ(eventsCount - 1, staticTopology.getEventsCount());
+}
+
+/// The kernel gives the same results as a driver loop through the virtual classes, with fusion on or off.
+TEST_F(StaticTopologyTest, SameAsVirtualCalls) {
+	unsigned int eventsCount = runWithVirtualCalls(1.0, 10.0);
+	for (bool isFusionOn : { false, true }) {
+		SimulatorGlobals staticSimulatorGlobals(0.0, 0.0, false, "StaticTopologyTest static");
+		staticSimulatorGlobals.seedRandomNumberGenerator(1);
+		Scheduler staticScheduler(staticSimulatorGlobals);
+		staticScheduler.setFusion(isFusionOn);
+		StaticTopology<> staticTopology(staticSimulatorGlobals, staticScheduler);
+		std::vector<std::shared_ptr<Node>> staticNodes;
+		for (unsigned int nodeId = 0; nodeId < 4; ++nodeId) {
+			staticNodes.push_back(std::make_shared<Node>(staticSimulatorGlobals, nodeId));
+			staticTopology.addNode(staticNodes.back());
+		}
+		staticTopology.addLink(std::make_shared<Link>(staticNodes[0], staticNodes[2], 1000000, 0.01, staticSimulatorGlobals, staticScheduler));
+		staticTopology.addLink(std::make_shared<Link>(staticNodes[1], staticNodes[2], 2000000, 0.02, staticSimulatorGlobals, staticScheduler));
+		staticTopology.addLink(std::make_shared<Link>(staticNodes[2], staticNodes[3], 1500000, 0.03, staticSimulatorGlobals, staticScheduler));
+		for (unsigned int source = 0; source < 2; ++source) {
+			std::shared_ptr<ExponentialTrafficGenerator> generator = std::make_shared<ExponentialTrafficGenerator>(staticSimulatorGlobals,
+				staticScheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, staticNodes[source], staticNodes[3], 1, 0.005, 1);
+			generator->setRandomStream(source);
+			generator->turnOn();
+			staticTopology.addGenerator(generator, 512, std::vector<std::shared_ptr<Entity>>({ staticNodes[source], staticNodes[2], staticNodes[3] }));
+		}
+		staticTopology.start(1.0);
+		staticScheduler.schedule(Event(10.0, EventType::END_SIMULATION, nullptr));
+		EXPECT_EQ(eventsCount, staticTopology.run());
+		for (unsigned int nodeId = 0; nodeId < 4; ++nodeId) {
+			EXPECT_EQ(nodes[nodeId]->getReceivedPdusOrTokensCount(), staticNodes[nodeId]->getReceivedPdusOrTokensCount());
+			EXPECT_EQ(nodes[nodeId]->getSumPduOrTokenDelay(), staticNodes[nodeId]->getSumPduOrTokenDelay());
+			EXPECT_EQ(nodes[nodeId]->getSumPduOrTokenJitter(), staticNodes[nodeId]->getSumPduOrTokenJitter());
+		}
+		for (unsigned int linkIndex = 0; linkIndex < 3; ++linkIndex) {
+			EXPECT_EQ(links[linkIndex]->getMaxRecordedTransmissionQueueSize(), staticTopology.getLinks()[linkIndex]->getMaxRecordedTransmissionQueueSize());
+		}
+		EXPECT_EQ(isFusionOn, staticScheduler.getFusedEventsCount() > 0);
+	}
+}
+
+/// Both directions of a duplex link are served.
+TEST_F(StaticTopologyTest, DuplexLink) {
+	StaticTopology<Node, CountingLink, ExponentialTrafficGenerator> staticTopology(simulatorGlobals, scheduler);
+	staticTopology.addNode(nodes[0]);
+	staticTopology.addNode(nodes[1]);
+	std::shared_ptr<CountingLink> duplexLink = std::make_shared<CountingLink>(nodes[0], nodes[1], 1000000, 0.01, simulatorGlobals, scheduler,
+		LinkType::DUPLEX_LINK);
+	staticTopology.addLink(duplexLink);
+	for (unsigned int source = 0; source < 2; ++source) {
+		std::shared_ptr<ExponentialTrafficGenerator> generator = std::make_shared<ExponentialTrafficGenerator>(simulatorGlobals, scheduler,
+			EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, nodes[source], nodes[1 - source], 1, 0.05, 1);
+		generator->setRandomStream(source);
+		generator->turnOn();
+		staticTopology.addGenerator(generator, 512, std::vector<std::shared_ptr<Entity>>({ nodes[source], nodes[1 - source] }));
+		generators[source] = generator;
+	}
+	staticTopology.start(1.0);
+	scheduler.schedule(Event(10.0, EventType::END_SIMULATION, nullptr));
+	staticTopology.run();
+	EXPECT_LT(0, generators[0]->getTokensGeneratedCount());
+	EXPECT_LT(0, generators[1]->getTokensGeneratedCount());
+	// Each node receives the PDUs of its own generator (at their source) and those of the other node.
+	unsigned int generatedCount = generators[0]->getTokensGeneratedCount() + generators[1]->getTokensGeneratedCount();
+	EXPECT_EQ(generatedCount, nodes[0]->getReceivedPdusOrTokensCount());
+	EXPECT_EQ(generatedCount, nodes[1]->getReceivedPdusOrTokensCount());
+	EXPECT_EQ(generators[0]->getTokensGeneratedCount(), nodes[0]->getForwardedPdusOrTokensCount());
+	EXPECT_EQ(generators[1]->getTokensGeneratedCount(), nodes[1]->getForwardedPdusOrTokensCount());
+	// Transmissions of both directions are requested at the forward link, which hands the reverse ones to its reverse link.
+	EXPECT_LE(generatedCount, duplexLink->transmissionRequestsCount);
+	EXPECT_EQ(0, duplexLink->getInTransitQueueSize());
+	EXPECT_EQ(0, duplexLink->getReverseLink()->getInTransitQueueSize());
+}
+
+/// PDUs routed hop by hop go through the link of the forwarding table, among parallel links.
+TEST_F(StaticTopologyTest, ForwardingTableLink) {
+	StaticTopology<Node, CountingLink, ExponentialTrafficGenerator> staticTopology(simulatorGlobals, scheduler);
+	staticTopology.addNode(nodes[0]);
+	staticTopology.addNode(nodes[1]);
+	std::shared_ptr<CountingLink> firstLink = std::make_shared<CountingLink>(nodes[0], nodes[1], 1000000, 0.01, simulatorGlobals, scheduler);
+	std::shared_ptr<CountingLink> secondLink = std::make_shared<CountingLink>(nodes[0], nodes[1], 1000000, 0.01, simulatorGlobals, scheduler);
+	staticTopology.addLink(firstLink);
+	staticTopology.addLink(secondLink);
+	auto forwardingTable = std::make_shared<ForwardingTable>(2);
+	forwardingTable->setEntry(1, nodes[1], secondLink);
+	nodes[0]->setForwardingTable(forwardingTable);
+	std::shared_ptr<ExponentialTrafficGenerator> generator = std::make_shared<ExponentialTrafficGenerator>(simulatorGlobals, scheduler,
+		EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, nodes[0], nodes[1], 1, 0.05, 1);
+	generator->turnOn();
+	staticTopology.addGenerator(generator, 512, std::vector<std::shared_ptr<Entity>>());
+	staticTopology.start(1.0);
+	scheduler.schedule(Event(10.0, EventType::END_SIMULATION, nullptr));
+	staticTopology.run();
+	EXPECT_LT(0, generator->getTokensGeneratedCount());
+	EXPECT_EQ(generator->getTokensGeneratedCount(), nodes[1]->getReceivedPdusOrTokensCount());
+	EXPECT_EQ(0, firstLink->transmissionRequestsCount);
+	EXPECT_LE(generator->getTokensGeneratedCount(), secondLink->transmissionRequestsCount);
+	EXPECT_EQ(0, secondLink->getInTransitQueueSize());
+}
+
+/// PDUs in flight end propagation on the link they were transmitted on, although the forwarding table entry moves to a parallel link meanwhile.
+TEST_F(StaticTopologyTest, ForwardingTableChange) {
+	StaticTopology<Node, CountingLink, ExponentialTrafficGenerator> staticTopology(simulatorGlobals, scheduler);
+	staticTopology.addNode(nodes[0]);
+	staticTopology.addNode(nodes[1]);
+	std::shared_ptr<CountingLink> firstLink = std::make_shared<CountingLink>(nodes[0], nodes[1], 1000000, 0.01, simulatorGlobals, scheduler);
+	std::shared_ptr<CountingLink> secondLink = std::make_shared<CountingLink>(nodes[0], nodes[1], 1000000, 0.01, simulatorGlobals, scheduler);
+	staticTopology.addLink(firstLink);
+	staticTopology.addLink(secondLink);
+	auto forwardingTable = std::make_shared<ForwardingTable>(2);
+	forwardingTable->setEntry(1, nodes[1], secondLink);
+	nodes[0]->setForwardingTable(forwardingTable);
+	std::shared_ptr<ExponentialTrafficGenerator> generator = std::make_shared<ExponentialTrafficGenerator>(simulatorGlobals, scheduler,
+		EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, nodes[0], nodes[1], 1, 0.005, 1);
+	generator->turnOn();
+	staticTopology.addGenerator(generator, 512, std::vector<std::shared_ptr<Entity>>());
+	staticTopology.start(1.0);
+	scheduler.schedule(Event(0.5, EventType::SET_LINK_DOWN, nullptr));
+	scheduler.schedule(Event(10.0, EventType::END_SIMULATION, nullptr));
+	unsigned int inTransitAtChange = 0;
+	staticTopology.run([&](const Event &event) {
+		if (event.eventType == EventType::SET_LINK_DOWN) {
+			inTransitAtChange = secondLink->getInTransitQueueSize();
+			forwardingTable->setEntry(1, nodes[1], firstLink);
+			return true;
+		}
+		return event.eventType != EventType::END_SIMULATION;
+	});
+	EXPECT_LT(0u, inTransitAtChange);
+	EXPECT_LT(0, firstLink->transmissionRequestsCount);
+	EXPECT_EQ(generator->getTokensGeneratedCount(), nodes[1]->getReceivedPdusOrTokensCount());
+	EXPECT_EQ(0, firstLink->getInTransitQueueSize());
+	EXPECT_EQ(0, secondLink->getInTransitQueueSize());
+}
+
+/// Events off the PDU path are left to the driver: handleEvent() returns false, and run() passes them to the handler until it returns false.
+TEST_F(StaticTopologyTest, OtherEvents) {
+	StaticTopology<> staticTopology(simulatorGlobals, scheduler);
+	Event otherEvent(1.0, EventType::SET_LINK_DOWN, nullptr);
+	EXPECT_FALSE(staticTopology.handleEvent(otherEvent));
+	EXPECT_EQ(0, staticTopology.getEventsCount());
+	scheduler.schedule(Event(1.0, EventType::SET_LINK_DOWN, nullptr));
+	scheduler.schedule(Event(2.0, EventType::REROUTE_QCN_TRAFFIC, nullptr));
+	scheduler.schedule(Event(3.0, EventType::END_SIMULATION, nullptr));
+	scheduler.schedule(Event(4.0, EventType::SET_LINK_DOWN, nullptr));
+	std::vector<EventType> otherEventTypes;
+	EXPECT_EQ(3, staticTopology.run([&otherEventTypes](const Event &event) {
+		otherEventTypes.push_back(event.eventType);
+		return event.eventType != EventType::END_SIMULATION;
+	}));
+	ASSERT_EQ(3, otherEventTypes.size());
+	EXPECT_EQ(EventType::SET_LINK_DOWN, otherEventTypes[0]);
+	EXPECT_EQ(EventType::REROUTE_QCN_TRAFFIC, otherEventTypes[1]);
+	EXPECT_EQ(EventType::END_SIMULATION, otherEventTypes[2]);
+	EXPECT_EQ(1, scheduler.getChainSize());
+}
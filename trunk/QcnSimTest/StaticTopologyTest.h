@@ -0,0 +1,67 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This sample shows how to write a simple unit test for a function,
+// using Google C++ testing framework.
+//
+// Writing a unit test using Google C++ testing framework is easy as 1-2-3:
+
+
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+#pragma once
+
+#include "../gtest/include/gtest/gtest.h"
+#include "../QcnSim/SimulatorGlobals.h"
+#include "../QcnSim/Scheduler.h"
+#include "../QcnSim/StaticTopology.h"
+#include "../QcnSim/Node.h"
+#include "../QcnSim/Link.h"
+#include "../QcnSim/Message.h"
+#include "../QcnSim/ExponentialTrafficGenerator.h"
+#include <memory>
+#include <vector>
+
+/// Link policy for the tests: a Link that counts its transmission requests.
+class CountingLink: public Link {
+public:
+	unsigned int transmissionRequestsCount; //!< Transmission requests received.
+
+	CountingLink(std::shared_ptr<Node> nodeA, std::shared_ptr<Node> nodeB, double bandwidth, double propagationDelay,
+		SimulatorGlobals &simulatorGlobals, Scheduler &scheduler, LinkType linkType = LinkType::SIMPLEX_LINK);
+
+	LinkReturnType transmitPdu(EventType transmitEventType, EventType endTransmitEventType, std::shared_ptr<const ProtocolDataUnit> pdu) override;
+};
+
+/// Fixture for StaticTopology Tests.
+class StaticTopologyTest: public ::testing::Test {
+protected:
+	SimulatorGlobals simulatorGlobals;
+	Scheduler scheduler;
+	std::shared_ptr<Message> tokenContents;
+	std::vector<std::shared_ptr<Node>> nodes; // Sources 0 and 1, router 2, destination 3.
+	std::vector<std::shared_ptr<CountingLink>> links; // 0 to 2, 1 to 2, 2 to 3.
+	std::vector<std::shared_ptr<ExponentialTrafficGenerator>> generators; // At nodes 0 and 1.
+	std::vector<std::vector<std::shared_ptr<Entity>>> routes; // From nodes 0 and 1 to node 3, through node 2.
+		
+	/**
+	 * Constructor.
+	 *
+	 * Do initializations here.
+	 */
+	StaticTopologyTest();
+
+	unsigned int runWithVirtualCalls(double generationEndTime, double simulationTime);
+};
@@ -0,0 +1,162 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TopologySnapshotTest.h"
+#include <cstdio>
+#include <fstream>
+
+const std::string TopologySnapshotTest::snapshotFileName = "TopologySnapshotTest.bin";
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+TopologySnapshotTest::TopologySnapshotTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "TopologySnapshotTest")), 
+		scheduler(Scheduler(simulatorGlobals)) {
+}
+
+/**
+ * Destructor.
+ *
+ * Do cleanup here.
+ */
+TopologySnapshotTest::~TopologySnapshotTest() {
+	std::remove(snapshotFileName.c_str());
+}
+
+/**
+ * Build a small topology: three nodes (one shared by two keys), a duplex and a simplex link, one sensor and its routes.
+ */
+void TopologySnapshotTest::buildTopology() {
+	auto sensorNode = std::make_shared<Node>(simulatorGlobals, 0);
+	auto routerNode = std::make_shared<Node>(simulatorGlobals, 1);
+	auto serverNode = std::make_shared<Node>(simulatorGlobals, 2);
+	topology.nodeMap[10] = sensorNode;
+	topology.nodeMap[20] = routerNode;
+	topology.nodeMap[21] = routerNode;
+	topology.nodeMap[30] = serverNode;
+	topology.linkMap[100] = std::make_shared<Link>(sensorNode, routerNode, 1e6, 0.01, simulatorGlobals, scheduler, "sensor-router", LinkType::DUPLEX_LINK);
+	topology.linkMap[101] = std::make_shared<Link>(routerNode, serverNode, 1e9, 0.002, simulatorGlobals, scheduler, "router-server");
+	topology.linkMap[101]->setTransmissionQueueSizeLimit(50);
+	topology.linkMap[101]->setDown();
+	auto qcnSensorTrafficGenerator = std::make_shared<QcnSensorTrafficGenerator>(simulatorGlobals, scheduler, EventType::SEISMIC_EVENT_DETECTION, nullptr,
+		sensorNode, serverNode, 3, 41.93, -77.21, 2, 7);
+	QcnSensorParameters sensorParameters;
+	sensorParameters.onFraction = 0.9;
+	sensorParameters.triggerProbability = 0.5;
+	sensorParameters.pduSize = 1000;
+	qcnSensorTrafficGenerator->setSensorParameters(sensorParameters);
+	qcnSensorTrafficGenerator->turnOff();
+	topology.qcnSensorTrafficGeneratorMap[2] = qcnSensorTrafficGenerator;
+	topology.explicitRouteMap[2] = {sensorNode, routerNode, serverNode};
+	topology.alternateRouteMap[2] = {{sensorNode, routerNode, serverNode}, {sensorNode, serverNode}};
+}
+
+/// Save and load a topology, check rebuilt objects and sharing.
+TEST_F(TopologySnapshotTest, SaveAndLoad) {
+	buildTopology();
+	ScenarioParameters scenarioParameters;
+	scenarioParameters.simulationName = "snapshotSim";
+	scenarioParameters.endClock = 100.0;
+	scenarioParameters.printTraces = true;
+	std::vector<std::shared_ptr<EarthquakeData>> earthquakes;
+	earthquakes.push_back(std::make_shared<EarthquakeData>(1, 6.5, 10.0, 3.5, 15.0, 40.46, -75.95));
+	TopologySnapshot topologySnapshot(simulatorGlobals, scheduler);
+	ASSERT_EQ(SnapshotReturnType::SNAPSHOT_SAVED, topologySnapshot.save(snapshotFileName, topology, scenarioParameters, earthquakes))
+		<< topologySnapshot.getErrorMessage();
+
+	Topology loadedTopology;
+	TopologySnapshot loadingSnapshot(simulatorGlobals, scheduler);
+	ASSERT_EQ(SnapshotReturnType::SNAPSHOT_LOADED, loadingSnapshot.load(snapshotFileName, loadedTopology)) << loadingSnapshot.getErrorMessage();
+	// Parameters and earthquakes.
+	EXPECT_EQ("snapshotSim", loadingSnapshot.getScenarioParameters().simulationName);
+	EXPECT_EQ(100.0, loadingSnapshot.getScenarioParameters().endClock);
+	EXPECT_TRUE(loadingSnapshot.getScenarioParameters().printTraces);
+	ASSERT_EQ(1, loadingSnapshot.getEarthquakes().size());
+	EXPECT_EQ(6.5, loadingSnapshot.getEarthquakes().at(0)->magnitude);
+	EXPECT_EQ(-75.95, loadingSnapshot.getEarthquakes().at(0)->longitude);
+	// Nodes: same keys, same ids, sharing preserved.
+	ASSERT_EQ(4, loadedTopology.nodeMap.size());
+	EXPECT_EQ(1, loadedTopology.nodeMap.at(20)->getNodeId());
+	EXPECT_EQ(loadedTopology.nodeMap.at(20), loadedTopology.nodeMap.at(21));
+	EXPECT_NE(topology.nodeMap.at(20), loadedTopology.nodeMap.at(20));
+	// Links.
+	ASSERT_EQ(2, loadedTopology.linkMap.size());
+	std::shared_ptr<Link> duplexLink = loadedTopology.linkMap.at(100);
+	EXPECT_EQ(LinkType::DUPLEX_LINK, duplexLink->getLinkType());
+	EXPECT_EQ(1e6, duplexLink->getBandwidth());
+	EXPECT_EQ(0.01, duplexLink->getPropagationDelay());
+	EXPECT_EQ("sensor-router", duplexLink->getName());
+	EXPECT_EQ(loadedTopology.nodeMap.at(10), duplexLink->getNodeA());
+	EXPECT_EQ(loadedTopology.nodeMap.at(20), duplexLink->getNodeB());
+	ASSERT_NE(nullptr, duplexLink->getReverseLink());
+	EXPECT_EQ(loadedTopology.nodeMap.at(10), duplexLink->getReverseLink()->getNodeB());
+	std::shared_ptr<Link> simplexLink = loadedTopology.linkMap.at(101);
+	EXPECT_EQ(LinkType::SIMPLEX_LINK, simplexLink->getLinkType());
+	EXPECT_FALSE(simplexLink->isUp());
+	EXPECT_EQ(50, simplexLink->getTransmissionQueueSizeLimit());
+	// Generators.
+	ASSERT_EQ(1, loadedTopology.qcnSensorTrafficGeneratorMap.size());
+	std::shared_ptr<QcnSensorTrafficGenerator> qcnSensorTrafficGenerator = loadedTopology.qcnSensorTrafficGeneratorMap.at(2);
+	EXPECT_EQ(EventType::SEISMIC_EVENT_DETECTION, qcnSensorTrafficGenerator->getEventType());
+	EXPECT_EQ(loadedTopology.nodeMap.at(10), qcnSensorTrafficGenerator->getSource());
+	EXPECT_EQ(loadedTopology.nodeMap.at(30), qcnSensorTrafficGenerator->getDestination());
+	EXPECT_EQ(3, qcnSensorTrafficGenerator->getPriority());
+	EXPECT_FALSE(qcnSensorTrafficGenerator->isGeneratorOn());
+	EXPECT_EQ(41.93, qcnSensorTrafficGenerator->getLatitude());
+	EXPECT_EQ(2, qcnSensorTrafficGenerator->getQcnExplorerSensorId());
+	EXPECT_EQ(7, qcnSensorTrafficGenerator->getRegionId());
+	EXPECT_EQ(0.9, qcnSensorTrafficGenerator->getSensorParameters().onFraction);
+	EXPECT_EQ(0.5, qcnSensorTrafficGenerator->getSensorParameters().triggerProbability);
+	EXPECT_EQ(1000, qcnSensorTrafficGenerator->getSensorParameters().pduSize);
+	// Routes.
+	ASSERT_EQ(3, loadedTopology.explicitRouteMap.at(2).size());
+	EXPECT_EQ(loadedTopology.nodeMap.at(21), loadedTopology.explicitRouteMap.at(2).at(1));
+	ASSERT_EQ(2, loadedTopology.alternateRouteMap.at(2).size());
+	ASSERT_EQ(2, loadedTopology.alternateRouteMap.at(2).at(1).size());
+	EXPECT_EQ(loadedTopology.nodeMap.at(30), loadedTopology.alternateRouteMap.at(2).at(1).at(1));
+}
+
+/// Missing, foreign and truncated files, and entities outside the topology.
+TEST_F(TopologySnapshotTest, InvalidSnapshots) {
+	TopologySnapshot topologySnapshot(simulatorGlobals, scheduler);
+	Topology loadedTopology;
+	std::remove(snapshotFileName.c_str());
+	EXPECT_EQ(SnapshotReturnType::FILE_NOT_FOUND, topologySnapshot.load(snapshotFileName, loadedTopology));
+	{
+		std::ofstream outputFile(snapshotFileName, std::ios::binary);
+		outputFile << "not a snapshot at all";
+	}
+	EXPECT_EQ(SnapshotReturnType::INVALID_SNAPSHOT, topologySnapshot.load(snapshotFileName, loadedTopology));
+	EXPECT_FALSE(topologySnapshot.getErrorMessage().empty());
+
+	// Truncate a valid snapshot.
+	buildTopology();
+	ASSERT_EQ(SnapshotReturnType::SNAPSHOT_SAVED, topologySnapshot.save(snapshotFileName, topology));
+	std::string contents;
+	{
+		std::ifstream inputFile(snapshotFileName, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(inputFile), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream outputFile(snapshotFileName, std::ios::binary | std::ios::trunc);
+		outputFile.write(contents.data(), contents.size() - 5);
+	}
+	EXPECT_EQ(SnapshotReturnType::INVALID_SNAPSHOT, topologySnapshot.load(snapshotFileName, loadedTopology));
+
+	// Route hop not present in nodeMap.
+	topology.explicitRouteMap[3] = {topology.nodeMap.at(10), std::make_shared<Node>(simulatorGlobals)};
+	EXPECT_EQ(SnapshotReturnType::UNSUPPORTED_ENTITY, topologySnapshot.save(snapshotFileName, topology));
+}
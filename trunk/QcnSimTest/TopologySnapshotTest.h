@@ -0,0 +1,57 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This sample shows how to write a simple unit test for a function,
+// using Google C++ testing framework.
+//
+// Writing a unit test using Google C++ testing framework is easy as 1-2-3:
+
+
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#pragma once
+
+#include "../gtest/include/gtest/gtest.h"
+#include "../QcnSim/SimulatorGlobals.h"
+#include "../QcnSim/Scheduler.h"
+#include "../QcnSim/Topology.h"
+#include "../QcnSim/TopologySnapshot.h"
+#include <string>
+
+/// Fixture for TopologySnapshot Tests.
+class TopologySnapshotTest: public ::testing::Test {
+protected:
+	SimulatorGlobals simulatorGlobals;
+	Scheduler scheduler;
+	Topology topology;
+	static const std::string snapshotFileName; //!< Scratch snapshot file, removed by the destructor.
+		
+	/**
+	 * Constructor.
+	 *
+	 * Do initializations here.
+	 */
+	TopologySnapshotTest();
+
+	/**
+	 * Destructor.
+	 *
+	 * Do cleanup here.
+	 */
+	virtual ~TopologySnapshotTest();
+
+	void buildTopology();
+};
@@ -0,0 +1,174 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TraceReplayTrafficGeneratorTest.h"
+#include <cmath>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+TraceReplayTrafficGeneratorTest::TraceReplayTrafficGeneratorTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "TraceReplayTrafficGeneratorTest")),
+		scheduler(Scheduler(simulatorGlobals)), defaultSource(std::make_shared<Message>("Default source.")),
+		firstHostSource(std::make_shared<Message>("Source of host 10.")), secondHostSource(std::make_shared<Message>("Source of host 20.")),
+		destination(std::make_shared<Message>("This is a dummy entity for destination.")) {
+	TraceReplayTrafficGenerator::TraceRecord record;
+	record.time = 0.5; record.hostId = 10; record.pduSize = 100; records.push_back(record);
+	record.time = 1.5; record.hostId = 20; record.pduSize = 200; records.push_back(record);
+	record.time = 1.5; record.hostId = 10; record.pduSize = 0; records.push_back(record);
+	record.time = 4.0; record.hostId = 30; record.pduSize = 300; records.push_back(record);
+}
+
+/**
+ * Write the test records as a CSV trace, with a header line.
+ */
+void TraceReplayTrafficGeneratorTest::writeCsvTrace(const std::string &fileName) {
+	std::ofstream outputFile(fileName);
+	outputFile << "time,hostId,pduSize" << std::endl;
+	for (auto &record : records) {
+		outputFile << record.time << "," << record.hostId << "," << record.pduSize << std::endl;
+	}
+}
+
+/// CSV replay: arrival times, host sources and sizes; the generator turns off at the end of the trace.
+TEST_F(TraceReplayTrafficGeneratorTest, CsvReplay) {
+	writeCsvTrace("traceReplay.csv");
+	TraceReplayTrafficGenerator traceGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, defaultSource, destination, 1);
+	EXPECT_EQ(TraceReturnType::TRACE_OPENED, traceGenerator.openTrace("traceReplay.csv"));
+	traceGenerator.mapHost(10, firstHostSource);
+	traceGenerator.mapHost(20, secondHostSource);
+	EXPECT_EQ(nullptr, traceGenerator.createInstanceTrafficEventPdu(500)); // Off: no record is consumed.
+	traceGenerator.turnOn();
+	std::vector<std::shared_ptr<Entity>> expectedSources = {firstHostSource, secondHostSource, firstHostSource, defaultSource};
+	std::vector<unsigned int> expectedSizes = {100, 200, 500, 300};
+	for (std::vector<TraceReplayTrafficGenerator::TraceRecord>::size_type i = 0; i < records.size(); ++i) {
+		std::shared_ptr<ProtocolDataUnit> pdu = traceGenerator.createInstanceTrafficEventPdu(500);
+		ASSERT_NE(nullptr, pdu);
+		EXPECT_EQ(expectedSources[i], pdu->source);
+		EXPECT_EQ(destination, pdu->destination);
+		EXPECT_EQ(expectedSizes[i], pdu->getPduSize());
+		Event event = scheduler.cause();
+		EXPECT_EQ(pdu, event.entity);
+		EXPECT_DOUBLE_EQ(records[i].time, simulatorGlobals.getCurrentAbsoluteTime());
+	}
+	EXPECT_EQ(nullptr, traceGenerator.createInstanceTrafficEventPdu(500));
+	EXPECT_FALSE(traceGenerator.isGeneratorOn());
+	EXPECT_EQ(4, traceGenerator.getTokensGeneratedCount());
+}
+
+/// Binary replay with time scaling, host subset and looping.
+TEST_F(TraceReplayTrafficGeneratorTest, BinaryScaledSubsetLooping) {
+	EXPECT_EQ(TraceReturnType::TRACE_WRITTEN, TraceReplayTrafficGenerator::writeBinaryTrace("traceReplay.trace", records));
+	TraceReplayTrafficGenerator traceGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, defaultSource, destination, 1);
+	EXPECT_EQ(TraceReturnType::TRACE_OPENED, traceGenerator.openTrace("traceReplay.trace"));
+	traceGenerator.setTimeScale(2.0);
+	traceGenerator.setHostSubset({10});
+	traceGenerator.setLooping(true);
+	EXPECT_TRUE(traceGenerator.isTraceLooping());
+	traceGenerator.turnOn();
+	// Host 10 at 0.5 and 1.5, scaled; each loop starts after the last record of the trace (4.0).
+	std::vector<double> expectedTimes = {1.0, 3.0, 9.0, 11.0, 17.0, 19.0};
+	for (auto expectedTime : expectedTimes) {
+		std::shared_ptr<Token> token = traceGenerator.createInstanceTrafficEvent();
+		ASSERT_NE(nullptr, token);
+		EXPECT_EQ(10, traceGenerator.getCurrentRecord().hostId);
+		scheduler.cause();
+		EXPECT_DOUBLE_EQ(expectedTime, simulatorGlobals.getCurrentAbsoluteTime());
+	}
+	// A subset with no host in the trace ends the replay instead of looping forever.
+	traceGenerator.setHostSubset({99});
+	EXPECT_EQ(nullptr, traceGenerator.createInstanceTrafficEvent());
+}
+
+/// Changing the time scale mid-run scales only the trace time elapsed since the last record, without jumps.
+TEST_F(TraceReplayTrafficGeneratorTest, TimeScaleChange) {
+	EXPECT_EQ(TraceReturnType::TRACE_WRITTEN, TraceReplayTrafficGenerator::writeBinaryTrace("traceReplay.trace", records));
+	TraceReplayTrafficGenerator traceGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, defaultSource, destination, 1);
+	EXPECT_EQ(TraceReturnType::TRACE_OPENED, traceGenerator.openTrace("traceReplay.trace"));
+	traceGenerator.turnOn();
+	ASSERT_NE(nullptr, traceGenerator.createInstanceTrafficEvent());
+	scheduler.cause();
+	EXPECT_DOUBLE_EQ(0.5, simulatorGlobals.getCurrentAbsoluteTime());
+	// Twice as slow from 0.5 on: 1.5 -> 0.5 + 1.0 * 2, 4.0 -> 2.5 + 2.5 * 2.
+	traceGenerator.setTimeScale(2.0);
+	std::vector<double> expectedTimes = {2.5, 2.5, 7.5};
+	for (auto expectedTime : expectedTimes) {
+		ASSERT_NE(nullptr, traceGenerator.createInstanceTrafficEvent());
+		scheduler.cause();
+		EXPECT_DOUBLE_EQ(expectedTime, simulatorGlobals.getCurrentAbsoluteTime());
+	}
+}
+
+/// Traces longer than the read-ahead are streamed in order.
+TEST_F(TraceReplayTrafficGeneratorTest, LongTrace) {
+	std::vector<TraceReplayTrafficGenerator::TraceRecord> longRecords;
+	int numberOfRecords = 3 * TRACE_READ_AHEAD_RECORDS + 7;
+	for (int i = 0; i < numberOfRecords; ++i) {
+		TraceReplayTrafficGenerator::TraceRecord record;
+		record.time = i * 0.25;
+		record.hostId = i % 7;
+		record.pduSize = i;
+		longRecords.push_back(record);
+	}
+	EXPECT_EQ(TraceReturnType::TRACE_WRITTEN, TraceReplayTrafficGenerator::writeBinaryTrace("traceReplayLong.trace", longRecords));
+	TraceReplayTrafficGenerator traceGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, defaultSource, destination, 1);
+	EXPECT_EQ(TraceReturnType::TRACE_OPENED, traceGenerator.openTrace("traceReplayLong.trace"));
+	traceGenerator.turnOn();
+	for (int i = 0; i < numberOfRecords; ++i) {
+		std::shared_ptr<ProtocolDataUnit> pdu = traceGenerator.createInstanceTrafficEventPdu(1);
+		ASSERT_NE(nullptr, pdu);
+		EXPECT_EQ(static_cast<unsigned int>(i == 0 ? 1 : i), pdu->getPduSize());
+		EXPECT_EQ(static_cast<uint32_t>(i % 7), traceGenerator.getCurrentRecord().hostId);
+		scheduler.cause();
+		EXPECT_DOUBLE_EQ(i * 0.25, simulatorGlobals.getCurrentAbsoluteTime());
+	}
+	EXPECT_EQ(nullptr, traceGenerator.createInstanceTrafficEventPdu(1));
+}
+
+/// Autonomous replay: one recurring event, PDUs materialized with the host and size of the arrival just fired.
+TEST_F(TraceReplayTrafficGeneratorTest, Autonomous) {
+	writeCsvTrace("traceReplay.csv");
+	TraceReplayTrafficGenerator traceGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, defaultSource, destination, 1);
+	EXPECT_EQ(TraceReturnType::TRACE_OPENED, traceGenerator.openTrace("traceReplay.csv"));
+	traceGenerator.mapHost(20, secondHostSource);
+	EXPECT_TRUE(traceGenerator.turnOnAutonomous());
+	std::vector<std::shared_ptr<Entity>> expectedSources = {defaultSource, secondHostSource, defaultSource, defaultSource};
+	std::vector<unsigned int> expectedSizes = {100, 200, 500, 300};
+	for (std::vector<TraceReplayTrafficGenerator::TraceRecord>::size_type i = 0; i < records.size(); ++i) {
+		Event event = scheduler.cause();
+		EXPECT_EQ(&traceGenerator, event.entity.get());
+		EXPECT_DOUBLE_EQ(records[i].time, simulatorGlobals.getCurrentAbsoluteTime());
+		std::shared_ptr<ProtocolDataUnit> pdu = traceGenerator.materializePdu(500);
+		ASSERT_NE(nullptr, pdu);
+		EXPECT_EQ(expectedSources[i], pdu->source);
+		EXPECT_EQ(expectedSizes[i], pdu->getPduSize());
+		EXPECT_EQ(1, scheduler.getChainSize());
+	}
+	// The exhausted trace parks its event at infinity.
+	scheduler.schedule(Event(10.0, EventType::END_SIMULATION, nullptr));
+	EXPECT_EQ(EventType::END_SIMULATION, scheduler.cause().eventType);
+}
+
+/// Missing and invalid traces.
+TEST_F(TraceReplayTrafficGeneratorTest, InvalidTraces) {
+	TraceReplayTrafficGenerator traceGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, nullptr, defaultSource, destination, 1);
+	EXPECT_EQ(TraceReturnType::FILE_NOT_FOUND, traceGenerator.openTrace("doesNotExist.trace"));
+	traceGenerator.turnOn();
+	EXPECT_EQ(nullptr, traceGenerator.createInstanceTrafficEvent());
+	std::ofstream outputFile("traceReplayInvalid.trace", std::ios::binary);
+	outputFile << "QCNTRACE" << "xx";
+	outputFile.close();
+	EXPECT_EQ(TraceReturnType::INVALID_TRACE, traceGenerator.openTrace("traceReplayInvalid.trace"));
+}
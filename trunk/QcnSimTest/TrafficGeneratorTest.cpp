@@ -234,3 +234,72 @@ TEST_F(TrafficGeneratorTest, ConstantRateGeneratorTest) {
 }
 
 
+
+/// Autonomous mode: a single recurring event per generator, and tokens only when materialized.
+TEST_F(TrafficGeneratorTest, AutonomousModeTest) {
+	std::shared_ptr<Message> source(new Message("This is a dummy entity for source."));
+	std::shared_ptr<Message> destination(new Message("This is a dummy entity for destination."));
+	std::shared_ptr<Message> tokenContents(new Message("This is a dummy Token contents."));
+	Event event;
+
+	ConstantRateTrafficGenerator cbrGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 3.0);
+	EXPECT_TRUE(cbrGenerator.supportsAutonomousMode());
+	EXPECT_TRUE(cbrGenerator.turnOnAutonomous());
+	EXPECT_FALSE(cbrGenerator.turnOnAutonomous()); // Already autonomous.
+	EXPECT_TRUE(cbrGenerator.isGeneratorOn());
+	EXPECT_TRUE(cbrGenerator.isGeneratorAutonomous());
+	scheduler.schedule(Event(4.0, EventType::END_SIMULATION, nullptr));
+	EXPECT_EQ(2, scheduler.getChainSize());
+	// Arrivals at 3, 6, 9, with the other event in between; the recurring event stays in the chain.
+	event = scheduler.cause();
+	EXPECT_DOUBLE_EQ(3.0, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(EventType::TRAFFIC_GENERATOR_ARRIVAL, event.eventType);
+	EXPECT_EQ(&cbrGenerator, event.entity.get());
+	EXPECT_EQ(2, scheduler.getChainSize());
+	event = scheduler.cause();
+	EXPECT_DOUBLE_EQ(4.0, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(EventType::END_SIMULATION, event.eventType);
+	event = scheduler.cause();
+	EXPECT_DOUBLE_EQ(6.0, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(&cbrGenerator, event.entity.get());
+	// No token until materialized.
+	EXPECT_EQ(0, cbrGenerator.getTokensGeneratedCount());
+	std::shared_ptr<ProtocolDataUnit> pdu = cbrGenerator.materializePdu(1000);
+	ASSERT_NE(nullptr, pdu);
+	EXPECT_EQ(1000, pdu->getPduSize());
+	EXPECT_EQ(tokenContents, pdu->associatedEntity);
+	EXPECT_EQ(destination, pdu->destination);
+	EXPECT_EQ(1, cbrGenerator.getTokensGeneratedCount());
+	event = scheduler.cause();
+	EXPECT_DOUBLE_EQ(9.0, simulatorGlobals.getCurrentAbsoluteTime());
+	EXPECT_EQ(1, scheduler.getChainSize());
+	// Turning off removes the recurring event.
+	cbrGenerator.turnOff();
+	EXPECT_FALSE(cbrGenerator.isGeneratorAutonomous());
+	EXPECT_EQ(0, scheduler.getChainSize());
+	EXPECT_EQ(nullptr, cbrGenerator.materializeToken());
+
+	// An autonomous exponential generator arrives at the same times as one driven by createInstanceTrafficEvent(), with equal streams.
+	SimulatorGlobals otherSimulatorGlobals(0.0, 0.0, false, "TrafficGeneratorTest");
+	Scheduler otherScheduler(otherSimulatorGlobals);
+	otherSimulatorGlobals.seedRandomNumberGenerator(simulatorGlobals.getRandomNumberGeneratorSeed());
+	ExponentialTrafficGenerator drivenGenerator(otherSimulatorGlobals, otherScheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 2.0);
+	drivenGenerator.setRandomStream(1);
+	drivenGenerator.turnOn();
+	drivenGenerator.createInstanceTrafficEvent();
+	{
+		ExponentialTrafficGenerator exponentialGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 2.0);
+		exponentialGenerator.setRandomStream(1);
+		EXPECT_TRUE(exponentialGenerator.turnOnAutonomous());
+		double startTime = simulatorGlobals.getCurrentAbsoluteTime();
+		for (int i = 0; i < 300; ++i) {
+			scheduler.cause();
+			otherScheduler.cause();
+			drivenGenerator.createInstanceTrafficEvent();
+			EXPECT_NEAR(otherSimulatorGlobals.getCurrentAbsoluteTime(), simulatorGlobals.getCurrentAbsoluteTime() - startTime, 1e-9);
+			EXPECT_EQ(1, scheduler.getChainSize());
+		}
+	}
+	// The destroyed generator removed its recurring event.
+	EXPECT_EQ(0, scheduler.getChainSize());
+}
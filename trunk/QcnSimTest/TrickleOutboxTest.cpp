@@ -0,0 +1,182 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TrickleOutboxTest.h"
+#include <cmath>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+TrickleOutboxTest::TrickleOutboxTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "TrickleOutboxTest")),
+		scheduler(Scheduler(simulatorGlobals)) {
+	node0 = std::make_shared<Node>(simulatorGlobals, 0);
+	node1 = std::make_shared<Node>(simulatorGlobals, 1);
+	uplink = std::make_shared<Link>(node0, node1, 8000, 0.01, simulatorGlobals, scheduler);
+}
+
+/**
+ * Create a PDU from node0 to node1, as forwarded by node0.
+ */
+std::shared_ptr<ProtocolDataUnit> TrickleOutboxTest::createPdu() {
+	return std::shared_ptr<ProtocolDataUnit>(new ProtocolDataUnit(simulatorGlobals, 1, nullptr, node0, node1, node0, node1, 100));
+}
+
+/// Timers expire at the end of their tick, together with the other timers of the tick; far timers wait in the overflow map.
+TEST_F(TrickleOutboxTest, TimerWheel) {
+	TimerWheel timerWheel(0.1, 8);
+	std::vector<uint32_t> expiredTimerIds;
+	EXPECT_TRUE(timerWheel.isEmpty());
+	EXPECT_EQ(std::numeric_limits<double>::max(), timerWheel.getNextExpiryTime());
+	timerWheel.add(0.25, 1);
+	timerWheel.add(0.21, 2);
+	timerWheel.add(0.35, 3);
+	timerWheel.add(5.0, 4); // Beyond the 8 ticks of the wheel.
+	timerWheel.add(0.3, 5); // On a tick boundary.
+	EXPECT_EQ(5, timerWheel.getSize());
+	EXPECT_NEAR(0.3, timerWheel.getNextExpiryTime(), 1e-12);
+	timerWheel.advance(0.29, expiredTimerIds);
+	EXPECT_TRUE(expiredTimerIds.empty());
+	timerWheel.advance(0.3, expiredTimerIds);
+	ASSERT_EQ(3, expiredTimerIds.size());
+	EXPECT_EQ(1, expiredTimerIds[0]);
+	EXPECT_EQ(2, expiredTimerIds[1]);
+	EXPECT_EQ(5, expiredTimerIds[2]);
+	EXPECT_NEAR(0.4, timerWheel.getNextExpiryTime(), 1e-12);
+	expiredTimerIds.clear();
+	timerWheel.advance(0.4, expiredTimerIds);
+	ASSERT_EQ(1, expiredTimerIds.size());
+	EXPECT_EQ(3, expiredTimerIds[0]);
+	EXPECT_NEAR(5.0, timerWheel.getNextExpiryTime(), 1e-12);
+	// Timer in the past expires on the next advance; the overflow timer moves into the wheel as time approaches it.
+	timerWheel.add(0.1, 6);
+	expiredTimerIds.clear();
+	timerWheel.advance(4.5, expiredTimerIds);
+	ASSERT_EQ(1, expiredTimerIds.size());
+	EXPECT_EQ(6, expiredTimerIds[0]);
+	EXPECT_EQ(1, timerWheel.getSize());
+	expiredTimerIds.clear();
+	timerWheel.advance(100.0, expiredTimerIds);
+	ASSERT_EQ(1, expiredTimerIds.size());
+	EXPECT_EQ(4, expiredTimerIds[0]);
+	EXPECT_TRUE(timerWheel.isEmpty());
+}
+
+/// PDUs submitted while the uplink is down are stored, retried with backoff, and flushed in order when the uplink is up again.
+TEST_F(TrickleOutboxTest, StoreAndFlush) {
+	TrickleOutbox trickleOutbox(simulatorGlobals, scheduler);
+	std::vector<std::shared_ptr<ProtocolDataUnit>> pdus;
+	EXPECT_EQ(OutboxReturnType::PDU_SENT, trickleOutbox.submit(7, createPdu(), uplink));
+	EXPECT_EQ(1, scheduler.getChainSize());
+	Event event = scheduler.cause();
+	EXPECT_EQ(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, event.eventType);
+	uplink->setDown();
+	for (int i = 0; i < 3; ++i) {
+		pdus.push_back(createPdu());
+		EXPECT_EQ(OutboxReturnType::PDU_STORED, trickleOutbox.submit(7, pdus.back(), uplink));
+	}
+	EXPECT_EQ(3, trickleOutbox.getOutboxSize(7));
+	EXPECT_EQ(1, scheduler.getChainSize()); // The recurring event of retries only.
+	// First retry after the initial backoff, with the uplink still down.
+	event = scheduler.cause();
+	EXPECT_EQ(EventType::TRICKLE_RETRY, event.eventType);
+	EXPECT_NEAR(OUTBOX_INITIAL_BACKOFF, simulatorGlobals.getCurrentAbsoluteTime(), 1e-9);
+	EXPECT_EQ(0, trickleOutbox.processRetries());
+	EXPECT_EQ(1, trickleOutbox.getFailedRetriesCount());
+	uplink->setUp();
+	// A PDU submitted now waits behind the stored ones.
+	pdus.push_back(createPdu());
+	EXPECT_EQ(OutboxReturnType::PDU_STORED, trickleOutbox.submit(7, pdus.back(), uplink));
+	event = scheduler.cause();
+	EXPECT_EQ(EventType::TRICKLE_RETRY, event.eventType);
+	EXPECT_NEAR(OUTBOX_INITIAL_BACKOFF * (1.0 + OUTBOX_BACKOFF_MULTIPLIER), simulatorGlobals.getCurrentAbsoluteTime(), 1e-9);
+	EXPECT_EQ(4, trickleOutbox.processRetries());
+	EXPECT_EQ(0, trickleOutbox.getOutboxSize(7));
+	for (auto &pdu : pdus) {
+		event = scheduler.cause();
+		EXPECT_EQ(EventType::REQUEST_PDU_TRANSMISSION_AT_LINK, event.eventType);
+		EXPECT_EQ(pdu, event.entity);
+	}
+	EXPECT_EQ(OutboxReturnType::PDU_SENT, trickleOutbox.submit(7, createPdu(), uplink));
+	EXPECT_EQ(2, trickleOutbox.getSentPdusCount());
+	EXPECT_EQ(4, trickleOutbox.getStoredPdusCount());
+	EXPECT_EQ(4, trickleOutbox.getFlushedPdusCount());
+	EXPECT_EQ(2, trickleOutbox.getRetriesCount());
+}
+
+/// Delays between retries double up to the maximum; full outboxes drop their oldest PDUs; large outboxes are flushed in batches.
+TEST_F(TrickleOutboxTest, BackoffCapacityAndBatches) {
+	TrickleOutbox trickleOutbox(simulatorGlobals, scheduler);
+	trickleOutbox.setCapacity(5);
+	trickleOutbox.setBackoff(1.0, 4.0);
+	trickleOutbox.setFlushBatchSize(2);
+	std::vector<std::shared_ptr<ProtocolDataUnit>> pdus;
+	uplink->setDown();
+	for (int i = 0; i < 6; ++i) {
+		pdus.push_back(createPdu());
+		EXPECT_EQ(i < 5 ? OutboxReturnType::PDU_STORED : OutboxReturnType::PDU_STORED_OLDEST_DROPPED, trickleOutbox.submit(3, pdus.back(), uplink));
+	}
+	EXPECT_EQ(5, trickleOutbox.getOutboxSize(3));
+	EXPECT_EQ(1, trickleOutbox.getDroppedPdusCount());
+	double retryTimes[] = {1.0, 3.0, 7.0, 11.0, 15.0};
+	for (auto retryTime : retryTimes) {
+		Event event = scheduler.cause();
+		EXPECT_EQ(EventType::TRICKLE_RETRY, event.eventType);
+		EXPECT_NEAR(retryTime, simulatorGlobals.getCurrentAbsoluteTime(), 1e-9);
+		EXPECT_EQ(0, trickleOutbox.processRetries());
+	}
+	uplink->setUp();
+	// Batches of 2 PDUs, one tick apart; the first PDU was dropped.
+	unsigned int pduIndex = 1;
+	double flushTime = 19.0;
+	while (pduIndex < pdus.size()) {
+		Event event = scheduler.cause();
+		EXPECT_EQ(EventType::TRICKLE_RETRY, event.eventType);
+		EXPECT_NEAR(flushTime, simulatorGlobals.getCurrentAbsoluteTime(), 1e-9);
+		unsigned int flushedCount = trickleOutbox.processRetries();
+		EXPECT_EQ(std::min(2u, static_cast<unsigned int>(pdus.size() - pduIndex)), flushedCount);
+		for (unsigned int i = 0; i < flushedCount; ++i) {
+			event = scheduler.cause();
+			EXPECT_EQ(pdus[pduIndex++], event.entity);
+		}
+		flushTime += TIMER_WHEEL_TICK;
+	}
+	EXPECT_EQ(0, trickleOutbox.getStoredPdusSize());
+	EXPECT_EQ(0, trickleOutbox.getPendingRetriesSize());
+}
+
+/// An outage of many hosts keeps a single retry event in the event chain.
+TEST_F(TrickleOutboxTest, MassOutage) {
+	TrickleOutbox trickleOutbox(simulatorGlobals, scheduler);
+	const unsigned int numberOfHosts = 10000;
+	uplink->setDown();
+	for (unsigned int hostId = 0; hostId < numberOfHosts; ++hostId) {
+		trickleOutbox.submit(hostId, createPdu(), uplink);
+	}
+	EXPECT_EQ(1, scheduler.getChainSize());
+	EXPECT_EQ(numberOfHosts, trickleOutbox.getPendingRetriesSize());
+	scheduler.cause();
+	EXPECT_EQ(0, trickleOutbox.processRetries());
+	EXPECT_EQ(numberOfHosts, trickleOutbox.getFailedRetriesCount());
+	EXPECT_EQ(1, scheduler.getChainSize());
+	uplink->setUp();
+	Event event = scheduler.cause();
+	EXPECT_EQ(EventType::TRICKLE_RETRY, event.eventType);
+	EXPECT_EQ(numberOfHosts, trickleOutbox.processRetries());
+	EXPECT_EQ(2, trickleOutbox.getRetryEventsCount());
+	EXPECT_EQ(0, trickleOutbox.getPendingRetriesSize());
+	// The PDUs flushed, plus the recurring event parked until new timers are armed.
+	EXPECT_EQ(numberOfHosts + 1, scheduler.getChainSize());
+}
@@ -0,0 +1,135 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "VariateValidationTest.h"
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+/**
+ * Constructor.
+ *
+ * Do initializations here.
+ */
+VariateValidationTest::VariateValidationTest(): simulatorGlobals(SimulatorGlobals(0.0, 0.0, false, "VariateValidationTest")),
+		scheduler(Scheduler(simulatorGlobals)), source(std::make_shared<Message>("This is a dummy entity for source.")),
+		destination(std::make_shared<Message>("This is a dummy entity for destination.")),
+		tokenContents(std::make_shared<Message>("This is a dummy Token contents.")) {
+	simulatorGlobals.seedRandomNumberGenerator(1); // Use a fixed seed here for the tests.
+}
+
+/**
+ * Print the throughput of a generator and record it as a test property.
+ *
+ * @param name Name of the generator.
+ * @param elapsedSeconds Time taken to draw VALIDATION_NUMBER_OF_SAMPLES variates.
+ */
+void VariateValidationTest::reportThroughput(const std::string &name, double elapsedSeconds) {
+	double variatesPerSecond = elapsedSeconds > 0.0 ? VALIDATION_NUMBER_OF_SAMPLES / elapsedSeconds : 0.0;
+	std::ostringstream throughput;
+	throughput << static_cast<long long>(variatesPerSecond);
+	RecordProperty(name + " variates/s", throughput.str());
+	std::cout << "[ VARIATES] " << name << ": " << throughput.str() << " variates/s" << std::endl;
+}
+
+/**
+ * Expect the samples to pass the Kolmogorov-Smirnov, Anderson-Darling and chi-square tests against a CDF, at 1% significance.
+ *
+ * @param name Name of the generator, for failure messages.
+ * @param samples Samples drawn from the generator.
+ * @param cdf Analytical CDF of the distribution of the generator.
+ */
+void VariateValidationTest::expectFit(const std::string &name, const std::vector<double> &samples, const GoodnessOfFit::Cdf &cdf) {
+	EXPECT_LE(GoodnessOfFit::kolmogorovSmirnovStatistic(samples, cdf), GoodnessOfFit::kolmogorovSmirnovCriticalValue(samples.size())) << name;
+	EXPECT_LE(GoodnessOfFit::andersonDarlingStatistic(samples, cdf), GoodnessOfFit::andersonDarlingCriticalValue()) << name;
+	EXPECT_LE(GoodnessOfFit::chiSquareStatistic(samples, cdf, VALIDATION_NUMBER_OF_BINS), GoodnessOfFit::chiSquareCriticalValue(VALIDATION_NUMBER_OF_BINS)) << name;
+}
+
+/// The statistics detect samples that do not fit, and accept samples that do.
+TEST_F(VariateValidationTest, StatisticsTest) {
+	// Evenly spaced samples of the standard uniform distribution fit perfectly.
+	std::vector<double> uniformSamples;
+	for (int i = 0; i < 1000; ++i) {
+		uniformSamples.push_back((i + 0.5) / 1000);
+	}
+	auto uniformCdf = [](double x) {return x <= 0.0 ? 0.0 : (x >= 1.0 ? 1.0 : x);};
+	EXPECT_NEAR(0.0005, GoodnessOfFit::kolmogorovSmirnovStatistic(uniformSamples, uniformCdf), 1e-12);
+	EXPECT_LT(GoodnessOfFit::andersonDarlingStatistic(uniformSamples, uniformCdf), 0.01);
+	EXPECT_DOUBLE_EQ(0.0, GoodnessOfFit::chiSquareStatistic(uniformSamples, uniformCdf, 10));
+	// Critical values.
+	EXPECT_NEAR(1.628 / 100.0, GoodnessOfFit::kolmogorovSmirnovCriticalValue(10000), 1e-4);
+	EXPECT_NEAR(21.666, GoodnessOfFit::chiSquareCriticalValue(10), 0.05);
+	EXPECT_NEAR(134.642, GoodnessOfFit::chiSquareCriticalValue(100), 0.05);
+	// CDFs.
+	EXPECT_DOUBLE_EQ(0.5, GoodnessOfFit::normalCdf(3.0, 3.0, 2.0));
+	EXPECT_NEAR(1.0 - std::exp(-1.0), GoodnessOfFit::exponentialCdf(2.0, 2.0), 1e-12);
+	EXPECT_NEAR(1.0 - std::exp(-4.0), GoodnessOfFit::weibullCdf(2.0, 1.0, 2.0), 1e-12);
+
+	// Exponential samples with tau 1.0 are rejected against tau 1.1 by all tests.
+	ExponentialTrafficGenerator exponentialGenerator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 1.0, 1);
+	std::vector<double> samples = sampleGenerator(exponentialGenerator, "Exponential tau 1.0");
+	auto wrongCdf = [](double x) {return GoodnessOfFit::exponentialCdf(x, 1.1);};
+	EXPECT_GT(GoodnessOfFit::kolmogorovSmirnovStatistic(samples, wrongCdf), GoodnessOfFit::kolmogorovSmirnovCriticalValue(samples.size()));
+	EXPECT_GT(GoodnessOfFit::andersonDarlingStatistic(samples, wrongCdf), GoodnessOfFit::andersonDarlingCriticalValue());
+	EXPECT_GT(GoodnessOfFit::chiSquareStatistic(samples, wrongCdf, VALIDATION_NUMBER_OF_BINS), GoodnessOfFit::chiSquareCriticalValue(VALIDATION_NUMBER_OF_BINS));
+}
+
+/// Exponential variate generator, with the parameters of doc/validations/exponential.
+TEST_F(VariateValidationTest, ExponentialValidationTest) {
+	unsigned int streamId = 0;
+	for (double lambda : {0.5, 1.0, 1.5, 3.0}) {
+		ExponentialTrafficGenerator generator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 1.0/lambda);
+		generator.setRandomStream(++streamId);
+		std::ostringstream name;
+		name << "Exponential lambda " << lambda;
+		expectFit(name.str(), sampleGenerator(generator, name.str()), [lambda](double x) {return GoodnessOfFit::exponentialCdf(x, 1.0/lambda);});
+	}
+	// Shared engine, one variate at a time.
+	ExponentialTrafficGenerator generator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 1.0);
+	expectFit("Exponential lambda 1.0, shared engine", sampleGenerator(generator, "Exponential lambda 1.0, shared engine"),
+		[](double x) {return GoodnessOfFit::exponentialCdf(x, 1.0);});
+}
+
+/// Normal variate generator, with the parameters of doc/validations/normal.
+TEST_F(VariateValidationTest, NormalValidationTest) {
+	unsigned int streamId = 0;
+	for (double variance : {0.2, 0.5, 1.0, 5.0}) {
+		double standardDeviation = std::sqrt(variance);
+		NormalTrafficGenerator generator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 0.0, standardDeviation);
+		generator.setRandomStream(++streamId);
+		std::ostringstream name;
+		name << "Normal variance " << variance;
+		expectFit(name.str(), sampleGenerator(generator, name.str()), [standardDeviation](double x) {return GoodnessOfFit::normalCdf(x, 0.0, standardDeviation);});
+	}
+	// Shared engine, one variate at a time.
+	NormalTrafficGenerator generator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 0.0, 1.0);
+	expectFit("Normal variance 1.0, shared engine", sampleGenerator(generator, "Normal variance 1.0, shared engine"),
+		[](double x) {return GoodnessOfFit::normalCdf(x, 0.0, 1.0);});
+}
+
+/// Weibull variate generator, with the parameters of doc/validations/weibull.
+TEST_F(VariateValidationTest, WeibullValidationTest) {
+	unsigned int streamId = 0;
+	for (double shape : {0.5, 1.0, 2.0, 5.0}) {
+		WeibullTrafficGenerator generator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 1.0, shape);
+		generator.setRandomStream(++streamId);
+		std::ostringstream name;
+		name << "Weibull shape " << shape;
+		expectFit(name.str(), sampleGenerator(generator, name.str()), [shape](double x) {return GoodnessOfFit::weibullCdf(x, 1.0, shape);});
+	}
+	// Shared engine, one variate at a time.
+	WeibullTrafficGenerator generator(simulatorGlobals, scheduler, EventType::TRAFFIC_GENERATOR_ARRIVAL, tokenContents, source, destination, 1, 1.0, 2.0);
+	expectFit("Weibull shape 2.0, shared engine", sampleGenerator(generator, "Weibull shape 2.0, shared engine"),
+		[](double x) {return GoodnessOfFit::weibullCdf(x, 1.0, 2.0);});
+}
@@ -0,0 +1,82 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This sample shows how to write a simple unit test for a function,
+// using Google C++ testing framework.
+//
+// Writing a unit test using Google C++ testing framework is easy as 1-2-3:
+
+
+// Step 1. Include necessary header files such that the stuff your
+// test logic needs is declared.
+//
+// Don't forget gtest.h, which declares the testing framework.
+
+#pragma once
+
+#include "../gtest/include/gtest/gtest.h"
+#include "../QcnSim/SimulatorGlobals.h"
+#include "../QcnSim/Scheduler.h"
+#include "../QcnSim/GoodnessOfFit.h"
+#include "../QcnSim/ExponentialTrafficGenerator.h"
+#include "../QcnSim/NormalTrafficGenerator.h"
+#include "../QcnSim/WeibullTrafficGenerator.h"
+#include "../QcnSim/Message.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define VALIDATION_NUMBER_OF_SAMPLES 100000 //!< Samples drawn per generator for the goodness of fit tests.
+#define VALIDATION_NUMBER_OF_BINS 100 //!< Equiprobable bins for the chi-square test.
+
+/// Fixture for in-process statistical validation of the variate generators (replaces plotting the CSV outputs in doc/validations).
+class VariateValidationTest: public ::testing::Test {
+protected:
+	SimulatorGlobals simulatorGlobals;
+	Scheduler scheduler;
+	std::shared_ptr<Message> source; //!< Dummy source for traffic generators.
+	std::shared_ptr<Message> destination; //!< Dummy destination for traffic generators.
+	std::shared_ptr<Message> tokenContents; //!< Dummy token contents for traffic generators.
+		
+	/**
+	 * Constructor.
+	 *
+	 * Do initializations here.
+	 */
+	VariateValidationTest();
+
+	/**
+	 * Draw samples from a generator, through its traffic events, and report its throughput.
+	 *
+	 * @param generator Generator to sample; it is turned on here.
+	 * @param name Name of the generator, to report variates per second.
+	 * @return Interarrival times of VALIDATION_NUMBER_OF_SAMPLES events.
+	 */
+	template<typename Generator> std::vector<double> sampleGenerator(Generator &generator, const std::string &name) {
+		std::vector<double> samples;
+		samples.reserve(VALIDATION_NUMBER_OF_SAMPLES);
+		generator.turnOn();
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < VALIDATION_NUMBER_OF_SAMPLES; ++i) {
+			generator.createInstanceTrafficEvent();
+			samples.push_back(scheduler.cause().occurAfterTime);
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		reportThroughput(name, elapsed.count());
+		return samples;
+	}
+
+	void reportThroughput(const std::string &name, double elapsedSeconds);
+	void expectFit(const std::string &name, const std::vector<double> &samples, const GoodnessOfFit::Cdf &cdf);
+};
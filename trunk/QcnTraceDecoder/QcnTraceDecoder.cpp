@@ -0,0 +1,93 @@
+/**
+ * This file is part of QCNSim.  QCNSim is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.<br>
+ * QCNSim is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.<br>
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with QCNSim.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// QcnTraceDecoder.cpp : Prints a binary event trace written by EventTracer as text, one record per line.
+//
+
+#include "../QcnSim/EventTracer.h"
+#include "../QcnSim/EventType.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Print the records of an event trace, optionally only those of one event type or entity.
+ *
+ * @details
+ * Usage: QcnTraceDecoder <trace file> [--type <EVENT_TYPE>] [--entity [node:|sensor:]<entity ID>]
+ * An entity ID without kind matches entities of all kinds with that ID.
+ *
+ * @return 0 if the trace was printed; 1 otherwise.
+ */
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cout << "Usage: " << argv[0] << " <trace file> [--type <EVENT_TYPE>] [--entity [node:|sensor:]<entity ID>]" << std::endl;
+		return 1;
+	}
+	std::string eventTypeName; // Event type to print; empty prints all.
+	bool isEntityFiltered = false;
+	bool isEntityKindFiltered = false;
+	TraceEntityKind entityKind = TraceEntityKind::NO_ENTITY;
+	unsigned long entityId = 0;
+	for (int argumentIndex = 2; argumentIndex + 1 < argc; argumentIndex += 2) {
+		if (std::strcmp(argv[argumentIndex], "--type") == 0) {
+			eventTypeName = argv[argumentIndex + 1];
+		} else if (std::strcmp(argv[argumentIndex], "--entity") == 0) {
+			std::string entity = argv[argumentIndex + 1];
+			std::string::size_type separator = entity.find(':');
+			if (separator != std::string::npos) {
+				std::string entityKindName = entity.substr(0, separator);
+				if (entityKindName == "node") {
+					entityKind = TraceEntityKind::NODE;
+				} else if (entityKindName == "sensor") {
+					entityKind = TraceEntityKind::SENSOR;
+				} else {
+					std::cout << "Unknown entity kind " << entityKindName << "." << std::endl;
+					return 1;
+				}
+				isEntityKindFiltered = true;
+				entity = entity.substr(separator + 1);
+			}
+			isEntityFiltered = true;
+			entityId = std::stoul(entity);
+		}
+	}
+
+	std::vector<EventTraceRecord> traceRecords;
+	switch (EventTracer::readTrace(argv[1], traceRecords)) {
+		case TraceReturnType::FILE_NOT_FOUND:
+			std::cout << "Could not open " << argv[1] << "." << std::endl;
+			return 1;
+		case TraceReturnType::INVALID_TRACE:
+			std::cout << argv[1] << " is not an event trace of version " << EVENT_TRACE_VERSION << "." << std::endl;
+			return 1;
+		default:
+			break;
+	}
+	for (auto &traceRecord : traceRecords) {
+		if (!eventTypeName.empty() && (traceRecord.eventType >= EVENT_TYPES_COUNT
+				|| eventTypeName != getEventTypeName(static_cast<EventType>(traceRecord.eventType)))) {
+			continue;
+		}
+		if (isEntityFiltered && traceRecord.entityId != entityId) {
+			continue;
+		}
+		if (isEntityKindFiltered && traceRecord.entityKind != static_cast<uint8_t>(entityKind)) {
+			continue;
+		}
+		std::cout << EventTracer::formatRecord(traceRecord) << "\n";
+	}
+	std::cout.flush();
+	return 0;
+}